@@ -61,8 +61,15 @@
 // ascent includes
 //-----------------------------------------------------------------------------
 #include <ascent_logging.hpp>
+#include <ascent_hdf5_lock.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #if defined(ASCENT_MPI_ENABLED)
     #include "ascent_hola_mpi.hpp"
@@ -88,7 +95,8 @@ public:
                                int num_files,
                                int num_trees,
                                const std::string &protocol,
-                               const Node &mesh_index)
+                               const Node &mesh_index,
+                               const Node &file_map)
     : m_file_pattern(file_pattern),
       m_tree_pattern(tree_pattern),
       m_num_files(num_files),
@@ -96,6 +104,11 @@ public:
       m_protocol(protocol),
       m_mesh_index(mesh_index)
     {
+        // optional explicit tree to file mapping
+        if(!file_map.dtype().is_empty())
+        {
+            file_map.to_int_array(m_file_map);
+        }
 
     }
 
@@ -153,8 +166,16 @@ public:
     //-------------------------------------------------------------------//
     std::string GenerateFilePath(int tree_id) const
     {
-        // for now, we only support 1 tree per file.
         int file_id = tree_id;
+        if(m_file_map.dtype().number_of_elements() == m_num_trees)
+        {
+            file_id = m_file_map.as_int_ptr()[tree_id];
+        }
+        else if(m_num_files > 0 && m_num_files < m_num_trees)
+        {
+            // trees are spread evenly and in order across the files
+            file_id = (int)(((long long)tree_id * m_num_files) / m_num_trees);
+        }
         return Expand(m_file_pattern,file_id);
     }
 
@@ -177,9 +198,88 @@ private:
     int m_num_trees;
     std::string m_protocol;
     Node m_mesh_index;
+    Node m_file_map;
 
 };
 
+//-----------------------------------------------------------------------------
+std::string domain_name(const int domain)
+{
+    char domain_fmt_buff[64];
+    snprintf(domain_fmt_buff, sizeof(domain_fmt_buff), "%06d",domain);
+    return "domain_" + std::string(domain_fmt_buff);
+}
+
+//-----------------------------------------------------------------------------
+// reads the given trees of one file into data, which must already
+// have a child for each domain. Files holding a single conduit_bin tree
+// can be memory mapped, they are loaded if the mapping fails.
+//-----------------------------------------------------------------------------
+void read_file_trees(const BlueprintTreePathGenerator &gen,
+                     const std::string &file_path,
+                     const std::vector<int> &trees,
+                     const std::string &protocol,
+                     const bool use_mmap,
+                     Node &data)
+{
+    if(use_mmap && trees.size() == 1 && gen.GenerateTreePath(trees[0]) == "/")
+    {
+        // the domain owns the mapping. Pages are only read from disk
+        // when a pipeline touches them. Conduit maps the file for
+        // writing, so this fails for read only files.
+        Node &dom = data[domain_name(trees[0])];
+        try
+        {
+            dom.mmap(file_path);
+            return;
+        }
+        catch(conduit::Error &e)
+        {
+            ASCENT_INFO("hola: failed to map " << file_path
+                        << ", loading it instead" << std::endl
+                        << e.message());
+            dom.reset();
+        }
+    }
+
+    // the hdf5 library is not thread safe, so hdf5 reads take turns
+    // with all other hdf5 io in the process. other protocols are parsed
+    // concurrently.
+    std::unique_lock<std::mutex> lock(hdf5_mutex(), std::defer_lock);
+    if(uses_hdf5(file_path, protocol))
+    {
+        lock.lock();
+    }
+
+    if(trees.size() == 1 && gen.GenerateTreePath(trees[0]) == "/")
+    {
+        relay::io::load(file_path,
+                        protocol,
+                        data[domain_name(trees[0])]);
+        return;
+    }
+
+    // the file holds several trees, pull out the ones we want
+    Node file_data;
+    relay::io::load(file_path, protocol, file_data);
+    if(lock.owns_lock())
+    {
+        lock.unlock();
+    }
+
+    for(size_t i = 0; i < trees.size(); ++i)
+    {
+        std::string tree_path = gen.GenerateTreePath(trees[i]);
+        tree_path = tree_path.substr(0, tree_path.size() - 1);
+        if(!file_data.has_path(tree_path))
+        {
+            ASCENT_ERROR("hola: file " << file_path
+                         << " is missing tree " << tree_path);
+        }
+        data[domain_name(trees[i])].set(file_data[tree_path]);
+    }
+}
+
 //-----------------------------------------------------------------------------
 void relay_blueprint_mesh_read(const Node &options,
                                Node &data)
@@ -210,7 +310,14 @@ void relay_blueprint_mesh_read(const Node &options,
     }
 
     Node root_node;
-    relay::io::load(root_fname, root_protocol, root_node);
+    {
+        std::unique_lock<std::mutex> lock(hdf5_mutex(), std::defer_lock);
+        if(root_protocol == "hdf5")
+        {
+            lock.lock();
+        }
+        relay::io::load(root_fname, root_protocol, root_node);
+    }
 
 
     if(!root_node.has_child("file_pattern"))
@@ -247,14 +354,19 @@ void relay_blueprint_mesh_read(const Node &options,
 
     int num_domains = root_node["number_of_trees"].to_int();
 
+    Node file_map;
+    if(root_node.has_path("partition_map/file"))
+    {
+        file_map.set_external(root_node["partition_map/file"]);
+    }
+
     BlueprintTreePathGenerator gen(root_node["file_pattern"].as_string(),
                                    root_node["tree_pattern"].as_string(),
                                    root_node["number_of_files"].to_int(),
                                    num_domains,
                                    data_protocol,
-                                   mesh_index);
-
-    std::ostringstream oss;
+                                   mesh_index,
+                                   file_map);
 
     int domain_start = 0;
     int domain_end = num_domains;
@@ -301,15 +413,82 @@ void relay_blueprint_mesh_read(const Node &options,
 #endif
 
 
+    // group the trees we read by file, so each file is opened once
+    std::map<std::string, std::vector<int>> file_trees;
     for(int i = domain_start ; i < domain_end; i++)
     {
-        char domain_fmt_buff[64];
-        snprintf(domain_fmt_buff, sizeof(domain_fmt_buff), "%06d",i);
-        oss.str("");
-        oss << "domain_" << std::string(domain_fmt_buff);
-        relay::io::load(gen.GenerateFilePath(i),
-                        data_protocol,
-                        data[oss.str()]);
+        file_trees[gen.GenerateFilePath(i)].push_back(i);
+        // create the outputs here, the readers only fill them in
+        data[domain_name(i)];
+    }
+
+    std::vector<std::string> file_paths;
+    for(auto &file : file_trees)
+    {
+        file_paths.push_back(file.first);
+    }
+
+    // conduit_bin domains are only mapped when asked for, since writes
+    // to the mapped data go back to the files
+    bool use_mmap = false;
+    if(data_protocol == "conduit_bin" &&
+       options.has_child("mmap") &&
+       options["mmap"].as_string() == "true")
+    {
+        use_mmap = true;
+    }
+
+    const int num_files = static_cast<int>(file_paths.size());
+    int num_threads = 1;
+    if(options.has_child("num_threads"))
+    {
+        num_threads = options["num_threads"].to_int();
+    }
+    num_threads = std::max(1, std::min(num_threads, num_files));
+
+    std::atomic<int> next_file(0);
+    std::mutex error_mutex;
+    std::string error_msg;
+
+    auto read_files = [&]()
+    {
+        int f;
+        while((f = next_file++) < num_files)
+        {
+            try
+            {
+                read_file_trees(gen,
+                                file_paths[f],
+                                file_trees[file_paths[f]],
+                                data_protocol,
+                                use_mmap,
+                                data);
+            }
+            catch(conduit::Error &e)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if(error_msg.empty())
+                {
+                    error_msg = e.message();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for(int i = 1; i < num_threads; ++i)
+    {
+        readers.push_back(std::thread(read_files));
+    }
+    read_files();
+    for(auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    if(!error_msg.empty())
+    {
+        ASCENT_ERROR("hola: failed to read domains" << std::endl << error_msg);
     }
 }
 
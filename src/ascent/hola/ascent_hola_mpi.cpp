@@ -62,7 +62,11 @@
 //-----------------------------------------------------------------------------
 #include <ascent_logging.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 using namespace conduit;
 using namespace std;
@@ -73,6 +77,10 @@ namespace ascent
 {
 
 
+// mpi tags for the schema and data messages of each domain
+const int HOLA_SCHEMA_TAG = 0;
+const int HOLA_DATA_TAG   = 1;
+
 //-----------------------------------------------------------------------------
 int32
 calc_offsets(const int32_array &lst,
@@ -88,23 +96,133 @@ calc_offsets(const int32_array &lst,
     return count;
 }
 
+//-----------------------------------------------------------------------------
+// number of cells in a blueprint domain, summed over its topologies
+//-----------------------------------------------------------------------------
+int64
+domain_cells(const conduit::Node &dom)
+{
+    if(!dom.has_child("topologies") || !dom.has_child("coordsets"))
+    {
+        return 0;
+    }
+
+    int64 cells = 0;
+    NodeConstIterator itr = dom["topologies"].children();
+    while(itr.has_next())
+    {
+        const Node &topo = itr.next();
+        const std::string type = topo["type"].as_string();
+        const std::string cset_name = topo["coordset"].as_string();
+        if(!dom["coordsets"].has_child(cset_name))
+        {
+            continue;
+        }
+        const Node &cset = dom["coordsets"][cset_name];
+
+        int64 topo_cells = 1;
+        if(type == "uniform")
+        {
+            NodeConstIterator dims = cset["dims"].children();
+            while(dims.has_next())
+            {
+                topo_cells *= std::max(dims.next().to_int64() - 1, (int64)1);
+            }
+        }
+        else if(type == "rectilinear")
+        {
+            NodeConstIterator vals = cset["values"].children();
+            while(vals.has_next())
+            {
+                const int64 n = vals.next().dtype().number_of_elements();
+                topo_cells *= std::max(n - 1, (int64)1);
+            }
+        }
+        else if(type == "structured")
+        {
+            NodeConstIterator dims = topo["elements/dims"].children();
+            while(dims.has_next())
+            {
+                topo_cells *= dims.next().to_int64();
+            }
+        }
+        else if(topo.has_path("elements/sizes"))
+        {
+            topo_cells = topo["elements/sizes"].dtype().number_of_elements();
+        }
+        else if(topo.has_path("elements/connectivity"))
+        {
+            const std::string shape = topo["elements/shape"].as_string();
+            int64 shape_points = 1;
+            if(shape == "line")       shape_points = 2;
+            else if(shape == "tri")   shape_points = 3;
+            else if(shape == "quad")  shape_points = 4;
+            else if(shape == "tet")   shape_points = 4;
+            else if(shape == "hex")   shape_points = 8;
+            topo_cells = topo["elements/connectivity"].dtype().number_of_elements()
+                         / shape_points;
+        }
+        else
+        {
+            topo_cells = 0;
+        }
+        cells += topo_cells;
+    }
+    return cells;
+}
+
+//-----------------------------------------------------------------------------
+// compact schema of each domain, used to size and to describe messages
+//-----------------------------------------------------------------------------
+void
+local_domain_schemas(const conduit::Node &data,
+                     conduit::Node &schemas)
+{
+    schemas.reset();
+    NodeConstIterator itr = data.children();
+    while(itr.has_next())
+    {
+        Schema s_compact;
+        itr.next().schema().compact_to(s_compact);
+        schemas.append() = s_compact.to_json();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// splits the domains, in order, into dest_size contiguous ranges with
+// about the same total weight. When there are enough domains every
+// destination gets at least one.
 //-----------------------------------------------------------------------------
 void
-gen_dest_domain_lst(const int32_array &lst,
+gen_dest_domain_lst(const int64 *weights,
                     int32 total_num_doms,
                     int32 dest_size,
                     int32_array &res)
 {
-    int32 doms_per_dest = total_num_doms / dest_size;
-    int32 count = 0;
+    std::vector<double> prefix(total_num_doms + 1, 0.0);
+    for(int i=0; i < total_num_doms; i++)
+    {
+        prefix[i+1] = prefix[i] + (double)weights[i];
+    }
+
+    const int32 min_doms = total_num_doms >= dest_size ? 1 : 0;
+    int32 begin = 0;
     for(int i=0; i < dest_size ;i++)
     {
-        count += doms_per_dest;
-        if(i == dest_size - 1)
+        int32 end = total_num_doms;
+        if(i < dest_size - 1)
         {
-            doms_per_dest += total_num_doms - count;
+            const double target = prefix[total_num_doms] * (i + 1) / dest_size;
+            const int32 max_end = total_num_doms - min_doms * (dest_size - i - 1);
+            end = std::min(begin + min_doms, max_end);
+            while(end < max_end &&
+                  std::abs(prefix[end+1] - target) <= std::abs(prefix[end] - target))
+            {
+                end++;
+            }
         }
-        res[i] = doms_per_dest;
+        res[i] = end - begin;
+        begin = end;
     }
 }
 
@@ -114,7 +232,8 @@ hola_mpi_comm_map(const conduit::Node &data,
                   MPI_Comm comm,
                   const conduit::int32_array &world_to_src,
                   const conduit::int32_array &world_to_dest,
-                  conduit::Node &res)
+                  conduit::Node &res,
+                  const std::string &balance)
 {
     // calc src_size and dest_size
 
@@ -166,32 +285,66 @@ hola_mpi_comm_map(const conduit::Node &data,
         }
     }
 
-    Node n_num_loc_doms, n_num_total_doms;
-
+    //
+    // each source describes its domains with a weight, the size of its
+    // compact schema and the size of its data
+    //
+    std::vector<int64> local_info;
     if(is_source_rank)
     {
-        n_num_loc_doms.set_int32(data.number_of_children());
-    }
-    else
-    {
-        n_num_loc_doms.set_int32(0);
+        local_domain_schemas(data, res["local_schemas"]);
+        NodeConstIterator itr = data.children();
+        NodeConstIterator schemas = res["local_schemas"].children();
+        while(itr.has_next())
+        {
+            const Node &dom = itr.next();
+            const std::string &schema = schemas.next().as_string();
+            const int64 data_bytes = dom.total_bytes_compact();
+
+            int64 weight = data_bytes;
+            if(balance == "cells")
+            {
+                weight = domain_cells(dom);
+            }
+            else if(balance == "domains")
+            {
+                weight = 1;
+            }
+            local_info.push_back(std::max(weight, (int64)1));
+            local_info.push_back((int64)schema.size());
+            local_info.push_back(data_bytes);
+        }
     }
 
-    relay::mpi::all_gather_using_schema(n_num_loc_doms,
-                                        n_num_total_doms,
-                                        comm);
+    int local_count = static_cast<int>(local_info.size());
+    std::vector<int> info_counts(total_size);
+    MPI_Allgather(&local_count, 1, MPI_INT,
+                  &info_counts[0], 1, MPI_INT,
+                  comm);
 
-    Node n_num_total_doms_acc;
+    std::vector<int> info_offsets(total_size, 0);
+    for(int i=1; i < total_size; i++)
+    {
+        info_offsets[i] = info_offsets[i-1] + info_counts[i-1];
+    }
 
-    n_num_total_doms_acc.set_external((int32*)n_num_total_doms.data_ptr(),total_size);
-    int32_array num_doms = n_num_total_doms_acc.as_int32_array();
+    const int num_info = info_offsets[total_size-1] + info_counts[total_size-1];
+    std::vector<int64> all_info(std::max(num_info, 1));
+    MPI_Allgatherv(local_info.empty() ? NULL : &local_info[0],
+                   local_count,
+                   MPI_INT64_T,
+                   &all_info[0],
+                   &info_counts[0],
+                   &info_offsets[0],
+                   MPI_INT64_T,
+                   comm);
 
     res["src_counts"] = DataType::int32(src_size);
     int32_array src_counts =res["src_counts"].value();
 
     for(int i=0;i<src_size;i++)
     {
-        src_counts[i] = num_doms[src_to_world[i]];
+        src_counts[i] = info_counts[src_to_world[i]] / 3;
     }
 
     res["src_offsets"] = DataType::int32(src_size);
@@ -200,19 +353,39 @@ hola_mpi_comm_map(const conduit::Node &data,
     int32 num_total_doms = calc_offsets(src_counts,
                                         src_offsets);
 
+    // per domain info in source order
+    res["domain_weights"] = DataType::int64(num_total_doms);
+    res["schema_sizes"]   = DataType::int64(num_total_doms);
+    res["data_sizes"]     = DataType::int64(num_total_doms);
+
+    int64 *domain_weights = res["domain_weights"].value();
+    int64 *schema_sizes   = res["schema_sizes"].value();
+    int64 *data_sizes     = res["data_sizes"].value();
+
+    for(int i=0;i<src_size;i++)
+    {
+        const int64 *info = &all_info[info_offsets[src_to_world[i]]];
+        for(int d=0; d < src_counts[i]; d++)
+        {
+            const int idx = src_offsets[i] + d;
+            domain_weights[idx] = info[3*d];
+            schema_sizes[idx]   = info[3*d+1];
+            data_sizes[idx]     = info[3*d+2];
+        }
+    }
+
     res["dest_counts"] = DataType::int32(dest_size);
 
     int32_array dest_lst =  res["dest_counts"].as_int32_array();
 
-    gen_dest_domain_lst(src_counts,
+    gen_dest_domain_lst(domain_weights,
                         num_total_doms,
                         dest_size,
                         dest_lst);
 
     res["dest_offsets"] = DataType::int32(dest_size);
     int32_array dest_offsets = res["dest_offsets"].as_int32_array();
-    int32 num_dest_domains = calc_offsets(dest_lst,
-                                          dest_offsets);
+    calc_offsets(dest_lst, dest_offsets);
 }
 
 
@@ -230,12 +403,18 @@ hola_mpi_send(const conduit::Node &data,
     const int32 *dest_offsets  = comm_map["dest_offsets"].value();
     const int32 *dest_to_world = comm_map["dest_to_world"].value();
 
+    const Node &schemas = comm_map["local_schemas"];
+
     // responsible for sending src_offsets[src_idx] + src_counts[src_idx]
     // to who ever needs them
     // assumes multi domain mesh bp
     // we expect: data.number_of_children() == src_counts[src_idx]
     NodeConstIterator itr = data.children();
 
+    // the compact data has to live until the sends complete
+    Node send_bufs;
+    std::vector<MPI_Request> requests;
+
     int dest_idx = 0;
     for(int i = src_offsets[src_idx];
         i < src_offsets[src_idx] + src_counts[src_idx];
@@ -250,12 +429,36 @@ hola_mpi_send(const conduit::Node &data,
 
         int32 dest_rank = dest_to_world[(int32)dest_idx];
 
-        // std::cout << "src_idx " << src_idx << " send " << i << " to "
-        //           << dest_idx << " (rank: " << dest_rank <<  " )" << std::endl;
-
-        relay::mpi::send_using_schema(n_curr,dest_rank,0,comm);
+        // the schema string is owned by the comm map
+        const Node &schema = schemas.child(i - src_offsets[src_idx]);
+        Node &buf = send_bufs.append();
+        n_curr.compact_to(buf);
+
+        requests.push_back(MPI_REQUEST_NULL);
+        MPI_Isend(const_cast<char*>(schema.as_char8_str()),
+                  static_cast<int>(schema.as_string().size()),
+                  MPI_CHAR,
+                  dest_rank,
+                  HOLA_SCHEMA_TAG,
+                  comm,
+                  &requests.back());
+
+        requests.push_back(MPI_REQUEST_NULL);
+        MPI_Isend(buf.data_ptr(),
+                  static_cast<int>(buf.total_bytes_compact()),
+                  MPI_BYTE,
+                  dest_rank,
+                  HOLA_DATA_TAG,
+                  comm,
+                  &requests.back());
     }
 
+    if(!requests.empty())
+    {
+        MPI_Waitall(static_cast<int>(requests.size()),
+                    &requests[0],
+                    MPI_STATUSES_IGNORE);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -272,29 +475,76 @@ hola_mpi_recv(MPI_Comm comm,
     const int32 *dest_counts  = comm_map["dest_counts"].value();
     const int32 *dest_offsets = comm_map["dest_offsets"].value();
 
+    const int64 *schema_sizes = comm_map["schema_sizes"].value();
+    const int64 *data_sizes   = comm_map["data_sizes"].value();
+
+    const int num_recvs = dest_counts[dest_idx];
+    if(num_recvs == 0)
+    {
+        return;
+    }
+
     // responsible for receiving dest_offsets[dest_idx] + dest_counts[dest_idx]
-    // from who ever has them
+    // from who ever has them. The message sizes are known, so every
+    // schema receive is posted up front. Receives from one source are
+    // posted in the order it sends.
+    std::vector<int> src_ranks(num_recvs);
+    std::vector<std::string> schemas(num_recvs);
+    std::vector<MPI_Request> requests(num_recvs, MPI_REQUEST_NULL);
+
     int src_idx = 0;
-    for(int i = dest_offsets[dest_idx];
-        i < dest_offsets[dest_idx] + dest_counts[dest_idx];
-        i++)
+    for(int r = 0; r < num_recvs; r++)
     {
+        const int i = dest_offsets[dest_idx] + r;
         // find  i's src
         while( i >= src_offsets[src_idx] + src_counts[src_idx])
         {
             src_idx++;
         }
 
-        int32 src_rank = src_to_world[(int32)src_idx];
-        // std::cout << "dest_idx " << dest_idx << " rcv "
-        //           << i <<  " from " << src_idx << " ( rank: " << src_rank << ") " <<std::endl;
+        src_ranks[r] = src_to_world[(int32)src_idx];
+        schemas[r].resize(schema_sizes[i]);
+        MPI_Irecv(&schemas[r][0],
+                  static_cast<int>(schema_sizes[i]),
+                  MPI_CHAR,
+                  src_ranks[r],
+                  HOLA_SCHEMA_TAG,
+                  comm,
+                  &requests[r]);
+    }
+
+    MPI_Waitall(num_recvs, &requests[0], MPI_STATUSES_IGNORE);
+
+    // the data lands directly in the output domains
+    for(int r = 0; r < num_recvs; r++)
+    {
+        const int i = dest_offsets[dest_idx] + r;
         Node &n_curr = data.append();
-        // rcv n_curr
-        relay::mpi::recv_using_schema(n_curr,src_rank,0,comm);
+        n_curr.set(Schema(schemas[r]));
+        MPI_Irecv(n_curr.data_ptr(),
+                  static_cast<int>(data_sizes[i]),
+                  MPI_BYTE,
+                  src_ranks[r],
+                  HOLA_DATA_TAG,
+                  comm,
+                  &requests[r]);
     }
+
+    MPI_Waitall(num_recvs, &requests[0], MPI_STATUSES_IGNORE);
 }
 
 
+//-----------------------------------------------------------------------------
+// number of comm maps hola_mpi built instead of reusing a cached one
+static int hola_mpi_num_comm_map_builds = 0;
+
+//-----------------------------------------------------------------------------
+int
+hola_mpi_comm_map_builds()
+{
+    return hola_mpi_num_comm_map_builds;
+}
+
 //-----------------------------------------------------------------------------
 void
 hola_mpi(const conduit::Node &options,
@@ -308,6 +558,18 @@ hola_mpi(const conduit::Node &options,
 
     int rank_split = options["rank_split"].to_int();
 
+    std::string balance = "bytes";
+    if(options.has_child("balance"))
+    {
+        balance = options["balance"].as_string();
+    }
+
+    if(balance != "bytes" && balance != "cells" && balance != "domains")
+    {
+        ASCENT_ERROR("hola_mpi: unknown balance '" << balance << "'"
+                     << " (expected 'bytes', 'cells' or 'domains')");
+    }
+
     //
     // TODO: We can enhance to also support the case
     // where client code passes in world to src and world to dest maps
@@ -359,13 +621,51 @@ hola_mpi(const conduit::Node &options,
         data_ptr = &md_data;
     }
 
-    Node comm_map;
+    //
+    // the comm map is kept between calls and rebuilt only when a
+    // source's domains change shape
+    //
+    static Node comm_map_cache;
+    std::ostringstream key;
+    key << "comm_" << options["mpi_comm"].to_int()
+        << "_size_" << total_size
+        << "_split_" << rank_split
+        << "_" << balance;
+
+    Node &comm_map = comm_map_cache[key.str()];
+
+    int local_changed = 1;
+    if(comm_map.has_child("src_to_world"))
+    {
+        local_changed = 0;
+        if(is_src_rank)
+        {
+            Node schemas;
+            local_domain_schemas(*data_ptr, schemas);
+            const Node &cached = comm_map["local_schemas"];
+            local_changed = schemas.number_of_children() !=
+                            cached.number_of_children();
+            for(int i=0; !local_changed && i < schemas.number_of_children(); i++)
+            {
+                local_changed = schemas.child(i).as_string() !=
+                                cached.child(i).as_string();
+            }
+        }
+    }
+
+    int changed = 1;
+    MPI_Allreduce(&local_changed, &changed, 1, MPI_INT, MPI_MAX, comm);
 
-    hola_mpi_comm_map(*data_ptr,
-                      comm,
-                      world_to_src,
-                      world_to_dest,
-                      comm_map);
+    if(changed)
+    {
+        hola_mpi_comm_map(*data_ptr,
+                          comm,
+                          world_to_src,
+                          world_to_dest,
+                          comm_map,
+                          balance);
+        hola_mpi_num_comm_map_builds++;
+    }
 
     if(is_src_rank )
     {
@@ -70,14 +70,21 @@ namespace ascent
 void ASCENT_API hola_mpi(const conduit::Node &options,
                          conduit::Node &data);
 
+/// number of times hola_mpi built a comm map instead of reusing
+/// the one kept from an earlier call
+int ASCENT_API hola_mpi_comm_map_builds();
+
 
 /// Creates maps used for book keeping to guide sending domains
-/// from source to destination ranks.
+/// from source to destination ranks. Destinations get contiguous
+/// ranges of domains with about the same total weight, where balance
+/// selects the weight of a domain: "bytes", "cells" or "domains".
 void ASCENT_API hola_mpi_comm_map(const conduit::Node &data,
                                   MPI_Comm comm,
                                   const conduit::int32_array &world_to_src,
                                   const conduit::int32_array &world_to_dest,
-                                  conduit::Node &res);
+                                  conduit::Node &res,
+                                  const std::string &balance = "bytes");
 
 /// executes a send
 void ASCENT_API hola_mpi_send(const conduit::Node &data,
@@ -77,6 +77,10 @@ namespace expressions
 extern ASTExpression *expression;
 
 conduit::Node ExpressionEval::m_cache;
+conduit::Node ExpressionEval::m_field_stats;
+std::map<std::string, CompiledExpression> ExpressionEval::m_compiled;
+std::map<std::string, DerivedFieldProgram> ExpressionEval::m_derived_fields;
+std::mutex ExpressionEval::m_lock;
 conduit::Node g_function_table;
 
 void register_builtin()
@@ -232,6 +236,41 @@ initialize_functions()
   // TODO: validate thar there are no ambiguities
 }
 
+CompiledExpression &
+ExpressionEval::compile(const std::string &expr)
+{
+  std::map<std::string, CompiledExpression>::iterator itr = m_compiled.find(expr);
+  if(itr != m_compiled.end())
+  {
+    return itr->second;
+  }
+
+  try
+  {
+    scan_string(expr.c_str());
+  }
+  catch(const char* msg)
+  {
+    ASCENT_ERROR("Expression parsing error: "<<msg<<" in '"<<expr<<"'");
+  }
+
+  ASTExpression *expression = get_result();
+
+  CompiledExpression program(g_function_table);
+  try
+  {
+    program.set_result(expression->compile(program));
+  }
+  catch(...)
+  {
+    delete expression;
+    throw;
+  }
+  delete expression;
+
+  return m_compiled.insert(std::make_pair(expr, program)).first->second;
+}
+
 conduit::Node
 ExpressionEval::evaluate(const std::string expr, std::string expr_name)
 {
@@ -241,8 +280,50 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
     expr_name = expr;
   }
 
+  // the compiled programs and caches are shared by all evaluators
+  std::lock_guard<std::mutex> guard(m_lock);
+
+  CompiledExpression &program = compile(expr);
+
   w.registry().add<conduit::Node>("dataset", m_data, -1);
   w.registry().add<conduit::Node>("cache", &m_cache, -1);
+  w.registry().add<conduit::Node>("field_stats", &m_field_stats, -1);
+  w.registry().add<conduit::Node>("function_table", &g_function_table, -1);
+  int cycle = get_state_var(*m_data, "cycle").to_int32();
+  w.registry().add<int>("cycle", &cycle, -1);
+
+  ExprContext ctx;
+  ctx.m_dataset = m_data;
+  ctx.m_cache = &m_cache;
+  ctx.m_registry = &w.registry();
+
+  conduit::Node return_val;
+  try
+  {
+    program.execute(ctx).to_node(return_val);
+  }
+  catch(std::exception &e)
+  {
+    w.reset();
+    ASCENT_ERROR("Error while executing expression '"<<expr<<"': "<<e.what());
+  }
+
+  std::stringstream cache_entry;
+  cache_entry<<expr_name<<"/"<<cycle;
+  m_cache[cache_entry.str()] = return_val;
+
+  w.reset();
+  return return_val;
+}
+
+conduit::Node
+ExpressionEval::evaluate_graph(const std::string expr)
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+
+  w.registry().add<conduit::Node>("dataset", m_data, -1);
+  w.registry().add<conduit::Node>("cache", &m_cache, -1);
+  w.registry().add<conduit::Node>("field_stats", &m_field_stats, -1);
   w.registry().add<conduit::Node>("function_table", &g_function_table, -1);
   int cycle = get_state_var(*m_data, "cycle").to_int32();
   w.registry().add<int>("cycle", &cycle, -1);
@@ -259,31 +340,70 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
 
   ASTExpression *expression = get_result();
 
-  expression->access();
-  conduit::Node root = expression->build_graph(w);
-
-  //std::cout<<w.graph().to_dot()<<"\n";
+  conduit::Node return_val;
   try
   {
+    expression->access();
+    conduit::Node root = expression->build_graph(w);
     w.execute();
+    return_val = *w.registry().fetch<conduit::Node>(root["filter_name"].as_string());
   }
   catch(std::exception &e)
   {
+    delete expression;
     w.reset();
     ASCENT_ERROR("Error while executing expression '"<<expr<<"': "<<e.what());
   }
-  conduit::Node *n_res = w.registry().fetch<conduit::Node>(root["filter_name"].as_string());
-  conduit::Node return_val = *n_res;
   delete expression;
 
-  std::stringstream cache_entry;
-  cache_entry<<expr_name<<"/"<<cycle;
-  m_cache[cache_entry.str()] = *n_res;
-
   w.reset();
   return return_val;
 }
 
+DerivedFieldProgram
+ExpressionEval::derived_field(const std::string &expr)
+{
+  std::lock_guard<std::mutex> guard(m_lock);
+
+  std::map<std::string, DerivedFieldProgram>::iterator itr = m_derived_fields.find(expr);
+  if(itr == m_derived_fields.end())
+  {
+    try
+    {
+      scan_string(expr.c_str());
+    }
+    catch(const char* msg)
+    {
+      ASCENT_ERROR("Expression parsing error: "<<msg<<" in '"<<expr<<"'");
+    }
+
+    ASTExpression *expression = get_result();
+
+    DerivedFieldProgram program;
+    try
+    {
+      program.set_result(expression->compile_field(program));
+    }
+    catch(...)
+    {
+      delete expression;
+      throw;
+    }
+    delete expression;
+
+    if(program.field_names().size() == 0)
+    {
+      ASCENT_ERROR("Derived field expression '"<<expr<<"' does not reference any fields");
+    }
+
+    itr = m_derived_fields.insert(std::make_pair(expr, program)).first;
+  }
+
+  DerivedFieldProgram program = itr->second;
+  program.bind_identifiers(m_cache);
+  return program;
+}
+
 const conduit::Node&
 ExpressionEval::get_cache()
 {
@@ -54,6 +54,11 @@
 #include <conduit.hpp>
 
 #include "flow_workspace.hpp"
+#include "expressions/ascent_compiled_expression.hpp"
+#include "expressions/ascent_derived_field.hpp"
+
+#include <map>
+#include <mutex>
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
 //-----------------------------------------------------------------------------
@@ -79,12 +84,29 @@ protected:
   conduit::Node *m_data;
   flow::Workspace w;
   static conduit::Node m_cache;
+  // field stats shared by all expressions of a cycle
+  static conduit::Node m_field_stats;
+  // expressions are parsed and type-checked once, later evaluations
+  // only bind the current dataset
+  static std::map<std::string, CompiledExpression> m_compiled;
+  static std::map<std::string, DerivedFieldProgram> m_derived_fields;
+  static std::mutex m_lock;
+
+  CompiledExpression &compile(const std::string &expr);
 public:
   ExpressionEval(conduit::Node *data);
 
   static const conduit::Node &get_cache();
 
+  // element-wise program for expr with identifiers bound to
+  // the current expression cache
+  static DerivedFieldProgram derived_field(const std::string &expr);
+
   conduit::Node evaluate(const std::string expr, std::string exp_name = "");
+
+  // evaluates expr with a graph of the expression flow filters instead
+  // of the compiled program, the result is not added to the cache
+  conduit::Node evaluate_graph(const std::string expr);
 };
 
 //-----------------------------------------------------------------------------
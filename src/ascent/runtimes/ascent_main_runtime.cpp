@@ -53,6 +53,7 @@
 
 // standard lib includes
 #include <string.h>
+#include <sys/stat.h>
 
 //-----------------------------------------------------------------------------
 // thirdparty includes
@@ -70,9 +71,11 @@
 
 #include <flow.hpp>
 #include <ascent_runtime_filters.hpp>
+#include <ascent_runtime_relay_filters.hpp>
 #include <ascent_expression_eval.hpp>
 
 #if defined(ASCENT_VTKM_ENABLED)
+#include <ascent_runtime_rover_filters.hpp>
 #include <vtkh/vtkh.hpp>
 #include <vtkh/Error.hpp>
 
@@ -112,6 +115,103 @@ class InfoHandler
 
 int InfoHandler::m_rank = 0;
 
+//-----------------------------------------------------------------------------
+// extracts that read vtk-h data sets and default to the vtk-h
+// version of the published data instead of the blueprint mesh
+//-----------------------------------------------------------------------------
+static bool
+extract_uses_vtkh(const std::string &extract_type)
+{
+    return extract_type == "xray" ||
+           extract_type == "volume";
+}
+
+//-----------------------------------------------------------------------------
+// true if two trees hold the same names, types and values
+//-----------------------------------------------------------------------------
+static bool
+same_tree(const Node &a, const Node &b)
+{
+    const DataType &a_type = a.dtype();
+    const DataType &b_type = b.dtype();
+    if(a_type.id() != b_type.id() ||
+       a.number_of_children() != b.number_of_children())
+    {
+        return false;
+    }
+
+    const index_t num_children = a.number_of_children();
+    if(num_children == 0)
+    {
+        if(a_type.is_empty())
+        {
+            return true;
+        }
+        if(a_type.number_of_elements() != b_type.number_of_elements())
+        {
+            return false;
+        }
+        if(a.is_compact() && b.is_compact())
+        {
+            return memcmp(a.element_ptr(0),
+                          b.element_ptr(0),
+                          a_type.bytes_compact()) == 0;
+        }
+        return a.to_json() == b.to_json();
+    }
+
+    for(index_t i = 0; i < num_children; ++i)
+    {
+        if(a_type.is_object() && a.child(i).name() != b.child(i).name())
+        {
+            return false;
+        }
+        if(!same_tree(a.child(i), b.child(i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// appends the modification time and size of a file (-1 if it does
+// not exist) to stamps
+//-----------------------------------------------------------------------------
+static void
+stamp_file(const std::string &file_name, Node &stamps)
+{
+    Node &stamp = stamps.append();
+    stamp["file"] = file_name;
+
+    struct stat file_stat;
+    if(stat(file_name.c_str(), &file_stat) != 0)
+    {
+        stamp["mtime"] = static_cast<int64>(-1);
+        stamp["size"]  = static_cast<int64>(-1);
+        return;
+    }
+
+    stamp["mtime"] = static_cast<int64>(file_stat.st_mtime);
+    stamp["size"]  = static_cast<int64>(file_stat.st_size);
+}
+
+#ifdef ASCENT_MPI_ENABLED
+//-----------------------------------------------------------------------------
+// cacheable filters may issue collectives, so a cached result is only
+// used if every rank has a hit
+//-----------------------------------------------------------------------------
+static bool
+mpi_cache_consensus(bool local_hit)
+{
+    MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+    int local  = local_hit ? 1 : 0;
+    int global = 0;
+    MPI_Allreduce(&local, &global, 1, MPI_INT, MPI_MIN, mpi_comm);
+    return global == 1;
+}
+#endif
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //
@@ -125,7 +225,12 @@ AscentRuntime::AscentRuntime()
 :Runtime(),
  m_refinement_level(2), // default refinement level for high order meshes
  m_rank(0),
- m_ghost_field_name("ascent_ghosts")
+ m_ghost_field_name("ascent_ghosts"),
+ m_verify_mode("always"),
+ m_graph_cache(false),
+ m_graph_cache_valid(false),
+ m_graph_cache_clean(true),
+ m_graph_cache_reset_pending(false)
 {
     flow::filters::register_builtin();
     ResetInfo();
@@ -219,6 +324,60 @@ AscentRuntime::Initialize(const conduit::Node &options)
       m_ghost_field_name = options["ghost_field_name"].as_string();
     }
 
+    if(options.has_path("verify"))
+    {
+      m_verify_mode = options["verify"].as_string();
+      if(m_verify_mode != "incremental" &&
+         m_verify_mode != "first_cycle" &&
+         m_verify_mode != "always")
+      {
+        ASCENT_ERROR("'verify' must be one of "
+                     "{\"incremental\", \"first_cycle\", \"always\"}");
+      }
+    }
+
+    if(options.has_path("graph_cache") &&
+       options["graph_cache"].as_string() == "enabled")
+    {
+      m_graph_cache = true;
+    }
+
+    // only filters that declare thread_safe run concurrently, and none
+    // of the built-in ascent filters do, so this only affects filters
+    // registered by the application
+    if(options.has_path("flow/num_threads"))
+    {
+      int num_threads = options["flow/num_threads"].to_int32();
+#ifdef ASCENT_MPI_ENABLED
+      // many filters issue collectives, which must be called in the
+      // same order on every rank. This can't be guaranteed when
+      // independent filters execute concurrently.
+      int comm_size = 1;
+      MPI_Comm_size(MPI_Comm_f2c(options["mpi_comm"].to_int()), &comm_size);
+      if(num_threads > 1 && comm_size > 1)
+      {
+        ASCENT_INFO("'flow/num_threads' is not supported with more than "
+                    "one MPI task, filters will execute serially");
+        num_threads = 1;
+      }
+#endif
+      w.set_num_threads(num_threads);
+    }
+
+    if(options.has_path("flow/cache") &&
+       options["flow/cache"].as_string() == "enabled")
+    {
+#ifdef ASCENT_MPI_ENABLED
+      int comm_size = 1;
+      MPI_Comm_size(MPI_Comm_f2c(options["mpi_comm"].to_int()), &comm_size);
+      if(comm_size > 1)
+      {
+        w.set_cache_consensus_method(mpi_cache_consensus);
+      }
+#endif
+      w.set_cache_enabled(true);
+    }
+
     // standard flow filters
     flow::filters::register_builtin();
     // filters for ascent flow runtime.
@@ -267,6 +426,13 @@ AscentRuntime::ResetInfo()
 void
 AscentRuntime::Cleanup()
 {
+    // finish writing asynchronous extracts before closing
+    runtime::filters::relay_io_flush();
+#if defined(ASCENT_VTKM_ENABLED)
+    // release the rays and engines kept by the rover extracts
+    runtime::filters::RoverCaches::clear();
+#endif
+
     if(m_runtime_options.has_child("timings") &&
        m_runtime_options["timings"].as_string() == "enabled")
     {
@@ -397,6 +563,7 @@ AscentRuntime::CreateDefaultFilters()
     //
     conduit::Node params;
     params["protocol"] = "mesh";
+    params["verify"]   = m_verify_mode;
 
     w.graph().add_filter("blueprint_verify", // registered filter name
                          "verify",           // "unique" filter name
@@ -642,17 +809,16 @@ AscentRuntime::ConvertExtractToFlow(const conduit::Node &extract,
 
   // currently these are special cases.
   // TODO:
-  bool special = false;
-  if(extract_type == "xray" ||
-     extract_type == "volume") special = true;
+  bool special = extract_uses_vtkh(extract_type);
 
   std::string ensure_name = "ensure_blueprint_" + extract_name;
-  conduit::Node empty_params;
   if(!special)
   {
+    conduit::Node ensure_params;
+    ensure_params["verify"] = m_verify_mode;
     w.graph().add_filter("ensure_blueprint",
                          ensure_name,
-                         empty_params);
+                         ensure_params);
   }
 
   w.graph().add_filter(filter_name,
@@ -708,6 +874,10 @@ AscentRuntime::ConvertTriggerToFlow(const conduit::Node &trigger,
   // this is the blueprint mesh
   m_connections[trigger_name] = "source";
 
+  // the trigger's actions run as part of this graph, so they share
+  // the converted data and pipelines with the main actions
+  const std::string actions_file = params["actions_file"].as_string();
+  CreateTriggerGraph(LoadTriggerActions(actions_file), trigger_name);
 }
 //-----------------------------------------------------------------------------
 void
@@ -820,6 +990,215 @@ AscentRuntime::CreateTriggers(const conduit::Node &triggers)
   }
 }
 
+//-----------------------------------------------------------------------------
+// Trigger actions files are parsed once and re-read only when the file's
+// modification time or size changes. A missing file yields no actions.
+//-----------------------------------------------------------------------------
+const conduit::Node &
+AscentRuntime::LoadTriggerActions(const std::string &actions_file)
+{
+  conduit::Node &entry = m_trigger_actions[actions_file];
+
+  struct stat file_stat;
+  if(stat(actions_file.c_str(), &file_stat) != 0)
+  {
+    ASCENT_INFO("Trigger actions file '"<<actions_file<<"' does not exist");
+    entry.reset();
+    entry["actions"].set(DataType::empty());
+    return entry["actions"];
+  }
+
+  const int64 mtime = static_cast<int64>(file_stat.st_mtime);
+  const int64 size  = static_cast<int64>(file_stat.st_size);
+
+  if(!entry.has_path("mtime") ||
+     entry["mtime"].to_int64() != mtime ||
+     entry["size"].to_int64() != size)
+  {
+    std::string protocol = "json";
+    std::string curr, next;
+    conduit::utils::rsplit_string(actions_file, ".", curr, next);
+    if(curr == "yaml")
+    {
+      protocol = "yaml";
+    }
+
+    entry.reset();
+    entry["actions"].load(actions_file, protocol);
+    entry["mtime"] = mtime;
+    entry["size"] = size;
+  }
+
+  return entry["actions"];
+}
+
+//-----------------------------------------------------------------------------
+// Returns the filter a trigger's pipeline, plot, extract or query reads
+// from. References to the trigger's own pipelines are renamed, everything
+// else (the published data, the default filters and the pipelines of the
+// main actions) is shared with the main graph through a gate on the
+// trigger, so nothing is converted twice.
+//-----------------------------------------------------------------------------
+std::string
+AscentRuntime::TriggerSource(const std::string &trigger_name,
+                             const conduit::Node &trigger_pipelines,
+                             const std::string &source,
+                             const std::string &default_source)
+{
+  if(source != "" && trigger_pipelines.has_child(source))
+  {
+    return trigger_name + "_" + source;
+  }
+
+  const std::string input = source == "" ? default_source : source;
+  const std::string gate_name = trigger_name + "_gate_" + input;
+
+  if(!w.graph().has_filter(gate_name))
+  {
+    w.graph().add_filter("gate", gate_name);
+    // the gated filter may not exist yet, connect these later
+    m_trigger_gates[gate_name]["in"] = input;
+    m_trigger_gates[gate_name]["gate"] = trigger_name;
+  }
+
+  return gate_name;
+}
+
+//-----------------------------------------------------------------------------
+// Adds the actions of a trigger to the graph. The trigger filter skips its
+// output when the condition is false, which skips the entire sub-graph.
+// Names of the trigger's pipelines, scenes and extracts get the trigger's
+// name as a prefix to keep them apart from the main actions.
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::CreateTriggerGraph(const conduit::Node &actions,
+                                  const std::string &trigger_name)
+{
+  conduit::Node queries;
+  conduit::Node pipelines;
+  conduit::Node scenes;
+  conduit::Node extracts;
+
+  for(int i = 0; i < actions.number_of_children(); ++i)
+  {
+    const conduit::Node &action = actions.child(i);
+    if(!action.has_path("action"))
+    {
+      ASCENT_ERROR("Trigger '"<<trigger_name<<"': action missing child 'action'");
+    }
+
+    const std::string action_name = action["action"].as_string();
+    if(action_name == "add_queries" && action.has_path("queries"))
+    {
+      queries.update(action["queries"]);
+    }
+    else if(action_name == "add_pipelines" && action.has_path("pipelines"))
+    {
+      pipelines.update(action["pipelines"]);
+    }
+    else if(action_name == "add_scenes" && action.has_path("scenes"))
+    {
+      scenes.update(action["scenes"]);
+    }
+    else if(action_name == "add_extracts" && action.has_path("extracts"))
+    {
+      extracts.update(action["extracts"]);
+    }
+    else if(action_name == "execute" || action_name == "reset")
+    {
+      // the trigger executes with the main graph
+      continue;
+    }
+    else
+    {
+      ASCENT_ERROR("Trigger '"<<trigger_name<<"': unsupported action '"
+                   <<action_name<<"'");
+    }
+  }
+
+  const std::string prefix = trigger_name + "_";
+
+  // expression results are named by the query's "name" param,
+  // so only the filters are prefixed
+  std::vector<std::string> names = queries.child_names();
+  for(int i = 0; i < queries.number_of_children(); ++i)
+  {
+    ConvertQueryToFlow(queries.child(i), prefix + names[i]);
+    m_connections[prefix + names[i]] = TriggerSource(trigger_name,
+                                                     pipelines,
+                                                     "",
+                                                     "source");
+  }
+
+  names = pipelines.child_names();
+  for(int i = 0; i < pipelines.number_of_children(); ++i)
+  {
+    conduit::Node pipeline = pipelines.child(i);
+    std::string source;
+    if(pipeline.has_path("pipeline"))
+    {
+      source = pipeline["pipeline"].as_string();
+    }
+    pipeline["pipeline"] = TriggerSource(trigger_name,
+                                         pipelines,
+                                         source,
+                                         CreateDefaultFilters());
+    ConvertPipelineToFlow(pipeline, prefix + names[i]);
+  }
+
+  conduit::Node trigger_scenes;
+  names = scenes.child_names();
+  for(int i = 0; i < scenes.number_of_children(); ++i)
+  {
+    conduit::Node &scene = trigger_scenes[prefix + names[i]];
+    scene = scenes.child(i);
+    if(!scene.has_path("plots"))
+    {
+      continue;
+    }
+
+    conduit::Node &plots = scene["plots"];
+    for(int p = 0; p < plots.number_of_children(); ++p)
+    {
+      conduit::Node &plot = plots.child(p);
+      std::string source;
+      if(plot.has_path("pipeline"))
+      {
+        source = plot["pipeline"].as_string();
+      }
+      plot["pipeline"] = TriggerSource(trigger_name,
+                                       pipelines,
+                                       source,
+                                       CreateDefaultFilters());
+    }
+  }
+  CreateScenes(trigger_scenes);
+
+  names = extracts.child_names();
+  for(int i = 0; i < extracts.number_of_children(); ++i)
+  {
+    conduit::Node extract = extracts.child(i);
+    std::string source;
+    if(extract.has_path("pipeline"))
+    {
+      source = extract["pipeline"].as_string();
+    }
+
+    std::string default_source = "source";
+    if(extract.has_path("type") &&
+       extract_uses_vtkh(extract["type"].as_string()))
+    {
+      default_source = CreateDefaultFilters();
+    }
+
+    extract["pipeline"] = TriggerSource(trigger_name,
+                                        pipelines,
+                                        source,
+                                        default_source);
+    ConvertExtractToFlow(extract, prefix + names[i]);
+  }
+}
+
 //-----------------------------------------------------------------------------
 void
 AscentRuntime::CreateQueries(const conduit::Node &queries)
@@ -840,6 +1219,9 @@ AscentRuntime::PopulateMetadata()
   const int num_domains = m_data.number_of_children();
   int cycle = 0;
   float time = 0.f;
+  // the mesh generation is only meaningful if every domain has one
+  bool has_mesh_generation = num_domains > 0;
+  int64 mesh_generation = 0;
 
   for(int i = 0; i < num_domains; ++i)
   {
@@ -852,6 +1234,14 @@ AscentRuntime::PopulateMetadata()
     {
       time = dom["state/time"].to_float32();
     }
+    if(dom.has_path("state/mesh_generation"))
+    {
+      mesh_generation += dom["state/mesh_generation"].to_int64();
+    }
+    else
+    {
+      has_mesh_generation = false;
+    }
   }
 
   if(!w.registry().has_entry("metadata"))
@@ -864,6 +1254,14 @@ AscentRuntime::PopulateMetadata()
   (*meta)["cycle"] = cycle;
   (*meta)["time"] = time;
   (*meta)["refinement_level"] = m_refinement_level;
+  if(has_mesh_generation)
+  {
+    (*meta)["mesh_generation"] = mesh_generation;
+  }
+  else if(meta->has_path("mesh_generation"))
+  {
+    meta->remove("mesh_generation");
+  }
 
 }
 //-----------------------------------------------------------------------------
@@ -879,6 +1277,14 @@ AscentRuntime::ConnectSource()
                                &m_data);
     }
 
+    // verify signatures are kept across cycles, the entry isn't
+    // tracked so registry resets don't release it
+    if(!w.registry().has_entry("verify_cache"))
+    {
+        w.registry().add<Node>("verify_cache",
+                               &m_verify_cache);
+    }
+
     if(!w.graph().has_filter("source"))
     {
        Node p;
@@ -909,6 +1315,26 @@ AscentRuntime::ConnectGraphs()
                       names[i], // dest
                       0);       // default port
   }
+
+  // connect the gates that guard trigger actions
+  names = m_trigger_gates.child_names();
+  for(int i = 0; i < m_trigger_gates.number_of_children(); ++i)
+  {
+    const conduit::Node &gate = m_trigger_gates.child(i);
+    const std::string input = gate["in"].as_string();
+    if(!w.graph().has_filter(input))
+    {
+      ASCENT_ERROR("Trigger '"<<gate["gate"].as_string()
+                   <<"' references unknown pipeline: "<<input);
+    }
+
+    w.graph().connect(input,    // src
+                      names[i], // dest
+                      "in");
+    w.graph().connect(gate["gate"].as_string(), // src
+                      names[i],                 // dest
+                      "gate");
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -990,6 +1416,13 @@ AscentRuntime::CreateScenes(const conduit::Node &scenes)
 
     std::string renders_name = names[i] + "_renders";
 
+    if(!scene.has_path("image_prefix"))
+    {
+      // default prefixes change every execute, keep track
+      // of them so a cached graph can be updated
+      m_default_image_prefixes[renders_name] = names[i];
+    }
+
     w.graph().add_filter("default_render",
                           renders_name,
                           render_params);
@@ -1211,13 +1644,142 @@ AscentRuntime::FindRenders(conduit::Node &image_params, conduit::Node& image_lis
 
 }
 
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::ResetGraph()
+{
+    // resets the entire workspace meaning all filters
+    // in the graph are cleared
+    w.reset();
+    m_default_image_prefixes.reset();
+    m_trigger_gates.reset();
+    m_graph_cache_clean = true;
+}
+
+//-----------------------------------------------------------------------------
+// Stamps the files read while the graph for these actions is built: the
+// actions files of triggers and python extract scripts, including the
+// scripts of the triggers' actions.
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::StampActionFiles(const conduit::Node &actions,
+                                conduit::Node &stamps,
+                                const bool triggers)
+{
+    for(int i = 0; i < actions.number_of_children(); ++i)
+    {
+      const Node &action = actions.child(i);
+      if(!action.has_path("action"))
+      {
+        continue;
+      }
+
+      const std::string action_name = action["action"].as_string();
+      if(action_name == "add_extracts" && action.has_path("extracts"))
+      {
+        const Node &extracts = action["extracts"];
+        for(int e = 0; e < extracts.number_of_children(); ++e)
+        {
+          const Node &extract = extracts.child(e);
+          if(extract.has_path("type") &&
+             extract["type"].as_string() == "python" &&
+             extract.has_path("params/file"))
+          {
+            stamp_file(extract["params/file"].as_string(), stamps);
+          }
+        }
+      }
+      else if(triggers &&
+              action_name == "add_triggers" &&
+              action.has_path("triggers"))
+      {
+        const Node &trigger_list = action["triggers"];
+        for(int t = 0; t < trigger_list.number_of_children(); ++t)
+        {
+          const Node &trigger = trigger_list.child(t);
+          if(trigger.has_path("params/actions_file"))
+          {
+            const std::string actions_file =
+              trigger["params/actions_file"].as_string();
+            stamp_file(actions_file, stamps);
+            StampActionFiles(LoadTriggerActions(actions_file), stamps, false);
+          }
+        }
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// When the graph cache is enabled, reset actions are deferred. If the next
+// set of actions is identical to the one that built the current graph and
+// none of the files read while building it changed, graph construction is
+// skipped and the existing graph (along with the workspace's compiled
+// execution plan) is replayed against the newly published data. Returns
+// true if the cached graph should be replayed.
+//-----------------------------------------------------------------------------
+bool
+AscentRuntime::CheckGraphCache(const conduit::Node &actions)
+{
+    conduit::Node file_stamps;
+    StampActionFiles(actions, file_stamps, true);
+
+    // the actions are compared in place and only copied when they change
+    const bool same_actions = same_tree(actions, m_graph_cache_actions);
+    bool hit = m_graph_cache_reset_pending &&
+               m_graph_cache_valid &&
+               same_actions &&
+               same_tree(file_stamps, m_graph_cache_files);
+#ifdef ASCENT_MPI_ENABLED
+    // every rank has to replay or rebuild
+    hit = mpi_cache_consensus(hit);
+#endif
+
+    if(hit)
+    {
+      m_graph_cache_reset_pending = false;
+      return true;
+    }
+
+    if(m_graph_cache_reset_pending)
+    {
+      ResetGraph();
+      m_graph_cache_reset_pending = false;
+    }
+
+    // the graph we are about to build only matches these
+    // actions if we start from an empty graph
+    m_graph_cache_valid = m_graph_cache_clean;
+    m_graph_cache_clean = false;
+    if(!same_actions)
+    {
+      m_graph_cache_actions.set(actions);
+    }
+    m_graph_cache_files.set(file_stamps);
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::UpdateDefaultImagePrefixes()
+{
+    std::vector<std::string> names = m_default_image_prefixes.child_names();
+    for(int i = 0; i < m_default_image_prefixes.number_of_children(); ++i)
+    {
+      flow::Filter *renders = w.graph().filter(names[i]);
+      if(renders != NULL)
+      {
+        const std::string scene = m_default_image_prefixes[names[i]].as_string();
+        renders->params()["image_prefix"] = GetDefaultImagePrefix(scene);
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 AscentRuntime::Execute(const conduit::Node &actions)
 {
     ResetInfo();
-    // make sure we always have our source data
-    ConnectSource();
 
     // exection will be enforced in the following order:
     conduit::Node queries;
@@ -1228,6 +1790,7 @@ AscentRuntime::Execute(const conduit::Node &actions)
 
     bool do_execute = false;
     bool do_reset= false;
+    bool do_flush = false;
 
     // Loop over the actions
     for (int i = 0; i < actions.number_of_children(); ++i)
@@ -1298,6 +1861,10 @@ AscentRuntime::Execute(const conduit::Node &actions)
         {
           do_reset = true;
         }
+        else if( action_name == "flush")
+        {
+          do_flush = true;
+        }
         else
         {
             ASCENT_ERROR("Unknown action ' "<<action_name<<"'");
@@ -1305,32 +1872,61 @@ AscentRuntime::Execute(const conduit::Node &actions)
 
     }
 
-    // we are enforcing the order of exectution
-    for(int i = 0; i < queries.number_of_children(); ++i)
-    {
-      CreateQueries(queries.child(i));
-    }
-    for(int i = 0; i < triggers.number_of_children(); ++i)
-    {
-      CreateTriggers(triggers.child(i));
-    }
-    for(int i = 0; i < pipelines.number_of_children(); ++i)
+    const bool has_graph_actions = queries.number_of_children() > 0 ||
+                                   triggers.number_of_children() > 0 ||
+                                   pipelines.number_of_children() > 0 ||
+                                   scenes.number_of_children() > 0 ||
+                                   extracts.number_of_children() > 0;
+
+    // a reset by itself leaves the graph cache alone
+    bool replay_graph = false;
+    if(m_graph_cache && (has_graph_actions || do_execute))
     {
-      CreatePipelines(pipelines.child(i));
+      replay_graph = CheckGraphCache(actions);
     }
-    for(int i = 0; i < scenes.number_of_children(); ++i)
+
+    // make sure we always have our source data
+    ConnectSource();
+
+    if(replay_graph)
     {
-      CreateScenes(scenes.child(i));
+      UpdateDefaultImagePrefixes();
     }
-    for(int i = 0; i < extracts.number_of_children(); ++i)
+    else
     {
-      CreateExtracts(extracts.child(i));
+      // we are enforcing the order of exectution
+      for(int i = 0; i < queries.number_of_children(); ++i)
+      {
+        CreateQueries(queries.child(i));
+      }
+      for(int i = 0; i < triggers.number_of_children(); ++i)
+      {
+        CreateTriggers(triggers.child(i));
+      }
+      for(int i = 0; i < pipelines.number_of_children(); ++i)
+      {
+        CreatePipelines(pipelines.child(i));
+      }
+      for(int i = 0; i < scenes.number_of_children(); ++i)
+      {
+        CreateScenes(scenes.child(i));
+      }
+      for(int i = 0; i < extracts.number_of_children(); ++i)
+      {
+        CreateExtracts(extracts.child(i));
+      }
     }
 
     if(do_execute)
     {
-
-      ConnectGraphs();
+      if(!replay_graph)
+      {
+        ConnectGraphs();
+      }
+#if defined(ASCENT_VTKM_ENABLED)
+      // drop the rover state of extracts that were removed
+      runtime::filters::RoverCaches::prune(w.graph());
+#endif
       PopulateMetadata(); // add metadata so filters can access it
       w.info(m_info["flow_graph"]);
       m_info["actions"] = actions;
@@ -1381,11 +1977,24 @@ AscentRuntime::Execute(const conduit::Node &actions)
       w.registry().reset();
     }
 
+    if(do_flush)
+    {
+      // wait for asynchronous extracts, including this execute's
+      runtime::filters::relay_io_flush();
+    }
+
     if(do_reset)
     {
-      // resets the entire workspace meaning all filters
-      // in the graph are cleared
-      w.reset();
+      if(m_graph_cache)
+      {
+        // keep the graph around, the next execute decides
+        // if it can be reused
+        m_graph_cache_reset_pending = true;
+      }
+      else
+      {
+        ResetGraph();
+      }
     }
 }
 
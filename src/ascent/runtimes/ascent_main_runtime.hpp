@@ -57,6 +57,8 @@
 #include <ascent_web_interface.hpp>
 #include <flow.hpp>
 
+#include <map>
+
 
 
 //-----------------------------------------------------------------------------
@@ -108,6 +110,30 @@ private:
     int               m_refinement_level;
     int               m_rank;
     std::string       m_ghost_field_name;
+    // blueprint verify mode ("incremental", "first_cycle" or "always")
+    // and the signatures of data that already passed verify
+    std::string       m_verify_mode;
+    conduit::Node     m_verify_cache;
+
+    // graph cache: reuse the flow graph when the actions do not
+    // change between executes (enabled via the "graph_cache" option)
+    bool              m_graph_cache;
+    bool              m_graph_cache_valid;
+    bool              m_graph_cache_clean;
+    bool              m_graph_cache_reset_pending;
+    // the actions that built the graph and the modification times
+    // and sizes of the files read while building it
+    conduit::Node     m_graph_cache_actions;
+    conduit::Node     m_graph_cache_files;
+    // render filters that use a default (per execute) image prefix
+    conduit::Node     m_default_image_prefixes;
+
+    // triggers add their actions to the graph behind gate filters,
+    // gate name -> "in" (gated filter) and "gate" (trigger) names
+    conduit::Node     m_trigger_gates;
+    // parsed trigger actions files, keyed by file name. they are
+    // re-read when the file's modification time or size changes
+    std::map<std::string,conduit::Node> m_trigger_actions;
 
     void              ResetInfo();
 
@@ -127,6 +153,13 @@ private:
     void CreateExtracts(const conduit::Node &extracts);
     void CreateTriggers(const conduit::Node &triggers);
     void CreateQueries(const conduit::Node &queries);
+    const conduit::Node &LoadTriggerActions(const std::string &actions_file);
+    void CreateTriggerGraph(const conduit::Node &actions,
+                            const std::string &trigger_name);
+    std::string TriggerSource(const std::string &trigger_name,
+                              const conduit::Node &trigger_pipelines,
+                              const std::string &source,
+                              const std::string &default_source);
     void CreatePlots(const conduit::Node &plots);
     std::vector<std::string> GetPipelines(const conduit::Node &plots);
     void CreateScenes(const conduit::Node &scenes);
@@ -136,6 +169,12 @@ private:
     void ExecuteGraphs();
     void EnsureDomainIds();
     void PopulateMetadata();
+    void StampActionFiles(const conduit::Node &actions,
+                          conduit::Node &stamps,
+                          const bool triggers);
+    bool CheckGraphCache(const conduit::Node &actions);
+    void ResetGraph();
+    void UpdateDefaultImagePrefixes();
 
     std::string GetDefaultImagePrefix(const std::string scene);
 
@@ -56,6 +56,7 @@
 
 #include <cstring>
 #include <limits>
+#include <vector>
 
 #include <flow_workspace.hpp>
 
@@ -110,7 +111,7 @@ struct UniformCoords
 {
   conduit::float64 m_origin[3] = {0., 0., 0.};
   conduit::float64 m_spacing[3] = {1., 1., 1.};
-  int m_dims[3] = {0,0,0};
+  conduit::index_t m_dims[3] = {0,0,0};
   bool m_is_2d = true;
 
   UniformCoords(const conduit::Node &n_coords)
@@ -123,14 +124,14 @@ struct UniformCoords
 
     const conduit::Node &n_dims = n_coords["dims"];
 
-    m_dims[0] = n_dims["i"].to_int();
-    m_dims[1] = n_dims["j"].to_int();
+    m_dims[0] = n_dims["i"].to_index_t();
+    m_dims[1] = n_dims["j"].to_index_t();
     m_dims[2] = 1;
 
     // check for 3d
     if(n_dims.has_path("k"))
     {
-        m_dims[2] = n_dims["k"].to_int();
+        m_dims[2] = n_dims["k"].to_index_t();
         m_is_2d = false;
     }
 
@@ -188,22 +189,46 @@ get_num_indices(const std::string shape_type)
   return num;
 }
 
-void logical_index_2d(int *idx, const int vert_index, const int *dims)
+void logical_index_2d(conduit::index_t *idx,
+                      const conduit::index_t vert_index,
+                      const conduit::index_t *dims)
 {
   idx[0] = vert_index % dims[0];
   idx[1] = vert_index / dims[0];
 }
 
-void logical_index_3d(int *idx, const int vert_index, const int *dims)
+void logical_index_3d(conduit::index_t *idx,
+                      const conduit::index_t vert_index,
+                      const conduit::index_t *dims)
 {
   idx[0] = vert_index % dims[0];
   idx[1] = (vert_index / dims[0]) % dims[1];
   idx[2] = vert_index / (dims[0] * dims[1]);
 }
 
+// connectivity can be any integer type, so read it through
+// the widest one instead of assuming int32
+conduit::index_t
+conn_value(const conduit::Node &n_conn, const conduit::index_t &index)
+{
+  const conduit::DataType dtype = n_conn.dtype();
+  const void *ptr = n_conn.element_ptr(index);
+  if(dtype.is_int32())
+  {
+    return *static_cast<const conduit::int32*>(ptr);
+  }
+  else if(dtype.is_int64())
+  {
+    return *static_cast<const conduit::int64*>(ptr);
+  }
+  conduit::Node n_val;
+  n_val.set_external(conduit::DataType(dtype.id(), 1), const_cast<void*>(ptr));
+  return n_val.to_index_t();
+}
+
 void get_element_indices(const conduit::Node &n_topo,
-                         const int index,
-                         std::vector<int> &indices)
+                         const conduit::index_t index,
+                         std::vector<conduit::index_t> &indices)
 {
 
   const std::string mesh_type = n_topo["type"].as_string();
@@ -219,31 +244,30 @@ void get_element_indices(const conduit::Node &n_topo,
     indices.resize(num_indices);
     // look up the connectivity
     const conduit::Node &n_topo_conn = n_topo_eles["connectivity"];
-    const conduit::int32_array conn_a = n_topo_conn.value();
-    const int offset = index * num_indices;
+    const conduit::index_t offset = index * num_indices;
     for(int i = 0; i < num_indices; ++i)
     {
-      indices.push_back(conn_a[offset + i]);
+      indices[i] = conn_value(n_topo_conn, offset + i);
     }
   }
   else
   {
     bool is_2d = true;
-    int vert_dims[3] = {0, 0, 0};
-    vert_dims[0] = n_topo["elements/dims/i"].to_int32() + 1;
-    vert_dims[1] = n_topo["elements/dims/j"].to_int32() + 1;
+    conduit::index_t vert_dims[3] = {0, 0, 0};
+    vert_dims[0] = n_topo["elements/dims/i"].to_index_t() + 1;
+    vert_dims[1] = n_topo["elements/dims/j"].to_index_t() + 1;
 
-    if(n_topo.has_path("elements/dims/j"))
+    if(n_topo.has_path("elements/dims/k"))
     {
-      vert_dims[2] = n_topo["elements/dims/k"].to_int32() + 1;
+      vert_dims[2] = n_topo["elements/dims/k"].to_index_t() + 1;
       is_2d = false;
     }
 
-    const int element_dims[3] = {vert_dims[0] - 1,
-                              vert_dims[1] - 1,
-                              vert_dims[2] - 1};
+    const conduit::index_t element_dims[3] = {vert_dims[0] - 1,
+                                              vert_dims[1] - 1,
+                                              vert_dims[2] - 1};
 
-    int element_index[3] = {0, 0, 0};
+    conduit::index_t element_index[3] = {0, 0, 0};
     if(is_2d)
     {
       indices.resize(4);
@@ -261,11 +285,11 @@ void get_element_indices(const conduit::Node &n_topo,
 
       indices[0] = (element_index[2] * vert_dims[1] + element_index[1]) * vert_dims[0] + element_index[0];
       indices[1] = indices[0] + 1;
-      indices[2] = indices[1] + vert_dims[1];
+      indices[2] = indices[1] + vert_dims[0];
       indices[3] = indices[2] - 1;
-      indices[4] = indices[0] + vert_dims[0] * vert_dims[2];
+      indices[4] = indices[0] + vert_dims[0] * vert_dims[1];
       indices[5] = indices[4] + 1;
-      indices[6] = indices[5] + vert_dims[1];
+      indices[6] = indices[5] + vert_dims[0];
       indices[7] = indices[6] - 1;
     }
 
@@ -275,12 +299,12 @@ void get_element_indices(const conduit::Node &n_topo,
 
 
 conduit::Node
-get_uniform_vert(const conduit::Node &n_coords, const int &index)
+get_uniform_vert(const conduit::Node &n_coords, const conduit::index_t &index)
 {
 
   UniformCoords coords(n_coords);
 
-  int logical_index[3] = {0, 0, 0};
+  conduit::index_t logical_index[3] = {0, 0, 0};
 
   if(coords.m_is_2d)
   {
@@ -302,7 +326,7 @@ get_uniform_vert(const conduit::Node &n_coords, const int &index)
 }
 
 conduit::Node
-get_explicit_vert(const conduit::Node &n_coords, const int &index)
+get_explicit_vert(const conduit::Node &n_coords, const conduit::index_t &index)
 {
   bool is_float64 = true;
   if(n_coords["values/x"].dtype().is_float32())
@@ -336,11 +360,11 @@ get_explicit_vert(const conduit::Node &n_coords, const int &index)
 }
 
 conduit::Node
-get_rectilinear_vert(const conduit::Node &n_coords, const int &index)
+get_rectilinear_vert(const conduit::Node &n_coords, const conduit::index_t &index)
 {
   bool is_float64 = true;
 
-  int dims[3] = {0,0,0};
+  conduit::index_t dims[3] = {0,0,0};
   dims[0] = n_coords["values/x"].dtype().number_of_elements();
   dims[1] = n_coords["values/y"].dtype().number_of_elements();
 
@@ -356,7 +380,7 @@ get_rectilinear_vert(const conduit::Node &n_coords, const int &index)
   double vert[3] = {0., 0., 0.};
 
 
-  int logical_index[3] = {0, 0, 0};
+  conduit::index_t logical_index[3] = {0, 0, 0};
 
   if(dims[2] == 0)
   {
@@ -399,15 +423,15 @@ get_rectilinear_vert(const conduit::Node &n_coords, const int &index)
 }
 // ----------------------  element locations ---------------------------------
 conduit::Node
-get_uniform_element(const conduit::Node &n_coords, const int &index)
+get_uniform_element(const conduit::Node &n_coords, const conduit::index_t &index)
 {
 
   UniformCoords coords(n_coords);
 
-  int logical_index[3] = {0, 0, 0};
-  const int element_dims[3] = {coords.m_dims[0] - 1,
-                            coords.m_dims[1] - 1,
-                            coords.m_dims[2] - 1};
+  conduit::index_t logical_index[3] = {0, 0, 0};
+  const conduit::index_t element_dims[3] = {coords.m_dims[0] - 1,
+                                            coords.m_dims[1] - 1,
+                                            coords.m_dims[2] - 1};
 
   if(coords.m_is_2d)
   {
@@ -431,11 +455,11 @@ get_uniform_element(const conduit::Node &n_coords, const int &index)
 }
 
 conduit::Node
-get_rectilinear_element(const conduit::Node &n_coords, const int &index)
+get_rectilinear_element(const conduit::Node &n_coords, const conduit::index_t &index)
 {
   bool is_float64 = true;
 
-  int dims[3] = {0,0,0};
+  conduit::index_t dims[3] = {0,0,0};
   dims[0] = n_coords["values/x"].dtype().number_of_elements();
   dims[1] = n_coords["values/y"].dtype().number_of_elements();
 
@@ -449,13 +473,13 @@ get_rectilinear_element(const conduit::Node &n_coords, const int &index)
   {
     is_float64 = false;
   }
-  const int element_dims[3] = {dims[0] - 1,
-                            dims[1] - 1,
-                            dims[2] - 1};
+  const conduit::index_t element_dims[3] = {dims[0] - 1,
+                                            dims[1] - 1,
+                                            dims[2] - 1};
 
   double vert[3] = {0., 0., 0.};
 
-  int logical_index[3] = {0, 0, 0};
+  conduit::index_t logical_index[3] = {0, 0, 0};
 
   if(dims[2] == 0)
   {
@@ -500,15 +524,15 @@ get_rectilinear_element(const conduit::Node &n_coords, const int &index)
 conduit::Node
 get_explicit_element(const conduit::Node &n_coords,
                   const conduit::Node &n_topo,
-                  const int &index)
+                  const conduit::index_t &index)
 {
-  std::vector<int> conn;
+  std::vector<conduit::index_t> conn;
   get_element_indices(n_topo, index, conn);
   const int num_indices = conn.size();
   double vert[3] = {0., 0., 0.};
   for(int i = 0; i < num_indices; ++i)
   {
-    int vert_index = conn[i];
+    conduit::index_t vert_index = conn[i];
     conduit::Node n_vert = get_explicit_vert(n_coords, vert_index);
     double * ptr = n_vert.value();
     vert[0] += ptr[0];
@@ -532,7 +556,7 @@ get_explicit_element(const conduit::Node &n_coords,
 
 conduit::Node
 vert_location(const conduit::Node &domain,
-              const int &index,
+              const conduit::index_t &index,
               const std::string topo_name)
 {
   std::string topo = topo_name;
@@ -573,7 +597,7 @@ vert_location(const conduit::Node &domain,
 
 conduit::Node
 element_location(const conduit::Node &domain,
-              const int &index,
+              const conduit::index_t &index,
               const std::string topo_name)
 {
   std::string topo = topo_name;
@@ -649,16 +673,19 @@ bool has_field(const conduit::Node &dataset, const std::string &field_name)
   return has_field;
 }
 
-conduit::Node
-field_histogram(const conduit::Node &dataset,
-                const std::string &field,
-                const double &min_val,
-                const double &max_val,
-                const int &num_bins)
+namespace detail
 {
 
-  int *bins = new int[num_bins];
-  memset(bins, 0, sizeof(int) * num_bins);
+// sums the per domain histograms computed by hist_func and reduces
+// the bins across ranks
+template<typename HistFunc>
+conduit::Node
+reduce_histogram(const conduit::Node &dataset,
+                 const std::string &field,
+                 const int &num_bins,
+                 const HistFunc &hist_func)
+{
+  std::vector<conduit::int64> bins(num_bins, 0);
 
   for(int i = 0; i < dataset.number_of_children(); ++i)
   {
@@ -667,12 +694,9 @@ field_histogram(const conduit::Node &dataset,
     {
       const std::string path = "fields/" + field + "/values";
       conduit::Node res;
-      res = array_histogram(dom[path], min_val, max_val, num_bins);
+      res = hist_func(dom[path]);
 
-      int *dom_hist = res["value"].value();
-#ifdef ASCENT_USE_OPENMP
-      #pragma omp parallel for
-#endif
+      const conduit::int64 *dom_hist = res["value"].as_int64_ptr();
       for(int b = 0; b < num_bins; ++b)
       {
         bins[b] += dom_hist[b];
@@ -682,107 +706,209 @@ field_histogram(const conduit::Node &dataset,
   conduit::Node res;
 
 #ifdef ASCENT_MPI_ENABLED
-
-  int *global_bins = new int[num_bins];
+  std::vector<conduit::int64> global_bins(num_bins, 0);
 
   MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
-  MPI_Allreduce( bins, global_bins, num_bins, MPI_INT, MPI_SUM, mpi_comm);
+  MPI_Allreduce(bins.data(),
+                global_bins.data(),
+                num_bins,
+                MPI_INT64_T,
+                MPI_SUM,
+                mpi_comm);
 
-  int *tmp = bins;
-  bins = global_bins;
-  delete[] tmp;
+  bins.swap(global_bins);
 #endif
-  res["value"].set(bins, num_bins);
-  delete[] bins;
+  res["value"].set(bins.data(), num_bins);
   return res;
 }
 
-conduit::Node
-field_min(const conduit::Node &dataset,
-          const std::string &field)
+struct LinearHistogram
 {
-  double min_value = std::numeric_limits<double>::max();
+  double m_min_val;
+  double m_max_val;
+  int m_num_bins;
+  conduit::Node operator()(const conduit::Node &values) const
+  {
+    return array_histogram(values, m_min_val, m_max_val, m_num_bins);
+  }
+};
 
-  int domain = -1;
-  int domain_id = -1;
-  int index = -1;
+struct LogHistogram
+{
+  double m_min_val;
+  double m_max_val;
+  int m_num_bins;
+  conduit::Node operator()(const conduit::Node &values) const
+  {
+    return array_log_histogram(values, m_min_val, m_max_val, m_num_bins);
+  }
+};
 
-  for(int i = 0; i < dataset.number_of_children(); ++i)
+struct EdgesHistogram
+{
+  const conduit::Node *m_edges;
+  conduit::Node operator()(const conduit::Node &values) const
   {
-    const conduit::Node &dom = dataset.child(i);
-    if(dom.has_path("fields/"+field))
-    {
-      const std::string path = "fields/" + field + "/values";
-      conduit::Node res;
-      res = array_min(dom[path]);
-      double a_min = res["value"].to_float64();
-      if(a_min < min_value)
-      {
-        min_value = a_min;
-        index = res["index"].as_int32();
-        domain = i;
-        domain_id = dom["state/domain_id"].to_int32();
-      }
-    }
+    return array_histogram(values, *m_edges);
   }
+};
 
-  const std::string assoc_str = dataset.child(0)["fields/"
-                                + field + "/association"].as_string();
+};
 
-  conduit::Node loc;
-  if(assoc_str == "vertex")
+conduit::Node
+field_histogram(const conduit::Node &dataset,
+                const std::string &field,
+                const double &min_val,
+                const double &max_val,
+                const int &num_bins)
+{
+  detail::LinearHistogram hist = {min_val, max_val, num_bins};
+  return detail::reduce_histogram(dataset, field, num_bins, hist);
+}
+
+conduit::Node
+field_log_histogram(const conduit::Node &dataset,
+                    const std::string &field,
+                    const double &min_val,
+                    const double &max_val,
+                    const int &num_bins)
+{
+  if(min_val <= 0.)
   {
-    loc = vert_location(dataset.child(domain),index);
+    ASCENT_ERROR("Log histogram: min value ("<<min_val<<") must be positive");
   }
-  else if(assoc_str == "element")
+  detail::LogHistogram hist = {min_val, max_val, num_bins};
+  return detail::reduce_histogram(dataset, field, num_bins, hist);
+}
+
+conduit::Node
+field_histogram(const conduit::Node &dataset,
+                const std::string &field,
+                const conduit::Node &bin_edges)
+{
+  const int num_bins = bin_edges.dtype().number_of_elements() - 1;
+  if(num_bins < 1)
   {
-    loc = element_location(dataset.child(domain),index);
+    ASCENT_ERROR("Histogram: at least two bin edges are required");
   }
-  else
+  detail::EdgesHistogram hist = {&bin_edges};
+  return detail::reduce_histogram(dataset, field, num_bins, hist);
+}
+
+//-----------------------------------------------------------------------------
+// packed layout used to reduce field stats across ranks with one collective
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+enum StatsSlot
+{
+  STATS_MIN = 0,
+  STATS_MIN_RANK,
+  STATS_MIN_POS,   // 3 values
+  STATS_MIN_DOMAIN = STATS_MIN_POS + 3,
+  STATS_MAX,
+  STATS_MAX_RANK,
+  STATS_MAX_POS,   // 3 values
+  STATS_MAX_DOMAIN = STATS_MAX_POS + 3,
+  STATS_SUM,
+  STATS_SUM_SQ,
+  STATS_COUNT,
+  STATS_SIZE
+};
+
+void
+copy_loc(const double *src, double *dest, const int offset)
+{
+  // value, rank, position and domain id
+  for(int i = 0; i < 6; ++i)
   {
-    ASCENT_ERROR("Location for "<<assoc_str<<" not implemented");
+    dest[offset + i] = src[offset + i];
   }
+}
 
-  int rank = 0;
-  conduit::Node res;
 #ifdef ASCENT_MPI_ENABLED
-  struct MinLoc
+// ties go to the lower rank, which matches MPI_MINLOC/MPI_MAXLOC
+void
+stats_reduce_op(void *in, void *inout, int *len, MPI_Datatype *)
+{
+  double *a = static_cast<double*>(in);
+  double *b = static_cast<double*>(inout);
+  for(int i = 0; i < *len; ++i)
   {
-    double value;
-    int rank;
-  };
+    double *s_in  = a + i * STATS_SIZE;
+    double *s_out = b + i * STATS_SIZE;
 
-  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
-  MPI_Comm_rank(mpi_comm, &rank);
+    if(s_in[STATS_MIN] < s_out[STATS_MIN] ||
+       (s_in[STATS_MIN] == s_out[STATS_MIN] &&
+        s_in[STATS_MIN_RANK] < s_out[STATS_MIN_RANK]))
+    {
+      copy_loc(s_in, s_out, STATS_MIN);
+    }
 
-  MinLoc minloc = {min_value, rank};
-  MinLoc minloc_res;
-  MPI_Allreduce( &minloc, &minloc_res, 1, MPI_DOUBLE_INT, MPI_MINLOC, mpi_comm);
-  min_value = minloc.value;
+    if(s_in[STATS_MAX] > s_out[STATS_MAX] ||
+       (s_in[STATS_MAX] == s_out[STATS_MAX] &&
+        s_in[STATS_MAX_RANK] < s_out[STATS_MAX_RANK]))
+    {
+      copy_loc(s_in, s_out, STATS_MAX);
+    }
 
-  double * ploc = loc.as_float64_ptr();
-  MPI_Bcast(ploc, 3, MPI_DOUBLE, minloc_res.rank, mpi_comm);
-  MPI_Bcast(&domain_id, 1, MPI_INT, minloc_res.rank, mpi_comm);
+    s_out[STATS_SUM] += s_in[STATS_SUM];
+    s_out[STATS_SUM_SQ] += s_in[STATS_SUM_SQ];
+    s_out[STATS_COUNT] += s_in[STATS_COUNT];
+  }
+}
+#endif
 
-  loc.set(ploc, 3);
+void
+field_location(const conduit::Node &dataset,
+               const std::string &field,
+               const int domain,
+               const conduit::index_t index,
+               double *pos)
+{
+  const conduit::Node &dom = dataset.child(domain);
+  const std::string assoc_str = dom["fields/" + field + "/association"].as_string();
 
-  rank = minloc_res.rank;
-#endif
-  res["rank"] = rank;
-  res["domain_id"] = domain_id;
-  res["position"] = loc;
-  res["value"] = min_value;
+  conduit::Node loc;
+  if(assoc_str == "vertex")
+  {
+    loc = vert_location(dom,index);
+  }
+  else if(assoc_str == "element")
+  {
+    loc = element_location(dom,index);
+  }
+  else
+  {
+    ASCENT_ERROR("Location for "<<assoc_str<<" not implemented");
+  }
 
-  return res;
+  const double *ploc = loc.as_float64_ptr();
+  pos[0] = ploc[0];
+  pos[1] = ploc[1];
+  pos[2] = ploc[2];
 }
 
+};
+
 conduit::Node
-field_avg(const conduit::Node &dataset,
-          const std::string &field)
+field_stats(const conduit::Node &dataset,
+            const std::string &field)
 {
-  double sum = 0.;
-  long long int count = 0;
-
+  double stats[detail::STATS_SIZE];
+  memset(stats, 0, sizeof(double) * detail::STATS_SIZE);
+  stats[detail::STATS_MIN] = std::numeric_limits<double>::max();
+  stats[detail::STATS_MIN_DOMAIN] = -1;
+  stats[detail::STATS_MAX] = std::numeric_limits<double>::lowest();
+  stats[detail::STATS_MAX_DOMAIN] = -1;
+
+  int min_domain = -1;
+  conduit::index_t min_index = -1;
+  int max_domain = -1;
+  conduit::index_t max_index = -1;
+
+  // one pass over the values of each domain
   for(int i = 0; i < dataset.number_of_children(); ++i)
   {
     const conduit::Node &dom = dataset.child(i);
@@ -790,115 +916,113 @@ field_avg(const conduit::Node &dataset,
     {
       const std::string path = "fields/" + field + "/values";
       conduit::Node res;
-      res = array_sum(dom[path]);
+      res = array_stats(dom[path]);
 
-      double a_sum = res["value"].to_float64();
-      long long int a_count = res["count"].to_int64();
+      const double a_min = res["min/value"].to_float64();
+      if(a_min < stats[detail::STATS_MIN])
+      {
+        stats[detail::STATS_MIN] = a_min;
+        stats[detail::STATS_MIN_DOMAIN] = dom["state/domain_id"].to_int32();
+        min_index = res["min/index"].to_index_t();
+        min_domain = i;
+      }
+
+      const double a_max = res["max/value"].to_float64();
+      if(a_max > stats[detail::STATS_MAX])
+      {
+        stats[detail::STATS_MAX] = a_max;
+        stats[detail::STATS_MAX_DOMAIN] = dom["state/domain_id"].to_int32();
+        max_index = res["max/index"].to_index_t();
+        max_domain = i;
+      }
 
-      sum += a_sum;
-      count += a_count;
+      stats[detail::STATS_SUM] += res["sum"].to_float64();
+      stats[detail::STATS_SUM_SQ] += res["sum_sq"].to_float64();
+      stats[detail::STATS_COUNT] += res["count"].to_float64();
     }
   }
 
+  if(min_domain != -1)
+  {
+    detail::field_location(dataset,
+                           field,
+                           min_domain,
+                           min_index,
+                           stats + detail::STATS_MIN_POS);
+  }
+
+  if(max_domain != -1)
+  {
+    detail::field_location(dataset,
+                           field,
+                           max_domain,
+                           max_index,
+                           stats + detail::STATS_MAX_POS);
+  }
+
 #ifdef ASCENT_MPI_ENABLED
   int rank;
   MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
   MPI_Comm_rank(mpi_comm, &rank);
-  double global_sum;
-  MPI_Allreduce( &sum, &global_sum, 1, MPI_DOUBLE, MPI_SUM, mpi_comm);
+  stats[detail::STATS_MIN_RANK] = rank;
+  stats[detail::STATS_MAX_RANK] = rank;
 
-  long long int global_count;
-  MPI_Allreduce( &count, &global_count, 1, MPI_LONG_LONG_INT, MPI_SUM, mpi_comm);
+  MPI_Datatype stats_type;
+  MPI_Type_contiguous(detail::STATS_SIZE, MPI_DOUBLE, &stats_type);
+  MPI_Type_commit(&stats_type);
 
-  sum = global_sum;
-  count = global_count;
+  MPI_Op stats_op;
+  MPI_Op_create(detail::stats_reduce_op, 1, &stats_op);
+
+  double global_stats[detail::STATS_SIZE];
+  MPI_Allreduce(stats, global_stats, 1, stats_type, stats_op, mpi_comm);
+
+  MPI_Op_free(&stats_op);
+  MPI_Type_free(&stats_type);
+
+  memcpy(stats, global_stats, sizeof(double) * detail::STATS_SIZE);
 #endif
 
-  double avg = sum / double(count);
   conduit::Node res;
-  res["value"] = avg;
+  res["min/value"] = stats[detail::STATS_MIN];
+  res["min/rank"] = (int) stats[detail::STATS_MIN_RANK];
+  res["min/domain_id"] = (int) stats[detail::STATS_MIN_DOMAIN];
+  res["min/position"].set(stats + detail::STATS_MIN_POS, 3);
+  res["max/value"] = stats[detail::STATS_MAX];
+  res["max/rank"] = (int) stats[detail::STATS_MAX_RANK];
+  res["max/domain_id"] = (int) stats[detail::STATS_MAX_DOMAIN];
+  res["max/position"].set(stats + detail::STATS_MAX_POS, 3);
+  res["sum"] = stats[detail::STATS_SUM];
+  res["sum_sq"] = stats[detail::STATS_SUM_SQ];
+  res["count"] = (conduit::int64) stats[detail::STATS_COUNT];
+  res["avg"] = stats[detail::STATS_SUM] / stats[detail::STATS_COUNT];
 
   return res;
 }
 
 conduit::Node
-field_max(const conduit::Node &dataset,
+field_min(const conduit::Node &dataset,
           const std::string &field)
 {
-  double max_value = std::numeric_limits<double>::lowest();
-
-  int domain = -1;
-  int domain_id = -1;
-  int index = -1;
-
-  for(int i = 0; i < dataset.number_of_children(); ++i)
-  {
-    const conduit::Node &dom = dataset.child(i);
-    if(dom.has_path("fields/"+field))
-    {
-      const std::string path = "fields/" + field + "/values";
-      conduit::Node res;
-      res = array_max(dom[path]);
-      double a_max = res["value"].to_float64();
-      if(a_max > max_value)
-      {
-        max_value = a_max;
-        index = res["index"].as_int32();
-        domain = i;
-        domain_id = dom["state/domain_id"].to_int32();
-      }
-    }
-  }
-
-  const std::string assoc_str = dataset.child(0)["fields/"
-                                + field + "/association"].as_string();
-
-  conduit::Node loc;
-  if(assoc_str == "vertex")
-  {
-    loc = vert_location(dataset.child(domain),index);
-  }
-  else if(assoc_str == "element")
-  {
-    loc = element_location(dataset.child(domain),index);
-  }
-  else
-  {
-    ASCENT_ERROR("Location for "<<assoc_str<<" not implemented");
-  }
+  return field_stats(dataset, field)["min"];
+}
 
-  int rank = 0;
+conduit::Node
+field_avg(const conduit::Node &dataset,
+          const std::string &field)
+{
   conduit::Node res;
-#ifdef ASCENT_MPI_ENABLED
-  struct MaxLoc
-  {
-    double value;
-    int rank;
-  };
-
-  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
-  MPI_Comm_rank(mpi_comm, &rank);
-
-  MaxLoc maxloc = {max_value, rank};
-  MaxLoc maxloc_res;
-  MPI_Allreduce( &maxloc, &maxloc_res, 1, MPI_DOUBLE_INT, MPI_MAXLOC, mpi_comm);
-  max_value = maxloc.value;
-
-  double * ploc = loc.as_float64_ptr();
-  MPI_Bcast(ploc, 3, MPI_DOUBLE, maxloc_res.rank, mpi_comm);
-  MPI_Bcast(&domain_id, 1, MPI_INT, maxloc_res.rank, mpi_comm);
-
-  loc.set(ploc, 3);
-  rank = maxloc_res.rank;
-#endif
-  res["rank"] = rank;
-  res["domain_id"] = domain_id;
-  res["position"] = loc;
-  res["value"] = max_value;
-
+  res["value"] = field_stats(dataset, field)["avg"];
   return res;
 }
 
+conduit::Node
+field_max(const conduit::Node &dataset,
+          const std::string &field)
+{
+  return field_stats(dataset, field)["max"];
+}
+
 conduit::Node
 get_state_var(const conduit::Node &dataset,
               const std::string &var_name)
@@ -75,13 +75,19 @@ namespace expressions
 {
 
 conduit::Node vert_location(const conduit::Node &domain,
-                            const int &index,
+                            const conduit::index_t &index,
                             const std::string topo_name = "");
 
 conduit::Node element_location(const conduit::Node &domain,
-                               const int &index,
+                               const conduit::index_t &index,
                                const std::string topo_name = "");
 
+// min and max (with locations), sum, sum of squares, count and
+// average of a field computed with one pass over each domain and
+// a single reduction across ranks
+conduit::Node field_stats(const conduit::Node &dataset,
+                          const std::string &field_name);
+
 conduit::Node field_max(const conduit::Node &dataset,
                         const std::string &field_name);
 
@@ -91,12 +97,25 @@ conduit::Node field_min(const conduit::Node &dataset,
 conduit::Node field_avg(const conduit::Node &dataset,
                         const std::string &field_name);
 
+// histograms use 64-bit counts
 conduit::Node field_histogram(const conduit::Node &dataset,
                               const std::string &field_name,
                               const double &min_val,
                               const double &max_val,
                               const int &num_bins);
 
+// bins are uniform in log space, min_val must be positive
+conduit::Node field_log_histogram(const conduit::Node &dataset,
+                                  const std::string &field_name,
+                                  const double &min_val,
+                                  const double &max_val,
+                                  const int &num_bins);
+
+// bins are given by num_bins + 1 increasing edges
+conduit::Node field_histogram(const conduit::Node &dataset,
+                              const std::string &field_name,
+                              const conduit::Node &bin_edges);
+
 conduit::Node get_state_var(const conduit::Node &dataset,
                             const std::string &var_name);
 
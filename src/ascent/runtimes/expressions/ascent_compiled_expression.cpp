@@ -0,0 +1,801 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_compiled_expression.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_compiled_expression.hpp"
+#include "ascent_blueprint_architect.hpp"
+#include "ascent_expression_filters.hpp"
+#include "parser.hpp"
+
+#include <ascent_logging.hpp>
+
+#include <algorithm>
+#include <map>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+namespace detail
+{
+
+bool is_math(const int op)
+{
+  return op == TPLUS || op == TMINUS || op == TMUL || op == TDIV;
+}
+
+template<typename T>
+T math_op(const T& lhs, const T& rhs, const int op)
+{
+  T res = 0;
+  switch(op)
+  {
+    case TPLUS:  res = lhs + rhs; break;
+    case TMINUS: res = lhs - rhs; break;
+    case TMUL:   res = lhs * rhs; break;
+    case TDIV:   res = lhs / rhs; break;
+    default: ASCENT_ERROR("unknown math op "<<op);
+  }
+  return res;
+}
+
+template<typename T>
+int comp_op(const T& lhs, const T& rhs, const int op)
+{
+  int res = 0;
+  switch(op)
+  {
+    case TCLT: res = lhs < rhs; break;
+    case TCLE: res = lhs <= rhs; break;
+    case TCGT: res = lhs > rhs; break;
+    case TCGE: res = lhs >= rhs; break;
+    case TCEQ: res = lhs == rhs; break;
+    case TCNE: res = lhs != rhs; break;
+    default: ASCENT_ERROR("unknown comparison op "<<op);
+  }
+  return res;
+}
+
+void
+binary_op(const int op,
+          const ExprValue &lhs,
+          const ExprValue &rhs,
+          ExprValue &res)
+{
+  const bool lhs_is_vector = lhs.m_type == ExprValue::VECTOR;
+  const bool rhs_is_vector = rhs.m_type == ExprValue::VECTOR;
+
+  if(lhs_is_vector != rhs_is_vector)
+  {
+    ASCENT_ERROR("Mixed vector and scalar quantities not implemeneted / supported");
+  }
+
+  if(!lhs_is_vector &&
+     ((lhs.m_type != ExprValue::SCALAR && lhs.m_type != ExprValue::BOOLEAN) ||
+      (rhs.m_type != ExprValue::SCALAR && rhs.m_type != ExprValue::BOOLEAN)))
+  {
+    ASCENT_ERROR("Binary operations are only supported on scalars and vectors");
+  }
+
+  const bool math = is_math(op);
+
+  if(lhs_is_vector)
+  {
+    if(!math)
+    {
+      ASCENT_ERROR("Boolean operators on vectors no allowed");
+    }
+    if(op != TPLUS && op != TMINUS)
+    {
+      ASCENT_ERROR("Unsupported vector op "<<op);
+    }
+    double vec[3];
+    for(int i = 0; i < 3; ++i)
+    {
+      vec[i] = math_op(lhs.m_vec[i], rhs.m_vec[i], op);
+    }
+    res.set_vector(vec);
+  }
+  else if(lhs.m_is_float || rhs.m_is_float)
+  {
+    // promote to double if at one is a double
+    const double d_lhs = lhs.to_float64();
+    const double d_rhs = rhs.to_float64();
+    if(math)
+    {
+      res.set_double(math_op(d_lhs, d_rhs, op));
+    }
+    else
+    {
+      res.set_int(comp_op(d_lhs, d_rhs, op), ExprValue::BOOLEAN);
+    }
+  }
+  else
+  {
+    if(math)
+    {
+      res.set_int(math_op(lhs.m_int, rhs.m_int, op));
+    }
+    else
+    {
+      res.set_int(comp_op(lhs.m_int, rhs.m_int, op), ExprValue::BOOLEAN);
+    }
+  }
+}
+
+const conduit::Node &
+get_dataset(const ExprContext &ctx, const std::string &func_name)
+{
+  if(ctx.m_dataset == nullptr)
+  {
+    ASCENT_ERROR(func_name<<": Missing dataset");
+  }
+  return *ctx.m_dataset;
+}
+
+void
+check_field(const conduit::Node &dataset,
+            const std::string &field,
+            const std::string &func_name,
+            const bool require_scalar)
+{
+  if(!has_field(dataset, field))
+  {
+    std::vector<std::string> names = dataset.child(0)["fields"].child_names();
+    std::stringstream ss;
+    ss<<"[";
+    for(int i = 0; i < names.size(); ++i)
+    {
+      ss<<" "<<names[i];
+    }
+    ss<<"]";
+    ASCENT_ERROR(func_name<<": dataset does not contain field '"<<field<<"'"
+                 <<" known = "<<ss.str());
+  }
+
+  if(require_scalar && !is_scalar_field(dataset, field))
+  {
+    ASCENT_ERROR(func_name<<": field '"<<field<<"' is not a scalar");
+  }
+}
+
+void
+field_extreme(const ExprValue **args,
+              ExprValue &res,
+              ExprContext &ctx,
+              const std::string &func_name,
+              const std::string &which)
+{
+  const std::string &field = args[0]->m_name;
+  const conduit::Node &data = get_dataset(ctx, func_name);
+  check_field(data, field, func_name, true);
+
+  const conduit::Node n_stats = cached_field_stats(*ctx.m_registry,
+                                                   data,
+                                                   field);
+  res.set_double(n_stats[which + "/value"].to_float64());
+  res.m_atts["position"] = n_stats[which + "/position"];
+}
+
+void
+field_min(const ExprValue **args, ExprValue &res, ExprContext &ctx)
+{
+  field_extreme(args, res, ctx, "FieldMin", "min");
+}
+
+void
+field_max(const ExprValue **args, ExprValue &res, ExprContext &ctx)
+{
+  field_extreme(args, res, ctx, "FieldMax", "max");
+}
+
+void
+field_avg(const ExprValue **args, ExprValue &res, ExprContext &ctx)
+{
+  const std::string &field = args[0]->m_name;
+  const conduit::Node &data = get_dataset(ctx, "FieldAvg");
+  check_field(data, field, "FieldAvg", true);
+
+  const conduit::Node n_stats = cached_field_stats(*ctx.m_registry,
+                                                   data,
+                                                   field);
+  res.set_double(n_stats["avg"].to_float64());
+}
+
+void
+scalar_min(const ExprValue **args, ExprValue &res, ExprContext &ctx)
+{
+  if(args[0]->m_is_float || args[1]->m_is_float)
+  {
+    res.set_double(std::min(args[0]->to_float64(), args[1]->to_float64()));
+  }
+  else
+  {
+    res.set_int(std::min(args[0]->m_int, args[1]->m_int));
+  }
+}
+
+void
+scalar_max(const ExprValue **args, ExprValue &res, ExprContext &ctx)
+{
+  if(args[0]->m_is_float || args[1]->m_is_float)
+  {
+    res.set_double(std::max(args[0]->to_float64(), args[1]->to_float64()));
+  }
+  else
+  {
+    res.set_int(std::max(args[0]->m_int, args[1]->m_int));
+  }
+}
+
+void
+position(const ExprValue **args, ExprValue &res, ExprContext &ctx)
+{
+  if(!args[0]->m_atts.has_path("position"))
+  {
+    ASCENT_ERROR("Position: input does not have 'position' attribute");
+  }
+
+  conduit::Node n_pos;
+  args[0]->m_atts["position"].to_float64_array(n_pos);
+  res.set_vector(n_pos.as_float64_ptr());
+}
+
+void
+cycle(const ExprValue **args, ExprValue &res, ExprContext &ctx)
+{
+  conduit::Node state = get_state_var(get_dataset(ctx, "Cycle"), "cycle");
+  if(!state.dtype().is_number())
+  {
+    ASCENT_ERROR("Expressions: cycle() is not a number");
+  }
+
+  if(state.dtype().is_floating_point())
+  {
+    res.set_double(state.to_float64());
+  }
+  else
+  {
+    res.set_int(state.to_int32());
+  }
+}
+
+void
+make_vector(const ExprValue **args, ExprValue &res, ExprContext &ctx)
+{
+  double vec[3] = {0., 0., 0.};
+  for(int i = 0; i < 3; ++i)
+  {
+    if(args[i]->m_type != ExprValue::SCALAR)
+    {
+      ASCENT_ERROR("All components to vector constructor must be scalars");
+    }
+    vec[i] = args[i]->to_float64();
+  }
+  res.set_vector(vec);
+}
+
+void
+magnitude(const ExprValue **args, ExprValue &res, ExprContext &ctx)
+{
+  if(args[0]->m_type != ExprValue::VECTOR)
+  {
+    ASCENT_ERROR("Magnitude input must be a vector");
+  }
+
+  const double *vec = args[0]->m_vec;
+  res.set_double(sqrt(vec[0] * vec[0] + vec[1] * vec[1] + vec[2] * vec[2]));
+}
+
+void
+histogram(const ExprValue **args, ExprValue &res, ExprContext &ctx)
+{
+  if(args[0]->m_type != ExprValue::MESHVAR)
+  {
+    ASCENT_ERROR("Histogram: input must be a meshvar");
+  }
+
+  const std::string &field = args[0]->m_name;
+  const conduit::Node &data = get_dataset(ctx, "Histogram");
+  check_field(data, field, "Histogram", false);
+
+  // optional inputs
+  const ExprValue *n_bins = args[1];
+  const ExprValue *n_min = args[2];
+  const ExprValue *n_max = args[3];
+
+  int num_bins = 256;
+  if(n_bins->m_type != ExprValue::NONE)
+  {
+    num_bins = static_cast<int>(n_bins->to_float64());
+  }
+
+  // min and max come from the same pass over the data
+  conduit::Node n_stats;
+  if(n_min->m_type == ExprValue::NONE || n_max->m_type == ExprValue::NONE)
+  {
+    n_stats = cached_field_stats(*ctx.m_registry, data, field);
+  }
+
+  const double min_val = n_min->m_type != ExprValue::NONE ?
+                         n_min->to_float64() :
+                         n_stats["min/value"].to_float64();
+
+  const double max_val = n_max->m_type != ExprValue::NONE ?
+                         n_max->to_float64() :
+                         n_stats["max/value"].to_float64();
+
+  if(min_val >=  max_val)
+  {
+    ASCENT_ERROR("Histogram: min value ("<<min_val<<") must be smaller than max ("<<max_val<<")");
+  }
+
+  res.m_type = ExprValue::HISTOGRAM;
+  res.m_atts.reset();
+  res.m_atts["value"] = field_histogram(data,
+                                        field,
+                                        min_val,
+                                        max_val,
+                                        num_bins)["value"];
+  res.m_atts["type"] = "histogram";
+  res.m_atts["min_val"] = min_val;
+  res.m_atts["max_val"] = max_val;
+  res.m_atts["num_bins"] = num_bins;
+}
+
+// implementations of the function table entries, keyed by "filter_name"
+std::map<std::string, ExprFunction>
+builtin_functions()
+{
+  std::map<std::string, ExprFunction> functions;
+  functions["field_min"] = field_min;
+  functions["field_max"] = field_max;
+  functions["field_avg"] = field_avg;
+  functions["scalar_min"] = scalar_min;
+  functions["scalar_max"] = scalar_max;
+  functions["expr_position"] = position;
+  functions["cycle"] = cycle;
+  functions["vector"] = make_vector;
+  functions["magnitude"] = magnitude;
+  functions["histogram"] = histogram;
+  return functions;
+}
+
+} // namespace detail
+
+const int CompiledExpression::MAX_ARGS;
+
+//-----------------------------------------------------------------------------
+ExprValue::ExprValue()
+  : m_type(NONE),
+    m_is_float(false),
+    m_int(0),
+    m_double(0.)
+{
+  m_vec[0] = 0.;
+  m_vec[1] = 0.;
+  m_vec[2] = 0.;
+}
+
+//-----------------------------------------------------------------------------
+void
+ExprValue::set_int(const int value, const Type type)
+{
+  m_type = type;
+  m_is_float = false;
+  m_int = value;
+  m_atts.reset();
+}
+
+//-----------------------------------------------------------------------------
+void
+ExprValue::set_double(const double value)
+{
+  m_type = SCALAR;
+  m_is_float = true;
+  m_double = value;
+  m_atts.reset();
+}
+
+//-----------------------------------------------------------------------------
+void
+ExprValue::set_vector(const double vec[3])
+{
+  m_type = VECTOR;
+  m_is_float = true;
+  m_vec[0] = vec[0];
+  m_vec[1] = vec[1];
+  m_vec[2] = vec[2];
+  m_atts.reset();
+}
+
+//-----------------------------------------------------------------------------
+void
+ExprValue::set_meshvar(const std::string &name)
+{
+  m_type = MESHVAR;
+  m_name = name;
+  m_atts.reset();
+}
+
+//-----------------------------------------------------------------------------
+double
+ExprValue::to_float64() const
+{
+  return m_is_float ? m_double : static_cast<double>(m_int);
+}
+
+//-----------------------------------------------------------------------------
+void
+ExprValue::from_node(const conduit::Node &node)
+{
+  std::string type;
+  if(node.has_path("type"))
+  {
+    type = node["type"].as_string();
+  }
+
+  if(type == "scalar" || type == "boolean")
+  {
+    const conduit::Node &value = node["value"];
+    if(value.dtype().is_floating_point())
+    {
+      set_double(value.to_float64());
+    }
+    else
+    {
+      set_int(value.to_int32(), type == "boolean" ? BOOLEAN : SCALAR);
+    }
+
+    if(node.has_path("atts"))
+    {
+      m_atts = node["atts"];
+    }
+  }
+  else if(type == "vector")
+  {
+    conduit::Node n_vec;
+    node["value"].to_float64_array(n_vec);
+    set_vector(n_vec.as_float64_ptr());
+  }
+  else if(type == "meshvar")
+  {
+    set_meshvar(node["value"].as_string());
+  }
+  else
+  {
+    m_type = type == "histogram" ? HISTOGRAM : NODE;
+    m_atts = node;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void
+ExprValue::to_node(conduit::Node &node) const
+{
+  node.reset();
+  switch(m_type)
+  {
+    case SCALAR:
+    case BOOLEAN:
+    {
+      if(m_is_float)
+      {
+        node["value"] = m_double;
+      }
+      else
+      {
+        node["value"] = m_int;
+      }
+      node["type"] = m_type == BOOLEAN ? "boolean" : "scalar";
+      if(m_atts.number_of_children() > 0)
+      {
+        node["atts"] = m_atts;
+      }
+      break;
+    }
+    case VECTOR:
+    {
+      node["value"].set(m_vec, 3);
+      node["type"] = "vector";
+      break;
+    }
+    case MESHVAR:
+    {
+      node["value"] = m_name;
+      node["type"] = "meshvar";
+      break;
+    }
+    case HISTOGRAM:
+    case NODE:
+    {
+      node = m_atts;
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+CompiledExpression::CompiledExpression(const conduit::Node &function_table)
+  : m_function_table(&function_table),
+    m_null_arg(-1),
+    m_result(-1)
+{
+}
+
+//-----------------------------------------------------------------------------
+const conduit::Node &
+CompiledExpression::function_table() const
+{
+  return *m_function_table;
+}
+
+//-----------------------------------------------------------------------------
+int
+CompiledExpression::add_register(const std::string &type)
+{
+  m_registers.push_back(ExprValue());
+  m_types.push_back(type);
+  return static_cast<int>(m_registers.size()) - 1;
+}
+
+//-----------------------------------------------------------------------------
+int
+CompiledExpression::add_constant(const ExprValue &value,
+                                 const std::string &type)
+{
+  const int reg = add_register(type);
+  m_registers[reg] = value;
+  return reg;
+}
+
+//-----------------------------------------------------------------------------
+int
+CompiledExpression::add_identifier(const std::string &name)
+{
+  Instruction instr;
+  instr.m_op = LOAD_IDENTIFIER;
+  instr.m_dest = add_register("scalar");
+  instr.m_num_args = 0;
+  instr.m_bin_op = 0;
+  instr.m_name = name;
+  instr.m_func = nullptr;
+  m_program.push_back(instr);
+  return instr.m_dest;
+}
+
+//-----------------------------------------------------------------------------
+int
+CompiledExpression::add_binary_op(const int op,
+                                  const int lhs,
+                                  const int rhs,
+                                  const std::string &type)
+{
+  Instruction instr;
+  instr.m_op = BINARY_OP;
+  instr.m_dest = add_register(type);
+  instr.m_args[0] = lhs;
+  instr.m_args[1] = rhs;
+  instr.m_num_args = 2;
+  instr.m_bin_op = op;
+  instr.m_func = nullptr;
+  m_program.push_back(instr);
+  return instr.m_dest;
+}
+
+//-----------------------------------------------------------------------------
+int
+CompiledExpression::add_call(const std::string &filter_name,
+                             const std::vector<int> &args,
+                             const std::string &type)
+{
+  if(args.size() > MAX_ARGS)
+  {
+    ASCENT_ERROR("Compiled expression: '"<<filter_name<<"' has more than "
+                 <<MAX_ARGS<<" arguments");
+  }
+
+  Instruction instr;
+  instr.m_op = CALL;
+  instr.m_dest = add_register(type);
+  instr.m_num_args = static_cast<int>(args.size());
+  for(int a = 0; a < instr.m_num_args; ++a)
+  {
+    instr.m_args[a] = args[a];
+  }
+  instr.m_bin_op = 0;
+  instr.m_name = filter_name;
+  instr.m_func = function(filter_name);
+  m_program.push_back(instr);
+  return instr.m_dest;
+}
+
+//-----------------------------------------------------------------------------
+int
+CompiledExpression::null_arg()
+{
+  if(m_null_arg == -1)
+  {
+    m_null_arg = add_register("");
+  }
+  return m_null_arg;
+}
+
+//-----------------------------------------------------------------------------
+const std::string &
+CompiledExpression::type(const int reg) const
+{
+  return m_types[reg];
+}
+
+//-----------------------------------------------------------------------------
+void
+CompiledExpression::set_result(const int reg)
+{
+  m_result = reg;
+}
+
+//-----------------------------------------------------------------------------
+const ExprValue &
+CompiledExpression::execute(ExprContext &ctx)
+{
+  if(m_result == -1)
+  {
+    ASCENT_ERROR("Compiled expression: no result register");
+  }
+
+  const size_t num_instrs = m_program.size();
+  for(size_t i = 0; i < num_instrs; ++i)
+  {
+    const Instruction &instr = m_program[i];
+    ExprValue &dest = m_registers[instr.m_dest];
+    switch(instr.m_op)
+    {
+      case LOAD_IDENTIFIER:
+      {
+        if(!ctx.m_cache->has_path(instr.m_name))
+        {
+          ASCENT_ERROR("Unknown expression identifier: '"<<instr.m_name<<"'");
+        }
+
+        const conduit::Node &entries = (*ctx.m_cache)[instr.m_name];
+        const int num_entries = entries.number_of_children();
+        if(num_entries < 1)
+        {
+          ASCENT_ERROR("Expression identifier: needs a non-zero number of entires: "
+                       <<num_entries);
+        }
+        // grab the last one calculated
+        dest.from_node(entries.child(num_entries - 1));
+        break;
+      }
+      case BINARY_OP:
+      {
+        binary_op(instr.m_bin_op,
+                  m_registers[instr.m_args[0]],
+                  m_registers[instr.m_args[1]],
+                  dest);
+        break;
+      }
+      case CALL:
+      {
+        const ExprValue *args[MAX_ARGS];
+        for(int a = 0; a < instr.m_num_args; ++a)
+        {
+          args[a] = &m_registers[instr.m_args[a]];
+        }
+        instr.m_func(args, dest, ctx);
+        break;
+      }
+    }
+  }
+
+  return m_registers[m_result];
+}
+
+//-----------------------------------------------------------------------------
+ExprFunction
+CompiledExpression::function(const std::string &filter_name)
+{
+  static const std::map<std::string, ExprFunction> functions =
+    detail::builtin_functions();
+
+  std::map<std::string, ExprFunction>::const_iterator itr = functions.find(filter_name);
+  if(itr == functions.end())
+  {
+    ASCENT_ERROR("Compiled expression: no implementation of '"<<filter_name<<"'");
+  }
+  return itr->second;
+}
+
+//-----------------------------------------------------------------------------
+void
+CompiledExpression::binary_op(const int op,
+                              const ExprValue &lhs,
+                              const ExprValue &rhs,
+                              ExprValue &res)
+{
+  detail::binary_op(op, lhs, rhs, res);
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
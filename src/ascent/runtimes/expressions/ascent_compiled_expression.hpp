@@ -0,0 +1,232 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_compiled_expression.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_COMPILED_EXPRESSION
+#define ASCENT_COMPILED_EXPRESSION
+
+#include <ascent.hpp>
+#include <conduit.hpp>
+#include <flow_registry.hpp>
+
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+//-----------------------------------------------------------------------------
+// Result of one step of a compiled expression. Scalars, booleans and
+// vectors are held directly so arithmetic never touches a conduit::Node.
+// Anything else (positions of field extrema, histograms, values loaded
+// from the expression cache) lives in m_atts.
+//-----------------------------------------------------------------------------
+struct ExprValue
+{
+  enum Type
+  {
+    NONE,      // missing optional argument
+    SCALAR,
+    BOOLEAN,
+    VECTOR,
+    MESHVAR,
+    HISTOGRAM,
+    NODE       // opaque result from the expression cache
+  };
+
+  ExprValue();
+
+  void set_int(const int value, const Type type = SCALAR);
+  void set_double(const double value);
+  void set_vector(const double vec[3]);
+  void set_meshvar(const std::string &name);
+
+  double to_float64() const;
+
+  void from_node(const conduit::Node &node);
+  void to_node(conduit::Node &node) const;
+
+  Type          m_type;
+  bool          m_is_float;
+  int           m_int;
+  double        m_double;
+  double        m_vec[3];
+  std::string   m_name;
+  // scalars: attributes ("position"), histograms and nodes: the result
+  conduit::Node m_atts;
+};
+
+//-----------------------------------------------------------------------------
+// what a compiled expression needs from the evaluator. This is bound
+// again on every evaluation, the program itself is reused.
+//-----------------------------------------------------------------------------
+struct ExprContext
+{
+  conduit::Node  *m_dataset;
+  conduit::Node  *m_cache;
+  flow::Registry *m_registry;
+};
+
+typedef void (*ExprFunction)(const ExprValue **args,
+                             ExprValue &res,
+                             ExprContext &ctx);
+
+//-----------------------------------------------------------------------------
+// An expression lowered to a flat list of register instructions. Each
+// AST node is compiled once into a register: literals become constant
+// registers and operators/function calls become instructions that are
+// run in order by execute().
+//-----------------------------------------------------------------------------
+class CompiledExpression
+{
+public:
+  static const int MAX_ARGS = 4;
+
+  CompiledExpression(const conduit::Node &function_table);
+
+  // the function signatures used to type-check calls
+  const conduit::Node &function_table() const;
+
+  // used by the AST while lowering, returns the destination register
+  int add_constant(const ExprValue &value, const std::string &type);
+  int add_identifier(const std::string &name);
+  int add_binary_op(const int op,
+                    const int lhs,
+                    const int rhs,
+                    const std::string &type);
+  int add_call(const std::string &filter_name,
+               const std::vector<int> &args,
+               const std::string &type);
+  // register for omitted optional arguments
+  int null_arg();
+
+  const std::string &type(const int reg) const;
+
+  void set_result(const int reg);
+
+  const ExprValue &execute(ExprContext &ctx);
+
+  // resolves the implementation of a function table "filter_name".
+  // the expression flow filters call these too, so both evaluation
+  // paths share one implementation of each builtin
+  static ExprFunction function(const std::string &filter_name);
+
+  // implementation of the binary operators (op is a parser token)
+  static void binary_op(const int op,
+                        const ExprValue &lhs,
+                        const ExprValue &rhs,
+                        ExprValue &res);
+
+private:
+  enum OpCode
+  {
+    LOAD_IDENTIFIER,
+    BINARY_OP,
+    CALL
+  };
+
+  struct Instruction
+  {
+    OpCode       m_op;
+    int          m_dest;
+    int          m_args[MAX_ARGS];
+    int          m_num_args;
+    int          m_bin_op;
+    std::string  m_name;
+    ExprFunction m_func;
+  };
+
+  int add_register(const std::string &type);
+
+  const conduit::Node     *m_function_table;
+  std::vector<ExprValue>   m_registers;
+  std::vector<std::string> m_types;
+  std::vector<Instruction> m_program;
+  int                      m_null_arg;
+  int                      m_result;
+};
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
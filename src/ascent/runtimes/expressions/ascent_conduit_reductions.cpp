@@ -53,8 +53,11 @@
 
 #include <ascent_logging.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <limits>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -82,7 +85,7 @@ conduit::Node
 type_dispatch(const conduit::Node &values, const Function &func)
 {
   conduit::Node res;
-  const int num_vals = values.dtype().number_of_elements();
+  const conduit::index_t num_vals = values.dtype().number_of_elements();
   if(values.dtype().is_float32())
   {
     const conduit::float32 *ptr =  values.as_float32_ptr();
@@ -93,6 +96,16 @@ type_dispatch(const conduit::Node &values, const Function &func)
     const conduit::float64 *ptr =  values.as_float64_ptr();
     res = func(ptr, num_vals);
   }
+  else if(values.dtype().is_int8())
+  {
+    const conduit::int8 *ptr =  values.as_int8_ptr();
+    res = func(ptr, num_vals);
+  }
+  else if(values.dtype().is_int16())
+  {
+    const conduit::int16 *ptr =  values.as_int16_ptr();
+    res = func(ptr, num_vals);
+  }
   else if(values.dtype().is_int32())
   {
     const conduit::int32 *ptr =  values.as_int32_ptr();
@@ -103,37 +116,76 @@ type_dispatch(const conduit::Node &values, const Function &func)
     const conduit::int64 *ptr =  values.as_int64_ptr();
     res = func(ptr, num_vals);
   }
+  else if(values.dtype().is_uint8())
+  {
+    const conduit::uint8 *ptr =  values.as_uint8_ptr();
+    res = func(ptr, num_vals);
+  }
+  else if(values.dtype().is_uint16())
+  {
+    const conduit::uint16 *ptr =  values.as_uint16_ptr();
+    res = func(ptr, num_vals);
+  }
+  else if(values.dtype().is_uint32())
+  {
+    const conduit::uint32 *ptr =  values.as_uint32_ptr();
+    res = func(ptr, num_vals);
+  }
+  else if(values.dtype().is_uint64())
+  {
+    const conduit::uint64 *ptr =  values.as_uint64_ptr();
+    res = func(ptr, num_vals);
+  }
   else
   {
-    ASCENT_ERROR("Type dispatch: unsupported array type");
+    ASCENT_ERROR("Type dispatch: unsupported array type "<<
+                  values.dtype().name());
   }
   return res;
 }
 
+// compensated (Kahan) summation: the running error is kept in comp,
+// so sums over billions of values do not drift. The sum is sum - comp.
+inline void
+kahan_add(double &sum, double &comp, const double value)
+{
+  const double y = value - comp;
+  const double t = sum + y;
+  comp = (t - sum) - y;
+  sum = t;
+}
+
 struct MaxCompare
 {
   double value;
-  int index;
+  conduit::index_t index;
 };
 
+inline MaxCompare
+max_init()
+{
+  MaxCompare mcomp;
+  mcomp.value = std::numeric_limits<double>::lowest();
+  mcomp.index = 0;
+  return mcomp;
+}
+
 #ifdef ASCENT_USE_OPENMP
     #pragma omp declare reduction(maximum: struct MaxCompare : \
-        omp_out = omp_in.value > omp_out.value ? omp_in : omp_out)
+        omp_out = omp_in.value > omp_out.value ? omp_in : omp_out) \
+        initializer(omp_priv = max_init())
 #endif
 
 struct MaxFunctor
 {
   template<typename T>
-  conduit::Node operator()(const T* values, const int &size) const
+  conduit::Node operator()(const T* values, const conduit::index_t &size) const
   {
-    MaxCompare mcomp;
-
-    mcomp.value = std::numeric_limits<double>::lowest();
-    mcomp.index = 0;
+    MaxCompare mcomp = max_init();
 #ifdef ASCENT_USE_OPENMP
     #pragma omp parallel for reduction(maximum:mcomp)
 #endif
-    for(int v = 0; v < size; ++v)
+    for(conduit::index_t v = 0; v < size; ++v)
     {
       double val = static_cast<double>(values[v]);
       if(val > mcomp.value)
@@ -145,7 +197,7 @@ struct MaxFunctor
 
     conduit::Node res;
     res["value"] = mcomp.value;
-    res["index"] = mcomp.index;
+    res["index"] = (conduit::int64) mcomp.index;
     return res;
   }
 };
@@ -153,27 +205,34 @@ struct MaxFunctor
 struct MinCompare
 {
   double value;
-  int index;
+  conduit::index_t index;
 };
 
+inline MinCompare
+min_init()
+{
+  MinCompare mcomp;
+  mcomp.value = std::numeric_limits<double>::max();
+  mcomp.index = 0;
+  return mcomp;
+}
+
 #ifdef ASCENT_USE_OPENMP
     #pragma omp declare reduction(minimum: struct MinCompare : \
-        omp_out = omp_in.value < omp_out.value ? omp_in : omp_out)
+        omp_out = omp_in.value < omp_out.value ? omp_in : omp_out) \
+        initializer(omp_priv = min_init())
 #endif
 
 struct MinFunctor
 {
   template<typename T>
-  conduit::Node operator()(const T* values, const int &size) const
+  conduit::Node operator()(const T* values, const conduit::index_t &size) const
   {
-    MinCompare mcomp;
-
-    mcomp.value = std::numeric_limits<double>::max();
-    mcomp.index = 0;
+    MinCompare mcomp = min_init();
 #ifdef ASCENT_USE_OPENMP
     #pragma omp parallel for reduction(minimum:mcomp)
 #endif
-    for(int v = 0; v < size; ++v)
+    for(conduit::index_t v = 0; v < size; ++v)
     {
       double val = static_cast<double>(values[v]);
       if(val < mcomp.value)
@@ -185,7 +244,7 @@ struct MinFunctor
 
     conduit::Node res;
     res["value"] = mcomp.value;
-    res["index"] = mcomp.index;
+    res["index"] = (conduit::int64) mcomp.index;
     return res;
   }
 };
@@ -193,64 +252,235 @@ struct MinFunctor
 struct SumFunctor
 {
   template<typename T>
-  conduit::Node operator()(const T* values, const int &size) const
+  conduit::Node operator()(const T* values, const conduit::index_t &size) const
+  {
+    // always accumulate in double, integer fields would overflow T
+    double sum = 0.;
+    double comp = 0.;
+#ifdef ASCENT_USE_OPENMP
+    #pragma omp parallel
+    {
+      double local_sum = 0.;
+      double local_comp = 0.;
+      #pragma omp for nowait
+      for(conduit::index_t v = 0; v < size; ++v)
+      {
+        kahan_add(local_sum, local_comp, static_cast<double>(values[v]));
+      }
+
+      #pragma omp critical
+      {
+        kahan_add(sum, comp, local_sum);
+        kahan_add(sum, comp, -local_comp);
+      }
+    }
+#else
+    for(conduit::index_t v = 0; v < size; ++v)
+    {
+      kahan_add(sum, comp, static_cast<double>(values[v]));
+    }
+#endif
+    conduit::Node res;
+    res["value"] = sum - comp;
+    res["count"] = (conduit::int64) size;
+    return res;
+  }
+};
+
+struct StatsAccum
+{
+  double min_value;
+  conduit::index_t min_index;
+  double max_value;
+  conduit::index_t max_index;
+  double sum;
+  double sum_comp;
+  double sum_sq;
+  double sum_sq_comp;
+};
+
+inline StatsAccum
+stats_init()
+{
+  StatsAccum accum;
+  accum.min_value = std::numeric_limits<double>::max();
+  accum.min_index = 0;
+  accum.max_value = std::numeric_limits<double>::lowest();
+  accum.max_index = 0;
+  accum.sum = 0.;
+  accum.sum_comp = 0.;
+  accum.sum_sq = 0.;
+  accum.sum_sq_comp = 0.;
+  return accum;
+}
+
+// ties go to the lower index so results don't depend on the
+// number of threads
+inline StatsAccum
+stats_combine(const StatsAccum &a, const StatsAccum &b)
+{
+  StatsAccum res = a;
+  if(b.min_value < a.min_value ||
+     (b.min_value == a.min_value && b.min_index < a.min_index))
+  {
+    res.min_value = b.min_value;
+    res.min_index = b.min_index;
+  }
+
+  if(b.max_value > a.max_value ||
+     (b.max_value == a.max_value && b.max_index < a.max_index))
   {
-    T sum = 0;
+    res.max_value = b.max_value;
+    res.max_index = b.max_index;
+  }
+
+  kahan_add(res.sum, res.sum_comp, b.sum);
+  kahan_add(res.sum, res.sum_comp, -b.sum_comp);
+  kahan_add(res.sum_sq, res.sum_sq_comp, b.sum_sq);
+  kahan_add(res.sum_sq, res.sum_sq_comp, -b.sum_sq_comp);
+  return res;
+}
+
 #ifdef ASCENT_USE_OPENMP
-    #pragma omp parallel for reduction(+:sum)
+    #pragma omp declare reduction(stats: struct StatsAccum : \
+        omp_out = stats_combine(omp_out, omp_in)) \
+        initializer(omp_priv = stats_init())
 #endif
-    for(int v = 0; v < size; ++v)
+
+// computes min, max, sum and sum of squares in one pass
+struct StatsFunctor
+{
+  template<typename T>
+  conduit::Node operator()(const T* values, const conduit::index_t &size) const
+  {
+    StatsAccum accum = stats_init();
+#ifdef ASCENT_USE_OPENMP
+    #pragma omp parallel for reduction(stats:accum)
+#endif
+    for(conduit::index_t v = 0; v < size; ++v)
     {
       double val = static_cast<double>(values[v]);
-      sum += val;
+      if(val < accum.min_value)
+      {
+        accum.min_value = val;
+        accum.min_index = v;
+      }
+      if(val > accum.max_value)
+      {
+        accum.max_value = val;
+        accum.max_index = v;
+      }
+      kahan_add(accum.sum, accum.sum_comp, val);
+      kahan_add(accum.sum_sq, accum.sum_sq_comp, val * val);
     }
+
     conduit::Node res;
-    res["value"] = sum;
-    res["count"] = (int)size;
+    res["min/value"] = accum.min_value;
+    res["min/index"] = (conduit::int64) accum.min_index;
+    res["max/value"] = accum.max_value;
+    res["max/index"] = (conduit::int64) accum.max_index;
+    res["sum"] = accum.sum - accum.sum_comp;
+    res["sum_sq"] = accum.sum_sq - accum.sum_sq_comp;
+    res["count"] = (conduit::int64) size;
     return res;
   }
 };
 
+// bins are either uniform in linear or log space, or given by
+// explicit edges. Values outside the range are clamped to the
+// first and last bins.
 struct HistogramFunctor
 {
   double m_min_val;
-  double m_max_val;
+  double m_inv_delta;
   int m_num_bins;
+  bool m_log_scale;
+  const double *m_edges;
+
   HistogramFunctor(const double &min_val,
                    const double &max_val,
+                   const int &num_bins,
+                   const bool &log_scale = false)
+    : m_min_val(log_scale ? std::log(min_val) : min_val),
+      m_inv_delta(0.),
+      m_num_bins(num_bins),
+      m_log_scale(log_scale),
+      m_edges(nullptr)
+  {
+    const double max_bin_val = log_scale ? std::log(max_val) : max_val;
+    m_inv_delta = double(m_num_bins) / (max_bin_val - m_min_val);
+  }
+
+  // num_bins + 1 increasing edges
+  HistogramFunctor(const double *edges,
                    const int &num_bins)
-    : m_min_val(min_val),
-      m_max_val(max_val),
-      m_num_bins(num_bins)
+    : m_min_val(0.),
+      m_inv_delta(0.),
+      m_num_bins(num_bins),
+      m_log_scale(false),
+      m_edges(edges)
   {}
 
-  template<typename T>
-  conduit::Node operator()(const T* values, const int &size) const
+  int bin_index(double val) const
   {
-    const double inv_delta = double(m_num_bins) / (m_max_val - m_min_val);
+    int bin_index;
+    if(m_edges != nullptr)
+    {
+      const double *upper = std::upper_bound(m_edges,
+                                             m_edges + m_num_bins + 1,
+                                             val);
+      bin_index = static_cast<int>(upper - m_edges) - 1;
+    }
+    else
+    {
+      if(m_log_scale)
+      {
+        // non-positive values go to the first bin
+        val = val > 0. ? std::log(val) : m_min_val;
+      }
+      bin_index = static_cast<int>((val - m_min_val) * m_inv_delta);
+    }
+    // clamp for now
+    return std::max(0, std::min(bin_index, m_num_bins - 1));
+  }
 
-    int *bins = new int[m_num_bins];
-    memset(bins, 0, sizeof(int) * m_num_bins);
+  template<typename T>
+  conduit::Node operator()(const T* values, const conduit::index_t &size) const
+  {
+    std::vector<conduit::int64> bins(m_num_bins, 0);
 #ifdef ASCENT_USE_OPENMP
-    #pragma omp parallel for
-#endif
-    for(int v = 0; v < size; ++v)
+    #pragma omp parallel
     {
-      double val = static_cast<double>(values[v]);
-      int bin_index = static_cast<int>((val - m_min_val) * inv_delta);
-      // clamp for now
-      bin_index = std::max(0, std::min(bin_index, m_num_bins - 1));
-#ifdef ASCENT_USE_OPENMP
-      #pragma omp atomic
-#endif
-      bins[bin_index]++;
+      // each thread fills private bins, so threads never
+      // contend on the (few) cache lines holding the bins
+      std::vector<conduit::int64> local_bins(m_num_bins, 0);
+      #pragma omp for nowait
+      for(conduit::index_t v = 0; v < size; ++v)
+      {
+        local_bins[bin_index(static_cast<double>(values[v]))]++;
+      }
 
+      #pragma omp critical
+      {
+        for(int b = 0; b < m_num_bins; ++b)
+        {
+          bins[b] += local_bins[b];
+        }
+      }
     }
-    conduit::Node res;
-    res["value"].set(bins, m_num_bins);
-    res["bin_size"] = (m_max_val - m_min_val) / double(m_num_bins);
+#else
+    for(conduit::index_t v = 0; v < size; ++v)
+    {
+      bins[bin_index(static_cast<double>(values[v]))]++;
+    }
+#endif
 
-    delete[] bins;
+    conduit::Node res;
+    res["value"].set(bins.data(), m_num_bins);
+    if(m_edges == nullptr && !m_log_scale)
+    {
+      res["bin_size"] = 1. / m_inv_delta;
+    }
     return res;
   }
 };
@@ -278,6 +508,12 @@ array_sum(const conduit::Node &values)
   return detail::type_dispatch(values, detail::SumFunctor());
 }
 
+conduit::Node
+array_stats(const conduit::Node &values)
+{
+  return detail::type_dispatch(values, detail::StatsFunctor());
+}
+
 conduit::Node
 array_histogram(const conduit::Node &values,
                 const double &min_value,
@@ -288,6 +524,46 @@ array_histogram(const conduit::Node &values,
   return detail::type_dispatch(values, histogram);
 }
 
+conduit::Node
+array_log_histogram(const conduit::Node &values,
+                    const double &min_value,
+                    const double &max_value,
+                    const int &num_bins)
+{
+  if(min_value <= 0.)
+  {
+    ASCENT_ERROR("Log histogram: min value ("<<min_value<<") must be positive");
+  }
+  detail::HistogramFunctor histogram(min_value, max_value, num_bins, true);
+  return detail::type_dispatch(values, histogram);
+}
+
+conduit::Node
+array_histogram(const conduit::Node &values,
+                const conduit::Node &bin_edges)
+{
+  conduit::Node edges;
+  bin_edges.to_float64_array(edges);
+  const int num_edges = edges.dtype().number_of_elements();
+  const double *edges_ptr = edges.as_float64_ptr();
+
+  if(num_edges < 2)
+  {
+    ASCENT_ERROR("Histogram: at least two bin edges are required");
+  }
+
+  for(int i = 1; i < num_edges; ++i)
+  {
+    if(!(edges_ptr[i - 1] < edges_ptr[i]))
+    {
+      ASCENT_ERROR("Histogram: bin edges must be increasing");
+    }
+  }
+
+  detail::HistogramFunctor histogram(edges_ptr, num_edges - 1);
+  return detail::type_dispatch(values, histogram);
+}
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
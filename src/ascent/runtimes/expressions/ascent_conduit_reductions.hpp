@@ -74,17 +74,35 @@ namespace runtime
 namespace expressions
 {
 
+// all reductions accept float32/64 and signed/unsigned 8 to 64 bit
+// integer arrays. Indices and counts are int64, sums are float64
+// accumulated with compensated summation
 conduit::Node array_max(const conduit::Node &values);
 
 conduit::Node array_min(const conduit::Node &values);
 
 conduit::Node array_sum(const conduit::Node &values);
 
+// min and max (with indices), sum, sum of squares and count
+// computed in a single pass over the values
+conduit::Node array_stats(const conduit::Node &values);
+
+// histogram with uniform bins, counts are int64
 conduit::Node array_histogram(const conduit::Node &values,
                               const double &min_value,
                               const double &max_value,
                               const int &num_bins);
 
+// histogram with bins that are uniform in log space (min_value > 0)
+conduit::Node array_log_histogram(const conduit::Node &values,
+                                  const double &min_value,
+                                  const double &max_value,
+                                  const int &num_bins);
+
+// histogram with explicit, increasing bin edges (num_bins + 1 values)
+conduit::Node array_histogram(const conduit::Node &values,
+                              const conduit::Node &bin_edges);
+
 };
 //-----------------------------------------------------------------------------
 // -- end ascent::runtime::expressions--
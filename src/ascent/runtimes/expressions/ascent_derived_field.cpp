@@ -0,0 +1,488 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_derived_field.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_derived_field.hpp"
+#include "parser.hpp"
+
+#include <ascent_logging.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+namespace detail
+{
+
+template<typename T>
+void
+convert_block(const conduit::Node &values,
+              const conduit::index_t offset,
+              const int size,
+              double *dest)
+{
+  const char *ptr = static_cast<const char*>(values.element_ptr(offset));
+  const conduit::index_t stride = values.dtype().stride();
+  for(int i = 0; i < size; ++i)
+  {
+    dest[i] = static_cast<double>(*reinterpret_cast<const T*>(ptr + i * stride));
+  }
+}
+
+// returns a pointer to size values of the input starting at offset.
+// Compact float64 values are used in place, anything else is
+// converted into the register's block.
+const double *
+load_block(const conduit::Node &values,
+           const conduit::index_t offset,
+           const int size,
+           double *block)
+{
+  const conduit::DataType &dtype = values.dtype();
+  if(dtype.is_float64())
+  {
+    if(dtype.stride() == sizeof(conduit::float64))
+    {
+      return static_cast<const double*>(values.element_ptr(offset));
+    }
+    convert_block<conduit::float64>(values, offset, size, block);
+  }
+  else if(dtype.is_float32())
+  {
+    convert_block<conduit::float32>(values, offset, size, block);
+  }
+  else if(dtype.is_int32())
+  {
+    convert_block<conduit::int32>(values, offset, size, block);
+  }
+  else if(dtype.is_int64())
+  {
+    convert_block<conduit::int64>(values, offset, size, block);
+  }
+  else if(dtype.is_uint32())
+  {
+    convert_block<conduit::uint32>(values, offset, size, block);
+  }
+  else if(dtype.is_uint64())
+  {
+    convert_block<conduit::uint64>(values, offset, size, block);
+  }
+  else if(dtype.is_int8())
+  {
+    convert_block<conduit::int8>(values, offset, size, block);
+  }
+  else if(dtype.is_uint8())
+  {
+    convert_block<conduit::uint8>(values, offset, size, block);
+  }
+  else if(dtype.is_int16())
+  {
+    convert_block<conduit::int16>(values, offset, size, block);
+  }
+  else if(dtype.is_uint16())
+  {
+    convert_block<conduit::uint16>(values, offset, size, block);
+  }
+  return block;
+}
+
+} // namespace detail
+
+const int DerivedFieldProgram::BLOCK_SIZE;
+
+//-----------------------------------------------------------------------------
+DerivedFieldProgram::DerivedFieldProgram()
+  : m_result(-1)
+{
+}
+
+//-----------------------------------------------------------------------------
+int
+DerivedFieldProgram::add_register(const RegisterKind kind)
+{
+  m_kinds.push_back(kind);
+  m_constants.push_back(0.);
+  m_field_index.push_back(-1);
+  return static_cast<int>(m_kinds.size()) - 1;
+}
+
+//-----------------------------------------------------------------------------
+int
+DerivedFieldProgram::add_instruction(const OpCode op,
+                                     const int lhs,
+                                     const int rhs)
+{
+  // fold operations on literals
+  if(m_kinds[lhs] == CONSTANT && m_kinds[rhs] == CONSTANT)
+  {
+    double value = 0.;
+    run(op, &m_constants[lhs], &m_constants[rhs], &value, 1);
+    return add_constant(value);
+  }
+
+  Instruction instr;
+  instr.m_op = op;
+  instr.m_dest = add_register(TEMPORARY);
+  instr.m_lhs = lhs;
+  instr.m_rhs = rhs;
+  m_program.push_back(instr);
+  return instr.m_dest;
+}
+
+//-----------------------------------------------------------------------------
+int
+DerivedFieldProgram::add_constant(const double value)
+{
+  const int reg = add_register(CONSTANT);
+  m_constants[reg] = value;
+  return reg;
+}
+
+//-----------------------------------------------------------------------------
+int
+DerivedFieldProgram::add_field(const std::string &name)
+{
+  // each field is loaded once, no matter how often it is referenced
+  for(size_t r = 0; r < m_kinds.size(); ++r)
+  {
+    if(m_kinds[r] == FIELD && m_fields[m_field_index[r]] == name)
+    {
+      return static_cast<int>(r);
+    }
+  }
+
+  const int reg = add_register(FIELD);
+  m_field_index[reg] = static_cast<int>(m_fields.size());
+  m_fields.push_back(name);
+  return reg;
+}
+
+//-----------------------------------------------------------------------------
+int
+DerivedFieldProgram::add_identifier(const std::string &name)
+{
+  const int reg = add_register(IDENTIFIER);
+  m_identifiers.push_back(std::make_pair(reg, name));
+  return reg;
+}
+
+//-----------------------------------------------------------------------------
+int
+DerivedFieldProgram::add_binary_op(const int op,
+                                   const int lhs,
+                                   const int rhs)
+{
+  OpCode code;
+  switch(op)
+  {
+    case TPLUS:  code = ADD; break;
+    case TMINUS: code = SUB; break;
+    case TMUL:   code = MUL; break;
+    case TDIV:   code = DIV; break;
+    case TCLT:   code = LT;  break;
+    case TCLE:   code = LE;  break;
+    case TCGT:   code = GT;  break;
+    case TCGE:   code = GE;  break;
+    case TCEQ:   code = EQ;  break;
+    case TCNE:   code = NE;  break;
+    default: ASCENT_ERROR("Derived field: unknown binary op "<<op);
+  }
+  return add_instruction(code, lhs, rhs);
+}
+
+//-----------------------------------------------------------------------------
+int
+DerivedFieldProgram::add_function(const std::string &name,
+                                  const std::vector<int> &args)
+{
+  OpCode code;
+  int num_args = 1;
+  if(name == "sqrt")       code = SQRT;
+  else if(name == "abs")   code = ABS;
+  else if(name == "exp")   code = EXP;
+  else if(name == "log")   code = LOG;
+  else if(name == "log10") code = LOG10;
+  else if(name == "sin")   code = SIN;
+  else if(name == "cos")   code = COS;
+  else if(name == "min")   { code = MIN; num_args = 2; }
+  else if(name == "max")   { code = MAX; num_args = 2; }
+  else if(name == "pow")   { code = POW; num_args = 2; }
+  else
+  {
+    ASCENT_ERROR("Derived field: unsupported function '"<<name<<"'."
+                 <<" Element-wise functions are: sqrt, abs, exp, log,"
+                 <<" log10, sin, cos, min, max and pow");
+  }
+
+  if(static_cast<int>(args.size()) != num_args)
+  {
+    ASCENT_ERROR("Derived field: '"<<name<<"' expects "<<num_args
+                 <<" argument(s), got "<<args.size());
+  }
+
+  // unary functions ignore their second operand
+  return add_instruction(code, args[0], args[num_args - 1]);
+}
+
+//-----------------------------------------------------------------------------
+void
+DerivedFieldProgram::set_result(const int reg)
+{
+  m_result = reg;
+}
+
+//-----------------------------------------------------------------------------
+const std::vector<std::string> &
+DerivedFieldProgram::field_names() const
+{
+  return m_fields;
+}
+
+//-----------------------------------------------------------------------------
+void
+DerivedFieldProgram::bind_identifiers(const conduit::Node &cache)
+{
+  for(size_t i = 0; i < m_identifiers.size(); ++i)
+  {
+    const int reg = m_identifiers[i].first;
+    const std::string &name = m_identifiers[i].second;
+    if(!cache.has_path(name) || cache[name].number_of_children() < 1)
+    {
+      ASCENT_ERROR("Derived field: unknown expression identifier: '"<<name<<"'");
+    }
+
+    // grab the last one calculated
+    const conduit::Node &entry = cache[name].child(cache[name].number_of_children() - 1);
+    if(!entry.has_path("value") || !entry["value"].dtype().is_number() ||
+       entry["value"].dtype().number_of_elements() != 1)
+    {
+      ASCENT_ERROR("Derived field: identifier '"<<name<<"' is not a scalar");
+    }
+    m_constants[reg] = entry["value"].to_float64();
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool
+DerivedFieldProgram::supported_type(const conduit::DataType &dtype)
+{
+  return dtype.is_number();
+}
+
+//-----------------------------------------------------------------------------
+void
+DerivedFieldProgram::run(const OpCode op,
+                         const double *lhs,
+                         const double *rhs,
+                         double *dest,
+                         const int size)
+{
+  // one simple loop per op so the compiler can vectorize each of them
+  switch(op)
+  {
+    case ADD:
+      for(int i = 0; i < size; ++i) dest[i] = lhs[i] + rhs[i];
+      break;
+    case SUB:
+      for(int i = 0; i < size; ++i) dest[i] = lhs[i] - rhs[i];
+      break;
+    case MUL:
+      for(int i = 0; i < size; ++i) dest[i] = lhs[i] * rhs[i];
+      break;
+    case DIV:
+      for(int i = 0; i < size; ++i) dest[i] = lhs[i] / rhs[i];
+      break;
+    case LT:
+      for(int i = 0; i < size; ++i) dest[i] = lhs[i] < rhs[i] ? 1. : 0.;
+      break;
+    case LE:
+      for(int i = 0; i < size; ++i) dest[i] = lhs[i] <= rhs[i] ? 1. : 0.;
+      break;
+    case GT:
+      for(int i = 0; i < size; ++i) dest[i] = lhs[i] > rhs[i] ? 1. : 0.;
+      break;
+    case GE:
+      for(int i = 0; i < size; ++i) dest[i] = lhs[i] >= rhs[i] ? 1. : 0.;
+      break;
+    case EQ:
+      for(int i = 0; i < size; ++i) dest[i] = lhs[i] == rhs[i] ? 1. : 0.;
+      break;
+    case NE:
+      for(int i = 0; i < size; ++i) dest[i] = lhs[i] != rhs[i] ? 1. : 0.;
+      break;
+    case MIN:
+      for(int i = 0; i < size; ++i) dest[i] = std::min(lhs[i], rhs[i]);
+      break;
+    case MAX:
+      for(int i = 0; i < size; ++i) dest[i] = std::max(lhs[i], rhs[i]);
+      break;
+    case POW:
+      for(int i = 0; i < size; ++i) dest[i] = std::pow(lhs[i], rhs[i]);
+      break;
+    case SQRT:
+      for(int i = 0; i < size; ++i) dest[i] = std::sqrt(lhs[i]);
+      break;
+    case ABS:
+      for(int i = 0; i < size; ++i) dest[i] = std::abs(lhs[i]);
+      break;
+    case EXP:
+      for(int i = 0; i < size; ++i) dest[i] = std::exp(lhs[i]);
+      break;
+    case LOG:
+      for(int i = 0; i < size; ++i) dest[i] = std::log(lhs[i]);
+      break;
+    case LOG10:
+      for(int i = 0; i < size; ++i) dest[i] = std::log10(lhs[i]);
+      break;
+    case SIN:
+      for(int i = 0; i < size; ++i) dest[i] = std::sin(lhs[i]);
+      break;
+    case COS:
+      for(int i = 0; i < size; ++i) dest[i] = std::cos(lhs[i]);
+      break;
+  }
+}
+
+//-----------------------------------------------------------------------------
+void
+DerivedFieldProgram::execute(const std::vector<const conduit::Node*> &inputs,
+                             const conduit::index_t size,
+                             double *output) const
+{
+  // this runs inside of parallel regions, so the inputs are
+  // validated by the caller and nothing here can throw
+  const int num_regs = static_cast<int>(m_kinds.size());
+  std::vector<double> blocks(static_cast<size_t>(num_regs) * BLOCK_SIZE);
+  std::vector<const double*> regs(num_regs, nullptr);
+
+  // constants are broadcast once for all blocks
+  for(int r = 0; r < num_regs; ++r)
+  {
+    double *block = &blocks[static_cast<size_t>(r) * BLOCK_SIZE];
+    if(m_kinds[r] == CONSTANT || m_kinds[r] == IDENTIFIER)
+    {
+      std::fill(block, block + BLOCK_SIZE, m_constants[r]);
+    }
+    regs[r] = block;
+  }
+
+  const size_t num_instrs = m_program.size();
+  for(conduit::index_t offset = 0; offset < size; offset += BLOCK_SIZE)
+  {
+    const int block_size = static_cast<int>(std::min<conduit::index_t>(BLOCK_SIZE,
+                                                                       size - offset));
+    for(int r = 0; r < num_regs; ++r)
+    {
+      if(m_kinds[r] == FIELD)
+      {
+        double *block = &blocks[static_cast<size_t>(r) * BLOCK_SIZE];
+        regs[r] = detail::load_block(*inputs[m_field_index[r]],
+                                     offset,
+                                     block_size,
+                                     block);
+      }
+    }
+
+    for(size_t i = 0; i < num_instrs; ++i)
+    {
+      const Instruction &instr = m_program[i];
+      // the result is written straight to the output
+      double *dest = instr.m_dest == m_result ?
+                     output + offset :
+                     &blocks[static_cast<size_t>(instr.m_dest) * BLOCK_SIZE];
+      run(instr.m_op, regs[instr.m_lhs], regs[instr.m_rhs], dest, block_size);
+      regs[instr.m_dest] = dest;
+    }
+
+    // the expression is just a field or a constant
+    if(m_kinds[m_result] != TEMPORARY)
+    {
+      std::memcpy(output + offset,
+                  regs[m_result],
+                  sizeof(double) * block_size);
+    }
+  }
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
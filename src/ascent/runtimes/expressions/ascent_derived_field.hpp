@@ -0,0 +1,184 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_derived_field.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_DERIVED_FIELD
+#define ASCENT_DERIVED_FIELD
+
+#include <ascent.hpp>
+#include <conduit.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+//-----------------------------------------------------------------------------
+// An element-wise expression over mesh fields, e.g.
+//   sqrt("vx" * "vx" + "vy" * "vy")
+// lowered to a register program. execute() runs the whole program over
+// blocks of BLOCK_SIZE values, so there is a single pass over the inputs
+// and the only temporaries are one block per register.
+//-----------------------------------------------------------------------------
+class DerivedFieldProgram
+{
+public:
+  static const int BLOCK_SIZE = 512;
+
+  DerivedFieldProgram();
+
+  // used by the AST while lowering, returns the result register
+  int add_constant(const double value);
+  int add_field(const std::string &name);
+  int add_identifier(const std::string &name);
+  int add_binary_op(const int op, const int lhs, const int rhs);
+  int add_function(const std::string &name, const std::vector<int> &args);
+
+  void set_result(const int reg);
+
+  // the fields read by the expression. execute() expects their
+  // values in this order
+  const std::vector<std::string> &field_names() const;
+
+  // identifiers refer to scalar results of previous expressions and
+  // are looked up in the expression cache before executing
+  void bind_identifiers(const conduit::Node &cache);
+
+  // true if execute() can read values with this layout
+  static bool supported_type(const conduit::DataType &dtype);
+
+  // evaluates the expression for size elements, inputs are the
+  // values of field_names()
+  void execute(const std::vector<const conduit::Node*> &inputs,
+               const conduit::index_t size,
+               double *output) const;
+
+private:
+  enum OpCode
+  {
+    ADD, SUB, MUL, DIV,
+    LT, LE, GT, GE, EQ, NE,
+    MIN, MAX, POW,
+    SQRT, ABS, EXP, LOG, LOG10, SIN, COS
+  };
+
+  enum RegisterKind
+  {
+    CONSTANT,
+    IDENTIFIER,
+    FIELD,
+    TEMPORARY
+  };
+
+  struct Instruction
+  {
+    OpCode m_op;
+    int    m_dest;
+    int    m_lhs;
+    int    m_rhs;
+  };
+
+  int add_register(const RegisterKind kind);
+  int add_instruction(const OpCode op, const int lhs, const int rhs);
+
+  static void run(const OpCode op,
+                  const double *lhs,
+                  const double *rhs,
+                  double *dest,
+                  const int size);
+
+  std::vector<RegisterKind>                m_kinds;
+  std::vector<double>                      m_constants;
+  std::vector<int>                         m_field_index;
+  std::vector<std::string>                 m_fields;
+  std::vector<std::pair<int, std::string> > m_identifiers;
+  std::vector<Instruction>                 m_program;
+  int                                      m_result;
+};
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
@@ -64,9 +64,11 @@
 #include <ascent_logging.hpp>
 #include "ascent_conduit_reductions.hpp"
 #include "ascent_blueprint_architect.hpp"
+#include "ascent_compiled_expression.hpp"
 #include <flow_graph.hpp>
 #include <flow_workspace.hpp>
 
+#include <functional>
 #include <limits>
 #include <math.h>
 
@@ -99,100 +101,135 @@ namespace expressions
 namespace detail
 {
 
-bool is_math(const std::string &op)
+// true if every rank agrees
+bool all_agree(bool local)
 {
-  if(op == "*" || op == "+" || op == "/" || op == "-")
-  {
-    return true;
-  }
-  else
-  {
-    return false;
-  }
+  bool agreement = local;
+#ifdef ASCENT_MPI_ENABLED
+  int local_boolean = local ? 1 : 0;
+  int global_min = 0;
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  MPI_Allreduce((void *)(&local_boolean),
+                (void *)(&global_min),
+                1,
+                MPI_INT,
+                MPI_MIN,
+                mpi_comm);
+  agreement = global_min == 1;
+#endif
+  return agreement;
 }
 
-void
-vector_op(const double lhs[3],
-          const double rhs[3],
-          const std::string &op,
-          double res[3])
+// identifies the values of a field: the layout and
+// addresses of the values in every domain
+conduit::uint64
+field_signature(const conduit::Node &dataset, const std::string &field)
 {
-
-  if(op == "+")
+  size_t sig = dataset.number_of_children();
+  const std::string path = "fields/" + field + "/values";
+  for(int i = 0; i < dataset.number_of_children(); ++i)
   {
-    res[0] = lhs[0] + rhs[0];
-    res[1] = lhs[1] + rhs[1];
-    res[2] = lhs[2] + rhs[2];
-  }
-  else if(op == "-")
-  {
-    res[0] = lhs[0] - rhs[0];
-    res[1] = lhs[1] - rhs[1];
-    res[2] = lhs[2] - rhs[2];
-  }
-  else
-  {
-    ASCENT_ERROR("Unsupported vector op "<<op);
+    const conduit::Node &dom = dataset.child(i);
+    if(dom.has_path(path))
+    {
+      const conduit::Node &values = dom[path];
+      size_t v = std::hash<std::string>()(values.schema().to_json());
+      sig ^= v + 0x9e3779b9 + (sig << 6) + (sig >> 2);
+      v = std::hash<const void*>()(values.data_ptr());
+      sig ^= v + 0x9e3779b9 + (sig << 6) + (sig >> 2);
+    }
   }
+  return (conduit::uint64) sig;
 }
 
-
-template<typename T>
-T math_op(const T& lhs, const T& rhs, const std::string &op)
+// field stats are cached per (field, cycle) so that every expression
+// that references the same field only sweeps the data once
+conduit::Node
+cached_field_stats(flow::Registry &registry,
+                   const conduit::Node &dataset,
+                   const std::string &field)
 {
-  T res;
-  if(op == "+")
+  if(!registry.has_entry("field_stats") || !registry.has_entry("cycle"))
   {
-    res = lhs + rhs;
+    return field_stats(dataset, field);
   }
-  else if(op == "-")
-  {
-    res = lhs - rhs;
-  }
-  else if(op == "*")
-  {
-    res = lhs * rhs;
-  }
-  else if(op == "/")
+
+  conduit::Node *cache = registry.fetch<conduit::Node>("field_stats");
+  const int cycle = *registry.fetch<int>("cycle");
+  const conduit::uint64 sig = field_signature(dataset, field);
+
+  bool local_hit = cache->has_child(field) &&
+                   (*cache)[field]["cycle"].to_int32() == cycle &&
+                   (*cache)[field]["signature"].to_uint64() == sig;
+
+  // computing the stats is a collective, so all ranks must agree
+  if(all_agree(local_hit))
   {
-    res = lhs / rhs;
+    return (*cache)[field]["stats"];
   }
-  else
+
+  // drop stats from previous cycles
+  std::vector<std::string> names = cache->child_names();
+  for(size_t i = 0; i < names.size(); ++i)
   {
-    ASCENT_ERROR("unknow math op "<<op);
+    if((*cache)[names[i]]["cycle"].to_int32() != cycle)
+    {
+      cache->remove(names[i]);
+    }
   }
-  return res;
+
+  conduit::Node &entry = (*cache)[field];
+  entry["cycle"] = cycle;
+  entry["signature"] = sig;
+  entry["stats"] = field_stats(dataset, field);
+  return entry["stats"];
 }
 
-template<typename T>
-int comp_op(const T& lhs, const T& rhs, const std::string &op)
+// runs the compiled expression implementation of a builtin on the
+// inputs of its flow filter (the function table keys builtins by
+// filter type name), so both evaluation paths give the same results
+void
+execute_builtin(flow::Filter &filter)
 {
-  int res;
-  if(op == "<")
+  const int num_args = filter.number_of_input_ports();
+  if(num_args > CompiledExpression::MAX_ARGS)
   {
-    res = lhs < rhs;
+    ASCENT_ERROR(filter.type_name()<<": too many arguments");
   }
-  else if(op == "<=")
-  {
-    res = lhs <= rhs;
-  }
-  else if(op == ">")
-  {
-    res = lhs > rhs;
-  }
-  else if(op == ">=")
+
+  ExprValue values[CompiledExpression::MAX_ARGS];
+  const ExprValue *args[CompiledExpression::MAX_ARGS];
+  for(int i = 0; i < num_args; ++i)
   {
-    res = lhs >= rhs;
+    // empty inputs come from null_arg (omitted optional arguments)
+    const conduit::Node *n_arg = filter.input<conduit::Node>(i);
+    if(!n_arg->dtype().is_empty())
+    {
+      values[i].from_node(*n_arg);
+    }
+    args[i] = &values[i];
   }
-  else if(op == "==")
+
+  flow::Registry &registry = filter.graph().workspace().registry();
+  ExprContext ctx;
+  ctx.m_dataset = nullptr;
+  ctx.m_cache = nullptr;
+  ctx.m_registry = &registry;
+  if(registry.has_entry("dataset"))
   {
-    res = lhs == rhs;
+    ctx.m_dataset = registry.fetch<conduit::Node>("dataset");
   }
-  else
+  if(registry.has_entry("cache"))
   {
-    ASCENT_ERROR("unknow comparison op "<<op);
+    ctx.m_cache = registry.fetch<conduit::Node>("cache");
   }
-  return res;
+
+  ExprValue res;
+  CompiledExpression::function(filter.type_name())(args, res, ctx);
+
+  conduit::Node *output = new conduit::Node();
+  res.to_node(*output);
+  filter.set_output<conduit::Node>(output);
 }
 
 } // namespace detail
@@ -476,9 +513,9 @@ BinaryOp::verify_params(const conduit::Node &params,
 {
     info.reset();
     bool res = true;
-    if(!params.has_path("op_string"))
+    if(!params.has_path("op"))
     {
-       info["errors"].append() = "Missing required string parameter 'op_string'";
+       info["errors"].append() = "Missing required numeric parameter 'op'";
        res = false;
     }
     return res;
@@ -489,100 +526,16 @@ BinaryOp::verify_params(const conduit::Node &params,
 void
 BinaryOp::execute()
 {
+  ExprValue lhs;
+  ExprValue rhs;
+  lhs.from_node(*input<Node>("lhs"));
+  rhs.from_node(*input<Node>("rhs"));
 
-  Node *n_lhs = input<Node>("lhs");
-  Node *n_rhs = input<Node>("rhs");
+  ExprValue res;
+  CompiledExpression::binary_op(params()["op"].to_int32(), lhs, rhs, res);
 
-  const Node &lhs = (*n_lhs)["value"];
-  const Node &rhs = (*n_rhs)["value"];
-
-  bool lhs_is_vector = false;
-  bool rhs_is_vector = false;
-
-  if((*n_lhs)["type"].as_string() == "vector")
-  {
-    lhs_is_vector = true;
-  }
-
-  if((*n_rhs)["type"].as_string() == "vector")
-  {
-    rhs_is_vector = true;
-  }
-
-  if((rhs_is_vector && !lhs_is_vector) ||
-     (!rhs_is_vector && lhs_is_vector))
-  {
-    ASCENT_ERROR("Mixed vector and scalar quantities not implemeneted / supported");
-  }
-
-  std::string op = params()["op_string"].as_string();
-  bool is_math = detail::is_math(op);
   conduit::Node *output = new conduit::Node();
-
-  if(rhs_is_vector && lhs_is_vector)
-  {
-    if(!is_math)
-    {
-      ASCENT_ERROR("Boolean operators on vectors no allowed");
-    }
-
-    double res[3];
-    detail::vector_op((*n_lhs)["value"].value(),
-                      (*n_rhs)["value"].value(),
-                      op,
-                      res);
-
-
-    (*output)["value"].set(res, 3);
-    (*output)["type"] = "vector";
-  }
-  else
-  {
-    bool has_float = false;
-
-    if(lhs.dtype().is_floating_point() ||
-       rhs.dtype().is_floating_point())
-    {
-      has_float = true;
-    }
-
-
-    // promote to double if at one is a double
-
-    if(has_float)
-    {
-      double d_rhs = rhs.to_float64();
-      double d_lhs = lhs.to_float64();
-      if(is_math)
-      {
-        (*output)["value"] = detail::math_op(d_lhs, d_rhs, op);
-        (*output)["type"] = "scalar";
-      }
-      else
-      {
-        (*output)["value"] = detail::comp_op(d_lhs, d_rhs, op);
-        (*output)["type"] = "boolean";
-      }
-    }
-    else
-    {
-      int i_rhs = rhs.to_int32();
-      int i_lhs = lhs.to_int32();
-      if(is_math)
-      {
-        (*output)["value"] = detail::math_op(i_lhs, i_rhs, op);
-        (*output)["type"] = "scalar";
-      }
-      else
-      {
-        (*output)["value"] = detail::comp_op(i_lhs, i_rhs, op);
-        (*output)["type"] = "boolean";
-      }
-    }
-  }
-
-  //std::cout<<" operation "<<op<<"\n";
-
+  res.to_node(*output);
   set_output<conduit::Node>(output);
 }
 
@@ -623,38 +576,8 @@ ScalarMin::verify_params(const conduit::Node &params,
 //-----------------------------------------------------------------------------
 void
 ScalarMin::execute()
-
 {
-
-  Node *arg1 = input<Node>("arg1");
-  Node *arg2 = input<Node>("arg2");
-
-
-  bool has_float = false;
-
-  if((*arg1)["value"].dtype().is_floating_point() ||
-     (*arg2)["value"].dtype().is_floating_point())
-  {
-    has_float = true;
-  }
-
-  conduit::Node *output = new conduit::Node();
-
-  if(has_float)
-  {
-    double d_rhs = (*arg1)["value"].to_float64();
-    double d_lhs = (*arg2)["value"].to_float64();
-    (*output)["value"] = std::min(d_lhs, d_rhs);
-  }
-  else
-  {
-    int i_rhs = (*arg1)["value"].to_int32();
-    int i_lhs = (*arg2)["value"].to_int32();
-    (*output)["value"] = std::min(i_lhs, i_rhs);
-  }
-
-  (*output)["type"] = "scalar";
-  set_output<conduit::Node>(output);
+  detail::execute_builtin(*this);
 }
 
 //-----------------------------------------------------------------------------
@@ -694,37 +617,8 @@ ScalarMax::verify_params(const conduit::Node &params,
 //-----------------------------------------------------------------------------
 void
 ScalarMax::execute()
-
 {
-
-  Node *arg1 = input<Node>("arg1");
-  Node *arg2 = input<Node>("arg2");
-
-  bool has_float = false;
-
-  if((*arg1)["value"].dtype().is_floating_point() ||
-     (*arg2)["value"].dtype().is_floating_point())
-  {
-    has_float = true;
-  }
-
-  conduit::Node *output = new conduit::Node();
-
-  if(has_float)
-  {
-    double d_rhs = (*arg1)["value"].to_float64();
-    double d_lhs = (*arg2)["value"].to_float64();
-    (*output)["value"] = std::max(d_lhs, d_rhs);
-  }
-  else
-  {
-    int i_rhs = (*arg1)["value"].to_int32();
-    int i_lhs = (*arg2)["value"].to_int32();
-    (*output)["value"] = std::max(i_lhs, i_rhs);
-  }
-
-  (*output)["type"] = "scalar";
-  set_output<conduit::Node>(output);
+  detail::execute_builtin(*this);
 }
 
 //-----------------------------------------------------------------------------
@@ -763,48 +657,8 @@ FieldMin::verify_params(const conduit::Node &params,
 //-----------------------------------------------------------------------------
 void
 FieldMin::execute()
-
 {
-
-  Node *arg1 = input<Node>("arg1");
-
-  const std::string field = (*arg1)["value"].as_string();
-
-  conduit::Node *output = new conduit::Node();
-
-  if(!graph().workspace().registry().has_entry("dataset"))
-  {
-    ASCENT_ERROR("FieldMin: Missing dataset");
-  }
-
-  conduit::Node *dataset = graph().workspace().registry().fetch<Node>("dataset");
-
-  if(!has_field(*dataset, field))
-  {
-    std::vector<std::string> names = dataset->child(0)["fields"].child_names();
-    std::stringstream ss;
-    ss<<"[";
-    for(int i = 0; i < names.size(); ++i)
-    {
-      ss<<" "<<names[i];
-    }
-    ss<<"]";
-    ASCENT_ERROR("FieldMin: dataset does not contain field '"<<field<<"'"
-                 <<" known = "<<ss.str());
-  }
-
-  if(!is_scalar_field(*dataset, field))
-  {
-    ASCENT_ERROR("FieldMin: field '"<<field<<"' is not a scalar");
-  }
-
-  conduit::Node n_min = field_min(*dataset, field);
-
-  (*output)["value"] = n_min["value"];
-  (*output)["type"] = "scalar";
-  (*output)["atts/position"] = n_min["position"];
-
-  set_output<conduit::Node>(output);
+  detail::execute_builtin(*this);
 }
 
 //-----------------------------------------------------------------------------
@@ -843,48 +697,8 @@ FieldMax::verify_params(const conduit::Node &params,
 //-----------------------------------------------------------------------------
 void
 FieldMax::execute()
-
 {
-
-  Node *arg1 = input<Node>("arg1");
-
-  const std::string field = (*arg1)["value"].as_string();
-
-  conduit::Node *output = new conduit::Node();
-
-  if(!graph().workspace().registry().has_entry("dataset"))
-  {
-    ASCENT_ERROR("FieldMax: Missing dataset");
-  }
-
-  conduit::Node *dataset = graph().workspace().registry().fetch<Node>("dataset");
-
-  if(!has_field(*dataset, field))
-  {
-    std::vector<std::string> names = dataset->child(0)["fields"].child_names();
-    std::stringstream ss;
-    ss<<"[";
-    for(int i = 0; i < names.size(); ++i)
-    {
-      ss<<" "<<names[i];
-    }
-    ss<<"]";
-    ASCENT_ERROR("FieldMax: dataset does not contain field '"<<field<<"'"
-                 <<" known = "<<ss.str());
-  }
-
-  if(!is_scalar_field(*dataset, field))
-  {
-    ASCENT_ERROR("FieldMax: field '"<<field<<"' is not a scalar");
-  }
-
-  conduit::Node n_max = field_max(*dataset, field);
-
-  (*output)["value"] = n_max["value"];
-  (*output)["type"] = "scalar";
-  (*output)["atts/position"] = n_max["position"];
-
-  set_output<conduit::Node>(output);
+  detail::execute_builtin(*this);
 }
 
 //-----------------------------------------------------------------------------
@@ -923,47 +737,8 @@ FieldAvg::verify_params(const conduit::Node &params,
 //-----------------------------------------------------------------------------
 void
 FieldAvg::execute()
-
 {
-
-  Node *arg1 = input<Node>("arg1");
-
-  const std::string field = (*arg1)["value"].as_string();
-
-  conduit::Node *output = new conduit::Node();
-
-  if(!graph().workspace().registry().has_entry("dataset"))
-  {
-    ASCENT_ERROR("FieldAvg: Missing dataset");
-  }
-
-  conduit::Node *dataset = graph().workspace().registry().fetch<Node>("dataset");
-
-  if(!has_field(*dataset, field))
-  {
-    std::vector<std::string> names = dataset->child(0)["fields"].child_names();
-    std::stringstream ss;
-    ss<<"[";
-    for(int i = 0; i < names.size(); ++i)
-    {
-      ss<<" "<<names[i];
-    }
-    ss<<"]";
-    ASCENT_ERROR("FieldAvg: dataset does not contain field '"<<field<<"'"
-                 <<" known = "<<ss.str());
-  }
-
-  if(!is_scalar_field(*dataset, field))
-  {
-    ASCENT_ERROR("FieldAvg: field '"<<field<<"' is not a scalar");
-  }
-
-  conduit::Node n_avg = field_avg(*dataset, field);
-
-  (*output)["value"] = n_avg["value"];
-  (*output)["type"] = "scalar";
-
-  set_output<conduit::Node>(output);
+  detail::execute_builtin(*this);
 }
 
 
@@ -1004,20 +779,7 @@ Position::verify_params(const conduit::Node &params,
 void
 Position::execute()
 {
-
-  Node *n_in = input<Node>("arg1");
-
-  if(!n_in->has_path("atts/position"))
-  {
-    ASCENT_ERROR("Position: input does not have 'position' attribute");
-  }
-
-  conduit::Node *output = new conduit::Node();
-
-  (*output)["value"] = (*n_in)["atts/position"];
-  (*output)["type"] = "vector";
-
-  set_output<conduit::Node>(output);
+  detail::execute_builtin(*this);
 }
 
 //-----------------------------------------------------------------------------
@@ -1056,26 +818,8 @@ Cycle::verify_params(const conduit::Node &params,
 //-----------------------------------------------------------------------------
 void
 Cycle::execute()
-
 {
-  conduit::Node *output = new conduit::Node();
-
-  if(!graph().workspace().registry().has_entry("dataset"))
-  {
-    ASCENT_ERROR("Cycle: Missing dataset");
-  }
-
-  conduit::Node *dataset = graph().workspace().registry().fetch<Node>("dataset");
-
-  conduit::Node state = get_state_var(*dataset, "cycle");
-  if(!state.dtype().is_number())
-  {
-    ASCENT_ERROR("Expressions: cycle() is not a number");
-  }
-
-  (*output)["type"] = "scalar";
-  (*output)["value"] = state;
-  set_output<conduit::Node>(output);
+  detail::execute_builtin(*this);
 }
 //-----------------------------------------------------------------------------
 Vector::Vector()
@@ -1115,29 +859,8 @@ Vector::verify_params(const conduit::Node &params,
 //-----------------------------------------------------------------------------
 void
 Vector::execute()
-
 {
-
-  Node *arg1 = input<Node>("arg1");
-  Node *arg2 = input<Node>("arg2");
-  Node *arg3 = input<Node>("arg3");
-
-  if( (*arg1)["type"].as_string() != "scalar" ||
-      (*arg2)["type"].as_string() != "scalar" ||
-      (*arg3)["type"].as_string() != "scalar")
-  {
-    ASCENT_ERROR("All components to vector constructor must be scalars");
-  }
-
-  double vec[3] = {0., 0., 0.};
-  vec[0] = (*arg1)["value"].to_float64();
-  vec[1] = (*arg2)["value"].to_float64();
-  vec[2] = (*arg3)["value"].to_float64();
-
-  conduit::Node *output = new conduit::Node();
-  (*output)["type"] = "vector";
-  (*output)["value"].set(vec,3);;
-  set_output<conduit::Node>(output);
+  detail::execute_builtin(*this);
 }
 
 //-----------------------------------------------------------------------------
@@ -1176,23 +899,8 @@ Magnitude::verify_params(const conduit::Node &params,
 //-----------------------------------------------------------------------------
 void
 Magnitude::execute()
-
 {
-
-  Node *arg1 = input<Node>("arg1");
-
-  if( (*arg1)["type"].as_string() != "vector")
-  {
-    ASCENT_ERROR("Magnitude input must be a vector");
-  }
-
-  double res = 0.;
-  const double *vec = (*arg1)["value"].value();
-  res = sqrt(vec[0] * vec[0] + vec[1] * vec[1] + vec[2] * vec[2]);
-  conduit::Node *output = new conduit::Node();
-  (*output)["type"] = "scalar";
-  (*output)["value"] = res;
-  set_output<conduit::Node>(output);
+  detail::execute_builtin(*this);
 }
 
 //-----------------------------------------------------------------------------
@@ -1233,78 +941,8 @@ Histogram::verify_params(const conduit::Node &params,
 //-----------------------------------------------------------------------------
 void
 Histogram::execute()
-
 {
-
-  Node *arg1 = input<Node>("arg1");
-  // optional inputs
-  const Node *n_bins = input<Node>("num_bins");
-  const Node *n_max = input<Node>("max_val");
-  const Node *n_min = input<Node>("min_val");
-
-  if( (*arg1)["type"].as_string() != "meshvar")
-  {
-    ASCENT_ERROR("Histogram: input must be a meshvar");
-  }
-
-  const std::string field = (*arg1)["value"].as_string();
-
-  conduit::Node *dataset = graph().workspace().registry().fetch<Node>("dataset");
-
-  if(!has_field(*dataset, field))
-  {
-    std::vector<std::string> names = dataset->child(0)["fields"].child_names();
-    std::stringstream ss;
-    ss<<"[";
-    for(int i = 0; i < names.size(); ++i)
-    {
-      ss<<" "<<names[i];
-    }
-    ss<<"]";
-    ASCENT_ERROR("Histogram: dataset does not contain field '"<<field<<"'"
-                 <<" known = "<<ss.str());
-  }
-
-  int num_bins = 256;
-  if(!n_bins->dtype().is_empty())
-  {
-    num_bins = (*n_bins)["value"].to_int32();
-  }
-
-  double min_val;
-  double max_val;
-
-  // handle the optional inputs
-  if(!n_max->dtype().is_empty())
-  {
-    max_val = (*n_max)["value"].to_float64();
-  }
-  else
-  {
-    max_val = field_max(*dataset, field)["value"].to_float64();
-  }
-
-  if(!n_min->dtype().is_empty())
-  {
-    min_val = (*n_min)["value"].to_float64();
-  }
-  else
-  {
-    min_val = field_min(*dataset, field)["value"].to_float64();
-  }
-
-  if(min_val >=  max_val)
-  {
-    ASCENT_ERROR("Histogram: min value ("<<min_val<<") must be smaller than max ("<<max_val<<")");
-  }
-
-  conduit::Node *output = new conduit::Node();
-  (*output)["value"] = field_histogram(*dataset, field, min_val, max_val, num_bins)["value"];
-  (*output)["type"] = "histogram";
-  (*output)["min_val"] = min_val;
-  (*output)["max_val"] = max_val;
-  (*output)["num_bins"] = num_bins;
-  set_output<conduit::Node>(output);
+  detail::execute_builtin(*this);
 }
 
 };
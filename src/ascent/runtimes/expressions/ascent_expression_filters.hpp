@@ -55,6 +55,7 @@
 #include <ascent.hpp>
 
 #include <flow_filter.hpp>
+#include <flow_registry.hpp>
 
 
 //-----------------------------------------------------------------------------
@@ -81,6 +82,16 @@ namespace expressions
 ///
 //-----------------------------------------------------------------------------
 
+namespace detail
+{
+// field stats shared by all expressions that reference the same field
+// during a cycle. The registry needs "field_stats" and "cycle" entries,
+// otherwise the stats are computed every call.
+conduit::Node cached_field_stats(flow::Registry &registry,
+                                 const conduit::Node &dataset,
+                                 const std::string &field);
+}
+
 //-----------------------------------------------------------------------------
 class NullArg : public ::flow::Filter
 {
@@ -1,6 +1,8 @@
 #include "ast.hpp"
 //#include "codegen.h"
 #include "parser.hpp"
+#include "ascent_compiled_expression.hpp"
+#include "ascent_derived_field.hpp"
 #include <typeinfo>
 
 //-----------------------------------------------------------------------------
@@ -65,6 +67,83 @@ std::string print_match_error(const std::string &fname,
   return ss.str();
 
 }
+
+// returns the index of the overload that matches the argument
+// types or -1 if none does
+int match_overload(const std::vector<conduit::Node> &arg_list,
+                   const conduit::Node &overload_list)
+{
+  int matched_index = -1;
+  for(int i = 0; i < overload_list.number_of_children(); ++i)
+  {
+    const conduit::Node &func = overload_list.child(i);
+    bool valid = false;
+    int total_args = 0;
+
+    if(func.has_path("args"))
+    {
+      total_args = func["args"].number_of_children();
+    }
+
+    //const int opt_args = func["opt_cout"].to_int32();
+    const int req_args = func["req_count"].to_int32();
+
+    const int arg_size = arg_list.size();
+    if(arg_size >= req_args && arg_size <= total_args)
+    {
+      valid = true;
+      // validate the types
+      for(int a = 0; a < arg_size; ++a)
+      {
+        if(arg_list[a]["type"].as_string() != func["args"].child(a)["type"].as_string())
+        {
+          valid = false;
+        }
+      }
+    }
+
+    if(valid)
+    {
+      matched_index = i;
+    }
+  }
+  return matched_index;
+}
+
+std::string op_string(const int op)
+{
+  std::string op_str;
+  switch (op)
+  {
+    case TPLUS:   op_str = "+"; break;
+    case TMINUS:  op_str = "-"; break;
+    case TMUL:    op_str = "*"; break;
+    case TDIV:    op_str = "/"; break;
+    case TCEQ:    op_str = "=="; break;
+    case TCNE:    op_str = "!="; break;
+    case TCLE:    op_str = "<="; break;
+    case TCGE:    op_str = ">="; break;
+    case TCGT:    op_str = ">"; break;
+    case TCLT:    op_str = "<"; break;
+    default: std::cout<<"unknown binary op "<<op<<"\n";
+
+  }
+  return op_str;
+}
+
+// strip the quotes from a mesh variable name
+std::string strip_quotes(const std::string &name)
+{
+  std::string stripped = name;
+  int pos = stripped.find("\"");
+  while (pos != std::string::npos)
+  {
+    stripped.erase(pos,1);
+    pos = stripped.find("\"");
+  }
+  return stripped;
+}
+
 } // namespace detail
 void ASTInteger::access()
 {
@@ -200,40 +279,7 @@ conduit::Node ASTMethodCall::build_graph(flow::Workspace &w)
   // resolve overloaded function names
   const conduit::Node &overload_list = (*f_table)[m_id->m_name];
 
-  int matched_index = -1;
-  for(int i = 0; i < overload_list.number_of_children(); ++i)
-  {
-    const conduit::Node &func = overload_list.child(i);
-    bool valid = false;
-    int total_args = 0;
-
-    if(func.has_path("args"))
-    {
-      total_args = func["args"].number_of_children();
-    }
-
-    //const int opt_args = func["opt_cout"].to_int32();
-    const int req_args = func["req_count"].to_int32();
-
-    const int arg_size = arg_list.size();
-    if(arg_size >= req_args && arg_size <= total_args)
-    {
-      valid = true;
-      // validate the types
-      for(int a = 0; a < arg_size; ++a)
-      {
-        if(arg_list[a]["type"].as_string() != func["args"].child(a)["type"].as_string())
-        {
-          valid = false;
-        }
-      }
-    }
-
-    if(valid)
-    {
-      matched_index = i;
-    }
-  }
+  int matched_index = detail::match_overload(arg_list, overload_list);
 
   conduit::Node res;
 
@@ -334,22 +380,6 @@ void ASTBinaryOp::access()
 conduit::Node ASTBinaryOp::build_graph(flow::Workspace &w)
 {
   //std::cout << "Creating binary operation " << m_op << endl;
-  std::string op_str;
-  switch (m_op)
-  {
-    case TPLUS:   op_str = "+"; break;
-    case TMINUS:  op_str = "-"; break;
-    case TMUL:    op_str = "*"; break;
-    case TDIV:    op_str = "/"; break;
-    case TCEQ:    op_str = "=="; break;
-    case TCNE:    op_str = "!="; break;
-    case TCLE:    op_str = "<="; break;
-    case TCGE:    op_str = ">="; break;
-    case TCGT:    op_str = ">"; break;
-    case TCLT:    op_str = "<"; break;
-    default: std::cout<<"unknown binary op "<<m_op<<"\n";
-
-  }
 
   conduit::Node r_in = m_rhs->build_graph(w);
   //std::cout<<" flow op "<<op_str<<"\n";
@@ -382,7 +412,7 @@ conduit::Node ASTBinaryOp::build_graph(flow::Workspace &w)
   std::string name = ss.str();
 
   conduit::Node params;
-  params["op_string"] = op_str;
+  params["op"] = m_op;
 
   w.graph().add_filter("expr_binary_op",
                        name,
@@ -408,13 +438,7 @@ conduit::Node ASTMeshVar::build_graph(flow::Workspace &w)
 {
 
   // strip the quotes from the variable name
-  std::string stripped = m_name;
-  int pos = stripped.find("\"");
-  while (pos != std::string::npos)
-  {
-    stripped.erase(pos,1);
-    pos = stripped.find("\"");
-  }
+  const std::string stripped = detail::strip_quotes(m_name);
 
   //std::cout << "Flow mesh var " << m_name << " "<< stripped <<endl;
   // create a unique name for the filter
@@ -437,3 +461,147 @@ conduit::Node ASTMeshVar::build_graph(flow::Workspace &w)
 
   return res;
 }
+
+//-----------------------------------------------------------------------------
+// lowering to compiled expressions
+//-----------------------------------------------------------------------------
+using ascent::runtime::expressions::CompiledExpression;
+using ascent::runtime::expressions::ExprValue;
+using ascent::runtime::expressions::DerivedFieldProgram;
+
+int ASTInteger::compile(CompiledExpression &program)
+{
+  ExprValue value;
+  value.set_int(m_value);
+  return program.add_constant(value, "scalar");
+}
+
+int ASTDouble::compile(CompiledExpression &program)
+{
+  ExprValue value;
+  value.set_double(m_value);
+  return program.add_constant(value, "scalar");
+}
+
+int ASTIdentifier::compile(CompiledExpression &program)
+{
+  return program.add_identifier(m_name);
+}
+
+int ASTMeshVar::compile(CompiledExpression &program)
+{
+  ExprValue value;
+  value.set_meshvar(detail::strip_quotes(m_name));
+  return program.add_constant(value, "meshvar");
+}
+
+int ASTMethodCall::compile(CompiledExpression &program)
+{
+  const size_t size = arguments->size();
+  std::vector<conduit::Node> arg_list;
+  std::vector<int> arg_regs;
+  arg_list.resize(size);
+  arg_regs.resize(size);
+  for(size_t i = 0; i < size; ++i)
+  {
+    arg_regs[i] = (*arguments)[i]->compile(program);
+    arg_list[i]["type"] = program.type(arg_regs[i]);
+  }
+
+  const conduit::Node &f_table = program.function_table();
+  // resolve the function
+  if(!f_table.has_path(m_id->m_name))
+  {
+    ASCENT_ERROR("unknown function "<<m_id->m_name);
+  }
+
+  // resolve overloaded function names
+  const conduit::Node &overload_list = f_table[m_id->m_name];
+  const int matched_index = detail::match_overload(arg_list, overload_list);
+
+  if(matched_index == -1)
+  {
+    ASCENT_ERROR( detail::print_match_error(m_id->m_name,
+                                            arg_list,
+                                            overload_list));
+  }
+
+  const conduit::Node &func = overload_list.child(matched_index);
+
+  // omitted optional parameters read the null register
+  const int total_args = func["args"].number_of_children();
+  for(int a = size; a < total_args; ++a)
+  {
+    arg_regs.push_back(program.null_arg());
+  }
+
+  return program.add_call(func["filter_name"].as_string(),
+                          arg_regs,
+                          func["return_type"].as_string());
+}
+
+int ASTBinaryOp::compile(CompiledExpression &program)
+{
+  const int rhs = m_rhs->compile(program);
+  const int lhs = m_lhs->compile(program);
+
+  // Validate types
+  const std::string l_type = program.type(lhs);
+  const std::string r_type = program.type(rhs);
+  if(l_type == "meshvar" || r_type == "meshvar")
+  {
+    std::stringstream msg;
+    msg<<"' "<<l_type<<" "<<detail::op_string(m_op)<<" "<<r_type<<"'";
+    ASCENT_ERROR("binary operation with mesh variable not supported: "<<msg.str());
+  }
+
+  std::string res_type = "scalar";
+  if(l_type == "vector" && r_type == "vector")
+  {
+    res_type = "vector";
+  }
+
+  return program.add_binary_op(m_op, lhs, rhs, res_type);
+}
+
+//-----------------------------------------------------------------------------
+// lowering to element-wise derived fields
+//-----------------------------------------------------------------------------
+int ASTInteger::compile_field(DerivedFieldProgram &program)
+{
+  return program.add_constant(m_value);
+}
+
+int ASTDouble::compile_field(DerivedFieldProgram &program)
+{
+  return program.add_constant(m_value);
+}
+
+int ASTIdentifier::compile_field(DerivedFieldProgram &program)
+{
+  return program.add_identifier(m_name);
+}
+
+int ASTMeshVar::compile_field(DerivedFieldProgram &program)
+{
+  return program.add_field(detail::strip_quotes(m_name));
+}
+
+int ASTMethodCall::compile_field(DerivedFieldProgram &program)
+{
+  const size_t size = arguments->size();
+  std::vector<int> arg_regs;
+  arg_regs.resize(size);
+  for(size_t i = 0; i < size; ++i)
+  {
+    arg_regs[i] = (*arguments)[i]->compile_field(program);
+  }
+  return program.add_function(m_id->m_name, arg_regs);
+}
+
+int ASTBinaryOp::compile_field(DerivedFieldProgram &program)
+{
+  const int rhs = m_rhs->compile_field(program);
+  const int lhs = m_lhs->compile_field(program);
+  return program.add_binary_op(m_op, lhs, rhs);
+}
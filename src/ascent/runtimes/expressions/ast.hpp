@@ -6,6 +6,18 @@
 
 class ASTExpression;
 
+namespace ascent
+{
+namespace runtime
+{
+namespace expressions
+{
+class CompiledExpression;
+class DerivedFieldProgram;
+}
+}
+}
+
 typedef std::vector<ASTExpression*> ExpressionList;
 
 class ASTNode {
@@ -17,6 +29,16 @@ public:
                                          conduit::Node res;
                                          return res;
                                      }
+  // lowers the node into program and returns its result register
+  virtual int compile(ascent::runtime::expressions::CompiledExpression &program)
+                                     {
+                                         return -1;
+                                     }
+  // lowers the node into an element-wise program over mesh fields
+  virtual int compile_field(ascent::runtime::expressions::DerivedFieldProgram &program)
+                                     {
+                                         return -1;
+                                     }
 };
 
 class ASTExpression : public ASTNode {
@@ -28,6 +50,8 @@ public:
   ASTInteger(int value) : m_value(value) { }
   virtual void access();
   virtual conduit::Node build_graph(flow::Workspace &w);
+  virtual int compile(ascent::runtime::expressions::CompiledExpression &program);
+  virtual int compile_field(ascent::runtime::expressions::DerivedFieldProgram &program);
 };
 
 class ASTDouble : public ASTExpression {
@@ -36,6 +60,8 @@ public:
   ASTDouble(double value) : m_value(value) { }
   virtual void access();
   virtual conduit::Node build_graph(flow::Workspace &w);
+  virtual int compile(ascent::runtime::expressions::CompiledExpression &program);
+  virtual int compile_field(ascent::runtime::expressions::DerivedFieldProgram &program);
 };
 
 class ASTIdentifier : public ASTExpression {
@@ -44,6 +70,8 @@ public:
   ASTIdentifier(const std::string& name) : m_name(name) { }
   virtual void access();
   virtual conduit::Node build_graph(flow::Workspace &w);
+  virtual int compile(ascent::runtime::expressions::CompiledExpression &program);
+  virtual int compile_field(ascent::runtime::expressions::DerivedFieldProgram &program);
 };
 
 class ASTMeshVar: public ASTExpression
@@ -53,6 +81,8 @@ public:
   ASTMeshVar(const std::string& name) : m_name(name) { }
   virtual void access();
   virtual conduit::Node build_graph(flow::Workspace &w);
+  virtual int compile(ascent::runtime::expressions::CompiledExpression &program);
+  virtual int compile_field(ascent::runtime::expressions::DerivedFieldProgram &program);
 };
 
 class ASTMethodCall : public ASTExpression {
@@ -64,6 +94,8 @@ public:
   ASTMethodCall(ASTIdentifier *id) : m_id(id) { }
   virtual void access();
   virtual conduit::Node build_graph(flow::Workspace &w);
+  virtual int compile(ascent::runtime::expressions::CompiledExpression &program);
+  virtual int compile_field(ascent::runtime::expressions::DerivedFieldProgram &program);
 
   virtual ~ASTMethodCall()
   {
@@ -86,6 +118,8 @@ public:
     m_lhs(lhs), m_rhs(rhs), m_op(op) { }
   virtual void access();
   virtual conduit::Node build_graph(flow::Workspace &w);
+  virtual int compile(ascent::runtime::expressions::CompiledExpression &program);
+  virtual int compile_field(ascent::runtime::expressions::DerivedFieldProgram &program);
   virtual ~ASTBinaryOp()
   {
     delete m_lhs;
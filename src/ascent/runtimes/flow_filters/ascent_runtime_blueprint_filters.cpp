@@ -55,6 +55,9 @@
 // thirdparty includes
 //-----------------------------------------------------------------------------
 
+// std includes
+#include <functional>
+
 // conduit includes
 #include <conduit.hpp>
 #include <conduit_relay.hpp>
@@ -108,6 +111,192 @@ namespace runtime
 namespace filters
 {
 
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::filters::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// signature of a sub-tree: its schema and the addresses of its arrays
+//-----------------------------------------------------------------------------
+uint64
+tree_signature(const Node &n)
+{
+    size_t sig = std::hash<std::string>()(n.schema().to_json());
+    flow::hash_leaf_pointers(n, sig);
+    return (uint64) sig;
+}
+
+//-----------------------------------------------------------------------------
+// verifies a single domain, only fields that changed since the last
+// successful verify are checked as long as everything else (coordsets,
+// topologies, matsets, ...) is unchanged. Updates sigs on success.
+//-----------------------------------------------------------------------------
+bool
+incremental_verify_domain(const Node &dom,
+                          Node &sigs,
+                          Node &info)
+{
+    // state holds per cycle values (cycle, time, ...), the rest
+    // of the tree is covered by the signatures. signatures only see
+    // schemas and array addresses, so data changed in place is only
+    // re-verified when the simulation bumps state/generation
+    uint64 generation = 0;
+    if(dom.has_path("state/generation"))
+    {
+        generation = dom["state/generation"].to_uint64();
+    }
+
+    uint64 mesh_sig = generation;
+    const index_t num_children = dom.number_of_children();
+    for(index_t i = 0; i < num_children; ++i)
+    {
+        const Node &child = dom.child(i);
+        if(child.name() != "fields" && child.name() != "state")
+        {
+            mesh_sig = mesh_sig * 31 + tree_signature(child);
+        }
+    }
+
+    Node field_sigs;
+    if(dom.has_child("fields"))
+    {
+        const Node &fields = dom["fields"];
+        for(index_t i = 0; i < fields.number_of_children(); ++i)
+        {
+            field_sigs[fields.child(i).name()] =
+                tree_signature(fields.child(i)) * 31 + generation;
+        }
+    }
+
+    if(!sigs.has_child("mesh") || sigs["mesh"].to_uint64() != mesh_sig)
+    {
+        if(!conduit::blueprint::mesh::verify(dom, info))
+        {
+            sigs.reset();
+            return false;
+        }
+    }
+    else if(dom.has_child("fields"))
+    {
+        const Node &fields = dom["fields"];
+        for(index_t i = 0; i < fields.number_of_children(); ++i)
+        {
+            const Node &field = fields.child(i);
+            const std::string f_name = field.name();
+
+            if(sigs["fields"].has_child(f_name) &&
+               sigs["fields"][f_name].to_uint64() == field_sigs[f_name].to_uint64())
+            {
+                continue;
+            }
+
+            if(!conduit::blueprint::mesh::field::verify(field, info[f_name]))
+            {
+                sigs.reset();
+                return false;
+            }
+
+            // the full mesh verify also checks references
+            if(field.has_child("topology") &&
+               !(dom.has_child("topologies") &&
+                 dom["topologies"].has_child(field["topology"].as_string())))
+            {
+                info[f_name]["errors"].append() = "field references a topology "
+                                                  "that does not exist";
+                sigs.reset();
+                return false;
+            }
+        }
+    }
+
+    sigs.reset();
+    sigs["mesh"] = mesh_sig;
+    sigs["fields"].set(field_sigs);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// verifies a blueprint mesh using the signatures in cache to skip data
+// that already passed verify.
+//
+//  mode:
+//   "incremental" only re-verify sub-trees whose schema or data changed
+//   "first_cycle" verify once, skip verify afterwards
+//-----------------------------------------------------------------------------
+bool
+cached_mesh_verify(const Node &mesh,
+                   const std::string &mode,
+                   Node &cache,
+                   Node &info)
+{
+    if(mode == "first_cycle")
+    {
+        if(cache.has_child("verified"))
+        {
+            return true;
+        }
+
+        bool res = conduit::blueprint::verify("mesh", mesh, info);
+        if(res)
+        {
+            cache["verified"] = 1;
+        }
+        return res;
+    }
+
+    const bool multi_domain = conduit::blueprint::mesh::is_multi_domain(mesh);
+    const index_t num_domains = multi_domain ? mesh.number_of_children() : 1;
+
+    Node &domains = cache["domains"];
+    if(domains.number_of_children() != num_domains)
+    {
+        // the domain decomposition changed, start over
+        domains.reset();
+        for(index_t i = 0; i < num_domains; ++i)
+        {
+            domains.append();
+        }
+    }
+
+    bool res = true;
+    for(index_t i = 0; i < num_domains && res; ++i)
+    {
+        const Node &dom = multi_domain ? mesh.child(i) : mesh;
+        res = incremental_verify_domain(dom, domains.child(i), info);
+    }
+
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+// checks the optional 'verify' param used by filters that verify input
+//-----------------------------------------------------------------------------
+bool
+check_verify_mode(const Node &params, Node &info)
+{
+    if( params.has_child("verify") )
+    {
+        if(! params["verify"].dtype().is_string() ||
+           (params["verify"].as_string() != "incremental" &&
+            params["verify"].as_string() != "first_cycle" &&
+            params["verify"].as_string() != "always"))
+        {
+            info["errors"].append() = "Optional parameter 'verify' must be "
+                                      "one of {\"incremental\", "
+                                      "\"first_cycle\", \"always\"}";
+            return false;
+        }
+    }
+    return true;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::filters::detail --
+//-----------------------------------------------------------------------------
+
 
 //-----------------------------------------------------------------------------
 BlueprintVerify::BlueprintVerify()
@@ -129,6 +318,7 @@ BlueprintVerify::declare_interface(Node &i)
     i["type_name"]   = "blueprint_verify";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["cacheable"]   = "true";
 }
 
 //-----------------------------------------------------------------------------
@@ -145,6 +335,8 @@ BlueprintVerify::verify_params(const conduit::Node &params,
         info["errors"].append() = "Missing required string parameter 'protocol'";
     }
 
+    res = detail::check_verify_mode(params, info) && res;
+
     return res;
 }
 
@@ -160,6 +352,22 @@ BlueprintVerify::execute()
 
     std::string protocol = params()["protocol"].as_string();
 
+    // mesh verify results can be reused across cycles if the
+    // runtime provides a cache for them
+    std::string mode = "always";
+    if(params().has_child("verify"))
+    {
+        mode = params()["verify"].as_string();
+    }
+
+    Node *v_cache = NULL;
+    if(protocol == "mesh" && mode != "always" &&
+       graph().workspace().registry().has_entry("verify_cache"))
+    {
+        Node *cache = graph().workspace().registry().fetch<Node>("verify_cache");
+        v_cache = &(*cache)[name()];
+    }
+
     Node v_info;
     Node *n_input = input<Node>(0);
     
@@ -169,9 +377,22 @@ BlueprintVerify::execute()
     int local_verify_ok = 0;
     if(!n_input->dtype().is_empty())
     {
-        if(!conduit::blueprint::verify(protocol,
-                                       *n_input,
-                                       v_info))
+        bool verify_ok = false;
+        if(v_cache != NULL)
+        {
+            verify_ok = detail::cached_mesh_verify(*n_input,
+                                                   mode,
+                                                   *v_cache,
+                                                   v_info);
+        }
+        else
+        {
+            verify_ok = conduit::blueprint::verify(protocol,
+                                                   *n_input,
+                                                   v_info);
+        }
+
+        if(!verify_ok)
         {
             n_input->schema().print();
             v_info.print();
@@ -329,6 +550,15 @@ EnsureBlueprint::declare_interface(Node &i)
     i["output_port"] = "true";
 }
 
+//-----------------------------------------------------------------------------
+bool
+EnsureBlueprint::verify_params(const conduit::Node &params,
+                               conduit::Node &info)
+{
+    info.reset();
+    return detail::check_verify_mode(params, info);
+}
+
 //-----------------------------------------------------------------------------
 void
 EnsureBlueprint::execute()
@@ -338,7 +568,27 @@ EnsureBlueprint::execute()
         // our data is already a node, pass though
         conduit::Node *res = input<Node>(0);
         conduit::Node info;
-        bool success = conduit::blueprint::verify("mesh",*res,info);
+        bool success = false;
+
+        std::string mode = "always";
+        if(params().has_child("verify"))
+        {
+            mode = params()["verify"].as_string();
+        }
+
+        if(mode != "always" &&
+           graph().workspace().registry().has_entry("verify_cache"))
+        {
+            Node *cache = graph().workspace().registry().fetch<Node>("verify_cache");
+            success = detail::cached_mesh_verify(*res,
+                                                 mode,
+                                                 (*cache)[name()],
+                                                 info);
+        }
+        else
+        {
+            success = conduit::blueprint::verify("mesh",*res,info);
+        }
 
         if(!success)
         {
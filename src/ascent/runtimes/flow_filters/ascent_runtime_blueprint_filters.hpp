@@ -118,6 +118,8 @@ public:
     virtual ~EnsureBlueprint();
 
     virtual void   declare_interface(conduit::Node &i);
+    virtual bool   verify_params(const conduit::Node &params,
+                                 conduit::Node &info);
     virtual void   execute();
 };
 
@@ -135,6 +135,25 @@ HolaMPIExtract::verify_params(const conduit::Node &params,
         info["errors"].append() = "Missing required integer parameter 'rank_split'";
     }
 
+    if( params.has_child("balance") )
+    {
+        if( !params["balance"].dtype().is_string() )
+        {
+            info["errors"].append() = "optional entry 'balance' must be a string";
+            res = false;
+        }
+        else
+        {
+            const std::string balance = params["balance"].as_string();
+            if(balance != "bytes" && balance != "cells" && balance != "domains")
+            {
+                info["errors"].append() = "optional entry 'balance' must be"
+                                          " 'bytes', 'cells' or 'domains'";
+                res = false;
+            }
+        }
+    }
+
     return res;
 }
 
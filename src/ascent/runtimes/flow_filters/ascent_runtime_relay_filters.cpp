@@ -65,6 +65,7 @@
 //-----------------------------------------------------------------------------
 #include <ascent_logging.hpp>
 #include <ascent_file_system.hpp>
+#include <ascent_hdf5_lock.hpp>
 
 #include <flow_graph.hpp>
 #include <flow_workspace.hpp>
@@ -77,8 +78,15 @@
 #endif
 
 // std includes
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <vector>
 
 using namespace std;
 using namespace conduit;
@@ -280,6 +288,220 @@ void filter_fields(const conduit::Node &input,
   }
 
 }
+
+// mpi tag for domains sent to a file aggregator
+const int AGGREGATE_TAG = 4242;
+
+//
+// ranks are split into num_files contiguous groups, one file per group
+//
+int file_group(const int rank, const int par_size, const int num_files)
+{
+  return static_cast<int>((static_cast<long long>(rank) * num_files) / par_size);
+}
+
+//
+// files holds a list of {path, protocol, data} entries. An empty
+// protocol lets relay pick one from the file extension.
+//
+conduit::Node &add_file(conduit::Node &files,
+                        const conduit::Node &data,
+                        const std::string &path,
+                        const std::string &protocol)
+{
+  conduit::Node &file = files.append();
+  file["path"] = path;
+  file["protocol"] = protocol;
+  file["data"].set_external(data);
+  return file["data"];
+}
+
+void save_files(const conduit::Node &files)
+{
+  const int num_files = files.number_of_children();
+  for(int i = 0; i < num_files; ++i)
+  {
+    const conduit::Node &file = files.child(i);
+    const std::string path = file["path"].as_string();
+    const std::string protocol = file["protocol"].as_string();
+    // writes can run next to hola reads or the asynchronous writer
+    std::unique_lock<std::mutex> lock(hdf5_mutex(), std::defer_lock);
+    if(uses_hdf5(path, protocol))
+    {
+      lock.lock();
+    }
+    if(protocol.empty())
+    {
+      relay::io::save(file["data"], path);
+    }
+    else
+    {
+      relay::io::save(file["data"], path, protocol);
+    }
+  }
+}
+
+//
+// Writes extracts on a background thread. Each write snapshots the
+// files into a staging node, so the simulation can change its data as
+// soon as write returns. Staging nodes are reused once written, and
+// their memory is reused when the next snapshot has the same layout.
+//
+// Only file writes happen on the writer thread. Everything that needs
+// MPI (cycle, directories, the root index) is done before the write.
+// hdf5 writes hold the process-wide hdf5 lock (see save_files).
+//
+class AsyncWriter
+{
+public:
+  static AsyncWriter &instance()
+  {
+    static AsyncWriter writer;
+    return writer;
+  }
+
+  // waits while max_in_flight writes are queued or being written
+  void write(const conduit::Node &files, const int max_in_flight)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_written.wait(lock, [&]()
+    {
+      return static_cast<int>(m_queue.size()) + m_busy < std::max(max_in_flight, 1);
+    });
+    check_error(lock);
+
+    std::shared_ptr<conduit::Node> staging;
+    if(m_pool.empty())
+    {
+      staging = std::make_shared<conduit::Node>();
+    }
+    else
+    {
+      staging = m_pool.back();
+      m_pool.pop_back();
+    }
+
+    // copy without holding the lock so the writer keeps writing
+    lock.unlock();
+    conduit::Schema layout;
+    files.schema().compact_to(layout);
+    if(staging->schema().equals(layout))
+    {
+      staging->update_compatible(files);
+    }
+    else
+    {
+      staging->set(files);
+    }
+    lock.lock();
+
+    m_queue.push_back(staging);
+    if(!m_thread.joinable())
+    {
+      m_thread = std::thread(&AsyncWriter::run, this);
+    }
+    m_queued.notify_one();
+  }
+
+  // waits until everything queued is written
+  void flush()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_written.wait(lock, [&]()
+    {
+      return m_queue.empty() && m_busy == 0;
+    });
+    check_error(lock);
+  }
+
+  ~AsyncWriter()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_queued.notify_one();
+    if(m_thread.joinable())
+    {
+      m_thread.join();
+    }
+  }
+
+private:
+  AsyncWriter()
+    : m_busy(0),
+      m_stop(false)
+  {}
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while(true)
+    {
+      m_queued.wait(lock, [&]()
+      {
+        return m_stop || !m_queue.empty();
+      });
+      // drain the queue before stopping
+      if(m_queue.empty())
+      {
+        break;
+      }
+
+      std::shared_ptr<conduit::Node> files = m_queue.front();
+      m_queue.pop_front();
+      m_busy = 1;
+      lock.unlock();
+
+      std::string error;
+      try
+      {
+        save_files(*files);
+      }
+      catch(conduit::Error &e)
+      {
+        error = e.message();
+      }
+      catch(std::exception &e)
+      {
+        error = e.what();
+      }
+
+      lock.lock();
+      if(!error.empty() && m_error.empty())
+      {
+        m_error = error;
+      }
+      m_busy = 0;
+      m_pool.push_back(files);
+      m_written.notify_all();
+    }
+  }
+
+  // reports the first failed background write on the calling thread
+  void check_error(std::unique_lock<std::mutex> &lock)
+  {
+    if(m_error.empty())
+    {
+      return;
+    }
+    std::string error = m_error;
+    m_error.clear();
+    lock.unlock();
+    ASCENT_ERROR("Relay: asynchronous extract failed: "<<error);
+  }
+
+  std::mutex                                  m_mutex;
+  std::condition_variable                     m_queued;
+  std::condition_variable                     m_written;
+  std::deque<std::shared_ptr<conduit::Node>>  m_queue;
+  std::vector<std::shared_ptr<conduit::Node>> m_pool;
+  std::thread                                 m_thread;
+  int                                         m_busy;
+  bool                                        m_stop;
+  std::string                                 m_error;
+};
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
@@ -330,14 +552,39 @@ verify_io_params(const conduit::Node &params,
         }
     }
 
+    if( params.has_child("async") &&
+        !params["async"].dtype().is_string() )
+    {
+        info["errors"].append() = "optional entry 'async' must be a string ('true' or 'false')";
+        res = false;
+    }
+
+    if( params.has_child("max_in_flight") &&
+        !params["max_in_flight"].dtype().is_number() )
+    {
+        info["errors"].append() = "optional entry 'max_in_flight' must be a number";
+        res = false;
+    }
+
+    if( params.has_child("num_files") &&
+        !params["num_files"].dtype().is_number() )
+    {
+        info["errors"].append() = "optional entry 'num_files' must be a number";
+        res = false;
+    }
+
     return res;
 }
 
 
+//-----------------------------------------------------------------------------
+// collects the files to write in files, they are written by the caller
 //-----------------------------------------------------------------------------
 void mesh_blueprint_save(const Node &data,
                          const std::string &path,
-                         const std::string &file_protocol)
+                         const std::string &file_protocol,
+                         const int requested_files,
+                         Node &files)
 {
     // The assumption here is that everything is multi domain
 
@@ -460,43 +707,143 @@ void mesh_blueprint_save(const Node &data,
     {
         ASCENT_ERROR("Error: failed to create directory " << output_dir);
     }
-    // write out each domain
-    for(int i = 0; i < num_domains; ++i)
-    {
-        const Node &dom = multi_dom.child(i);
-        uint64 domain = dom["state/domain_id"].to_uint64();
+    // domains per rank, used to find the root writer and to place
+    // domains in aggregated files
+    std::vector<int> rank_domains(par_size, num_domains);
+#ifdef ASCENT_MPI_ENABLED
+    MPI_Allgather(&num_domains, 1, MPI_INT,
+                  &rank_domains[0], 1, MPI_INT,
+                  mpi_comm);
+#endif
 
-        snprintf(fmt_buff, sizeof(fmt_buff), "%06llu",domain);
-        oss.str("");
-        oss << "domain_" << fmt_buff << "." << file_protocol;
-        string output_file  = conduit::utils::join_file_path(output_dir,oss.str());
-        relay::io::save(dom, output_file);
+    // by default every domain gets its own file. Aggregation writes
+    // one file per group of ranks, so there can't be more files than ranks.
+    int num_files = global_domains;
+    if(requested_files > 0)
+    {
+      num_files = std::min(requested_files, std::min(par_size, global_domains));
     }
+    const bool aggregate = num_files < global_domains;
 
-    int root_file_writer = 0;
-    if(num_domains == 0)
+    std::string file_pattern = "domain_%06d." + file_protocol;
+    if(!aggregate)
     {
-      root_file_writer = -1;
+      // write out each domain
+      for(int i = 0; i < num_domains; ++i)
+      {
+          const Node &dom = multi_dom.child(i);
+          uint64 domain = dom["state/domain_id"].to_uint64();
+
+          snprintf(fmt_buff, sizeof(fmt_buff), "%06llu",domain);
+          oss.str("");
+          oss << "domain_" << fmt_buff << "." << file_protocol;
+          string output_file  = conduit::utils::join_file_path(output_dir,oss.str());
+          Node &file_data = detail::add_file(files, dom, output_file, file_protocol);
+          // the domain id is owned by multi_dom, so keep a copy of the state
+          Node &file_state = file_data["state"];
+          file_state.reset();
+          file_state.set(dom["state"]);
+      }
     }
+    else
+    {
+      file_pattern = "file_%06d." + file_protocol;
+      const int group = detail::file_group(par_rank, par_size, num_files);
+      int aggregator = par_rank;
+      while(aggregator > 0 &&
+            detail::file_group(aggregator - 1, par_size, num_files) == group)
+      {
+        aggregator--;
+      }
+
+      if(par_rank != aggregator)
+      {
+#ifdef ASCENT_MPI_ENABLED
+        // aggregators never send, so these can't wait on each other
+        for(int i = 0; i < num_domains; ++i)
+        {
+          mpi::send_using_schema(multi_dom.child(i),
+                                 aggregator,
+                                 detail::AGGREGATE_TAG,
+                                 mpi_comm);
+        }
+#endif
+      }
+      else
+      {
+        int group_domains = 0;
+        for(int r = aggregator;
+            r < par_size && detail::file_group(r, par_size, num_files) == group;
+            ++r)
+        {
+          group_domains += rank_domains[r];
+        }
+
+        if(group_domains > 0)
+        {
+          snprintf(fmt_buff, sizeof(fmt_buff), "%06d", group);
+          oss.str("");
+          oss << "file_" << fmt_buff << "." << file_protocol;
+          string output_file  = conduit::utils::join_file_path(output_dir,oss.str());
+
+          Node &file = files.append();
+          file["path"] = output_file;
+          file["protocol"] = file_protocol;
+          Node &file_data = file["data"];
+
+          // trees are numbered in rank order, which is the order
+          // partition_map/file is filled in. domain ids are kept in
+          // each tree's state, but may be in any order.
+          int domain_offset = 0;
+          for(int r = 0; r < aggregator; ++r)
+          {
+            domain_offset += rank_domains[r];
+          }
+
+          for(int i = 0; i < num_domains; ++i)
+          {
+            const Node &dom = multi_dom.child(i);
+            snprintf(fmt_buff, sizeof(fmt_buff), "%06d", domain_offset + i);
+            Node &tree = file_data["domain_" + std::string(fmt_buff)];
+            tree.set_external(dom);
+            // the domain id is owned by multi_dom, so keep a copy of the state
+            tree["state"].reset();
+            tree["state"].set(dom["state"]);
+          }
+          domain_offset += num_domains;
 #ifdef ASCENT_MPI_ENABLED
+          for(int r = aggregator + 1;
+              r < par_size && detail::file_group(r, par_size, num_files) == group;
+              ++r)
+          {
+            for(int i = 0; i < rank_domains[r]; ++i)
+            {
+              snprintf(fmt_buff, sizeof(fmt_buff), "%06d", domain_offset + i);
+              mpi::recv_using_schema(file_data["domain_" + std::string(fmt_buff)],
+                                     r,
+                                     detail::AGGREGATE_TAG,
+                                     mpi_comm);
+            }
+            domain_offset += rank_domains[r];
+          }
+#endif
+        }
+      }
+    }
+
     // Rank 0 could have an empty domain, so we have to check
     // to find someone with a data set to write out the root file.
-    Node out;
-    out = num_domains;
-    Node rcv;
-
-    mpi::all_gather_using_schema(out, rcv, mpi_comm);
-    root_file_writer = -1;
-    int* res_ptr = (int*)rcv.data_ptr();
+    int root_file_writer = -1;
     for(int i = 0; i < par_size; ++i)
     {
-        if(res_ptr[i] != 0)
+        if(rank_domains[i] != 0)
         {
             root_file_writer = i;
             break;
         }
     }
 
+#ifdef ASCENT_MPI_ENABLED
     MPI_Barrier(mpi_comm);
 #endif
 
@@ -527,7 +874,7 @@ void mesh_blueprint_save(const Node &data,
                                       output_dir_path);
 
         string output_file_pattern = conduit::utils::join_file_path(output_dir_base,
-                                                                    "domain_%06d." + file_protocol);
+                                                                    file_pattern);
 
 
         Node root;
@@ -552,14 +899,37 @@ void mesh_blueprint_save(const Node &data,
         root["protocol/name"]    =  file_protocol;
         root["protocol/version"] = "0.4.0";
 
-        root["number_of_files"]  = global_domains;
-        // for now we will save one file per domain, so trees == files
+        root["number_of_files"]  = num_files;
         root["number_of_trees"]  = global_domains;
         // TODO: make sure this is relative
         root["file_pattern"]     = output_file_pattern;
-        root["tree_pattern"]     = "/";
+        if(!aggregate)
+        {
+          root["tree_pattern"]   = "/";
+        }
+        else
+        {
+          root["tree_pattern"]   = "domain_%06d";
+          // groups can hold different numbers of domains, so record
+          // which file each tree lives in
+          root["partition_map/file"].set(DataType::c_int(global_domains));
+          int *file_ids = root["partition_map/file"].value();
+          int tree = 0;
+          for(int r = 0; r < par_size; ++r)
+          {
+            for(int i = 0; i < rank_domains[r]; ++i)
+            {
+              file_ids[tree++] = detail::file_group(r, par_size, num_files);
+            }
+          }
+        }
 
-        relay::io::save(root,root_file,file_protocol);
+        // the root is local, so the file keeps a copy
+        Node &root_entry = files.append();
+        root_entry["path"] = root_file;
+        // conduit_bin domains are described by a json root file
+        root_entry["protocol"] = file_protocol == "conduit_bin" ? "json" : file_protocol;
+        root_entry["data"].set(root);
     }
 }
 
@@ -643,23 +1013,53 @@ RelayIOSave::execute()
       selected.set_external(*in);
     }
 
-    if(protocol.empty())
+    int num_files = 0;
+    if(params().has_path("num_files"))
     {
-        conduit::relay::io::save(selected,path);
+        num_files = params()["num_files"].to_int32();
     }
-    else if( protocol == "blueprint/mesh/hdf5")
+
+    Node files;
+    if( protocol == "blueprint/mesh/hdf5")
     {
-        mesh_blueprint_save(selected,path,"hdf5");
+        mesh_blueprint_save(selected,path,"hdf5",num_files,files);
     }
     else if( protocol == "blueprint/mesh/json")
     {
-        mesh_blueprint_save(selected,path,"json");
+        mesh_blueprint_save(selected,path,"json",num_files,files);
+    }
+    else if( protocol == "blueprint/mesh/conduit_bin")
+    {
+        mesh_blueprint_save(selected,path,"conduit_bin",num_files,files);
     }
     else
     {
-        conduit::relay::io::save(selected,path,protocol);
+        detail::add_file(files,selected,path,protocol);
     }
 
+    detail::AsyncWriter &writer = detail::AsyncWriter::instance();
+    if(params().has_path("async") && params()["async"].as_string() == "true")
+    {
+        int max_in_flight = 2;
+        if(params().has_path("max_in_flight"))
+        {
+            max_in_flight = params()["max_in_flight"].to_int32();
+        }
+        writer.write(files, max_in_flight);
+    }
+    else
+    {
+        // keep relay io on one thread at a time
+        writer.flush();
+        detail::save_files(files);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+relay_io_flush()
+{
+    detail::AsyncWriter::instance().flush();
 }
 
 
@@ -708,8 +1108,17 @@ RelayIOLoad::execute()
         protocol = params()["protocol"].as_string();
     }
 
+    // the file could still be written by an asynchronous extract
+    relay_io_flush();
+
     Node *res = new Node();
 
+    std::unique_lock<std::mutex> lock(hdf5_mutex(), std::defer_lock);
+    if(uses_hdf5(path, protocol))
+    {
+        lock.lock();
+    }
+
     if(protocol.empty())
     {
         conduit::relay::io::load(path,*res);
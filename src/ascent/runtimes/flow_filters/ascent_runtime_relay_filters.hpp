@@ -91,6 +91,11 @@ public:
     virtual void   execute();
 };
 
+//-----------------------------------------------------------------------------
+// waits until the asynchronous relay extracts are written
+//-----------------------------------------------------------------------------
+void relay_io_flush();
+
 //-----------------------------------------------------------------------------
 class RelayIOLoad : public ::flow::Filter
 {
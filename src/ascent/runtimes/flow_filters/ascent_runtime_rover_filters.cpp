@@ -75,6 +75,8 @@
 
 #if defined(ASCENT_VTKM_ENABLED)
 #include <rover.hpp>
+#include <engine_cache.hpp>
+#include <ray_cache.hpp>
 #include <ray_generators/camera_generator.hpp>
 #include <vtkh/vtkh.hpp>
 #include <vtkh/DataSet.hpp>
@@ -142,8 +144,196 @@ transmogrify_source(const conduit::Node *n_input, const int ref_level)
   return dataset;
 }
 
+//
+// Creates a single camera from the 'camera' parameter or, for batches of
+// views, one camera per named child of the 'cameras' parameter
+//
+void
+parse_camera_generators(const conduit::Node &params,
+                        const vtkm::Bounds &bounds,
+                        std::vector<CameraGenerator> &generators,
+                        std::vector<std::string> &names)
+{
+  int width, height;
+  parse_image_dims(params, width, height);
+
+  if(params.has_path("cameras"))
+  {
+    const conduit::Node &n_cameras = params["cameras"];
+    const int num_cameras = n_cameras.number_of_children();
+    for(int i = 0; i < num_cameras; ++i)
+    {
+      vtkmCamera camera;
+      camera.ResetToBounds(bounds);
+      parse_camera(n_cameras.child(i), camera);
+      generators.push_back(CameraGenerator(camera, width, height));
+      names.push_back(n_cameras.child(i).name());
+    }
+  }
+  else
+  {
+    vtkmCamera camera;
+    camera.ResetToBounds(bounds);
+    if(params.has_path("camera"))
+    {
+      parse_camera(params["camera"], camera);
+    }
+    generators.push_back(CameraGenerator(camera, width, height));
+    names.push_back("");
+  }
+}
+
+//
+// cameras from the 'cameras' parameter get their name appended
+//
+std::string
+view_file_name(const std::string &file_name, const std::string &view_name)
+{
+  if(view_name == "")
+  {
+    return file_name;
+  }
+  return file_name + "_" + view_name;
+}
+
+//
+// The mesh generation published in 'state/mesh_generation' describes the
+// published mesh, so it only applies to extracts whose input is the
+// default set of filters and not the output of a pipeline.
+// Returns -1 when there is no generation to go by.
+//
+vtkm::Int64
+input_mesh_generation(flow::Filter &filter)
+{
+  Node *meta = filter.graph().workspace().registry().fetch<Node>("metadata");
+  if(!meta->has_path("mesh_generation"))
+  {
+    return -1;
+  }
+
+  const Node &edges_in = filter.graph().edges_in(filter.name());
+  if(!edges_in.has_child("in") || !edges_in["in"].dtype().is_string())
+  {
+    return -1;
+  }
+
+  const std::string input_name = edges_in["in"].as_string();
+  if(input_name != "strip_garbage_ghosts" && input_name != "vtkh_data")
+  {
+    return -1;
+  }
+
+  return (*meta)["mesh_generation"].to_int64();
+}
+
+//
+// Adds the domains to the tracer, reusing the extract's mesh structures
+// from previous executes if the published mesh has not changed
+//
+void
+add_domains(flow::Filter &filter,
+            vtkh::DataSet *dataset,
+            Rover &tracer)
+{
+  const vtkm::Int64 mesh_generation = input_mesh_generation(filter);
+  std::shared_ptr<rover::EngineCache> engine_cache =
+    RoverCaches::engine_cache(filter.name());
+  if(mesh_generation >= 0)
+  {
+    tracer.set_engine_cache(engine_cache, mesh_generation);
+  }
+  else
+  {
+    engine_cache->clear();
+  }
+
+  for(int i = 0; i < dataset->GetNumberOfDomains(); ++i)
+  {
+    vtkm::cont::DataSet domain;
+    vtkm::Id domain_id;
+    dataset->GetDomain(i, domain, domain_id);
+    tracer.add_data_set(domain, domain_id);
+  }
+}
+
 }// namespace detail
 
+//-----------------------------------------------------------------------------
+std::map<std::string, RoverCaches::Entry> RoverCaches::m_entries;
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<rover::RayCache>
+RoverCaches::ray_cache(const std::string &name)
+{
+    Entry &entry = m_entries[name];
+    if(entry.m_ray_cache == nullptr)
+    {
+        entry.m_ray_cache = std::make_shared<rover::RayCache>();
+    }
+    return entry.m_ray_cache;
+}
+
+//-----------------------------------------------------------------------------
+std::shared_ptr<rover::EngineCache>
+RoverCaches::engine_cache(const std::string &name)
+{
+    Entry &entry = m_entries[name];
+    if(entry.m_engine_cache == nullptr)
+    {
+        entry.m_engine_cache = std::make_shared<rover::EngineCache>();
+    }
+    return entry.m_engine_cache;
+}
+
+//-----------------------------------------------------------------------------
+int
+RoverCaches::num_ray_reuses(const std::string &name)
+{
+    auto it = m_entries.find(name);
+    if(it == m_entries.end() || it->second.m_ray_cache == nullptr)
+    {
+        return 0;
+    }
+    return it->second.m_ray_cache->num_reuses();
+}
+
+//-----------------------------------------------------------------------------
+int
+RoverCaches::num_engine_reuses(const std::string &name)
+{
+    auto it = m_entries.find(name);
+    if(it == m_entries.end() || it->second.m_engine_cache == nullptr)
+    {
+        return 0;
+    }
+    return it->second.m_engine_cache->num_hits();
+}
+
+//-----------------------------------------------------------------------------
+void
+RoverCaches::clear()
+{
+    m_entries.clear();
+}
+
+//-----------------------------------------------------------------------------
+void
+RoverCaches::prune(flow::Graph &graph)
+{
+    auto it = m_entries.begin();
+    while(it != m_entries.end())
+    {
+        if(graph.has_filter(it->first))
+        {
+            ++it;
+        }
+        else
+        {
+            it = m_entries.erase(it);
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 RoverXRay::RoverXRay()
 :Filter()
@@ -195,16 +385,43 @@ RoverXRay::verify_params(const conduit::Node &params,
         res = false;
     }
 
-    if( params.has_child("precision") &&
-       ! params["precision"].dtype().is_string() )
+    if( params.has_child("cameras") &&
+       ! params["cameras"].dtype().is_object() )
+    {
+        info["errors"].append() = "Optional parameter 'cameras' must be a set of named cameras";
+        res = false;
+    }
+
+    if( params.has_child("tiled") &&
+       ! params["tiled"].dtype().is_string() )
+    {
+        info["errors"].append() = "Optional parameter 'tiled' must be a string ('true' or 'false')";
+        res = false;
+    }
+
+    if( params.has_child("ray_scope") &&
+       ! params["ray_scope"].dtype().is_string() )
     {
-        info["errors"].append() = "Optional parameter 'precision' must be a string";
-        std::string prec = params["precision"].as_string();
-        if(prec != "single" || prec != "double")
+        info["errors"].append() = "Optional parameter 'ray_scope' must be a string ('global' or 'local')";
+        res = false;
+    }
+
+    if( params.has_child("precision") )
+    {
+        if(! params["precision"].dtype().is_string() )
         {
-          info["errors"].append() = "Parameter 'precision' must be 'single' or 'double'";
+            info["errors"].append() = "Optional parameter 'precision' must be a string";
+            res = false;
+        }
+        else
+        {
+            std::string prec = params["precision"].as_string();
+            if(prec != "single" && prec != "double" && prec != "double_composite")
+            {
+                info["errors"].append() = "Parameter 'precision' must be 'single', 'double' or 'double_composite'";
+                res = false;
+            }
         }
-        res = false;
     }
 
     return res;
@@ -219,21 +436,19 @@ RoverXRay::execute()
         ASCENT_ERROR("vtkh_slice input must be a vtk-h dataset");
     }
     vtkh::DataSet *dataset = input<vtkh::DataSet>(0);
+    // the global bounds are handed to rover so it does not reduce them again
+    const vtkm::Bounds bounds = dataset->GetGlobalBounds();
 
-    vtkmCamera camera;
-    camera.ResetToBounds(dataset->GetGlobalBounds());
+    std::vector<CameraGenerator> generators;
+    std::vector<std::string> view_names;
+    detail::parse_camera_generators(params(), bounds, generators, view_names);
 
-    if(params().has_path("camera"))
+    std::vector<RayGenerator*> ray_generators;
+    for(size_t i = 0; i < generators.size(); ++i)
     {
-      const conduit::Node &n_camera = params()["camera"];
-      parse_camera(n_camera, camera);
+      ray_generators.push_back(&generators[i]);
     }
 
-    int width, height;
-    parse_image_dims(params(), width, height);
-
-    CameraGenerator generator(camera, width, height);
-
     Rover tracer;
 #ifdef ASCENT_MPI_ENABLED
     int comm_id = flow::Workspace::default_mpi_comm();
@@ -247,12 +462,18 @@ RoverXRay::execute()
       {
         tracer.set_tracer_precision64();
       }
+      else if(prec == "double_composite")
+      {
+        // trace in single precision, composite in double precision
+        tracer.set_composite_precision64();
+      }
     }
 
     //
     // Create some basic settings
     //
     RenderSettings settings;
+    settings.m_global_bounds = bounds;
     settings.m_primary_field = params()["absorption"].as_string();
 
     if(params().has_path("emission"))
@@ -265,16 +486,26 @@ RoverXRay::execute()
        settings.m_energy_settings.m_unit_scalar = params()["unit_scalar"].to_float64();
     }
 
+    // local rays are forwarded between domains instead of every rank
+    // tracing every ray
+    if(params().has_path("ray_scope") && params()["ray_scope"].as_string() == "local")
+    {
+       settings.m_ray_scope = rover::local_rays;
+    }
+
+    if(params().has_path("tiled") && params()["tiled"].as_string() == "true")
+    {
+       settings.m_energy_settings.m_tiled_output = true;
+    }
+
 
     settings.m_render_mode = rover::energy;
 
     tracer.set_render_settings(settings);
-    for(int i = 0; i < dataset->GetNumberOfDomains(); ++i)
-    {
-      tracer.add_data_set(dataset->GetDomain(i));
-    }
+    detail::add_domains(*this, dataset, tracer);
+    tracer.set_ray_cache(RoverCaches::ray_cache(name()));
 
-    tracer.set_ray_generator(&generator);
+    tracer.set_ray_generators(ray_generators);
     tracer.execute();
 
     Node * meta = graph().workspace().registry().fetch<Node>("metadata");
@@ -284,26 +515,34 @@ RoverXRay::execute()
       cycle = (*meta)["cycle"].as_int32();
     }
 
-    std::string filename = params()["filename"].as_string();
-    if(cycle != -1)
-    {
-      tracer.save_png(expand_family_name(filename, cycle));
-    }
-    else
-    {
-      tracer.save_png(expand_family_name(filename));
-    }
-
-    if(params().has_path("bov_filename"))
+    // saving composites the view, so every rank saves every view
+    // and all outputs of a view are saved before the next one
+    const int num_views = static_cast<int>(view_names.size());
+    for(int v = 0; v < num_views; ++v)
     {
-      std::string bov_filename = params()["bov_filename"].as_string();
+      std::string filename = detail::view_file_name(params()["filename"].as_string(),
+                                                    view_names[v]);
       if(cycle != -1)
       {
-        tracer.save_bov(expand_family_name(bov_filename, cycle));
+        tracer.save_png(expand_family_name(filename, cycle), v);
       }
       else
       {
-        tracer.save_bov(expand_family_name(bov_filename));
+        tracer.save_png(expand_family_name(filename), v);
+      }
+
+      if(params().has_path("bov_filename"))
+      {
+        std::string bov_filename = detail::view_file_name(params()["bov_filename"].as_string(),
+                                                          view_names[v]);
+        if(cycle != -1)
+        {
+          tracer.save_bov(expand_family_name(bov_filename, cycle), v);
+        }
+        else
+        {
+          tracer.save_bov(expand_family_name(bov_filename), v);
+        }
       }
     }
     tracer.finalize();
@@ -355,16 +594,36 @@ RoverVolume::verify_params(const conduit::Node &params,
         res = false;
     }
 
-    if( params.has_child("precision") &&
-       ! params["precision"].dtype().is_string() )
+    if( params.has_child("cameras") &&
+       ! params["cameras"].dtype().is_object() )
     {
-        info["errors"].append() = "Optional parameter 'precision' must be a string";
-        std::string prec = params["precision"].as_string();
-        if(prec != "single" || prec != "double")
+        info["errors"].append() = "Optional parameter 'cameras' must be a set of named cameras";
+        res = false;
+    }
+
+    if( params.has_child("ray_scope") &&
+       ! params["ray_scope"].dtype().is_string() )
+    {
+        info["errors"].append() = "Optional parameter 'ray_scope' must be a string ('global' or 'local')";
+        res = false;
+    }
+
+    if( params.has_child("precision") )
+    {
+        if(! params["precision"].dtype().is_string() )
         {
-          info["errors"].append() = "Parameter 'precision' must be 'single' or 'double'";
+            info["errors"].append() = "Optional parameter 'precision' must be a string";
+            res = false;
+        }
+        else
+        {
+            std::string prec = params["precision"].as_string();
+            if(prec != "single" && prec != "double" && prec != "double_composite")
+            {
+                info["errors"].append() = "Parameter 'precision' must be 'single', 'double' or 'double_composite'";
+                res = false;
+            }
         }
-        res = false;
     }
 
     return res;
@@ -379,21 +638,19 @@ RoverVolume::execute()
         ASCENT_ERROR("vtkh_slice input must be a vtk-h dataset");
     }
     vtkh::DataSet *dataset = input<vtkh::DataSet>(0);
+    // the global bounds are handed to rover so it does not reduce them again
+    const vtkm::Bounds bounds = dataset->GetGlobalBounds();
 
-    vtkmCamera camera;
-    camera.ResetToBounds(dataset->GetGlobalBounds());
+    std::vector<CameraGenerator> generators;
+    std::vector<std::string> view_names;
+    detail::parse_camera_generators(params(), bounds, generators, view_names);
 
-    if(params().has_path("camera"))
+    std::vector<RayGenerator*> ray_generators;
+    for(size_t i = 0; i < generators.size(); ++i)
     {
-      const conduit::Node &n_camera = params()["camera"];
-      parse_camera(n_camera, camera);
+      ray_generators.push_back(&generators[i]);
     }
 
-    int width, height;
-    parse_image_dims(params(), width, height);
-
-    CameraGenerator generator(camera, width, height);
-
     Rover tracer;
 #ifdef ASCENT_MPI_ENABLED
     int comm_id =flow::Workspace::default_mpi_comm();
@@ -407,12 +664,18 @@ RoverVolume::execute()
       {
         tracer.set_tracer_precision64();
       }
+      else if(prec == "double_composite")
+      {
+        // trace in single precision, composite in double precision
+        tracer.set_composite_precision64();
+      }
     }
 
     //
     // Create some basic settings
     //
     RenderSettings settings;
+    settings.m_global_bounds = bounds;
     settings.m_primary_field = params()["field"].as_string();
 
     if(params().has_path("samples"))
@@ -420,6 +683,23 @@ RoverVolume::execute()
       settings.m_volume_settings.m_num_samples = params()["samples"].to_int32();
     }
 
+    // local rays are forwarded between domains instead of every rank
+    // tracing every ray
+    if(params().has_path("ray_scope") && params()["ray_scope"].as_string() == "local")
+    {
+      settings.m_ray_scope = rover::local_rays;
+    }
+
+    if(params().has_path("macrocells"))
+    {
+      settings.m_volume_settings.m_macrocell_dims = params()["macrocells"].to_int32();
+    }
+
+    if(params().has_path("opacity_threshold"))
+    {
+      settings.m_volume_settings.m_opacity_threshold = params()["opacity_threshold"].to_float32();
+    }
+
 
     if(params().has_path("min_value"))
     {
@@ -446,12 +726,10 @@ RoverVolume::execute()
     }
 
     tracer.set_render_settings(settings);
-    for(int i = 0; i < dataset->GetNumberOfDomains(); ++i)
-    {
-      tracer.add_data_set(dataset->GetDomain(i));
-    }
+    detail::add_domains(*this, dataset, tracer);
+    tracer.set_ray_cache(RoverCaches::ray_cache(name()));
 
-    tracer.set_ray_generator(&generator);
+    tracer.set_ray_generators(ray_generators);
     tracer.execute();
 
     int cycle = -1;;
@@ -461,14 +739,21 @@ RoverVolume::execute()
       cycle = (*meta)["cycle"].as_int32();
     }
 
-    std::string filename = params()["filename"].as_string();
-    if(cycle != -1)
+    // saving composites the view, so every rank saves every view
+    // and all outputs of a view are saved before the next one
+    const int num_views = static_cast<int>(view_names.size());
+    for(int v = 0; v < num_views; ++v)
     {
-      tracer.save_png(expand_family_name(filename, cycle));
-    }
-    else
-    {
-      tracer.save_png(expand_family_name(filename));
+      std::string filename = detail::view_file_name(params()["filename"].as_string(),
+                                                    view_names[v]);
+      if(cycle != -1)
+      {
+        tracer.save_png(expand_family_name(filename, cycle), v);
+      }
+      else
+      {
+        tracer.save_png(expand_family_name(filename), v);
+      }
     }
     tracer.finalize();
 
@@ -56,6 +56,16 @@
 
 #include <flow_filter.hpp>
 
+#include <map>
+#include <memory>
+#include <string>
+
+namespace rover
+{
+    class EngineCache;
+    class RayCache;
+}
+
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
 //-----------------------------------------------------------------------------
@@ -80,6 +90,39 @@ namespace filters
 ///
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+///
+/// Rover state kept across executes, keyed by the name of the extract.
+/// Extract filters are recreated by every execute, so the state can't
+/// live in the filters themselves.
+///
+//-----------------------------------------------------------------------------
+class RoverCaches
+{
+public:
+    /// ray storage of the named extract, created on first use
+    static std::shared_ptr<rover::RayCache> ray_cache(const std::string &name);
+    /// engines of the named extract, created on first use
+    static std::shared_ptr<rover::EngineCache> engine_cache(const std::string &name);
+    /// number of times the named extract traced with rays kept from
+    /// an earlier domain, view or execute
+    static int  num_ray_reuses(const std::string &name);
+    /// number of times the named extract reused the engine of a domain
+    /// from an earlier execute
+    static int  num_engine_reuses(const std::string &name);
+    /// releases the state of all extracts
+    static void clear();
+    /// releases the state of extracts that are not in the graph
+    static void prune(flow::Graph &graph);
+private:
+    struct Entry
+    {
+        std::shared_ptr<rover::RayCache>    m_ray_cache;
+        std::shared_ptr<rover::EngineCache> m_engine_cache;
+    };
+    static std::map<std::string, Entry> m_entries;
+};
+
 //-----------------------------------------------------------------------------
 class RoverXRay: public ::flow::Filter
 {
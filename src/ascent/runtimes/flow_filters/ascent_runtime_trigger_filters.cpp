@@ -112,7 +112,7 @@ BasicTrigger::declare_interface(Node &i)
 {
     i["type_name"]   = "basic_trigger";
     i["port_names"].append() = "in";
-    i["output_port"] = "false";
+    i["output_port"] = "true";
 }
 
 //-----------------------------------------------------------------------------
@@ -127,11 +127,22 @@ BasicTrigger::verify_params(const conduit::Node &params,
     std::vector<std::string> valid_paths;
     valid_paths.push_back("condition");
     valid_paths.push_back("actions_file");
+    std::string surprises = surprise_check(valid_paths, params);
+
+    if(surprises != "")
+    {
+      res = false;
+      info["errors"].append() = surprises;
+    }
 
     return res;
 }
 
 
+//-----------------------------------------------------------------------------
+// The runtime adds the trigger's actions to the graph downstream of this
+// filter (see AscentRuntime::CreateTriggerGraph), so passing the input
+// through runs them and skipping the output skips them.
 //-----------------------------------------------------------------------------
 void
 BasicTrigger::execute()
@@ -142,10 +153,7 @@ BasicTrigger::execute()
     }
 
     std::string expression = params()["condition"].as_string();
-    std::string actions_file = params()["actions_file"].as_string();
-    conduit::Node actions;
 
-    Node v_info;
     Node *n_input = input<Node>(0);
 
     runtime::expressions::ExpressionEval eval(n_input);
@@ -156,21 +164,15 @@ BasicTrigger::execute()
       ASCENT_ERROR("result of expression '"<<expression<<"' is not an boolean");
     }
 
+    // expression results are global, so all ranks agree
     bool fire = res["value"].to_int32() != 0;
     if(fire)
     {
-      Ascent ascent;
-
-      Node ascent_opts;
-      ascent_opts["runtime/type"] = "ascent";
-#ifdef ASCENT_MPI_ENABLED
-      ascent_opts["mpi_comm"] = Workspace::default_mpi_comm();
-#endif
-      ascent_opts["actions_file"] = actions_file;
-      ascent.open(ascent_opts);
-      ascent.publish(*n_input);
-      ascent.execute(actions);
-      ascent.close();
+      set_output<Node>(n_input);
+    }
+    else
+    {
+      skip();
     }
 }
 
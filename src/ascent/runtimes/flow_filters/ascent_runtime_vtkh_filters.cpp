@@ -92,10 +92,12 @@
 #include <vtkh/filters/Slice.hpp>
 #include <vtkh/filters/Threshold.hpp>
 #include <vtkh/filters/VectorMagnitude.hpp>
+#include <vtkh/utils/vtkm_array_utils.hpp>
 #include <vtkm/cont/DataSet.h>
 
 #include <ascent_vtkh_data_adapter.hpp>
 #include <ascent_runtime_conduit_to_vtkm_parsing.hpp>
+#include <ascent_expression_eval.hpp>
 #endif
 
 #include <stdio.h>
@@ -725,6 +727,44 @@ public:
 
 std::map<std::string, CinemaManager> CinemaDatabases::m_databases;
 
+//-----------------------------------------------------------------------------
+template<typename T>
+bool
+wrap_vtkm_values(vtkm::cont::VariantArrayHandle &data, conduit::Node &values)
+{
+    typedef vtkm::cont::ArrayHandle<T> HandleType;
+    if(!data.IsType<HandleType>())
+    {
+        return false;
+    }
+
+    HandleType handle = data.Cast<HandleType>();
+    values.set_external(vtkh::GetVTKMPointer(handle),
+                        static_cast<index_t>(handle.GetNumberOfValues()));
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// wraps the values of a vtk-m field as an external conduit node so the
+// derived field program can read them in place. Integer values are
+// converted to float64 by the program as they are read.
+bool
+wrap_vtkm_field(vtkm::cont::Field &field, conduit::Node &values)
+{
+    vtkm::cont::VariantArrayHandle data = field.GetData();
+
+    return wrap_vtkm_values<vtkm::Float64>(data, values) ||
+           wrap_vtkm_values<vtkm::Float32>(data, values) ||
+           wrap_vtkm_values<vtkm::Int32>(data, values) ||
+           wrap_vtkm_values<vtkm::Int64>(data, values) ||
+           wrap_vtkm_values<vtkm::UInt32>(data, values) ||
+           wrap_vtkm_values<vtkm::UInt64>(data, values) ||
+           wrap_vtkm_values<vtkm::Int8>(data, values) ||
+           wrap_vtkm_values<vtkm::UInt8>(data, values) ||
+           wrap_vtkm_values<vtkm::Int16>(data, values) ||
+           wrap_vtkm_values<vtkm::UInt16>(data, values);
+}
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
@@ -751,6 +791,7 @@ EnsureVTKH::declare_interface(Node &i)
     i["type_name"]   = "ensure_vtkh";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["cacheable"]   = "true";
 }
 
 //-----------------------------------------------------------------------------
@@ -794,6 +835,25 @@ EnsureVTKH::execute()
     }
 }
 
+//-----------------------------------------------------------------------------
+void
+EnsureVTKH::serve_cached(flow::Data &cached)
+{
+    // vtk-m datasets are shallow copies, the cycle comes from the
+    // current publish
+    vtkh::DataSet *res = new vtkh::DataSet(*cached.value<vtkh::DataSet>());
+    if(input(0).check_type<Node>())
+    {
+        const Node *n_input = input<Node>(0);
+        if(n_input->number_of_children() > 0 &&
+           n_input->child(0).has_path("state/cycle"))
+        {
+            res->SetCycle(n_input->child(0)["state/cycle"].to_uint64());
+        }
+    }
+    set_output<vtkh::DataSet>(res);
+}
+
 
 //-----------------------------------------------------------------------------
 VTKHMarchingCubes::VTKHMarchingCubes()
@@ -1089,6 +1149,180 @@ VTKH3Slice::execute()
     set_output<vtkh::DataSet>(slice_output);
 }
 
+//-----------------------------------------------------------------------------
+DerivedField::DerivedField()
+:Filter()
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+DerivedField::~DerivedField()
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+void
+DerivedField::declare_interface(Node &i)
+{
+    i["type_name"]   = "derived_field";
+    i["port_names"].append() = "in";
+    i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+DerivedField::verify_params(const conduit::Node &params,
+                            conduit::Node &info)
+{
+    info.reset();
+
+    bool res = check_string("expression",params, info, true);
+    res = check_string("output_name",params, info, true) && res;
+
+    std::vector<std::string> valid_paths;
+    valid_paths.push_back("expression");
+    valid_paths.push_back("output_name");
+    std::string surprises = surprise_check(valid_paths, params);
+
+    if(surprises != "")
+    {
+      res = false;
+      info["errors"].append() = surprises;
+    }
+
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+DerivedField::execute()
+{
+
+    if(!input(0).check_type<vtkh::DataSet>())
+    {
+        ASCENT_ERROR("derived_field input must be a vtk-h dataset");
+    }
+
+    std::string expression = params()["expression"].as_string();
+    std::string output_name = params()["output_name"].as_string();
+
+    runtime::expressions::DerivedFieldProgram program =
+      runtime::expressions::ExpressionEval::derived_field(expression);
+
+    const std::vector<std::string> &field_names = program.field_names();
+    const int num_fields = static_cast<int>(field_names.size());
+
+    vtkh::DataSet *data = input<vtkh::DataSet>(0);
+
+    for(int f = 0; f < num_fields; ++f)
+    {
+      if(!data->GlobalFieldExists(field_names[f]))
+      {
+        ASCENT_ERROR("derived_field: unknown field '"<<field_names[f]<<"'"
+                     <<" in expression '"<<expression<<"'");
+      }
+    }
+
+    const int num_domains = static_cast<int>(data->GetNumberOfDomains());
+
+    std::vector<vtkm::cont::DataSet> domains(num_domains);
+    std::vector<vtkm::Id> domain_ids(num_domains);
+    std::vector<conduit::Node> inputs(num_domains);
+    std::vector<index_t> sizes(num_domains, 0);
+    std::vector<vtkm::cont::ArrayHandle<vtkm::Float64>> outputs(num_domains);
+
+    // validate every domain serially, so the parallel loop below only
+    // evaluates the program
+    for(int d = 0; d < num_domains; ++d)
+    {
+      data->GetDomain(d, domains[d], domain_ids[d]);
+      vtkm::cont::DataSet &dom = domains[d];
+
+      bool has_fields = true;
+      for(int f = 0; f < num_fields && has_fields; ++f)
+      {
+        has_fields = dom.HasField(field_names[f]);
+      }
+
+      // domains that are missing a field pass through unchanged
+      if(!has_fields)
+      {
+        continue;
+      }
+
+      vtkm::cont::Field first = dom.GetField(field_names[0]);
+      for(int f = 0; f < num_fields; ++f)
+      {
+        vtkm::cont::Field field = dom.GetField(field_names[f]);
+        if(field.GetAssociation() != first.GetAssociation() ||
+           field.GetNumberOfValues() != first.GetNumberOfValues())
+        {
+          ASCENT_ERROR("derived_field: fields '"<<field_names[0]<<"' and '"
+                       <<field_names[f]<<"' must have the same association"
+                       <<" and number of values");
+        }
+
+        if(!detail::wrap_vtkm_field(field, inputs[d].append()))
+        {
+          ASCENT_ERROR("derived_field: field '"<<field_names[f]<<"'"
+                       <<" must be a scalar field");
+        }
+      }
+
+      sizes[d] = static_cast<index_t>(first.GetNumberOfValues());
+      outputs[d].Allocate(sizes[d]);
+    }
+
+#ifdef ASCENT_USE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for(int d = 0; d < num_domains; ++d)
+    {
+      if(sizes[d] == 0)
+      {
+        continue;
+      }
+
+      std::vector<const conduit::Node*> values(num_fields);
+      for(int f = 0; f < num_fields; ++f)
+      {
+        values[f] = &inputs[d].child(f);
+      }
+
+      program.execute(values, sizes[d], vtkh::GetVTKMPointer(outputs[d]));
+    }
+
+    vtkh::DataSet *res = new vtkh::DataSet();
+    res->SetCycle(data->GetCycle());
+
+    for(int d = 0; d < num_domains; ++d)
+    {
+      vtkm::cont::DataSet &dom = domains[d];
+      if(sizes[d] != 0)
+      {
+        vtkm::cont::Field first = dom.GetField(field_names[0]);
+        if(first.GetAssociation() == vtkm::cont::Field::Association::POINTS)
+        {
+          dom.AddField(vtkm::cont::Field(output_name,
+                                         vtkm::cont::Field::Association::POINTS,
+                                         outputs[d]));
+        }
+        else
+        {
+          dom.AddField(vtkm::cont::Field(output_name,
+                                         first.GetAssociation(),
+                                         first.GetAssocCellSet(),
+                                         outputs[d]));
+        }
+      }
+      res->AddDomain(dom, domain_ids[d]);
+    }
+
+    set_output<vtkh::DataSet>(res);
+}
+
 //-----------------------------------------------------------------------------
 VTKHSlice::VTKHSlice()
 :Filter()
@@ -1198,6 +1432,7 @@ VTKHGhostStripper::declare_interface(Node &i)
     i["type_name"]   = "vtkh_ghost_stripper";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["cacheable"]   = "true";
 }
 
 //-----------------------------------------------------------------------------
@@ -1272,6 +1507,15 @@ VTKHGhostStripper::execute()
     }
 }
 
+//-----------------------------------------------------------------------------
+void
+VTKHGhostStripper::serve_cached(flow::Data &cached)
+{
+    vtkh::DataSet *res = new vtkh::DataSet(*cached.value<vtkh::DataSet>());
+    res->SetCycle(input<vtkh::DataSet>(0)->GetCycle());
+    set_output<vtkh::DataSet>(res);
+}
+
 //-----------------------------------------------------------------------------
 VTKHThreshold::VTKHThreshold()
 :Filter()
@@ -1972,6 +2216,7 @@ VTKHBounds::declare_interface(Node &i)
     i["type_name"] = "vtkh_bounds";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["cacheable"]   = "true";
 }
 
 
@@ -1991,6 +2236,13 @@ VTKHBounds::execute()
     set_output<vtkm::Bounds>(bounds);
 }
 
+//-----------------------------------------------------------------------------
+void
+VTKHBounds::serve_cached(flow::Data &cached)
+{
+    set_output<vtkm::Bounds>(new vtkm::Bounds(*cached.value<vtkm::Bounds>()));
+}
+
 
 //-----------------------------------------------------------------------------
 VTKHUnionBounds::VTKHUnionBounds()
@@ -2062,6 +2314,7 @@ VTKHDomainIds::declare_interface(Node &i)
     i["type_name"] = "vtkh_domain_ids";
     i["port_names"].append() = "in";
     i["output_port"] = "true";
+    i["cacheable"]   = "true";
 }
 
 
@@ -2084,6 +2337,15 @@ VTKHDomainIds::execute()
     set_output<std::set<vtkm::Id> >(result);
 }
 
+//-----------------------------------------------------------------------------
+void
+VTKHDomainIds::serve_cached(flow::Data &cached)
+{
+    std::set<vtkm::Id> *res =
+        new std::set<vtkm::Id>(*cached.value<std::set<vtkm::Id> >());
+    set_output<std::set<vtkm::Id> >(res);
+}
+
 
 
 //-----------------------------------------------------------------------------
@@ -90,6 +90,7 @@ public:
 
     virtual void   declare_interface(conduit::Node &i);
     virtual void   execute();
+    virtual void   serve_cached(::flow::Data &cached);
 };
 
 //-----------------------------------------------------------------------------
@@ -129,6 +130,21 @@ public:
     virtual void   execute();
 };
 
+//-----------------------------------------------------------------------------
+// adds a field computed element-wise from an expression over
+// other fields, e.g. sqrt("vx" * "vx" + "vy" * "vy")
+class DerivedField : public ::flow::Filter
+{
+public:
+    DerivedField();
+    virtual ~DerivedField();
+
+    virtual void   declare_interface(conduit::Node &i);
+    virtual bool   verify_params(const conduit::Node &params,
+                                 conduit::Node &info);
+    virtual void   execute();
+};
+
 //-----------------------------------------------------------------------------
 class VTKHSlice : public ::flow::Filter
 {
@@ -179,6 +195,7 @@ public:
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info);
     virtual void   execute();
+    virtual void   serve_cached(::flow::Data &cached);
 };
 
 //-----------------------------------------------------------------------------
@@ -242,6 +259,7 @@ public:
 
     virtual void   declare_interface(conduit::Node &i);
     virtual void   execute();
+    virtual void   serve_cached(::flow::Data &cached);
 };
 
 //-----------------------------------------------------------------------------
@@ -266,6 +284,7 @@ public:
 
     virtual void   declare_interface(conduit::Node &i);
     virtual void   execute();
+    virtual void   serve_cached(::flow::Data &cached);
 };
 
 //-----------------------------------------------------------------------------
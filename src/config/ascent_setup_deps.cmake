@@ -44,6 +44,11 @@
 
 include(CMakeFindDependencyMacro)
 
+###############################################################################
+# Setup Threads (used by flow)
+###############################################################################
+find_dependency(Threads REQUIRED)
+
 ###############################################################################
 # Setup Conduit
 ###############################################################################
@@ -110,6 +110,37 @@ Alias::execute()
     set_output(input(0));
 }
 
+//-----------------------------------------------------------------------------
+Gate::Gate()
+:Filter()
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+Gate::~Gate()
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+void
+Gate::declare_interface(Node &i)
+{
+    i["type_name"]   = "gate";
+    i["port_names"].append() = "in";
+    i["port_names"].append() = "gate";
+    i["output_port"] = "true";
+}
+
+
+//-----------------------------------------------------------------------------
+void
+Gate::execute()
+{
+    set_output(input("in"));
+}
+
 
 //-----------------------------------------------------------------------------
 RegistrySource::RegistrySource()
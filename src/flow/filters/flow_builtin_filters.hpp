@@ -85,6 +85,26 @@ public:
 };
 
 
+//-----------------------------------------------------------------------------
+///
+/// Gate returns its "in" input as output. The "gate" input only orders
+/// execution: if the filter connected to it is skipped, so is the gate
+/// (along with everything downstream of it).
+///
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+class Gate : public ::flow::Filter
+{
+public:
+    Gate();
+   ~Gate();
+
+    virtual void   declare_interface(conduit::Node &i);
+    virtual void   execute();
+};
+
+
 //-----------------------------------------------------------------------------
 ///
 /// Filters Related to Registry Access
@@ -78,7 +78,8 @@ namespace flow
 //-----------------------------------------------------------------------------
 Filter::Filter()
 : m_graph(NULL),
-  m_out(NULL)
+  m_out(NULL),
+  m_skipped(false)
 {
     // provide NULL as default data when output is not set
     // null pointer won't be reaped, concrete type doesn't matter,
@@ -189,6 +190,22 @@ Filter::output_port() const
     return properties()["interface/output_port"].as_string() == "true";
 }
 
+//-----------------------------------------------------------------------------
+bool
+Filter::cacheable() const
+{
+    return properties()["interface"].has_child("cacheable") &&
+           properties()["interface/cacheable"].as_string() == "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+Filter::thread_safe() const
+{
+    return properties()["interface"].has_child("thread_safe") &&
+           properties()["interface/thread_safe"].as_string() == "true";
+}
+
 //-----------------------------------------------------------------------------
 bool
 Filter::has_port(const std::string &port_name) const
@@ -254,6 +271,69 @@ Filter::verify_params(const Node &, // unused: params,
     return true;
 }
 
+//-----------------------------------------------------------------------------
+// replaces each "state" in dest with a copy of the state at the same
+// path in src. dest is an external view of cached data, so state is
+// reset before it is set to avoid writing through to the cache.
+//-----------------------------------------------------------------------------
+static void
+refresh_state(const Node &src, Node &dest)
+{
+    const index_t num_children = dest.number_of_children();
+    for(index_t i = 0; i < num_children; i++)
+    {
+        Node &d_child = dest.child(i);
+        const Node *s_child = NULL;
+        if(dest.dtype().is_list())
+        {
+            if(src.dtype().is_list() && i < src.number_of_children())
+            {
+                s_child = &src.child(i);
+            }
+        }
+        else if(src.dtype().is_object() && src.has_child(d_child.name()))
+        {
+            s_child = &src[d_child.name()];
+        }
+
+        if(s_child == NULL)
+        {
+            continue;
+        }
+
+        if(d_child.name() == "state")
+        {
+            d_child.reset();
+            d_child.set(*s_child);
+        }
+        else
+        {
+            refresh_state(*s_child, d_child);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Filter::serve_cached(Data &cached)
+{
+    if(!cached.check_type<Node>())
+    {
+        CONDUIT_ERROR(detailed_name() << " is cacheable and its output "
+                      "is not a conduit::Node, it must override "
+                      "serve_cached()");
+    }
+
+    Node *res = new Node();
+    res->set_external(*cached.value<Node>());
+
+    if(number_of_input_ports() > 0 && input(0).check_type<Node>())
+    {
+        refresh_state(*input<Node>(0), *res);
+    }
+
+    set_output<Node>(res);
+}
 
 //-----------------------------------------------------------------------------
 bool
@@ -316,6 +396,30 @@ Filter::verify_interface(const Node &i,
         info["info"].append().set("interface provides 'default_params'");
     }
 
+    if(i.has_child("cacheable"))
+    {
+        if(!i["cacheable"].dtype().is_string() ||
+           (i["cacheable"].as_string() != "true" &&
+            i["cacheable"].as_string() != "false"))
+        {
+            std::string msg = "interface 'cacheable' must be {\"true\" | \"false\"}";
+            info["errors"].append().set(msg);
+            res = false;
+        }
+    }
+
+    if(i.has_child("thread_safe"))
+    {
+        if(!i["thread_safe"].dtype().is_string() ||
+           (i["thread_safe"].as_string() != "true" &&
+            i["thread_safe"].as_string() != "false"))
+        {
+            std::string msg = "interface 'thread_safe' must be {\"true\" | \"false\"}";
+            info["errors"].append().set(msg);
+            res = false;
+        }
+    }
+
 
     return res;
 }
@@ -382,6 +486,20 @@ Filter::set_output(Data &data)
 }
 
 
+//-----------------------------------------------------------------------------
+void
+Filter::skip()
+{
+    m_skipped = true;
+}
+
+//-----------------------------------------------------------------------------
+bool
+Filter::skipped() const
+{
+    return m_skipped;
+}
+
 //-----------------------------------------------------------------------------
 Data &
 Filter::output()
@@ -440,6 +558,7 @@ Filter::reset_inputs_and_output()
 {
     // inputs aren't owned
     m_inputs.clear();
+    m_skipped = false;
 
     // output pointer to container is owned
     if(m_out != NULL)
@@ -104,6 +104,21 @@ class Graph;
 ///    // inited with a *copy* of the default_params when the filter is
 ///    // added to the filter graph.
 ///    i["default_params"]["inc"].set((int)1);
+///
+///    // Optionally declare that the filter's output only depends on its
+///    // inputs and params. When the workspace cache is enabled, the output
+///    // of a cacheable filter is kept across executes and reused (w/o
+///    // calling execute()) while its inputs are unchanged. Per-cycle
+///    // state (state/cycle, state/time, ...) doesn't count as a change.
+///    // Consumers get a copy of the cached output from serve_cached(),
+///    // which filters with non conduit::Node outputs must override.
+///    i["cacheable"] = {"true" | "false"};
+///
+///    // Optionally declare that execute() can run at the same time as
+///    // other filters (no unguarded shared or static state). When the
+///    // workspace uses more than one thread, filters that don't declare
+///    // this execute one at a time. (default: "false")
+///    i["thread_safe"] = {"true" | "false"};
 ///  }
 ///
 ///  2) Implement an execute() method:
@@ -126,6 +141,11 @@ class Graph;
 ///     set_output<Node>(my_result);
 ///     // the registry manages result lifetimes.
 ///
+///     // Or, if there is nothing to output for this execute, call skip()
+///     // instead. Filters that depend on this filter won't execute.
+///     // (With MPI, all tasks need to make the same choice.)
+///     skip();
+///
 ///  }
 ///
 ///  TODO: talk about optional verify_params()
@@ -159,6 +179,14 @@ public:
     virtual bool          verify_params(const conduit::Node &params,
                                         conduit::Node &info);
 
+    /// cacheable filters: called instead of execute() (with inputs set)
+    /// to set_output() a copy of the cached output for consumers, with
+    /// any per-cycle state refreshed from the current inputs.
+    /// the default handles conduit::Node outputs: it sets an external
+    /// view of the cached tree with each "state" replaced by a copy of
+    /// the matching state of the first input.
+    virtual void          serve_cached(Data &cached);
+
     //-------------------------------------------------------------------------
     // filter interface properties
     //-------------------------------------------------------------------------
@@ -174,6 +202,8 @@ public:
     std::string           type_name()   const;
     const conduit::Node  &port_names()  const;
     bool                  output_port() const;
+    bool                  cacheable()   const;
+    bool                  thread_safe() const;
 
     const conduit::Node  &default_params() const;
 
@@ -224,6 +254,12 @@ public:
         set_output(data);
     }
 
+    /// marks that this filter has no output for the current execute,
+    /// all filters that depend on it are skipped
+    void                   skip();
+    /// true if skip() was called during the current execute
+    bool                   skipped() const;
+
     /// generic access to wrapped output data
     Data                  &output();
 
@@ -289,6 +325,7 @@ private:
 
     conduit::Node                 m_props;
     Data                         *m_out;
+    bool                          m_skipped;
     std::map<std::string,Data*>   m_inputs;
 
 };
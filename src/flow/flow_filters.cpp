@@ -89,6 +89,11 @@ register_builtin()
     {
         Workspace::register_filter_type<Alias>();
     }
+
+    if(!Workspace::supports_filter_type<Gate>())
+    {
+        Workspace::register_filter_type<Gate>();
+    }
 #ifdef FLOW_PYTHON_ENABLED
     if(!Workspace::supports_filter_type<PythonScript>())
     {
@@ -87,7 +87,8 @@ namespace flow
 //-----------------------------------------------------------------------------
 Graph::Graph(Workspace *w)
 :m_workspace(w),
- m_filter_count(0)
+ m_filter_count(0),
+ m_version(0)
 {
     init();
 }
@@ -121,6 +122,7 @@ Graph::reset()
     m_filters.clear();
     m_edges.reset();
     init();
+    m_version++;
 
 }
 
@@ -194,6 +196,7 @@ Graph::add_filter(const std::string &filter_type,
     }
 
     m_filter_count++;
+    m_version++;
 
     return f;
 }
@@ -257,6 +260,7 @@ Graph::connect(const std::string &src_name,
 
     m_edges["in"][des_name][port_name] = src_name;
     m_edges["out"][src_name].append().set(des_name);
+    m_version++;
 }
 
 //-----------------------------------------------------------------------------
@@ -290,6 +294,18 @@ Graph::has_filter(const std::string &name)
     return itr != m_filters.end();
 }
 
+//-----------------------------------------------------------------------------
+Filter *
+Graph::filter(const std::string &name)
+{
+    std::map<std::string,Filter*>::iterator itr = m_filters.find(name);
+    if(itr == m_filters.end())
+    {
+        return NULL;
+    }
+    return itr->second;
+}
+
 //-----------------------------------------------------------------------------
 void
 Graph::remove_filter(const std::string &name)
@@ -310,6 +326,7 @@ Graph::remove_filter(const std::string &name)
 
     m_edges["in"].remove(name);
     m_edges["out"].remove(name);
+    m_version++;
 }
 
 //-----------------------------------------------------------------------------
@@ -342,6 +359,13 @@ Graph::filters()
 }
 
 
+//-----------------------------------------------------------------------------
+int
+Graph::version() const
+{
+    return m_version;
+}
+
 //-----------------------------------------------------------------------------
 void
 Graph::filters(Node &out) const
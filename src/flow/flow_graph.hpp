@@ -120,6 +120,10 @@ public:
     /// check if this graph has a filter with passed name
     bool has_filter(const std::string &name);
 
+    /// access filter with passed name
+    /// (returns NULL if the graph has no filter with passed name)
+    Filter *filter(const std::string &name);
+
     /// remove if filter with passed name from this graph
     void remove_filter(const std::string &name);
 
@@ -197,11 +201,16 @@ private:
 
     std::map<std::string,Filter*> &filters();
 
+    /// incremented each time filters or connections change, used
+    /// by the workspace to detect stale execution plans
+    int                  version() const;
+
 
     Workspace                       *m_workspace;
     conduit::Node                    m_edges;
     std::map<std::string,Filter*>    m_filters;
     int                              m_filter_count;
+    int                              m_version;
 
 };
 
@@ -56,6 +56,7 @@
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
+#include <mutex>
 
 using namespace conduit;
 using namespace std;
@@ -153,12 +154,20 @@ public:
 
     void   detach(const std::string &key);
 
+    void   forget(void *data_ptr);
+
     void   info(Node &out) const;
 
     void   reset();
 
+    // guards the map, so filters executing concurrently can
+    // add, fetch and consume entries
+    std::recursive_mutex &lock();
+
 private:
 
+    std::recursive_mutex           m_lock;
+
     std::map<void*,Value*>         m_values;
     std::map<std::string,Entry*>   m_entries;
 
@@ -369,6 +378,15 @@ Registry::Map::add(const std::string &key,
 
     void *data_ptr = data.data_ptr();
 
+    // untracked entries (refs_needed == -1) are never reaped by consume,
+    // clean up the old bookkeeping obj when they are re-added
+    std::map<std::string,Entry*>::iterator eitr = m_entries.find(key);
+    if( eitr != m_entries.end() && !eitr->second->ref()->tracked() )
+    {
+        delete eitr->second;
+        m_entries.erase(eitr);
+    }
+
     // check if we are already tracking this pointer
     std::map<void*,Value*>::iterator itr = m_values.find(data_ptr);
     if( itr != m_values.end() )
@@ -485,6 +503,43 @@ Registry::Map::detach(const std::string &key)
 }
 
 
+//-----------------------------------------------------------------------------
+void
+Registry::Map::forget(void *data_ptr)
+{
+    std::map<void*,Value*>::iterator vitr = m_values.find(data_ptr);
+    if(vitr == m_values.end())
+    {
+        return;
+    }
+
+    Value *value = vitr->second;
+
+    std::map<std::string,Entry*>::iterator eitr = m_entries.begin();
+    while(eitr != m_entries.end())
+    {
+        if(eitr->second->value() == value)
+        {
+            delete eitr->second;
+            m_entries.erase(eitr++);
+        }
+        else
+        {
+            eitr++;
+        }
+    }
+
+    delete value;
+    m_values.erase(vitr);
+}
+
+//-----------------------------------------------------------------------------
+std::recursive_mutex &
+Registry::Map::lock()
+{
+    return m_lock;
+}
+
 //-----------------------------------------------------------------------------
 void
 Registry::Map::info(Node &out) const
@@ -576,6 +631,7 @@ Registry::~Registry()
 bool
 Registry::has_entry(const std::string &key)
 {
+    std::lock_guard<std::recursive_mutex> guard(m_map->lock());
     return m_map->has_entry(key);
 }
 
@@ -583,6 +639,7 @@ Registry::has_entry(const std::string &key)
 void
 Registry::consume(const std::string &key)
 {
+    std::lock_guard<std::recursive_mutex> guard(m_map->lock());
     if(m_map->has_entry(key))
     {
         m_map->dec(key);
@@ -593,17 +650,27 @@ Registry::consume(const std::string &key)
 void
 Registry::detach(const std::string &key)
 {
+    std::lock_guard<std::recursive_mutex> guard(m_map->lock());
     if(m_map->has_entry(key))
     {
         m_map->detach(key);
     }
 }
 
+//-----------------------------------------------------------------------------
+void
+Registry::forget(void *data_ptr)
+{
+    std::lock_guard<std::recursive_mutex> guard(m_map->lock());
+    m_map->forget(data_ptr);
+}
+
 
 //-----------------------------------------------------------------------------
 void
 Registry::reset()
 {
+    std::lock_guard<std::recursive_mutex> guard(m_map->lock());
     m_map->reset();
 }
 
@@ -612,6 +679,7 @@ Registry::reset()
 void
 Registry::info(Node &out) const
 {
+    std::lock_guard<std::recursive_mutex> guard(m_map->lock());
     m_map->info(out);
 }
 
@@ -640,6 +708,7 @@ Registry::print() const
 Data &
 Registry::fetch(const std::string &key)
 {
+    std::lock_guard<std::recursive_mutex> guard(m_map->lock());
     if(!m_map->has_entry(key))
     {
         print();
@@ -655,6 +724,7 @@ Registry::add(const std::string &key,
               Data &data,
               int refs_needed)
 {
+    std::lock_guard<std::recursive_mutex> guard(m_map->lock());
     if(m_map->has_entry(key))
     {
         CONDUIT_WARN("Attempt to overwrite existing entry with key: " << key);
@@ -118,6 +118,9 @@ namespace flow
 // life will be managed by the registry
 // output()->set(my_new_data)
 
+// all registry methods are thread safe, filters executing concurrently
+// (see Workspace::set_num_threads) share the workspace's registry.
+
 //-----------------------------------------------------------------------------
 class FLOW_API Registry
 {
@@ -166,6 +169,10 @@ public:
     /// removes entry from that data store w/o releasing data.
     void           detach(const std::string &key);
 
+    /// removes all entries that refer to the given data pointer
+    /// w/o releasing data.
+    void           forget(void *data_ptr);
+
     /// clears registry entries and releases any outstanding
     /// tracked data refs.
     void           reset();
@@ -57,6 +57,13 @@
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 
 #include "perfstubs_api/Timer.h"
 
@@ -75,22 +82,364 @@ namespace flow
 // we will try this strategy.
 int Workspace::m_default_mpi_comm = -1;
 
+//-----------------------------------------------------------------------------
+// helpers used to fingerprint filter inputs
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+hash_combine(size_t &seed, size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+//-----------------------------------------------------------------------------
+void
+hash_leaf_pointers(const Node &n, size_t &fp)
+{
+    const index_t num_children = n.number_of_children();
+    if(num_children == 0)
+    {
+        hash_combine(fp, std::hash<const void*>()(n.data_ptr()));
+        return;
+    }
+
+    for(index_t i = 0; i < num_children; i++)
+    {
+        hash_leaf_pointers(n.child(i), fp);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// fingerprints a tree using the schema, data pointers and generation
+// counter of each versioned (sub)tree (those with "state/generation").
+// per-cycle state (cycle, time, ...) is left out, cached outputs get
+// it refreshed when they are served (see Filter::serve_cached).
+// returns false if part of the tree is not versioned.
+//-----------------------------------------------------------------------------
+static bool
+node_fingerprint(const Node &n, size_t &fp)
+{
+    if(n.has_path("state/generation"))
+    {
+        hash_combine(fp, (size_t)n["state/generation"].to_uint64());
+        for(index_t i = 0; i < n.number_of_children(); i++)
+        {
+            const Node &child = n.child(i);
+            if(child.name() != "state")
+            {
+                hash_combine(fp, std::hash<std::string>()(child.name()));
+                hash_combine(fp,
+                    std::hash<std::string>()(child.schema().to_json()));
+                hash_leaf_pointers(child, fp);
+            }
+        }
+        return true;
+    }
+
+    const index_t num_children = n.number_of_children();
+    if(num_children == 0)
+    {
+        return false;
+    }
+
+    for(index_t i = 0; i < num_children; i++)
+    {
+        if(!node_fingerprint(n.child(i), fp))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+class Workspace::FilterCache
+{
+    public:
+
+        // a cached output either aliases one of the filter's
+        // inputs (alias_port != -1) or is owned by the cache
+        struct Entry
+        {
+            size_t  fingerprint;
+            int     alias_port;
+            Data   *data;
+            bool    used;
+        };
+
+        FilterCache(Registry &registry);
+        ~FilterCache();
+
+        bool   enabled() const;
+        void   set_enabled(bool enabled);
+        void   set_consensus_method(CacheConsensusMethod m);
+
+        // returns the entry for the given filter if its fingerprint
+        // matches, otherwise NULL
+        Entry *lookup(const std::string &f_name,
+                      size_t fingerprint);
+
+        // combines the local hit with the result of other tasks
+        bool   consensus(bool local_hit);
+
+        // replaces the entry for the given filter
+        void   store(const std::string &f_name,
+                     size_t fingerprint,
+                     int alias_port,
+                     Data *data);
+
+        // releases entries that were not used since the last prune
+        void   prune();
+        // releases all entries
+        void   reset();
+
+        void   info(conduit::Node &out) const;
+
+    private:
+
+        void   release(Entry &entry);
+
+        Registry                     &m_registry;
+        bool                          m_enabled;
+        CacheConsensusMethod          m_consensus;
+        std::map<std::string,Entry>   m_entries;
+        std::mutex                    m_lock;
+};
+
+//-----------------------------------------------------------------------------
+Workspace::FilterCache::FilterCache(Registry &registry)
+: m_registry(registry),
+  m_enabled(false),
+  m_consensus(NULL)
+{
+    // empty
+}
+
+//-----------------------------------------------------------------------------
+Workspace::FilterCache::~FilterCache()
+{
+    reset();
+}
+
+//-----------------------------------------------------------------------------
+bool
+Workspace::FilterCache::enabled() const
+{
+    return m_enabled;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::FilterCache::set_enabled(bool enabled)
+{
+    m_enabled = enabled;
+    if(!m_enabled)
+    {
+        reset();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::FilterCache::set_consensus_method(CacheConsensusMethod m)
+{
+    m_consensus = m;
+}
+
+//-----------------------------------------------------------------------------
+Workspace::FilterCache::Entry *
+Workspace::FilterCache::lookup(const std::string &f_name,
+                               size_t fingerprint)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    std::map<std::string,Entry>::iterator itr = m_entries.find(f_name);
+    if(itr == m_entries.end() || itr->second.fingerprint != fingerprint)
+    {
+        return NULL;
+    }
+
+    itr->second.used = true;
+    return &itr->second;
+}
+
+//-----------------------------------------------------------------------------
+bool
+Workspace::FilterCache::consensus(bool local_hit)
+{
+    if(m_consensus == NULL)
+    {
+        return local_hit;
+    }
+    return m_consensus(local_hit);
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::FilterCache::store(const std::string &f_name,
+                              size_t fingerprint,
+                              int alias_port,
+                              Data *data)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    std::map<std::string,Entry>::iterator itr = m_entries.find(f_name);
+    if(itr != m_entries.end())
+    {
+        release(itr->second);
+    }
+
+    Entry &entry = m_entries[f_name];
+    entry.fingerprint = fingerprint;
+    entry.alias_port  = alias_port;
+    entry.data        = data;
+    entry.used        = true;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::FilterCache::prune()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    std::map<std::string,Entry>::iterator itr = m_entries.begin();
+    while(itr != m_entries.end())
+    {
+        if(!itr->second.used)
+        {
+            release(itr->second);
+            m_entries.erase(itr++);
+        }
+        else
+        {
+            itr->second.used = false;
+            itr++;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::FilterCache::reset()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    std::map<std::string,Entry>::iterator itr;
+    for(itr = m_entries.begin(); itr != m_entries.end(); itr++)
+    {
+        release(itr->second);
+    }
+    m_entries.clear();
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::FilterCache::release(Entry &entry)
+{
+    if(entry.data != NULL)
+    {
+        // make sure the registry doesn't hold on to the stale pointer
+        m_registry.forget(entry.data->data_ptr());
+        entry.data->release();
+        delete entry.data;
+        entry.data = NULL;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::FilterCache::info(Node &out) const
+{
+    out.reset();
+    out["enabled"] = m_enabled ? "true" : "false";
+
+    std::map<std::string,Entry>::const_iterator itr;
+    for(itr = m_entries.begin(); itr != m_entries.end(); itr++)
+    {
+        Node &ent = out["entries"][itr->first];
+        ent["fingerprint"] = (uint64)itr->second.fingerprint;
+        if(itr->second.alias_port != -1)
+        {
+            ent["alias_port"] = itr->second.alias_port;
+        }
+        else
+        {
+            itr->second.data->info(ent["data"]);
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 class Workspace::ExecutionPlan
 {
     public:
 
+        // a single filter exec, with the filter pointer and the
+        // registry keys that feed its input ports resolved up front
+        struct Step
+        {
+            Filter                   *filter;
+            int                       uref;
+            std::vector<std::string>  port_names;
+            std::vector<std::string>  input_names;
+            // indices of the steps that produce each input
+            std::vector<int>          producers;
+            // indices of the steps that consume this step's output
+            // (one entry per connected input port)
+            std::vector<int>          dependents;
+        };
+
+        ExecutionPlan();
+        ~ExecutionPlan();
+
         static void generate(Graph &g,
                              conduit::Node &traversals);
 
+        // flattens the graph traversals into a list of steps
+        void                     compile(Graph &g);
+        // true if the steps were compiled from the current graph state
+        bool                     valid(const Graph &g) const;
+        const std::vector<Step> &steps() const;
+
+        // executes all steps, records the exec time of each step.
+        // when num_threads > 1, steps run as soon as their inputs are
+        // available using a pool of num_threads worker threads.
+        // if a cache is passed, cacheable filters are memoized.
+        // steps downstream of a filter that called skip() don't execute.
+        void                     execute(Registry &registry,
+                                         FilterCache *cache,
+                                         int num_threads,
+                                         std::vector<float> &step_times);
+
     private:
-        ExecutionPlan();
-        ~ExecutionPlan();
+
+        class Scheduler;
+
+        // executes a single step, returns the elapsed time
+        float                    execute_step(int step_idx,
+                                              Registry &registry);
+
+        // computes the fingerprint of a step's params and inputs,
+        // returns false if any input can't be fingerprinted
+        bool                     fingerprint(int step_idx,
+                                             Registry &registry,
+                                             size_t &fp);
+
+        // asks a cacheable filter to set a copy of its cached output
+        static void              serve_cached(Filter *f,
+                                              Data &cached);
 
         static void bf_topo_sort_visit(Graph &graph,
                                        const std::string &filter_name,
                                        conduit::Node &tags,
                                        conduit::Node &tarv);
+
+        std::vector<Step>  m_steps;
+        int                m_graph_version;
+
+        // per execute state
+        FilterCache         *m_cache;
+        std::vector<size_t>  m_fingerprints;
+        std::vector<int>     m_has_fingerprint;
+        std::vector<int>     m_skipped;
 };
 
 //-----------------------------------------------------------------------------
@@ -113,6 +462,9 @@ std::map<std::string,FilterFactoryMethod> Workspace::FilterFactory::m_filter_typ
 
 //-----------------------------------------------------------------------------
 Workspace::ExecutionPlan::ExecutionPlan()
+: m_steps(),
+  m_graph_version(-1),
+  m_cache(NULL)
 {
     // empty
 }
@@ -187,6 +539,465 @@ Workspace::ExecutionPlan::generate(Graph &graph,
 }
 
 
+//-----------------------------------------------------------------------------
+void
+Workspace::ExecutionPlan::compile(Graph &graph)
+{
+    m_steps.clear();
+    m_graph_version = -1;
+
+    Node traversals;
+    generate(graph,traversals);
+
+    NodeConstIterator travs_itr = traversals.children();
+    while(travs_itr.has_next())
+    {
+        NodeConstIterator trav_itr(&travs_itr.next());
+
+        while(trav_itr.has_next())
+        {
+            const Node &t = trav_itr.next();
+
+            Step step;
+            std::string f_name = trav_itr.name();
+            step.filter = graph.filters()[f_name];
+            step.uref   = t.to_int32();
+
+            NodeConstIterator ports_itr(&step.filter->port_names());
+            while(ports_itr.has_next())
+            {
+                std::string port_name = ports_itr.next().as_string();
+                step.port_names.push_back(port_name);
+                step.input_names.push_back(graph.edges_in(f_name)[port_name].as_string());
+            }
+
+            m_steps.push_back(step);
+        }
+    }
+
+    // producers always come before their consumers in the
+    // traversals, so we can resolve the dependents in one pass
+    std::map<std::string,int> step_ids;
+    for(size_t s = 0; s < m_steps.size(); s++)
+    {
+        Step &step = m_steps[s];
+        step_ids[step.filter->name()] = (int)s;
+
+        for(size_t p = 0; p < step.input_names.size(); p++)
+        {
+            std::map<std::string,int>::const_iterator producer_itr;
+            producer_itr = step_ids.find(step.input_names[p]);
+            if(producer_itr == step_ids.end())
+            {
+                CONDUIT_ERROR("Filter " << step.filter->detailed_name()
+                              << " input port '" << step.port_names[p]
+                              << "' is connected to unknown filter '"
+                              << step.input_names[p] << "'");
+            }
+            int producer = producer_itr->second;
+            step.producers.push_back(producer);
+            m_steps[producer].dependents.push_back((int)s);
+        }
+    }
+
+    m_graph_version = graph.version();
+}
+
+//-----------------------------------------------------------------------------
+bool
+Workspace::ExecutionPlan::valid(const Graph &graph) const
+{
+    return m_graph_version != -1 &&
+           m_graph_version == graph.version();
+}
+
+//-----------------------------------------------------------------------------
+const std::vector<Workspace::ExecutionPlan::Step> &
+Workspace::ExecutionPlan::steps() const
+{
+    return m_steps;
+}
+
+//-----------------------------------------------------------------------------
+bool
+Workspace::ExecutionPlan::fingerprint(int step_idx,
+                                      Registry &registry,
+                                      size_t &fp)
+{
+    const Step &step = m_steps[step_idx];
+    Filter *f = step.filter;
+
+    fp = std::hash<std::string>()(f->type_name());
+    hash_combine(fp, std::hash<std::string>()(f->params().to_json()));
+
+    for(size_t p = 0; p < step.input_names.size(); p++)
+    {
+        int producer = step.producers[p];
+        if(m_has_fingerprint[producer] != 0)
+        {
+            hash_combine(fp, m_fingerprints[producer]);
+            continue;
+        }
+
+        // the producer isn't memoized, look at the data itself
+        Data &data = registry.fetch(step.input_names[p]);
+        size_t input_fp = 0;
+        if(!data.check_type<Node>() ||
+           !node_fingerprint(*data.value<Node>(), input_fp))
+        {
+            return false;
+        }
+        hash_combine(fp, input_fp);
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::ExecutionPlan::serve_cached(Filter *f,
+                                       Data &cached)
+{
+    f->serve_cached(cached);
+    // the registry reaps what it is given, it must never see cached data
+    if(f->m_out == NULL || f->m_out->data_ptr() == cached.data_ptr())
+    {
+        CONDUIT_ERROR(f->detailed_name() << " serve_cached() must "
+                      "set_output() to a copy of the cached output");
+    }
+}
+
+//-----------------------------------------------------------------------------
+float
+Workspace::ExecutionPlan::execute_step(int step_idx,
+                                       Registry &registry)
+{
+    const Step &step = m_steps[step_idx];
+    Filter *f = step.filter;
+    const size_t num_ports = step.port_names.size();
+
+    // if any producer was skipped, so is this step. skipped producers
+    // never add their output, so consume is a no-op for those inputs
+    for(size_t p = 0; p < num_ports; p++)
+    {
+        if(m_skipped[step.producers[p]] != 0)
+        {
+            m_skipped[step_idx] = 1;
+            for(size_t c = 0; c < num_ports; c++)
+            {
+                registry.consume(step.input_names[c]);
+            }
+            return 0.f;
+        }
+    }
+
+    Timer t_flt_exec;
+
+    bool   use_cache = m_cache != NULL && f->cacheable() && f->output_port();
+    bool   has_fp    = false;
+    bool   cache_hit = false;
+    size_t fp = 0;
+
+    if(use_cache)
+    {
+        has_fp = fingerprint(step_idx, registry, fp);
+
+        FilterCache::Entry *entry = NULL;
+        if(has_fp)
+        {
+            entry = m_cache->lookup(f->name(), fp);
+        }
+
+        cache_hit = m_cache->consensus(entry != NULL);
+
+        if(cache_hit)
+        {
+            if(entry->alias_port != -1)
+            {
+                Data &input = registry.fetch(step.input_names[entry->alias_port]);
+                registry.add(f->name(), input, step.uref);
+            }
+            else
+            {
+                // the cache keeps the data, consumers get their own copy
+                // with state (cycle, time, ...) refreshed from the inputs
+                f->reset_inputs_and_output();
+                for(size_t p = 0; p < num_ports; p++)
+                {
+                    f->set_input(step.port_names[p],
+                                 &registry.fetch(step.input_names[p]));
+                }
+                serve_cached(f, *entry->data);
+                registry.add(f->name(), f->output(), step.uref);
+                f->reset_inputs_and_output();
+            }
+        }
+
+        if(has_fp)
+        {
+            m_fingerprints[step_idx]    = fp;
+            m_has_fingerprint[step_idx] = 1;
+        }
+    }
+
+    if(!cache_hit)
+    {
+        f->reset_inputs_and_output();
+
+        // fetch inputs from reg, attach to filter's ports
+        for(size_t p = 0; p < num_ports; p++)
+        {
+            f->set_input(step.port_names[p],
+                         &registry.fetch(step.input_names[p]));
+        }
+
+        // execute
+        {
+        std::stringstream ss;
+        ss << "flow:" << f->name();
+        PERFSTUBS_SCOPED_TIMER(ss.str());
+        f->execute();
+        }
+
+        if(f->skipped())
+        {
+            m_skipped[step_idx] = 1;
+        }
+        // if has output, set output
+        else if(f->output_port())
+        {
+            void *out_ptr = f->output().data_ptr();
+            if(out_ptr == NULL)
+            {
+                CONDUIT_ERROR("filter output is NULL, was set_output() called?");
+            }
+
+            if(use_cache && has_fp)
+            {
+                // check if the filter passed one of its inputs through
+                int alias_port = -1;
+                for(size_t p = 0; p < num_ports && alias_port == -1; p++)
+                {
+                    if(f->input((int)p).data_ptr() == out_ptr)
+                    {
+                        alias_port = (int)p;
+                    }
+                }
+
+                if(alias_port != -1)
+                {
+                    registry.add(f->name(),
+                                 f->output(),
+                                 step.uref);
+                    m_cache->store(f->name(), fp, alias_port, NULL);
+                }
+                else
+                {
+                    // the cache takes ownership of the output and
+                    // consumers get a copy, just like on a hit
+                    Data *cached = f->output().wrap(out_ptr);
+                    m_cache->store(f->name(), fp, -1, cached);
+                    serve_cached(f, *cached);
+                    registry.add(f->name(),
+                                 f->output(),
+                                 step.uref);
+                }
+            }
+            else
+            {
+                registry.add(f->name(),
+                             f->output(),
+                             step.uref);
+            }
+        }
+
+        f->reset_inputs_and_output();
+    }
+
+    float elapsed = t_flt_exec.elapsed();
+
+    // consume inputs
+    for(size_t p = 0; p < num_ports; p++)
+    {
+        registry.consume(step.input_names[p]);
+    }
+
+    return elapsed;
+}
+
+//-----------------------------------------------------------------------------
+// Scheduler runs steps whose inputs are ready on a set of worker threads
+//-----------------------------------------------------------------------------
+class Workspace::ExecutionPlan::Scheduler
+{
+    public:
+        Scheduler(ExecutionPlan &plan,
+                  Registry &registry,
+                  std::vector<float> &step_times);
+
+        void run(int num_threads);
+
+    private:
+        void worker();
+
+        ExecutionPlan          &m_plan;
+        Registry               &m_registry;
+        std::vector<float>     &m_step_times;
+
+        std::mutex              m_lock;
+        // held while executing filters that aren't thread safe
+        std::mutex              m_serial_lock;
+        std::condition_variable m_cond;
+        std::deque<int>         m_ready;
+        std::vector<int>        m_pending;
+        int                     m_completed;
+        bool                    m_failed;
+        std::exception_ptr      m_error;
+};
+
+//-----------------------------------------------------------------------------
+Workspace::ExecutionPlan::Scheduler::Scheduler(ExecutionPlan &plan,
+                                               Registry &registry,
+                                               std::vector<float> &step_times)
+: m_plan(plan),
+  m_registry(registry),
+  m_step_times(step_times),
+  m_completed(0),
+  m_failed(false)
+{
+    const int num_steps = (int)m_plan.m_steps.size();
+    m_pending.resize(num_steps);
+    for(int s = 0; s < num_steps; s++)
+    {
+        m_pending[s] = (int)m_plan.m_steps[s].input_names.size();
+        if(m_pending[s] == 0)
+        {
+            m_ready.push_back(s);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::ExecutionPlan::Scheduler::run(int num_threads)
+{
+    std::vector<std::thread> workers;
+    for(int t = 0; t < num_threads; t++)
+    {
+        workers.push_back(std::thread(&Scheduler::worker, this));
+    }
+
+    for(size_t t = 0; t < workers.size(); t++)
+    {
+        workers[t].join();
+    }
+
+    // forward the first error to the calling thread
+    if(m_failed)
+    {
+        std::rethrow_exception(m_error);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::ExecutionPlan::Scheduler::worker()
+{
+    const int num_steps = (int)m_plan.m_steps.size();
+
+    std::unique_lock<std::mutex> guard(m_lock);
+    while(true)
+    {
+        while(m_ready.empty() && !m_failed && m_completed < num_steps)
+        {
+            m_cond.wait(guard);
+        }
+
+        if(m_failed || m_completed == num_steps)
+        {
+            break;
+        }
+
+        int step_idx = m_ready.front();
+        m_ready.pop_front();
+
+        guard.unlock();
+        float elapsed = 0.f;
+        bool ok = true;
+        try
+        {
+            if(m_plan.m_steps[step_idx].filter->thread_safe())
+            {
+                elapsed = m_plan.execute_step(step_idx, m_registry);
+            }
+            else
+            {
+                std::lock_guard<std::mutex> serial_guard(m_serial_lock);
+                elapsed = m_plan.execute_step(step_idx, m_registry);
+            }
+        }
+        catch(...)
+        {
+            ok = false;
+            guard.lock();
+            if(!m_failed)
+            {
+                m_failed = true;
+                m_error  = std::current_exception();
+            }
+        }
+
+        if(ok)
+        {
+            guard.lock();
+            m_step_times[step_idx] = elapsed;
+            m_completed++;
+
+            // release any consumers that now have all of their inputs
+            const std::vector<int> &deps = m_plan.m_steps[step_idx].dependents;
+            for(size_t d = 0; d < deps.size(); d++)
+            {
+                if(--m_pending[deps[d]] == 0)
+                {
+                    m_ready.push_back(deps[d]);
+                }
+            }
+        }
+
+        m_cond.notify_all();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::ExecutionPlan::execute(Registry &registry,
+                                  FilterCache *cache,
+                                  int num_threads,
+                                  std::vector<float> &step_times)
+{
+    const int num_steps = (int)m_steps.size();
+    step_times.assign(num_steps, 0.f);
+
+    m_cache = cache;
+    m_fingerprints.assign(num_steps, 0);
+    m_has_fingerprint.assign(num_steps, 0);
+    m_skipped.assign(num_steps, 0);
+
+    if(num_threads <= 1 || num_steps <= 1)
+    {
+        // execute steps, in traversal order
+        for(int s = 0; s < num_steps; s++)
+        {
+            step_times[s] = execute_step(s, registry);
+        }
+    }
+    else
+    {
+        Scheduler scheduler(*this, registry, step_times);
+        scheduler.run(std::min(num_threads, num_steps));
+    }
+}
+
 //-----------------------------------------------------------------------------
 void
 Workspace::ExecutionPlan::bf_topo_sort_visit(Graph &graph,
@@ -253,16 +1064,21 @@ Workspace::ExecutionPlan::bf_topo_sort_visit(Graph &graph,
 Workspace::Workspace()
 :m_graph(this),
  m_registry(),
+ m_plan(NULL),
+ m_cache(NULL),
+ m_num_threads(1),
  m_timing_exec_count(0),
  m_timing_info()
 {
-
+    m_plan  = new ExecutionPlan();
+    m_cache = new FilterCache(m_registry);
 }
 
 //-----------------------------------------------------------------------------
 Workspace::~Workspace()
 {
-
+    delete m_plan;
+    delete m_cache;
 }
 
 //-----------------------------------------------------------------------------
@@ -307,74 +1123,30 @@ void
 Workspace::execute()
 {
     Timer t_total_exec;
-    Node traversals;
-    ExecutionPlan::generate(graph(),traversals);
-    // execute traversals
-    NodeIterator travs_itr = traversals.children();
 
-    while(travs_itr.has_next())
+    if(!m_plan->valid(graph()))
     {
-        NodeIterator trav_itr(&travs_itr.next());
-
-        while(trav_itr.has_next())
-        {
-            Node &t = trav_itr.next();
-
-            std::string  f_name = trav_itr.name();
-            int          uref   = t.to_int32();
-            Filter      *f      = graph().filters()[f_name];
-
-            f->reset_inputs_and_output();
-
-            // fetch inputs from reg, attach to filter's ports
-            NodeConstIterator ports_itr = NodeConstIterator(&f->port_names());
-            //registry().print();
-            std::vector<std::string> f_i_names;
-            while(ports_itr.has_next())
-            {
-                std::string port_name = ports_itr.next().as_string();
-                std::string f_input_name = graph().edges_in(f_name)[port_name].as_string();
-                f->set_input(port_name,&registry().fetch(f_input_name));
-            }
-
-            Timer t_flt_exec;
-            // execute
-            {
-            std::stringstream ss;
-            ss << "flow:" << f_name;
-            PERFSTUBS_SCOPED_TIMER(ss.str());
-            f->execute();
-            }
+        m_plan->compile(graph());
+    }
 
-            m_timing_info << m_timing_exec_count
-                          << " " << f->name()
-                          << " " << std::fixed << t_flt_exec.elapsed()
-                          <<"\n";
+    FilterCache *cache = m_cache->enabled() ? m_cache : NULL;
 
-            // if has output, set output
-            if(f->output_port())
-            {
-                if(f->output().data_ptr() == NULL)
-                {
-                    CONDUIT_ERROR("filter output is NULL, was set_output() called?");
-                }
+    std::vector<float> step_times;
+    m_plan->execute(registry(), cache, m_num_threads, step_times);
 
-                registry().add(f_name,
-                               f->output(),
-                               uref);
-            }
-
-            f->reset_inputs_and_output();
+    if(cache != NULL)
+    {
+        // release outputs of filters that were not used by this exec
+        cache->prune();
+    }
 
-            // consume inputs
-            ports_itr.to_front();
-            while(ports_itr.has_next())
-            {
-                std::string port_name = ports_itr.next().as_string();
-                std::string f_input_name = graph().edges_in(f_name)[port_name].as_string();
-                registry().consume(f_input_name);
-            }
-        }
+    const std::vector<ExecutionPlan::Step> &steps = m_plan->steps();
+    for(size_t s = 0; s < steps.size(); s++)
+    {
+        m_timing_info << m_timing_exec_count
+                      << " " << steps[s].filter->name()
+                      << " " << std::fixed << step_times[s]
+                      <<"\n";
     }
 
     m_timing_info << m_timing_exec_count
@@ -388,6 +1160,48 @@ Workspace::execute()
 }
 
 
+//-----------------------------------------------------------------------------
+void
+Workspace::set_num_threads(int num_threads)
+{
+    m_num_threads = num_threads > 0 ? num_threads : 1;
+}
+
+//-----------------------------------------------------------------------------
+int
+Workspace::num_threads() const
+{
+    return m_num_threads;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::set_cache_enabled(bool enabled)
+{
+    m_cache->set_enabled(enabled);
+}
+
+//-----------------------------------------------------------------------------
+bool
+Workspace::cache_enabled() const
+{
+    return m_cache->enabled();
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::reset_cache()
+{
+    m_cache->reset();
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::set_cache_consensus_method(CacheConsensusMethod m)
+{
+    m_cache->set_consensus_method(m);
+}
+
 //-----------------------------------------------------------------------------
 void
 Workspace::reset()
@@ -405,6 +1219,7 @@ Workspace::info(Node &out) const
 
     graph().info(out["graph"]);
     registry().info(out["registry"]);
+    m_cache->info(out["cache"]);
     out["timings"] = timing_info();
 }
 
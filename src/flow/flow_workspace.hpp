@@ -74,6 +74,21 @@ namespace flow
 ///
 //-----------------------------------------------------------------------------
 
+//-----------------------------------------------------------------------------
+/// Callback used to agree on a cache hit across tasks (e.g. across MPI
+/// tasks, since cacheable filters may issue collectives). Receives the
+/// local hit result and returns the result all tasks agree on.
+//-----------------------------------------------------------------------------
+typedef bool (*CacheConsensusMethod)(bool local_hit);
+
+//-----------------------------------------------------------------------------
+/// Hash helpers used to fingerprint filter inputs, shared with filters
+/// that memoize their own work across executes.
+//-----------------------------------------------------------------------------
+void FLOW_API hash_combine(size_t &seed, size_t value);
+/// combines the data pointer of each leaf of n into fp
+void FLOW_API hash_leaf_pointers(const conduit::Node &n, size_t &fp);
+
 //-----------------------------------------------------------------------------
 class FLOW_API Workspace
 {
@@ -102,8 +117,41 @@ public:
     void             traversals(conduit::Node &out);
 
     /// execute the filter graph.
+    ///
+    /// The execution plan (traversal order, filter pointers and
+    /// input port bindings) is compiled on first use and reused by
+    /// later calls until the graph is modified.
     void             execute();
 
+    /// set the number of threads used to execute the filter graph.
+    /// With more than one thread, filters in independent branches of
+    /// the graph execute concurrently, as soon as all of their inputs
+    /// are available. Only filters that declare "thread_safe" run at the
+    /// same time as other filters, all others execute one at a time.
+    /// (default: 1, filters execute serially in traversal order)
+    void             set_num_threads(int num_threads);
+    /// number of threads used to execute the filter graph
+    int              num_threads() const;
+
+    /// enable or disable memoization of the outputs of filters that
+    /// declare themselves cacheable. (default: disabled)
+    ///
+    /// A cached output is reused while the filter's params and inputs
+    /// are unchanged. Inputs are identified by the fingerprint of their
+    /// producer, or for conduit::Node inputs, by the schema, the data
+    /// pointers and the "state/generation" counter of each (sub)tree.
+    /// Trees without "state/generation" are never cached, bumping the
+    /// counter tells the workspace the data values changed.
+    ///
+    /// Cached outputs are kept alive across registry and graph resets.
+    void             set_cache_enabled(bool enabled);
+    /// true if memoization of filter outputs is enabled
+    bool             cache_enabled() const;
+    /// releases all cached filter outputs
+    void             reset_cache();
+    /// set the callback used to agree on cache hits across tasks
+    void             set_cache_consensus_method(CacheConsensusMethod m);
+
     /// reset the registry and graph
     void             reset();
 
@@ -188,9 +236,13 @@ private:
 
     class ExecutionPlan;
     class FilterFactory;
+    class FilterCache;
 
     Graph             m_graph;
     Registry          m_registry;
+    ExecutionPlan    *m_plan;
+    FilterCache      *m_cache;
+    int               m_num_threads;
     int               m_timing_exec_count;
     std::stringstream m_timing_info;
 
@@ -0,0 +1,753 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include <algorithm>
+#include <limits>
+
+#include <bin_compositor.hpp>
+#include <rover_exceptions.hpp>
+#include <utils/rover_logging.hpp>
+
+namespace rover
+{
+
+namespace detail
+{
+
+//
+// A partial that points at its bins where they already live
+//
+template<typename FloatType>
+struct BinFragment
+{
+  vtkm::Id         m_pixel_id;
+  FloatType        m_depth;
+  const FloatType *m_absorption;
+  const FloatType *m_emission;
+
+  bool operator < (const BinFragment<FloatType> &other) const
+  {
+    if(m_pixel_id != other.m_pixel_id)
+    {
+      return m_pixel_id < other.m_pixel_id;
+    }
+    return m_depth < other.m_depth;
+  }
+};
+
+template<typename FloatType>
+void
+fragments(const BinPartials<FloatType> &partials,
+          std::vector<BinFragment<FloatType>> &frags)
+{
+  const vtkm::Id size = partials.size();
+  const vtkm::Id num_bins = partials.m_num_bins;
+  frags.resize(size);
+  for(vtkm::Id i = 0; i < size; ++i)
+  {
+    frags[i].m_pixel_id = partials.m_pixel_ids[i];
+    frags[i].m_depth = partials.m_depths[i];
+    frags[i].m_absorption = &partials.m_absorption[i * num_bins];
+    frags[i].m_emission = partials.m_has_emission ? &partials.m_emission[i * num_bins] : NULL;
+  }
+}
+
+//
+// Blend the sorted fragments of each pixel front to back
+//
+template<typename InType, typename FloatType>
+void
+reduce(const std::vector<BinFragment<InType>> &frags,
+       BinPartials<FloatType> &result)
+{
+  const vtkm::Id num_frags = static_cast<vtkm::Id>(frags.size());
+  const int num_bins = result.m_num_bins;
+  const bool has_emission = result.m_has_emission;
+
+  std::vector<vtkm::Id> offsets;
+  for(vtkm::Id i = 0; i < num_frags; ++i)
+  {
+    if(i == 0 || frags[i].m_pixel_id != frags[i-1].m_pixel_id)
+    {
+      offsets.push_back(i);
+    }
+  }
+  const vtkm::Id size = static_cast<vtkm::Id>(offsets.size());
+  offsets.push_back(num_frags);
+
+  result.resize(size);
+
+#ifdef ROVER_ENABLE_OPENMP
+  #pragma omp parallel for
+#endif
+  for(vtkm::Id i = 0; i < size; ++i)
+  {
+    const vtkm::Id begin = offsets[i];
+    const vtkm::Id end = offsets[i + 1];
+    result.m_pixel_ids[i] = frags[begin].m_pixel_id;
+    result.m_depths[i] = frags[begin].m_depth;
+
+    FloatType *absorption = &result.m_absorption[i * num_bins];
+    FloatType *emission = has_emission ? &result.m_emission[i * num_bins] : NULL;
+    for(int b = 0; b < num_bins; ++b)
+    {
+      absorption[b] = 1;
+    }
+    if(has_emission)
+    {
+      for(int b = 0; b < num_bins; ++b)
+      {
+        emission[b] = 0;
+      }
+    }
+
+    for(vtkm::Id f = begin; f < end; ++f)
+    {
+      const BinFragment<InType> &frag = frags[f];
+      if(has_emission && frag.m_emission != NULL)
+      {
+        // emission is attenuated by everything in front of it
+        for(int b = 0; b < num_bins; ++b)
+        {
+          emission[b] += frag.m_emission[b] * absorption[b];
+        }
+      }
+      for(int b = 0; b < num_bins; ++b)
+      {
+        absorption[b] *= frag.m_absorption[b];
+      }
+    }
+  }
+}
+
+template<typename FloatType>
+void
+copy_partial(const BinPartials<FloatType> &src,
+             const vtkm::Id src_index,
+             BinPartials<FloatType> &dest,
+             const vtkm::Id dest_index)
+{
+  const vtkm::Id num_bins = src.m_num_bins;
+  dest.m_pixel_ids[dest_index] = src.m_pixel_ids[src_index];
+  dest.m_depths[dest_index] = src.m_depths[src_index];
+  std::copy(src.m_absorption.begin() + src_index * num_bins,
+            src.m_absorption.begin() + (src_index + 1) * num_bins,
+            dest.m_absorption.begin() + dest_index * num_bins);
+  if(src.m_has_emission)
+  {
+    std::copy(src.m_emission.begin() + src_index * num_bins,
+              src.m_emission.begin() + (src_index + 1) * num_bins,
+              dest.m_emission.begin() + dest_index * num_bins);
+  }
+}
+
+#ifdef ROVER_PARALLEL
+template<typename T> MPI_Datatype mpi_type();
+template<> MPI_Datatype mpi_type<vtkm::Float32>() { return MPI_FLOAT; }
+template<> MPI_Datatype mpi_type<vtkm::Float64>() { return MPI_DOUBLE; }
+template<> MPI_Datatype mpi_type<vtkm::Int32>() { return MPI_INT32_T; }
+template<> MPI_Datatype mpi_type<vtkm::Int64>() { return MPI_INT64_T; }
+
+const int BIN_COMPOSITOR_TAG = 0;
+
+//
+// MPI counts are ints, so the helpers below send and receive in
+// chunks of at most max_count elements
+//
+inline int
+chunk_size(const vtkm::Id count, const vtkm::Id offset, const vtkm::Id max_count)
+{
+  return static_cast<int>(std::max(vtkm::Id(0), std::min(max_count, count - offset)));
+}
+
+template<typename T>
+void
+sendrecv_chunked(const T *send_data,
+                 const vtkm::Id send_count,
+                 T *recv_data,
+                 const vtkm::Id recv_count,
+                 const int partner,
+                 const vtkm::Id max_count,
+                 MPI_Comm comm)
+{
+  // both partners know both counts, so they agree on the number of chunks
+  const vtkm::Id count = std::max(send_count, recv_count);
+  for(vtkm::Id offset = 0; offset < count; offset += max_count)
+  {
+    const int send_chunk = chunk_size(send_count, offset, max_count);
+    const int recv_chunk = chunk_size(recv_count, offset, max_count);
+    MPI_Sendrecv(send_chunk != 0 ? send_data + offset : send_data,
+                 send_chunk, mpi_type<T>(), partner, BIN_COMPOSITOR_TAG,
+                 recv_chunk != 0 ? recv_data + offset : recv_data,
+                 recv_chunk, mpi_type<T>(), partner, BIN_COMPOSITOR_TAG,
+                 comm, MPI_STATUS_IGNORE);
+  }
+}
+
+template<typename T>
+void
+send_chunked(const T *data,
+             const vtkm::Id count,
+             const int dest,
+             const vtkm::Id max_count,
+             MPI_Comm comm)
+{
+  for(vtkm::Id offset = 0; offset < count; offset += max_count)
+  {
+    MPI_Send(data + offset, chunk_size(count, offset, max_count),
+             mpi_type<T>(), dest, BIN_COMPOSITOR_TAG, comm);
+  }
+}
+
+template<typename T>
+void
+recv_chunked(T *data,
+             const vtkm::Id count,
+             const int source,
+             const vtkm::Id max_count,
+             MPI_Comm comm)
+{
+  for(vtkm::Id offset = 0; offset < count; offset += max_count)
+  {
+    MPI_Recv(data + offset, chunk_size(count, offset, max_count),
+             mpi_type<T>(), source, BIN_COMPOSITOR_TAG, comm, MPI_STATUS_IGNORE);
+  }
+}
+#endif
+
+} // namespace detail
+
+template<typename FloatType>
+BinCompositor<FloatType>::BinCompositor()
+  : m_num_bins(0),
+    m_has_emission(false),
+    m_max_message_size(std::numeric_limits<int>::max())
+{
+#ifdef ROVER_PARALLEL
+  m_comm_handle = MPI_COMM_WORLD;
+#endif
+}
+
+template<typename FloatType>
+BinCompositor<FloatType>::~BinCompositor()
+{
+}
+
+#ifdef ROVER_PARALLEL
+template<typename FloatType>
+void
+BinCompositor<FloatType>::set_comm_handle(MPI_Comm comm_handle)
+{
+  m_comm_handle = comm_handle;
+}
+#endif
+
+template<typename FloatType>
+void
+BinCompositor<FloatType>::set_max_message_size(const vtkm::Id max_message_size)
+{
+  if(max_message_size < 1 || max_message_size > std::numeric_limits<int>::max())
+  {
+    throw RoverException("Bin compositor: max message size must be in [1, INT_MAX]");
+  }
+  m_max_message_size = max_message_size;
+}
+template<typename FloatType>
+void
+BinCompositor<FloatType>::composite(std::vector<PartialImage<vtkm::Float32>> &partial_images,
+                                    const int num_bins,
+                                    const bool has_emission,
+                                    const vtkm::Id image_size,
+                                    BinPartials<FloatType> &result)
+{
+  vtkm::Id tile_begin, tile_end;
+  composite_images(partial_images, num_bins, has_emission, image_size,
+                   false, result, tile_begin, tile_end);
+}
+
+template<typename FloatType>
+void
+BinCompositor<FloatType>::composite(std::vector<PartialImage<vtkm::Float64>> &partial_images,
+                                    const int num_bins,
+                                    const bool has_emission,
+                                    const vtkm::Id image_size,
+                                    BinPartials<FloatType> &result)
+{
+  vtkm::Id tile_begin, tile_end;
+  composite_images(partial_images, num_bins, has_emission, image_size,
+                   false, result, tile_begin, tile_end);
+}
+
+template<typename FloatType>
+void
+BinCompositor<FloatType>::composite_tiles(std::vector<PartialImage<vtkm::Float32>> &partial_images,
+                                          const int num_bins,
+                                          const bool has_emission,
+                                          const vtkm::Id image_size,
+                                          BinPartials<FloatType> &result,
+                                          vtkm::Id &tile_begin,
+                                          vtkm::Id &tile_end)
+{
+  composite_images(partial_images, num_bins, has_emission, image_size,
+                   true, result, tile_begin, tile_end);
+}
+
+template<typename FloatType>
+void
+BinCompositor<FloatType>::composite_tiles(std::vector<PartialImage<vtkm::Float64>> &partial_images,
+                                          const int num_bins,
+                                          const bool has_emission,
+                                          const vtkm::Id image_size,
+                                          BinPartials<FloatType> &result,
+                                          vtkm::Id &tile_begin,
+                                          vtkm::Id &tile_end)
+{
+  composite_images(partial_images, num_bins, has_emission, image_size,
+                   true, result, tile_begin, tile_end);
+}
+
+template<typename FloatType>
+template<typename InType>
+void
+BinCompositor<FloatType>::composite_images(std::vector<PartialImage<InType>> &partial_images,
+                                           const int num_bins,
+                                           const bool has_emission,
+                                           const vtkm::Id image_size,
+                                           const bool tiled,
+                                           BinPartials<FloatType> &result,
+                                           vtkm::Id &tile_begin,
+                                           vtkm::Id &tile_end)
+{
+  m_num_bins = num_bins;
+  m_has_emission = has_emission;
+  result.m_num_bins = num_bins;
+  result.m_has_emission = has_emission;
+
+  BinPartials<FloatType> partials;
+  partials.m_num_bins = num_bins;
+  partials.m_has_emission = has_emission;
+
+  // partials are converted to FloatType here, so everything
+  // from the first blend on is done in FloatType
+  local_partials(partial_images, partials);
+
+#ifdef ROVER_PARALLEL
+  binary_swap(partials, image_size, tile_begin, tile_end);
+#else
+  tile_begin = 0;
+  tile_end = image_size;
+#endif
+  if(has_emission)
+  {
+    reduce(partials);
+  }
+
+#ifdef ROVER_PARALLEL
+  if(!tiled)
+  {
+    gather(partials, result);
+    return;
+  }
+#else
+  (void) tiled;
+#endif
+  std::swap(partials, result);
+}
+
+template<typename FloatType>
+template<typename InType>
+void
+BinCompositor<FloatType>::local_partials(std::vector<PartialImage<InType>> &partial_images,
+                                         BinPartials<FloatType> &result)
+{
+  const int num_images = static_cast<int>(partial_images.size());
+  size_t total = 0;
+  for(int i = 0; i < num_images; ++i)
+  {
+    total += static_cast<size_t>(partial_images[i].m_pixel_ids.GetNumberOfValues());
+  }
+
+  std::vector<detail::BinFragment<InType>> frags;
+  frags.reserve(total);
+
+  for(int i = 0; i < num_images; ++i)
+  {
+    PartialImage<InType> &image = partial_images[i];
+    const vtkm::Id size = image.m_pixel_ids.GetNumberOfValues();
+    if(size == 0)
+    {
+      continue;
+    }
+
+    if(image.m_buffer.GetNumChannels() != m_num_bins)
+    {
+      throw RoverException("Bin compositor: partial images must have the same number of bins");
+    }
+
+    const vtkm::Id *ids = get_vtkm_ptr(image.m_pixel_ids);
+    const InType *depths = get_vtkm_ptr(image.m_distances);
+    const InType *absorption = get_vtkm_ptr(image.m_buffer.Buffer);
+    const InType *emission = NULL;
+    if(m_has_emission && image.m_intensities.Buffer.GetNumberOfValues() != 0)
+    {
+      emission = get_vtkm_ptr(image.m_intensities.Buffer);
+    }
+
+    for(vtkm::Id p = 0; p < size; ++p)
+    {
+      detail::BinFragment<InType> frag;
+      frag.m_pixel_id = ids[p];
+      frag.m_depth = depths[p];
+      frag.m_absorption = absorption + p * m_num_bins;
+      frag.m_emission = emission != NULL ? emission + p * m_num_bins : NULL;
+      frags.push_back(frag);
+    }
+  }
+
+  std::sort(frags.begin(), frags.end());
+
+  if(!m_has_emission)
+  {
+    detail::reduce(frags, result);
+    return;
+  }
+
+  // keep every partial so they can be blended in depth order later
+  const vtkm::Id size = static_cast<vtkm::Id>(frags.size());
+  const vtkm::Id num_bins = m_num_bins;
+  result.resize(size);
+#ifdef ROVER_ENABLE_OPENMP
+  #pragma omp parallel for
+#endif
+  for(vtkm::Id i = 0; i < size; ++i)
+  {
+    result.m_pixel_ids[i] = frags[i].m_pixel_id;
+    result.m_depths[i] = frags[i].m_depth;
+    std::copy(frags[i].m_absorption,
+              frags[i].m_absorption + num_bins,
+              result.m_absorption.begin() + i * num_bins);
+    if(frags[i].m_emission != NULL)
+    {
+      std::copy(frags[i].m_emission,
+                frags[i].m_emission + num_bins,
+                result.m_emission.begin() + i * num_bins);
+    }
+    else
+    {
+      std::fill(result.m_emission.begin() + i * num_bins,
+                result.m_emission.begin() + (i + 1) * num_bins,
+                FloatType(0));
+    }
+  }
+}
+
+template<typename FloatType>
+void
+BinCompositor<FloatType>::reduce(BinPartials<FloatType> &partials)
+{
+  std::vector<detail::BinFragment<FloatType>> frags;
+  detail::fragments(partials, frags);
+
+  BinPartials<FloatType> result;
+  result.m_num_bins = m_num_bins;
+  result.m_has_emission = m_has_emission;
+  detail::reduce(frags, result);
+  std::swap(partials, result);
+}
+
+template<typename FloatType>
+void
+BinCompositor<FloatType>::merge(const BinPartials<FloatType> &a,
+                                const vtkm::Id begin,
+                                const vtkm::Id end,
+                                const BinPartials<FloatType> &b,
+                                BinPartials<FloatType> &result)
+{
+  const vtkm::Id b_size = b.size();
+  result.m_num_bins = m_num_bins;
+  result.m_has_emission = m_has_emission;
+  result.resize((end - begin) + b_size);
+
+  vtkm::Id ia = begin;
+  vtkm::Id ib = 0;
+  vtkm::Id out = 0;
+  while(ia < end || ib < b_size)
+  {
+    bool take_a;
+    if(ia == end)
+    {
+      take_a = false;
+    }
+    else if(ib == b_size)
+    {
+      take_a = true;
+    }
+    else if(a.m_pixel_ids[ia] != b.m_pixel_ids[ib])
+    {
+      take_a = a.m_pixel_ids[ia] < b.m_pixel_ids[ib];
+    }
+    else
+    {
+      take_a = a.m_depths[ia] <= b.m_depths[ib];
+    }
+
+    if(take_a)
+    {
+      detail::copy_partial(a, ia++, result, out++);
+    }
+    else
+    {
+      detail::copy_partial(b, ib++, result, out++);
+    }
+  }
+}
+
+#ifdef ROVER_PARALLEL
+template<typename FloatType>
+void
+BinCompositor<FloatType>::exchange(const BinPartials<FloatType> &partials,
+                                   const vtkm::Id begin,
+                                   const vtkm::Id end,
+                                   const int partner,
+                                   BinPartials<FloatType> &recv)
+{
+  const vtkm::Id send_count = end - begin;
+  vtkm::Id recv_count = 0;
+  MPI_Sendrecv(&send_count, 1, detail::mpi_type<vtkm::Id>(), partner,
+               detail::BIN_COMPOSITOR_TAG,
+               &recv_count, 1, detail::mpi_type<vtkm::Id>(), partner,
+               detail::BIN_COMPOSITOR_TAG,
+               m_comm_handle, MPI_STATUS_IGNORE);
+
+  recv.m_num_bins = m_num_bins;
+  recv.m_has_emission = m_has_emission;
+  recv.resize(recv_count);
+
+  const vtkm::Id num_bins = m_num_bins;
+  detail::sendrecv_chunked(partials.m_pixel_ids.data() + begin, send_count,
+                           recv.m_pixel_ids.data(), recv_count,
+                           partner, m_max_message_size, m_comm_handle);
+
+  detail::sendrecv_chunked(partials.m_depths.data() + begin, send_count,
+                           recv.m_depths.data(), recv_count,
+                           partner, m_max_message_size, m_comm_handle);
+
+  detail::sendrecv_chunked(partials.m_absorption.data() + begin * num_bins,
+                           send_count * num_bins,
+                           recv.m_absorption.data(),
+                           recv_count * num_bins,
+                           partner, m_max_message_size, m_comm_handle);
+
+  if(m_has_emission)
+  {
+    detail::sendrecv_chunked(partials.m_emission.data() + begin * num_bins,
+                             send_count * num_bins,
+                             recv.m_emission.data(),
+                             recv_count * num_bins,
+                             partner, m_max_message_size, m_comm_handle);
+  }
+}
+
+template<typename FloatType>
+void
+BinCompositor<FloatType>::binary_swap(BinPartials<FloatType> &partials,
+                                      const vtkm::Id image_size,
+                                      vtkm::Id &tile_begin,
+                                      vtkm::Id &tile_end)
+{
+  int rank = 0;
+  int num_ranks = 1;
+  MPI_Comm_rank(m_comm_handle, &rank);
+  MPI_Comm_size(m_comm_handle, &num_ranks);
+
+  int pow2 = 1;
+  while(pow2 * 2 <= num_ranks)
+  {
+    pow2 *= 2;
+  }
+
+  BinPartials<FloatType> recv;
+  BinPartials<FloatType> merged;
+
+  //
+  // fold the ranks past the largest power of two into the others
+  //
+  if(rank >= pow2)
+  {
+    exchange(partials, 0, partials.size(), rank - pow2, recv);
+    partials.resize(0);
+    tile_begin = 0;
+    tile_end = 0;
+    return;
+  }
+  else if(rank + pow2 < num_ranks)
+  {
+    exchange(partials, 0, 0, rank + pow2, recv);
+    merge(partials, 0, partials.size(), recv, merged);
+    std::swap(partials, merged);
+    if(!m_has_emission)
+    {
+      reduce(partials);
+    }
+  }
+
+  //
+  // each round keeps half of the current pixel range and
+  // sends the other half to the partner
+  //
+  vtkm::Id low = 0;
+  vtkm::Id high = image_size;
+  for(int step = 1; step < pow2; step *= 2)
+  {
+    const int partner = rank ^ step;
+    const vtkm::Id mid = low + (high - low) / 2;
+    const vtkm::Id split = static_cast<vtkm::Id>(std::lower_bound(partials.m_pixel_ids.begin(),
+                                                                  partials.m_pixel_ids.end(),
+                                                                  mid) - partials.m_pixel_ids.begin());
+    const vtkm::Id size = partials.size();
+    if((rank & step) == 0)
+    {
+      exchange(partials, split, size, partner, recv);
+      merge(partials, 0, split, recv, merged);
+      high = mid;
+    }
+    else
+    {
+      exchange(partials, 0, split, partner, recv);
+      merge(partials, split, size, recv, merged);
+      low = mid;
+    }
+    std::swap(partials, merged);
+    if(!m_has_emission)
+    {
+      reduce(partials);
+    }
+  }
+  tile_begin = low;
+  tile_end = high;
+}
+
+//
+// Gathers the partials on rank 0 in rank order. The total can exceed
+// what MPI_Gatherv can address, so ranks send their partials in chunks.
+//
+template<typename FloatType>
+void
+BinCompositor<FloatType>::gather(BinPartials<FloatType> &partials,
+                                 BinPartials<FloatType> &result)
+{
+  int rank = 0;
+  int num_ranks = 1;
+  MPI_Comm_rank(m_comm_handle, &rank);
+  MPI_Comm_size(m_comm_handle, &num_ranks);
+
+  const vtkm::Id count = partials.size();
+  const vtkm::Id num_bins = m_num_bins;
+  std::vector<vtkm::Id> counts(num_ranks, 0);
+  MPI_Gather(&count, 1, detail::mpi_type<vtkm::Id>(),
+             counts.data(), 1, detail::mpi_type<vtkm::Id>(),
+             0, m_comm_handle);
+
+  result.m_num_bins = m_num_bins;
+  result.m_has_emission = m_has_emission;
+
+  if(rank != 0)
+  {
+    result.resize(0);
+    detail::send_chunked(partials.m_pixel_ids.data(), count,
+                         0, m_max_message_size, m_comm_handle);
+    detail::send_chunked(partials.m_depths.data(), count,
+                         0, m_max_message_size, m_comm_handle);
+    detail::send_chunked(partials.m_absorption.data(), count * num_bins,
+                         0, m_max_message_size, m_comm_handle);
+    if(m_has_emission)
+    {
+      detail::send_chunked(partials.m_emission.data(), count * num_bins,
+                           0, m_max_message_size, m_comm_handle);
+    }
+    return;
+  }
+
+  vtkm::Id total = 0;
+  for(int i = 0; i < num_ranks; ++i)
+  {
+    total += counts[i];
+  }
+  result.resize(total);
+
+  // rank 0 comes first, so its partials go to the front
+  std::copy(partials.m_pixel_ids.begin(), partials.m_pixel_ids.end(),
+            result.m_pixel_ids.begin());
+  std::copy(partials.m_depths.begin(), partials.m_depths.end(),
+            result.m_depths.begin());
+  std::copy(partials.m_absorption.begin(), partials.m_absorption.end(),
+            result.m_absorption.begin());
+  if(m_has_emission)
+  {
+    std::copy(partials.m_emission.begin(), partials.m_emission.end(),
+              result.m_emission.begin());
+  }
+
+  vtkm::Id offset = count;
+  for(int i = 1; i < num_ranks; ++i)
+  {
+    detail::recv_chunked(result.m_pixel_ids.data() + offset, counts[i],
+                         i, m_max_message_size, m_comm_handle);
+    detail::recv_chunked(result.m_depths.data() + offset, counts[i],
+                         i, m_max_message_size, m_comm_handle);
+    detail::recv_chunked(result.m_absorption.data() + offset * num_bins,
+                         counts[i] * num_bins,
+                         i, m_max_message_size, m_comm_handle);
+    if(m_has_emission)
+    {
+      detail::recv_chunked(result.m_emission.data() + offset * num_bins,
+                           counts[i] * num_bins,
+                           i, m_max_message_size, m_comm_handle);
+    }
+    offset += counts[i];
+  }
+}
+#endif
+
+//
+// Explicit instantiation
+template class BinCompositor<vtkm::Float32>;
+template class BinCompositor<vtkm::Float64>;
+
+} // namespace rover
@@ -0,0 +1,154 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef rover_bin_compositor_h
+#define rover_bin_compositor_h
+
+#include <vector>
+
+#include <bin_partials.hpp>
+#include <partial_image.hpp>
+#include <vtkm_typedefs.hpp>
+
+#ifdef ROVER_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace rover
+{
+//
+// Composites absorption and absorption + emission partials. Partials are
+// exchanged between ranks by halving the image (binary swap) and the
+// result is gathered on rank 0 (or left distributed as tiles). Bins are
+// never copied into per-pixel containers.
+//
+// Absorption is order independent, so partials are reduced to one per
+// pixel before every exchange. With emission, the partials along a ray
+// must be blended in depth order, so they are only reduced once each
+// rank holds every partial for its part of the image.
+//
+template<typename FloatType>
+class BinCompositor
+{
+public:
+  BinCompositor();
+  ~BinCompositor();
+
+#ifdef ROVER_PARALLEL
+  void set_comm_handle(MPI_Comm comm_handle);
+#endif
+  //
+  // Messages with more elements than this are split into chunks.
+  // (default: INT_MAX, the largest count MPI can send at once)
+  //
+  void set_max_message_size(const vtkm::Id max_message_size);
+  //
+  // result is only valid on rank 0. Partials traced in single precision
+  // can be composited in double precision.
+  //
+  void composite(std::vector<PartialImage<vtkm::Float32>> &partial_images,
+                 const int num_bins,
+                 const bool has_emission,
+                 const vtkm::Id image_size,
+                 BinPartials<FloatType> &result);
+  void composite(std::vector<PartialImage<vtkm::Float64>> &partial_images,
+                 const int num_bins,
+                 const bool has_emission,
+                 const vtkm::Id image_size,
+                 BinPartials<FloatType> &result);
+  //
+  // Same as composite, but skips the gather. Each rank keeps the
+  // composited pixels [tile_begin, tile_end) it owns after the swap.
+  //
+  void composite_tiles(std::vector<PartialImage<vtkm::Float32>> &partial_images,
+                       const int num_bins,
+                       const bool has_emission,
+                       const vtkm::Id image_size,
+                       BinPartials<FloatType> &result,
+                       vtkm::Id &tile_begin,
+                       vtkm::Id &tile_end);
+  void composite_tiles(std::vector<PartialImage<vtkm::Float64>> &partial_images,
+                       const int num_bins,
+                       const bool has_emission,
+                       const vtkm::Id image_size,
+                       BinPartials<FloatType> &result,
+                       vtkm::Id &tile_begin,
+                       vtkm::Id &tile_end);
+protected:
+  template<typename InType>
+  void composite_images(std::vector<PartialImage<InType>> &partial_images,
+                        const int num_bins,
+                        const bool has_emission,
+                        const vtkm::Id image_size,
+                        const bool tiled,
+                        BinPartials<FloatType> &result,
+                        vtkm::Id &tile_begin,
+                        vtkm::Id &tile_end);
+  template<typename InType>
+  void local_partials(std::vector<PartialImage<InType>> &partial_images,
+                      BinPartials<FloatType> &result);
+  // blends all partials of a pixel into one
+  void reduce(BinPartials<FloatType> &partials);
+  // merge [begin, end) of a with b keeping the pixel id and depth order
+  void merge(const BinPartials<FloatType> &a,
+             const vtkm::Id begin,
+             const vtkm::Id end,
+             const BinPartials<FloatType> &b,
+             BinPartials<FloatType> &result);
+#ifdef ROVER_PARALLEL
+  void exchange(const BinPartials<FloatType> &partials,
+                const vtkm::Id begin,
+                const vtkm::Id end,
+                const int partner,
+                BinPartials<FloatType> &recv);
+  void binary_swap(BinPartials<FloatType> &partials,
+                   const vtkm::Id image_size,
+                   vtkm::Id &tile_begin,
+                   vtkm::Id &tile_end);
+  void gather(BinPartials<FloatType> &partials, BinPartials<FloatType> &result);
+
+  MPI_Comm m_comm_handle;
+#endif
+  int      m_num_bins;
+  bool     m_has_emission;
+  vtkm::Id m_max_message_size;
+};
+
+} // namespace rover
+#endif
@@ -0,0 +1,86 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef rover_bin_partials_h
+#define rover_bin_partials_h
+
+#include <vector>
+
+#include <vtkm/Types.h>
+
+namespace rover
+{
+//
+// Structure of arrays layout for energy partials. Partial i owns
+// m_pixel_ids[i], m_depths[i] and the num_bins contiguous values starting
+// at i * num_bins in the absorption and (optional) emission arrays.
+// Partials are kept sorted by pixel id and depth.
+//
+template<typename FloatType>
+struct BinPartials
+{
+  int                    m_num_bins;
+  bool                   m_has_emission;
+  std::vector<vtkm::Id>  m_pixel_ids;
+  std::vector<FloatType> m_depths;
+  std::vector<FloatType> m_absorption;
+  std::vector<FloatType> m_emission;
+
+  BinPartials()
+    : m_num_bins(0),
+      m_has_emission(false)
+  {}
+
+  vtkm::Id size() const
+  {
+    return static_cast<vtkm::Id>(m_pixel_ids.size());
+  }
+
+  void resize(const vtkm::Id size)
+  {
+    m_pixel_ids.resize(size);
+    m_depths.resize(size);
+    const size_t bins_size = static_cast<size_t>(size) * m_num_bins;
+    m_absorption.resize(bins_size);
+    m_emission.resize(m_has_emission ? bins_size : 0);
+  }
+};
+
+} // namespace rover
+#endif
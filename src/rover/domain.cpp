@@ -47,6 +47,8 @@
 
 namespace rover {
 Domain::Domain()
+  : m_domain_id(0),
+    m_mesh_generation(-1)
 {
   m_engine = std::make_shared<VolumeEngine>();
 }
@@ -79,9 +81,7 @@ Domain::set_render_settings(const RenderSettings &settings)
           settings.m_render_mode == energy)
   {
     ROVER_INFO("Render mode = energy");
-    auto engine = std::make_shared<EnergyEngine>();
-    engine->set_unit_scalar(settings.m_energy_settings.m_unit_scalar);
-    m_engine = engine;
+    m_engine = std::make_shared<EnergyEngine>();
   }
   else if(m_render_settings.m_render_mode != surface &&
           settings.m_render_mode == surface)
@@ -97,7 +97,26 @@ Domain::set_render_settings(const RenderSettings &settings)
   m_render_settings = settings;
   m_render_settings.print();
 
-  m_engine->set_data_set(m_data_set);
+  if(m_engine_cache != nullptr && m_mesh_generation >= 0)
+  {
+    set_cached_engine();
+  }
+  else
+  {
+    m_engine->set_data_set(m_data_set);
+  }
+
+  if(m_render_settings.m_render_mode == energy)
+  {
+    std::static_pointer_cast<EnergyEngine>(m_engine)->set_unit_scalar(
+      m_render_settings.m_energy_settings.m_unit_scalar);
+  }
+
+  if(m_render_settings.m_render_mode == volume)
+  {
+    std::static_pointer_cast<VolumeEngine>(m_engine)->set_macrocell_dims(
+      m_render_settings.m_volume_settings.m_macrocell_dims);
+  }
   set_engine_fields();
 
   if(m_render_settings.m_render_mode == volume)
@@ -121,11 +140,62 @@ void
 Domain::set_data_set(vtkmDataSet &dataset)
 {
   ROVER_INFO("Setting dataset");
-  m_engine->set_data_set(dataset);
+  // the engine gets the data set with the render settings
   m_data_set = dataset;
   m_domain_bounds = m_data_set.GetCoordinateSystem().GetBounds();
 }
 
+void
+Domain::set_domain_id(const vtkm::Id domain_id)
+{
+  m_domain_id = domain_id;
+}
+
+void
+Domain::set_engine_cache(std::shared_ptr<EngineCache> engine_cache,
+                         const vtkm::Int64 mesh_generation)
+{
+  m_engine_cache = engine_cache;
+  m_mesh_generation = mesh_generation;
+}
+
+//
+// Reuses the engine (and the mesh structures its tracer built) from a
+// previous frame if the mesh has not changed. Otherwise the engine
+// traces a data set owned by the cache so later frames can swap the
+// field values in place.
+//
+void
+Domain::set_cached_engine()
+{
+  std::vector<std::string> field_names;
+  field_names.push_back(m_render_settings.m_primary_field);
+  if(m_render_settings.m_secondary_field != "")
+  {
+    field_names.push_back(m_render_settings.m_secondary_field);
+  }
+
+  const RenderMode mode = m_render_settings.m_render_mode;
+  std::shared_ptr<Engine> engine = m_engine_cache->find(m_domain_id,
+                                                        m_mesh_generation,
+                                                        mode,
+                                                        field_names,
+                                                        m_data_set);
+  if(engine != nullptr)
+  {
+    m_engine = engine;
+    return;
+  }
+
+  vtkmDataSet tracer_data = m_engine_cache->add(m_domain_id,
+                                                m_mesh_generation,
+                                                mode,
+                                                field_names,
+                                                m_data_set,
+                                                m_engine);
+  m_engine->set_data_set(tracer_data);
+}
+
 void
 Domain::set_engine_fields()
 {
@@ -45,6 +45,7 @@
 #include <memory>
 
 #include <engine.hpp>
+#include <engine_cache.hpp>
 #include <rover_types.hpp>
 #include <vtkm_typedefs.hpp>
 
@@ -61,6 +62,10 @@ public:
   void init_rays(Ray32 &rays);
   void init_rays(Ray64 &rays);
   void set_data_set(vtkmDataSet &dataset);
+  void set_domain_id(const vtkm::Id domain_id);
+  // a negative mesh generation disables the cache
+  void set_engine_cache(std::shared_ptr<EngineCache> engine_cache,
+                        const vtkm::Int64 mesh_generation);
   void set_render_settings(const RenderSettings &setttings);
   void set_primary_range(const vtkmRange &range);
   void set_composite_background(bool on);
@@ -74,7 +79,11 @@ protected:
   vtkm::Bounds            m_global_bounds;
   vtkm::Bounds            m_domain_bounds;
   RenderSettings          m_render_settings;
+  vtkm::Id                m_domain_id;
+  std::shared_ptr<EngineCache> m_engine_cache;
+  vtkm::Int64             m_mesh_generation;
   void                    set_engine_fields();
+  void                    set_cached_engine();
 }; // class domain
 } // namespace rover
 #endif
@@ -0,0 +1,720 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#ifdef ROVER_PARALLEL
+#include <chrono>
+#include <thread>
+#endif
+
+#include <dynamic_scheduler.hpp>
+#include <rover_exceptions.hpp>
+#include <utils/rover_logging.hpp>
+
+namespace rover {
+
+namespace detail
+{
+
+#ifdef ROVER_PARALLEL
+const int RAY_TAG = 8201;
+// longest wait between polls for messages when a rank has no rays
+const int MAX_IDLE_MICROSECONDS = 1000;
+#endif
+// domains per leaf of the domain hierarchy
+const int BVH_LEAF_SIZE = 2;
+// deeper than any hierarchy built with median splits
+const int BVH_STACK_SIZE = 64;
+
+//
+// Distances along the ray at which it enters and leaves the bounds.
+// The entry is clamped to zero for origins inside the bounds.
+//
+template<typename RayType>
+bool
+ray_span(const vtkm::Bounds &bounds,
+         const RayType &ray,
+         vtkm::Float64 &enter,
+         vtkm::Float64 &exit)
+{
+  const vtkm::Range *ranges[3] = {&bounds.X, &bounds.Y, &bounds.Z};
+  enter = 0.;
+  exit = std::numeric_limits<vtkm::Float64>::infinity();
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    const vtkm::Float64 o = ray.m_origin[axis];
+    const vtkm::Float64 d = ray.m_dir[axis];
+    if(d == 0.)
+    {
+      if(o < ranges[axis]->Min || o > ranges[axis]->Max)
+      {
+        return false;
+      }
+      continue;
+    }
+    vtkm::Float64 t0 = (ranges[axis]->Min - o) / d;
+    vtkm::Float64 t1 = (ranges[axis]->Max - o) / d;
+    if(t0 > t1)
+    {
+      std::swap(t0, t1);
+    }
+    enter = std::max(enter, t0);
+    exit = std::min(exit, t1);
+  }
+  return enter <= exit;
+}
+
+} // namespace detail
+
+template<typename FloatType, typename AccumType>
+DynamicScheduler<FloatType, AccumType>::DynamicScheduler()
+  : m_domain_offset(0),
+    m_early_termination(false),
+    m_completed(0),
+    m_started(0),
+    m_batch_size(4096),
+    m_rank(0),
+    m_num_ranks(1)
+{
+}
+
+template<typename FloatType, typename AccumType>
+DynamicScheduler<FloatType, AccumType>::~DynamicScheduler()
+{
+}
+
+template<typename FloatType, typename AccumType>
+void
+DynamicScheduler<FloatType, AccumType>::trace_rays()
+{
+  build_domain_table();
+  Scheduler<FloatType, AccumType>::trace_rays();
+}
+
+//
+// Every rank needs the bounds of every domain to know where a ray goes
+// after it leaves a local domain. Domains are numbered by rank. The
+// hierarchy over the bounds is built once per trace, so finding a ray's
+// next domain costs about log(domains) box tests.
+//
+template<typename FloatType, typename AccumType>
+void
+DynamicScheduler<FloatType, AccumType>::build_domain_table()
+{
+  const int num_domains = static_cast<int>(this->m_domains.size());
+  std::vector<vtkm::Float64> local_bounds(num_domains * 6);
+  for(int i = 0; i < num_domains; ++i)
+  {
+    vtkm::Bounds bounds = this->m_domains[i].get_domain_bounds();
+    local_bounds[i * 6 + 0] = bounds.X.Min;
+    local_bounds[i * 6 + 1] = bounds.X.Max;
+    local_bounds[i * 6 + 2] = bounds.Y.Min;
+    local_bounds[i * 6 + 3] = bounds.Y.Max;
+    local_bounds[i * 6 + 4] = bounds.Z.Min;
+    local_bounds[i * 6 + 5] = bounds.Z.Max;
+  }
+
+  std::vector<vtkm::Float64> all_bounds;
+  std::vector<int> counts;
+#ifdef ROVER_PARALLEL
+  MPI_Comm_rank(this->m_comm_handle, &m_rank);
+  MPI_Comm_size(this->m_comm_handle, &m_num_ranks);
+  counts.resize(m_num_ranks);
+  MPI_Allgather(&num_domains, 1, MPI_INT, &counts[0], 1, MPI_INT, this->m_comm_handle);
+
+  std::vector<int> value_counts(m_num_ranks);
+  std::vector<int> value_offsets(m_num_ranks);
+  int total = 0;
+  for(int r = 0; r < m_num_ranks; ++r)
+  {
+    value_counts[r] = counts[r] * 6;
+    value_offsets[r] = total;
+    total += value_counts[r];
+  }
+  all_bounds.resize(total);
+  MPI_Allgatherv(num_domains == 0 ? NULL : &local_bounds[0],
+                 num_domains * 6,
+                 MPI_DOUBLE,
+                 total == 0 ? NULL : &all_bounds[0],
+                 &value_counts[0],
+                 &value_offsets[0],
+                 MPI_DOUBLE,
+                 this->m_comm_handle);
+#else
+  counts.push_back(num_domains);
+  all_bounds = local_bounds;
+#endif
+
+  m_domain_bounds.clear();
+  m_domain_owners.clear();
+  m_domain_offset = 0;
+  for(int r = 0; r < static_cast<int>(counts.size()); ++r)
+  {
+    if(r == m_rank)
+    {
+      m_domain_offset = static_cast<int>(m_domain_owners.size());
+    }
+    for(int i = 0; i < counts[r]; ++i)
+    {
+      const int index = static_cast<int>(m_domain_bounds.size()) * 6;
+      vtkm::Bounds bounds(all_bounds[index + 0], all_bounds[index + 1],
+                          all_bounds[index + 2], all_bounds[index + 3],
+                          all_bounds[index + 4], all_bounds[index + 5]);
+      m_domain_bounds.push_back(bounds);
+      m_domain_owners.push_back(r);
+    }
+  }
+
+  m_bvh_nodes.clear();
+  m_bvh_domains.resize(m_domain_bounds.size());
+  std::iota(m_bvh_domains.begin(), m_bvh_domains.end(), 0);
+  if(!m_bvh_domains.empty())
+  {
+    build_bvh(0, static_cast<int>(m_bvh_domains.size()));
+  }
+}
+
+//
+// Builds the node holding m_bvh_domains[begin, end) by splitting the
+// domain centers at the median of the longest axis, and returns its index
+//
+template<typename FloatType, typename AccumType>
+int
+DynamicScheduler<FloatType, AccumType>::build_bvh(const int begin, const int end)
+{
+  const int index = static_cast<int>(m_bvh_nodes.size());
+  m_bvh_nodes.push_back(BVHNode());
+
+  vtkm::Bounds bounds;
+  vtkm::Bounds centers;
+  for(int i = begin; i < end; ++i)
+  {
+    const vtkm::Bounds &domain = m_domain_bounds[m_bvh_domains[i]];
+    bounds.Include(domain);
+    centers.Include(domain.Center());
+  }
+
+  BVHNode node;
+  node.m_bounds = bounds;
+  node.m_left = -1;
+  node.m_right = -1;
+  node.m_begin = begin;
+  node.m_end = end;
+
+  if(end - begin > detail::BVH_LEAF_SIZE)
+  {
+    const vtkm::Range *ranges[3] = {&centers.X, &centers.Y, &centers.Z};
+    int axis = 0;
+    for(int a = 1; a < 3; ++a)
+    {
+      if(ranges[a]->Length() > ranges[axis]->Length())
+      {
+        axis = a;
+      }
+    }
+
+    const int middle = begin + (end - begin) / 2;
+    std::nth_element(m_bvh_domains.begin() + begin,
+                     m_bvh_domains.begin() + middle,
+                     m_bvh_domains.begin() + end,
+                     [&](int a, int b)
+                     {
+                       return m_domain_bounds[a].Center()[axis] <
+                              m_domain_bounds[b].Center()[axis];
+                     });
+    node.m_left = build_bvh(begin, middle);
+    node.m_right = build_bvh(middle, end);
+  }
+
+  m_bvh_nodes[index] = node;
+  return index;
+}
+
+template<typename FloatType, typename AccumType>
+void
+DynamicScheduler<FloatType, AccumType>::trace_view(const int width,
+                                                   const int height)
+{
+  const int num_domains = static_cast<int>(this->m_domains.size());
+  m_queues.clear();
+  m_queues.resize(num_domains);
+  m_early_termination = this->early_termination();
+  if(m_early_termination)
+  {
+    this->reset_opaque_depths();
+  }
+  m_completed = 0;
+  m_started = 0;
+
+  seed_rays();
+  ROVER_INFO("Dynamic scheduler: seeded "<<m_started<<" rays");
+
+#ifdef ROVER_PARALLEL
+  m_outgoing.clear();
+  m_outgoing.resize(m_num_ranks);
+
+  vtkm::Int64 total_started = 0;
+  MPI_Allreduce(&m_started, &total_started, 1, MPI_INT64_T, MPI_SUM, this->m_comm_handle);
+
+  //
+  // Every ray is completed exactly once, so the rays are done when the
+  // completed counts of all ranks add up to the number of rays. The sum
+  // is taken with a non-blocking reduction whenever a rank runs out of
+  // rays, and ranks keep receiving and tracing rays while it is pending.
+  //
+  // Idle ranks back off between polls so they do not spin on the
+  // network while other ranks are tracing.
+  //
+  vtkm::Int64 completed_snapshot = 0;
+  vtkm::Int64 total_completed = 0;
+  MPI_Request reduce_request = MPI_REQUEST_NULL;
+  int idle_microseconds = 0;
+  bool done = false;
+  while(!done)
+  {
+    receive_rays();
+    const int domain = largest_queue();
+    if(domain != -1)
+    {
+      trace_queue(domain, width, height);
+      idle_microseconds = 0;
+      continue;
+    }
+
+    flush_rays();
+    test_sends();
+    if(reduce_request == MPI_REQUEST_NULL)
+    {
+      completed_snapshot = m_completed;
+      MPI_Iallreduce(&completed_snapshot,
+                     &total_completed,
+                     1,
+                     MPI_INT64_T,
+                     MPI_SUM,
+                     this->m_comm_handle,
+                     &reduce_request);
+    }
+    int reduced = 0;
+    MPI_Test(&reduce_request, &reduced, MPI_STATUS_IGNORE);
+    if(reduced)
+    {
+      done = total_completed == total_started;
+    }
+
+    if(!done)
+    {
+      if(idle_microseconds > 0)
+      {
+        std::this_thread::sleep_for(std::chrono::microseconds(idle_microseconds));
+      }
+      idle_microseconds = std::min(std::max(1, idle_microseconds * 2),
+                                   detail::MAX_IDLE_MICROSECONDS);
+    }
+  }
+
+  // every ray was received, so the sends finish
+  while(!m_send_requests.empty())
+  {
+    MPI_Wait(&m_send_requests.front(), MPI_STATUS_IGNORE);
+    m_send_requests.pop_front();
+    m_send_buffers.pop_front();
+  }
+#else
+  int domain = largest_queue();
+  while(domain != -1)
+  {
+    trace_queue(domain, width, height);
+    domain = largest_queue();
+  }
+#endif
+  ROVER_INFO("Dynamic scheduler: completed "<<m_completed<<" rays");
+}
+
+//
+// Rays are generated for each local domain, and a rank keeps the rays
+// whose first domain it owns. Every rank generates the same ray for a
+// pixel, so each ray is started by exactly one rank.
+//
+template<typename FloatType, typename AccumType>
+void
+DynamicScheduler<FloatType, AccumType>::seed_rays()
+{
+  const int num_domains = static_cast<int>(this->m_domains.size());
+  for(int i = 0; i < num_domains; ++i)
+  {
+    vtkmRayTracing::Ray<FloatType> rays;
+    this->m_ray_generator->get_rays(rays, this->m_domains[i].get_domain_bounds());
+
+    const vtkm::Id num_rays = rays.NumRays;
+    auto origin_x = rays.OriginX.GetPortalConstControl();
+    auto origin_y = rays.OriginY.GetPortalConstControl();
+    auto origin_z = rays.OriginZ.GetPortalConstControl();
+    auto dir_x = rays.DirX.GetPortalConstControl();
+    auto dir_y = rays.DirY.GetPortalConstControl();
+    auto dir_z = rays.DirZ.GetPortalConstControl();
+    auto pixels = rays.PixelIdx.GetPortalConstControl();
+
+    std::vector<RayState> &queue = m_queues[i];
+    for(vtkm::Id r = 0; r < num_rays; ++r)
+    {
+      RayState ray;
+      ray.m_origin[0] = origin_x.Get(r);
+      ray.m_origin[1] = origin_y.Get(r);
+      ray.m_origin[2] = origin_z.Get(r);
+      ray.m_dir[0] = dir_x.Get(r);
+      ray.m_dir[1] = dir_y.Get(r);
+      ray.m_dir[2] = dir_z.Get(r);
+      ray.m_transmittance = 1.;
+      ray.m_pixel_id = pixels.Get(r);
+      ray.m_pad = 0;
+      ray.m_domain = next_domain(ray, -1);
+      if(ray.m_domain == m_domain_offset + i)
+      {
+        queue.push_back(ray);
+      }
+    }
+    m_started += static_cast<vtkm::Int64>(queue.size());
+  }
+}
+
+template<typename FloatType, typename AccumType>
+int
+DynamicScheduler<FloatType, AccumType>::largest_queue() const
+{
+  int largest = -1;
+  size_t size = 0;
+  for(size_t i = 0; i < m_queues.size(); ++i)
+  {
+    if(m_queues[i].size() > size)
+    {
+      size = m_queues[i].size();
+      largest = static_cast<int>(i);
+    }
+  }
+  return largest;
+}
+
+//
+// Trace the rays waiting for a local domain and send them on
+//
+template<typename FloatType, typename AccumType>
+void
+DynamicScheduler<FloatType, AccumType>::trace_queue(const int domain,
+                                                    const int width,
+                                                    const int height)
+{
+  std::vector<RayState> batch;
+  batch.swap(m_queues[domain]);
+  const int num_rays = static_cast<int>(batch.size());
+  const vtkm::Bounds &bounds = m_domain_bounds[m_domain_offset + domain];
+
+  // partials can share storage with the rays, so every batch gets new rays
+  vtkmRayTracing::Ray<FloatType> rays;
+  rays.Resize(num_rays, vtkm::cont::DeviceAdapterTagSerial());
+  auto origin_x = rays.OriginX.GetPortalControl();
+  auto origin_y = rays.OriginY.GetPortalControl();
+  auto origin_z = rays.OriginZ.GetPortalControl();
+  auto dir_x = rays.DirX.GetPortalControl();
+  auto dir_y = rays.DirY.GetPortalControl();
+  auto dir_z = rays.DirZ.GetPortalControl();
+  auto pixels = rays.PixelIdx.GetPortalControl();
+  auto hits = rays.HitIdx.GetPortalControl();
+  auto min_distance = rays.MinDistance.GetPortalControl();
+  auto max_distance = rays.MaxDistance.GetPortalControl();
+  auto status = rays.Status.GetPortalControl();
+
+#ifdef ROVER_ENABLE_OPENMP
+  #pragma omp parallel for
+#endif
+  for(int i = 0; i < num_rays; ++i)
+  {
+    const RayState &ray = batch[i];
+    vtkm::Float64 enter = 0.;
+    vtkm::Float64 exit = 0.;
+    detail::ray_span(bounds, ray, enter, exit);
+    origin_x.Set(i, static_cast<FloatType>(ray.m_origin[0]));
+    origin_y.Set(i, static_cast<FloatType>(ray.m_origin[1]));
+    origin_z.Set(i, static_cast<FloatType>(ray.m_origin[2]));
+    dir_x.Set(i, static_cast<FloatType>(ray.m_dir[0]));
+    dir_y.Set(i, static_cast<FloatType>(ray.m_dir[1]));
+    dir_z.Set(i, static_cast<FloatType>(ray.m_dir[2]));
+    pixels.Set(i, ray.m_pixel_id);
+    hits.Set(i, -2);
+    min_distance.Set(i, static_cast<FloatType>(enter));
+    max_distance.Set(i, static_cast<FloatType>(exit));
+    status.Set(i, vtkmRayTracing::RAY_ACTIVE);
+  }
+
+  this->m_domains[domain].init_rays(rays);
+  std::vector<vtkmRayTracing::PartialComposite<FloatType>> partials;
+  partials = this->m_domains[domain].partial_trace(rays);
+
+  if(m_early_termination)
+  {
+    // the pixels' opacity so far travels with the rays
+    for(int i = 0; i < num_rays; ++i)
+    {
+      this->m_transmittance[batch[i].m_pixel_id] = batch[i].m_transmittance;
+    }
+    this->update_opaque_depths(partials);
+    for(int i = 0; i < num_rays; ++i)
+    {
+      batch[i].m_transmittance = this->m_transmittance[batch[i].m_pixel_id];
+    }
+  }
+
+  for(size_t p = 0; p < partials.size(); ++p)
+  {
+    this->add_partial(partials[p], width, height);
+  }
+
+  for(int i = 0; i < num_rays; ++i)
+  {
+    route(batch[i], m_domain_offset + domain);
+  }
+}
+
+template<typename FloatType, typename AccumType>
+void
+DynamicScheduler<FloatType, AccumType>::route(RayState &ray, const int domain)
+{
+  if(m_early_termination && this->is_opaque(ray.m_transmittance))
+  {
+    ++m_completed;
+    return;
+  }
+
+  ray.m_domain = next_domain(ray, domain);
+  if(ray.m_domain == -1)
+  {
+    ++m_completed;
+    return;
+  }
+
+  const int owner = m_domain_owners[ray.m_domain];
+  if(owner == m_rank)
+  {
+    m_queues[ray.m_domain - m_domain_offset].push_back(ray);
+    return;
+  }
+#ifdef ROVER_PARALLEL
+  m_outgoing[owner].push_back(ray);
+  if(static_cast<int>(m_outgoing[owner].size()) >= m_batch_size)
+  {
+    send_rays(owner);
+  }
+#endif
+}
+
+//
+// The domains a ray goes through are ordered by the distance at which
+// it enters them (ties by domain id). Returns the domain after the given
+// one, or the first domain if it is -1, and -1 if there is none.
+//
+template<typename FloatType, typename AccumType>
+int
+DynamicScheduler<FloatType, AccumType>::next_domain(const RayState &ray,
+                                                    const int domain) const
+{
+  vtkm::Float64 current = -std::numeric_limits<vtkm::Float64>::infinity();
+  if(domain != -1)
+  {
+    vtkm::Float64 exit = 0.;
+    detail::ray_span(m_domain_bounds[domain], ray, current, exit);
+  }
+
+  int next = -1;
+  vtkm::Float64 next_enter = std::numeric_limits<vtkm::Float64>::infinity();
+  if(m_bvh_nodes.empty())
+  {
+    return next;
+  }
+
+  //
+  // A node contains its children, so they are entered no earlier and
+  // left no later than the node. Nodes left before the current domain
+  // is entered, or entered after the best domain so far, are skipped.
+  //
+  int stack[detail::BVH_STACK_SIZE];
+  int stack_size = 0;
+  stack[stack_size++] = 0;
+  while(stack_size > 0)
+  {
+    const BVHNode &node = m_bvh_nodes[stack[--stack_size]];
+    vtkm::Float64 node_enter = 0.;
+    vtkm::Float64 node_exit = 0.;
+    if(!detail::ray_span(node.m_bounds, ray, node_enter, node_exit) ||
+       node_exit < current ||
+       (next != -1 && node_enter > next_enter))
+    {
+      continue;
+    }
+
+    if(node.m_left != -1)
+    {
+      stack[stack_size++] = node.m_right;
+      stack[stack_size++] = node.m_left;
+      continue;
+    }
+
+    for(int d = node.m_begin; d < node.m_end; ++d)
+    {
+      const int i = m_bvh_domains[d];
+      vtkm::Float64 enter = 0.;
+      vtkm::Float64 exit = 0.;
+      if(!detail::ray_span(m_domain_bounds[i], ray, enter, exit))
+      {
+        continue;
+      }
+      const bool after = enter > current || (enter == current && i > domain);
+      const bool before_next = enter < next_enter || (enter == next_enter && i < next);
+      if(after && (next == -1 || before_next))
+      {
+        next = i;
+        next_enter = enter;
+      }
+    }
+  }
+  return next;
+}
+
+#ifdef ROVER_PARALLEL
+template<typename FloatType, typename AccumType>
+void
+DynamicScheduler<FloatType, AccumType>::send_rays(const int rank)
+{
+  m_send_buffers.push_back(std::vector<RayState>());
+  m_send_buffers.back().swap(m_outgoing[rank]);
+  m_send_requests.push_back(MPI_REQUEST_NULL);
+  std::vector<RayState> &buffer = m_send_buffers.back();
+  MPI_Isend(&buffer[0],
+            static_cast<int>(buffer.size() * sizeof(RayState)),
+            MPI_BYTE,
+            rank,
+            detail::RAY_TAG,
+            this->m_comm_handle,
+            &m_send_requests.back());
+}
+
+// sends the partially filled batches
+template<typename FloatType, typename AccumType>
+void
+DynamicScheduler<FloatType, AccumType>::flush_rays()
+{
+  for(int r = 0; r < m_num_ranks; ++r)
+  {
+    if(!m_outgoing[r].empty())
+    {
+      send_rays(r);
+    }
+  }
+}
+
+// releases the buffers of finished sends
+template<typename FloatType, typename AccumType>
+void
+DynamicScheduler<FloatType, AccumType>::test_sends()
+{
+  auto request = m_send_requests.begin();
+  auto buffer = m_send_buffers.begin();
+  while(request != m_send_requests.end())
+  {
+    int finished = 0;
+    MPI_Test(&(*request), &finished, MPI_STATUS_IGNORE);
+    if(finished)
+    {
+      request = m_send_requests.erase(request);
+      buffer = m_send_buffers.erase(buffer);
+    }
+    else
+    {
+      ++request;
+      ++buffer;
+    }
+  }
+}
+
+template<typename FloatType, typename AccumType>
+void
+DynamicScheduler<FloatType, AccumType>::receive_rays()
+{
+  int has_message = 1;
+  while(has_message)
+  {
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE,
+               detail::RAY_TAG,
+               this->m_comm_handle,
+               &has_message,
+               &status);
+    if(!has_message)
+    {
+      break;
+    }
+
+    int bytes = 0;
+    MPI_Get_count(&status, MPI_BYTE, &bytes);
+    std::vector<RayState> rays(bytes / sizeof(RayState));
+    MPI_Recv(&rays[0],
+             bytes,
+             MPI_BYTE,
+             status.MPI_SOURCE,
+             detail::RAY_TAG,
+             this->m_comm_handle,
+             MPI_STATUS_IGNORE);
+
+    for(size_t i = 0; i < rays.size(); ++i)
+    {
+      m_queues[rays[i].m_domain - m_domain_offset].push_back(rays[i]);
+    }
+  }
+}
+#endif
+
+//
+// Explicit instantiation
+template class DynamicScheduler<vtkm::Float32>;
+template class DynamicScheduler<vtkm::Float64>;
+template class DynamicScheduler<vtkm::Float32, vtkm::Float64>;
+}; // namespace rover
@@ -0,0 +1,149 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+#ifndef rover_dynamic_scheduler_h
+#define rover_dynamic_scheduler_h
+
+#include <scheduler.hpp>
+
+#ifdef ROVER_PARALLEL
+#include <list>
+#include <mpi.h>
+#endif
+
+namespace rover {
+//
+// Scheduler for local rays (or scattering): a ray is only ever in one
+// domain. Each ray starts on the rank that owns the first domain it
+// enters. When it leaves a domain it is queued for the next domain
+// along the ray. Rays bound for other ranks are sent in batches with
+// non-blocking messages. Ranks trace whichever domain has the most
+// waiting rays instead of stepping through their domains in lock step.
+//
+// Volume rays whose accumulated opacity reaches the opacity threshold
+// are not forwarded, so domains hidden behind opaque ones are not
+// traced at all. Opacity is accumulated the same way as in the static
+// scheduler, and partials are composited by it.
+//
+template<typename FloatType, typename AccumType = FloatType>
+class DynamicScheduler : public Scheduler<FloatType, AccumType>
+{
+public:
+  DynamicScheduler();
+  virtual ~DynamicScheduler();
+  void trace_rays() override;
+protected:
+  //
+  // What is needed to continue a ray in another domain. Sent between
+  // ranks as raw bytes.
+  //
+  struct RayState
+  {
+    vtkm::Float64 m_origin[3];
+    vtkm::Float64 m_dir[3];
+    // product of one minus alpha of everything the ray went through
+    vtkm::Float64 m_transmittance;
+    vtkm::Id      m_pixel_id;
+    // global id of the domain the ray goes to next
+    vtkm::Int32   m_domain;
+    vtkm::Int32   m_pad;
+  };
+
+  void trace_view(const int width,
+                  const int height) override;
+  void build_domain_table();
+  int  build_bvh(const int begin, const int end);
+  void seed_rays();
+  int  largest_queue() const;
+  void trace_queue(const int domain,
+                   const int width,
+                   const int height);
+  void route(RayState &ray, const int domain);
+  int  next_domain(const RayState &ray, const int domain) const;
+
+  //
+  // Node of a bounding volume hierarchy over all domains, so the next
+  // domain along a ray is found without testing every domain
+  //
+  struct BVHNode
+  {
+    vtkm::Bounds m_bounds;
+    // child nodes, -1 for leaves
+    int          m_left;
+    int          m_right;
+    // range of m_bvh_domains in a leaf
+    int          m_begin;
+    int          m_end;
+  };
+
+  // bounds and owning rank of every domain on every rank
+  std::vector<vtkm::Bounds>          m_domain_bounds;
+  std::vector<int>                   m_domain_owners;
+  // the root is the first node
+  std::vector<BVHNode>               m_bvh_nodes;
+  std::vector<int>                   m_bvh_domains;
+  // global id of this rank's first domain
+  int                                m_domain_offset;
+  // rays waiting to be traced in each local domain
+  std::vector<std::vector<RayState>> m_queues;
+  bool                               m_early_termination;
+  // rays that left the last domain or became opaque on this rank
+  vtkm::Int64                        m_completed;
+  vtkm::Int64                        m_started;
+  // number of rays sent to a rank in one message
+  int                                m_batch_size;
+  int                                m_rank;
+  int                                m_num_ranks;
+#ifdef ROVER_PARALLEL
+  // rays waiting to be sent to each rank
+  std::vector<std::vector<RayState>> m_outgoing;
+  // buffers of unfinished sends
+  std::list<std::vector<RayState>>   m_send_buffers;
+  std::list<MPI_Request>             m_send_requests;
+  void send_rays(const int rank);
+  void flush_rays();
+  void test_sends();
+  void receive_rays();
+#endif
+};
+
+}; // namespace rover
+#endif
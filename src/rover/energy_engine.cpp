@@ -116,7 +116,16 @@ EnergyEngine::init_emission(vtkm::rendering::raytracing::Ray<Precision> &rays,
   {
     return;
   }
-  rays.AddBuffer(num_bins, "emission");
+  // rays can be reused across domains and frames so only
+  // add the buffer once
+  if(rays.HasBuffer("emission"))
+  {
+    rays.GetBuffer("emission").SetNumChannels(num_bins);
+  }
+  else
+  {
+    rays.AddBuffer(num_bins, "emission");
+  }
   rays.GetBuffer("emission").InitConst(0);
 }
 
@@ -76,6 +76,11 @@ public:
     m_secondary_field = secondary_field;
   }
 
+  // called when the values of the traced fields were replaced in place
+  virtual void fields_updated()
+  {
+  }
+
   virtual void set_color_table(const vtkmColorTable &color_map, int samples = 1024)
   {
     constexpr vtkm::Float32 conversionToFloatSpace = (1.0f / 255.0f);
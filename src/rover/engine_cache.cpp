@@ -0,0 +1,279 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include <engine_cache.hpp>
+#include <utils/rover_logging.hpp>
+
+#include <vtkm/cont/ArrayCopy.h>
+
+namespace rover
+{
+
+namespace detail
+{
+
+typedef vtkm::cont::ArrayHandle<vtkm::Float32> Float32Handle;
+typedef vtkm::cont::ArrayHandle<vtkm::Float64> Float64Handle;
+
+//
+// Copies the values into a new array. The copies run on the devices
+// enabled in the runtime device tracker, like the rest of the trace.
+//
+template<typename HandleType>
+bool
+copy_array(const vtkm::cont::VariantArrayHandle &values,
+           vtkm::cont::VariantArrayHandle &result)
+{
+  if(!values.IsType<HandleType>())
+  {
+    return false;
+  }
+
+  HandleType copy;
+  vtkm::cont::ArrayCopy(values.Cast<HandleType>(), copy);
+  result = vtkm::cont::VariantArrayHandle(copy);
+  return true;
+}
+
+//
+// Copies the values into an existing array. Every copy of the array
+// handle (e.g., the one held by the tracer) sees the new values.
+//
+template<typename HandleType>
+bool
+update_array(const vtkm::cont::VariantArrayHandle &values,
+             const vtkm::cont::VariantArrayHandle &dest)
+{
+  if(!values.IsType<HandleType>() || !dest.IsType<HandleType>())
+  {
+    return false;
+  }
+
+  HandleType dest_handle = dest.Cast<HandleType>();
+  vtkm::cont::ArrayCopy(values.Cast<HandleType>(), dest_handle);
+  return true;
+}
+
+bool
+copy_field(const vtkm::cont::Field &field, vtkmDataSet &dataset)
+{
+  vtkm::cont::VariantArrayHandle values;
+  if(!copy_array<Float32Handle>(field.GetData(), values) &&
+     !copy_array<Float64Handle>(field.GetData(), values))
+  {
+    return false;
+  }
+
+  if(field.GetAssociation() == vtkm::cont::Field::Association::POINTS)
+  {
+    dataset.AddField(vtkm::cont::Field(field.GetName(),
+                                       vtkm::cont::Field::Association::POINTS,
+                                       values));
+  }
+  else
+  {
+    dataset.AddField(vtkm::cont::Field(field.GetName(),
+                                       field.GetAssociation(),
+                                       field.GetAssocCellSet(),
+                                       values));
+  }
+  // compute the range before the tracer copies the field so
+  // all copies share the cached range
+  dataset.GetField(field.GetName()).GetRange();
+  return true;
+}
+
+bool
+update_field(const vtkm::cont::Field &field, const vtkm::cont::Field &dest)
+{
+  if(field.GetAssociation() != dest.GetAssociation() ||
+     field.GetData().GetNumberOfValues() != dest.GetData().GetNumberOfValues())
+  {
+    return false;
+  }
+
+  if(!update_array<Float32Handle>(field.GetData(), dest.GetData()) &&
+     !update_array<Float64Handle>(field.GetData(), dest.GetData()))
+  {
+    return false;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Range> range = dest.GetRange();
+  vtkm::cont::ArrayCopy(field.GetRange(), range);
+  return true;
+}
+
+bool
+same_bounds(const vtkm::Bounds &a, const vtkm::Bounds &b)
+{
+  return a.X.Min == b.X.Min && a.X.Max == b.X.Max &&
+         a.Y.Min == b.Y.Min && a.Y.Max == b.Y.Max &&
+         a.Z.Min == b.Z.Min && a.Z.Max == b.Z.Max;
+}
+
+} // namespace detail
+
+EngineCache::EngineCache()
+  : m_num_hits(0)
+{
+}
+
+EngineCache::~EngineCache()
+{
+}
+
+std::shared_ptr<Engine>
+EngineCache::find(const vtkm::Id domain_id,
+                  const vtkm::Int64 mesh_generation,
+                  const RenderMode render_mode,
+                  const std::vector<std::string> &field_names,
+                  const vtkmDataSet &dataset)
+{
+  Key key(domain_id, static_cast<int>(render_mode));
+  auto it = m_entries.find(key);
+  if(it == m_entries.end())
+  {
+    return nullptr;
+  }
+
+  Entry &entry = it->second;
+  const vtkmCoordinates &coords = dataset.GetCoordinateSystem();
+  bool hit = entry.m_mesh_generation == mesh_generation &&
+             entry.m_field_names == field_names &&
+             entry.m_num_points == coords.GetData().GetNumberOfValues() &&
+             entry.m_num_cells == dataset.GetCellSet().GetNumberOfCells() &&
+             detail::same_bounds(entry.m_bounds, coords.GetBounds());
+
+  const size_t num_fields = field_names.size();
+  for(size_t i = 0; i < num_fields && hit; ++i)
+  {
+    hit = dataset.HasField(field_names[i]) &&
+          detail::update_field(dataset.GetField(field_names[i]),
+                               entry.m_data_set.GetField(field_names[i]));
+  }
+
+  if(!hit)
+  {
+    ROVER_INFO("Engine cache miss for domain "<<domain_id);
+    m_entries.erase(it);
+    return nullptr;
+  }
+
+  ROVER_INFO("Engine cache hit for domain "<<domain_id);
+  m_num_hits++;
+  entry.m_used = true;
+  entry.m_engine->fields_updated();
+  return entry.m_engine;
+}
+
+vtkmDataSet
+EngineCache::add(const vtkm::Id domain_id,
+                 const vtkm::Int64 mesh_generation,
+                 const RenderMode render_mode,
+                 const std::vector<std::string> &field_names,
+                 const vtkmDataSet &dataset,
+                 std::shared_ptr<Engine> engine)
+{
+  const vtkmCoordinates &coords = dataset.GetCoordinateSystem();
+  Entry entry;
+  entry.m_data_set.AddCoordinateSystem(coords);
+  entry.m_data_set.AddCellSet(dataset.GetCellSet());
+
+  const size_t num_fields = field_names.size();
+  for(size_t i = 0; i < num_fields; ++i)
+  {
+    if(!dataset.HasField(field_names[i]) ||
+       !detail::copy_field(dataset.GetField(field_names[i]), entry.m_data_set))
+    {
+      // only float fields are copied, the engine can still
+      // trace the domain, it just won't be cached
+      ROVER_INFO("Engine cache can't copy field "<<field_names[i]);
+      return dataset;
+    }
+  }
+
+  entry.m_engine = engine;
+  entry.m_field_names = field_names;
+  entry.m_mesh_generation = mesh_generation;
+  entry.m_num_points = coords.GetData().GetNumberOfValues();
+  entry.m_num_cells = dataset.GetCellSet().GetNumberOfCells();
+  entry.m_bounds = coords.GetBounds();
+  entry.m_used = true;
+
+  m_entries[Key(domain_id, static_cast<int>(render_mode))] = entry;
+  return entry.m_data_set;
+}
+
+void
+EngineCache::prune()
+{
+  auto it = m_entries.begin();
+  while(it != m_entries.end())
+  {
+    if(!it->second.m_used)
+    {
+      it = m_entries.erase(it);
+    }
+    else
+    {
+      it->second.m_used = false;
+      ++it;
+    }
+  }
+}
+
+void
+EngineCache::clear()
+{
+  m_entries.clear();
+}
+
+int
+EngineCache::size() const
+{
+  return static_cast<int>(m_entries.size());
+}
+
+int
+EngineCache::num_hits() const
+{
+  return m_num_hits;
+}
+
+} // namespace rover
@@ -0,0 +1,116 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef rover_engine_cache_h
+#define rover_engine_cache_h
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <engine.hpp>
+#include <rover_types.hpp>
+#include <vtkm_typedefs.hpp>
+
+namespace rover
+{
+//
+// Keeps the engines of each domain alive between frames so the tracer's
+// mesh structures (connectivity, external faces and cell locators) are
+// only built when the mesh changes. Meshes are identified by a domain id
+// and a mesh generation counter that the caller bumps whenever the
+// coordinates or the cells change. A hit is also checked against the
+// number of points and cells and the bounds of the domain.
+//
+// The engines trace a private copy of the fields they render. On a hit
+// the new field values are copied into that copy, so the tracer keeps
+// its data set (and everything built from it) untouched.
+//
+class EngineCache
+{
+public:
+  EngineCache();
+  ~EngineCache();
+  //
+  // Returns the engine for the domain with its fields updated from
+  // dataset or NULL if the mesh is not cached
+  //
+  std::shared_ptr<Engine> find(const vtkm::Id domain_id,
+                               const vtkm::Int64 mesh_generation,
+                               const RenderMode render_mode,
+                               const std::vector<std::string> &field_names,
+                               const vtkmDataSet &dataset);
+  //
+  // Builds the data set the engine should trace: the mesh of dataset
+  // plus copies of the named fields that the cache owns
+  //
+  vtkmDataSet add(const vtkm::Id domain_id,
+                  const vtkm::Int64 mesh_generation,
+                  const RenderMode render_mode,
+                  const std::vector<std::string> &field_names,
+                  const vtkmDataSet &dataset,
+                  std::shared_ptr<Engine> engine);
+  //
+  // Releases the engines that were not used since the last prune
+  //
+  void prune();
+  void clear();
+  int  size() const;
+  // number of times find returned a cached engine
+  int  num_hits() const;
+protected:
+  struct Entry
+  {
+    std::shared_ptr<Engine>  m_engine;
+    vtkmDataSet              m_data_set;
+    std::vector<std::string> m_field_names;
+    vtkm::Int64              m_mesh_generation;
+    vtkm::Id                 m_num_points;
+    vtkm::Id                 m_num_cells;
+    vtkm::Bounds             m_bounds;
+    bool                     m_used;
+  };
+  typedef std::pair<vtkm::Id, int> Key;
+  std::map<Key, Entry> m_entries;
+  int                  m_num_hits;
+};
+
+} // namespace rover
+#endif
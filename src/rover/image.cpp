@@ -106,7 +106,7 @@ void cast_array_handle(vtkm::cont::ArrayHandle<T> &cast_to,
   const vtkm::Id size = cast_from.GetNumberOfValues();
   cast_to.Allocate(size);
   auto portal_to = cast_to.GetPortalControl();
-  auto portal_from = cast_to.GetPortalConstControl();
+  auto portal_from = cast_from.GetPortalConstControl();
 #ifdef ROVER_ENABLE_OPENMP
   #pragma omp parallel for
 #endif
@@ -124,6 +124,8 @@ template<typename T, typename O> void init_from_image(Image<T> &left, Image<O> &
   left.m_valid_optical_depths = right.m_valid_optical_depths;
 
   const size_t channels = right.m_intensities.size();
+  left.m_intensities.resize(channels);
+  left.m_optical_depths.resize(channels);
   for(size_t i = 0; i < channels; ++i)
   {
     cast_array_handle(left.m_intensities[i], right.m_intensities[i]);
@@ -0,0 +1,421 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include <macrocell_grid.hpp>
+#include <utils/rover_logging.hpp>
+
+#include <vtkm/rendering/raytracing/RayOperations.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace rover
+{
+
+namespace detail
+{
+
+typedef vtkm::cont::ArrayHandle<vtkm::Float32> Float32Handle;
+typedef vtkm::cont::ArrayHandle<vtkm::Float64> Float64Handle;
+
+inline vtkm::Id
+clamp_index(const vtkm::Float64 value, const vtkm::Id size)
+{
+  vtkm::Id index = static_cast<vtkm::Id>(std::floor(value));
+  return std::max(vtkm::Id(0), std::min(size - 1, index));
+}
+
+} // namespace detail
+
+MacrocellGrid::MacrocellGrid()
+  : m_valid(false)
+{
+}
+
+MacrocellGrid::~MacrocellGrid()
+{
+}
+
+bool
+MacrocellGrid::is_valid() const
+{
+  return m_valid;
+}
+
+void
+MacrocellGrid::invalidate()
+{
+  m_valid = false;
+}
+
+void
+MacrocellGrid::build(const vtkmDataSet &dataset,
+                     const std::string &field_name,
+                     const int dims)
+{
+  m_valid = false;
+  if(dims < 1 || !dataset.HasField(field_name))
+  {
+    return;
+  }
+
+  m_bounds = dataset.GetCoordinateSystem().GetBounds();
+  const vtkm::Range *ranges[3] = {&m_bounds.X, &m_bounds.Y, &m_bounds.Z};
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    // flat domains are traced without skipping
+    if(!(ranges[axis]->Length() > 0.))
+    {
+      return;
+    }
+    m_dims[axis] = dims;
+    m_spacing[axis] = ranges[axis]->Length() / static_cast<vtkm::Float64>(dims);
+  }
+
+  const size_t size = static_cast<size_t>(m_dims[0] * m_dims[1] * m_dims[2]);
+  m_mins.assign(size, std::numeric_limits<vtkm::Float64>::infinity());
+  m_maxs.assign(size, -std::numeric_limits<vtkm::Float64>::infinity());
+
+  const vtkm::cont::Field &field = dataset.GetField(field_name);
+  const bool cell_values =
+    field.GetAssociation() != vtkm::cont::Field::Association::POINTS;
+  const vtkm::cont::VariantArrayHandle &data = field.GetData();
+  if(data.IsType<detail::Float32Handle>())
+  {
+    bin_cells(dataset, data.Cast<detail::Float32Handle>(), cell_values);
+  }
+  else if(data.IsType<detail::Float64Handle>())
+  {
+    bin_cells(dataset, data.Cast<detail::Float64Handle>(), cell_values);
+  }
+  else
+  {
+    ROVER_INFO("Macrocell grid: unsupported field type for "<<field_name);
+    return;
+  }
+
+  // nothing is empty until a transfer function says so
+  m_visible.assign(size, 1);
+  m_opacities.clear();
+  m_valid = true;
+}
+
+template<typename ValuesType>
+void
+MacrocellGrid::bin_cells(const vtkmDataSet &dataset,
+                         const ValuesType &values,
+                         const bool cell_values)
+{
+  const vtkm::cont::CellSet *cell_set = dataset.GetCellSet().GetCellSetBase();
+  auto coords = dataset.GetCoordinateSystem().GetData().GetPortalConstControl();
+  auto value_portal = values.GetPortalConstControl();
+
+  const vtkm::Id num_cells = cell_set->GetNumberOfCells();
+  std::vector<vtkm::Id> point_ids;
+  for(vtkm::Id cell = 0; cell < num_cells; ++cell)
+  {
+    const vtkm::IdComponent num_points = cell_set->GetNumberOfPointsInCell(cell);
+    point_ids.resize(num_points);
+    cell_set->GetCellPointIds(cell, point_ids.data());
+
+    vtkm::Bounds cell_bounds;
+    vtkmRange cell_range;
+    for(vtkm::IdComponent p = 0; p < num_points; ++p)
+    {
+      cell_bounds.Include(coords.Get(point_ids[p]));
+      if(!cell_values)
+      {
+        cell_range.Include(static_cast<vtkm::Float64>(value_portal.Get(point_ids[p])));
+      }
+    }
+    if(cell_values)
+    {
+      cell_range.Include(static_cast<vtkm::Float64>(value_portal.Get(cell)));
+    }
+
+    const vtkm::Id x0 = detail::clamp_index((cell_bounds.X.Min - m_bounds.X.Min) / m_spacing[0], m_dims[0]);
+    const vtkm::Id x1 = detail::clamp_index((cell_bounds.X.Max - m_bounds.X.Min) / m_spacing[0], m_dims[0]);
+    const vtkm::Id y0 = detail::clamp_index((cell_bounds.Y.Min - m_bounds.Y.Min) / m_spacing[1], m_dims[1]);
+    const vtkm::Id y1 = detail::clamp_index((cell_bounds.Y.Max - m_bounds.Y.Min) / m_spacing[1], m_dims[1]);
+    const vtkm::Id z0 = detail::clamp_index((cell_bounds.Z.Min - m_bounds.Z.Min) / m_spacing[2], m_dims[2]);
+    const vtkm::Id z1 = detail::clamp_index((cell_bounds.Z.Max - m_bounds.Z.Min) / m_spacing[2], m_dims[2]);
+
+    for(vtkm::Id z = z0; z <= z1; ++z)
+    {
+      for(vtkm::Id y = y0; y <= y1; ++y)
+      {
+        for(vtkm::Id x = x0; x <= x1; ++x)
+        {
+          const vtkm::Id index = (z * m_dims[1] + y) * m_dims[0] + x;
+          m_mins[index] = std::min(m_mins[index], cell_range.Min);
+          m_maxs[index] = std::max(m_maxs[index], cell_range.Max);
+        }
+      }
+    }
+  }
+}
+
+void
+MacrocellGrid::set_opacity(const vtkmColorMap &color_map, const vtkmRange &scalar_range)
+{
+  if(!m_valid)
+  {
+    return;
+  }
+
+  // only the opacities decide which macrocells are empty
+  const vtkm::Id num_colors = color_map.GetNumberOfValues();
+  std::vector<vtkm::Float32> opacities(static_cast<size_t>(num_colors));
+  auto color_portal = color_map.GetPortalConstControl();
+  for(vtkm::Id i = 0; i < num_colors; ++i)
+  {
+    opacities[i] = color_portal.Get(i)[3];
+  }
+
+  if(!m_opacities.empty() &&
+     opacities == m_opacities &&
+     scalar_range == m_opacity_range)
+  {
+    return;
+  }
+  m_opacities.swap(opacities);
+  m_opacity_range = scalar_range;
+
+  const vtkm::Float64 length = scalar_range.Max - scalar_range.Min;
+  if(num_colors == 0 || !(length > 0.))
+  {
+    std::fill(m_visible.begin(), m_visible.end(), 1);
+    return;
+  }
+
+  // number of opaque colors before each color map entry
+  std::vector<vtkm::Id> opaque(num_colors + 1, 0);
+  for(vtkm::Id i = 0; i < num_colors; ++i)
+  {
+    opaque[i + 1] = opaque[i] + (m_opacities[i] > 0.f ? 1 : 0);
+  }
+
+  const vtkm::Float64 max_color = static_cast<vtkm::Float64>(num_colors - 1);
+  const size_t size = m_visible.size();
+  for(size_t i = 0; i < size; ++i)
+  {
+    if(m_mins[i] > m_maxs[i])
+    {
+      // no cells in this macrocell
+      m_visible[i] = 0;
+      continue;
+    }
+    // scalars outside the range are clamped to the ends of the color map
+    const vtkm::Float64 low =
+      std::max(0., std::min(1., (m_mins[i] - scalar_range.Min) / length));
+    const vtkm::Float64 high =
+      std::max(0., std::min(1., (m_maxs[i] - scalar_range.Min) / length));
+    const vtkm::Id first = static_cast<vtkm::Id>(std::floor(low * max_color));
+    const vtkm::Id last = static_cast<vtkm::Id>(std::ceil(high * max_color));
+    m_visible[i] = opaque[last + 1] - opaque[first] > 0 ? 1 : 0;
+  }
+}
+
+template<typename FloatType>
+void
+MacrocellGrid::skip(vtkmRayTracing::Ray<FloatType> &rays) const
+{
+  if(!m_valid || rays.NumRays == 0)
+  {
+    return;
+  }
+
+  const vtkm::Id num_rays = rays.NumRays;
+  auto origin_x = rays.OriginX.GetPortalConstControl();
+  auto origin_y = rays.OriginY.GetPortalConstControl();
+  auto origin_z = rays.OriginZ.GetPortalConstControl();
+  auto dir_x = rays.DirX.GetPortalConstControl();
+  auto dir_y = rays.DirY.GetPortalConstControl();
+  auto dir_z = rays.DirZ.GetPortalConstControl();
+  auto min_distance = rays.MinDistance.GetPortalControl();
+  auto max_distance = rays.MaxDistance.GetPortalControl();
+  auto status = rays.Status.GetPortalControl();
+
+  const vtkm::Float64 infinity = std::numeric_limits<vtkm::Float64>::infinity();
+  const vtkm::Float64 bounds_min[3] = {m_bounds.X.Min, m_bounds.Y.Min, m_bounds.Z.Min};
+  const vtkm::Float64 bounds_max[3] = {m_bounds.X.Max, m_bounds.Y.Max, m_bounds.Z.Max};
+  // keep a little of the space around the macrocells the ray
+  // keeps so round off never clips a visible sample
+  const vtkm::Float64 pad =
+    1e-3 * std::min(m_spacing[0], std::min(m_spacing[1], m_spacing[2]));
+
+  vtkm::Id num_removed = 0;
+#ifdef ROVER_ENABLE_OPENMP
+    #pragma omp parallel for reduction(+:num_removed)
+#endif
+  for(vtkm::Id i = 0; i < num_rays; ++i)
+  {
+    const vtkm::Float64 origin[3] = {origin_x.Get(i), origin_y.Get(i), origin_z.Get(i)};
+    const vtkm::Float64 dir[3] = {dir_x.Get(i), dir_y.Get(i), dir_z.Get(i)};
+
+    // clip the ray to the bounds of the domain
+    vtkm::Float64 t_enter = min_distance.Get(i);
+    vtkm::Float64 t_exit = max_distance.Get(i);
+    for(int axis = 0; axis < 3; ++axis)
+    {
+      if(dir[axis] == 0.)
+      {
+        if(origin[axis] < bounds_min[axis] || origin[axis] > bounds_max[axis])
+        {
+          t_exit = -infinity;
+        }
+        continue;
+      }
+      vtkm::Float64 t_near = (bounds_min[axis] - origin[axis]) / dir[axis];
+      vtkm::Float64 t_far = (bounds_max[axis] - origin[axis]) / dir[axis];
+      if(t_near > t_far)
+      {
+        std::swap(t_near, t_far);
+      }
+      t_enter = std::max(t_enter, t_near);
+      t_exit = std::min(t_exit, t_far);
+    }
+
+    //
+    // walk the macrocells the ray crosses and remember where it
+    // enters the first one with cells and leaves the last non empty one
+    //
+    vtkm::Float64 first_occupied = infinity;
+    vtkm::Float64 last_visible = -infinity;
+    if(t_enter <= t_exit)
+    {
+      vtkm::Id index[3];
+      vtkm::Id step[3];
+      vtkm::Float64 t_next[3];
+      vtkm::Float64 t_delta[3];
+      for(int axis = 0; axis < 3; ++axis)
+      {
+        const vtkm::Float64 p = origin[axis] + dir[axis] * t_enter;
+        index[axis] = detail::clamp_index((p - bounds_min[axis]) / m_spacing[axis],
+                                          m_dims[axis]);
+        if(dir[axis] == 0.)
+        {
+          step[axis] = 0;
+          t_next[axis] = infinity;
+          t_delta[axis] = infinity;
+          continue;
+        }
+        step[axis] = dir[axis] > 0. ? 1 : -1;
+        const vtkm::Float64 boundary =
+          bounds_min[axis] + static_cast<vtkm::Float64>(index[axis] + (step[axis] > 0 ? 1 : 0))
+                             * m_spacing[axis];
+        t_next[axis] = (boundary - origin[axis]) / dir[axis];
+        t_delta[axis] = m_spacing[axis] / std::abs(dir[axis]);
+      }
+
+      vtkm::Float64 cell_enter = t_enter;
+      while(true)
+      {
+        int axis = 0;
+        if(t_next[1] < t_next[axis]) axis = 1;
+        if(t_next[2] < t_next[axis]) axis = 2;
+        const vtkm::Float64 cell_exit = std::min(t_next[axis], t_exit);
+
+        const vtkm::Id cell = (index[2] * m_dims[1] + index[1]) * m_dims[0] + index[0];
+        if(first_occupied == infinity && m_mins[cell] <= m_maxs[cell])
+        {
+          first_occupied = cell_enter;
+        }
+        if(m_visible[cell] != 0)
+        {
+          last_visible = cell_exit;
+        }
+        cell_enter = cell_exit;
+
+        if(t_next[axis] >= t_exit)
+        {
+          break;
+        }
+        index[axis] += step[axis];
+        if(index[axis] < 0 || index[axis] >= m_dims[axis])
+        {
+          break;
+        }
+        t_next[axis] += t_delta[axis];
+      }
+    }
+
+    if(last_visible == -infinity)
+    {
+      status.Set(i, vtkmRayTracing::RAY_TERMINATED);
+      num_removed++;
+    }
+    else
+    {
+      status.Set(i, vtkmRayTracing::RAY_ACTIVE);
+      // a visible macrocell always holds cells, so first_occupied is set
+      const vtkm::Float64 start = first_occupied - pad;
+      if(start > min_distance.Get(i))
+      {
+        min_distance.Set(i, static_cast<FloatType>(start));
+      }
+      const vtkm::Float64 clipped = last_visible + pad;
+      if(clipped < max_distance.Get(i))
+      {
+        max_distance.Set(i, static_cast<FloatType>(clipped));
+      }
+    }
+  }
+
+  ROVER_INFO("Macrocell grid removed "<<num_removed<<" of "<<num_rays<<" rays");
+  if(num_removed != 0)
+  {
+    vtkmRayTracing::RayOperations::CompactActiveRays(rays);
+  }
+}
+
+void
+MacrocellGrid::skip_empty_space(Ray32 &rays) const
+{
+  skip(rays);
+}
+
+void
+MacrocellGrid::skip_empty_space(Ray64 &rays) const
+{
+  skip(rays);
+}
+
+} // namespace rover
@@ -0,0 +1,112 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef rover_macrocell_grid_h
+#define rover_macrocell_grid_h
+
+#include <string>
+#include <vector>
+
+#include <vtkm_typedefs.hpp>
+
+namespace rover
+{
+//
+// A coarse uniform grid over a domain that stores the min and max of a
+// scalar field for every macrocell. Each cell of the mesh is binned into
+// all macrocells its bounding box touches, so a macrocell's range covers
+// every value a ray can sample inside of it.
+//
+// Given a transfer function, macrocells whose range only maps to zero
+// opacity are empty. Rays are clipped to end after the last non empty
+// macrocell they cross, and rays that only cross empty macrocells are
+// removed before tracing.
+//
+// Rays start at the first macrocell that holds any cells. They can not
+// start at the first non empty one: the tracer finds where a ray enters
+// the mesh by intersecting the external faces past the ray's min
+// distance, so a ray has to start outside of the mesh.
+//
+class MacrocellGrid
+{
+public:
+  MacrocellGrid();
+  ~MacrocellGrid();
+  //
+  // Bins the field over a grid with at most dims macrocells per axis.
+  // Fields that are not 32 or 64 bit floats leave the grid invalid.
+  //
+  void build(const vtkmDataSet &dataset,
+             const std::string &field_name,
+             const int dims);
+  //
+  // Marks the macrocells that map to a non zero opacity. Nothing is
+  // redone if the opacities and the range did not change since the
+  // last call.
+  //
+  void set_opacity(const vtkmColorMap &color_map, const vtkmRange &scalar_range);
+  //
+  // Clips and removes the rays that only see empty space
+  //
+  void skip_empty_space(Ray32 &rays) const;
+  void skip_empty_space(Ray64 &rays) const;
+
+  bool is_valid() const;
+  void invalidate();
+protected:
+  template<typename ValuesType>
+  void bin_cells(const vtkmDataSet &dataset,
+                 const ValuesType &values,
+                 const bool cell_values);
+  template<typename FloatType>
+  void skip(vtkmRayTracing::Ray<FloatType> &rays) const;
+
+  vtkm::Bounds               m_bounds;
+  vtkm::Id3                  m_dims;
+  vtkm::Vec<vtkm::Float64,3> m_spacing;
+  std::vector<vtkm::Float64> m_mins;
+  std::vector<vtkm::Float64> m_maxs;
+  std::vector<vtkm::UInt8>   m_visible;
+  std::vector<vtkm::Float32> m_opacities;
+  vtkmRange                  m_opacity_range;
+  bool                       m_valid;
+};
+
+} // namespace rover
+#endif
@@ -42,13 +42,15 @@
 #ifndef rover_partial_image_h
 #define rover_partial_image_h
 
+#include <algorithm>
 #include <vector>
 
 #include <vtkm/cont/ArrayHandle.h>
-#include <vtkh/rendering/AbsorptionPartial.hpp>
-#include <vtkh/rendering/EmissionPartial.hpp>
 #include <vtkh/rendering/VolumePartial.hpp>
 
+#include <bin_partials.hpp>
+#include <vtkm_typedefs.hpp>
+
 namespace rover
 {
 
@@ -82,7 +84,9 @@ struct PartialImage
 
   }
 
-  void extract_partials(std::vector<vtkh::VolumePartial<FloatType>> &partials)
+  // the partials can be of a wider type than the image
+  template<typename PartialType>
+  void extract_partials(std::vector<vtkh::VolumePartial<PartialType>> &partials)
   {
     auto id_portal = m_pixel_ids.GetPortalConstControl();
     auto buffer_portal = m_buffer.Buffer.GetPortalConstControl();
@@ -96,70 +100,13 @@ struct PartialImage
     for(int i = 0; i < size; ++i)
     {
       partials[i].m_pixel_id = static_cast<int>(id_portal.Get(i));
-      partials[i].m_depth = static_cast<float>(depth_portal.Get(i));
+      partials[i].m_depth = static_cast<PartialType>(depth_portal.Get(i));
 
-      partials[i].m_pixel[0] = static_cast<float>(buffer_portal.Get(i*4+0));
-      partials[i].m_pixel[1] = static_cast<float>(buffer_portal.Get(i*4+1));
-      partials[i].m_pixel[2] = static_cast<float>(buffer_portal.Get(i*4+2));
+      partials[i].m_pixel[0] = static_cast<PartialType>(buffer_portal.Get(i*4+0));
+      partials[i].m_pixel[1] = static_cast<PartialType>(buffer_portal.Get(i*4+1));
+      partials[i].m_pixel[2] = static_cast<PartialType>(buffer_portal.Get(i*4+2));
 
-      partials[i].m_alpha = static_cast<float>(buffer_portal.Get(i*4+3));
-    }
-  }
-
-  void extract_partials(std::vector<vtkh::AbsorptionPartial<FloatType>> &partials)
-  {
-    const int num_bins = m_buffer.GetNumChannels();
-    auto id_portal = m_pixel_ids.GetPortalConstControl();
-    auto buffer_portal = m_buffer.Buffer.GetPortalConstControl();
-    auto depth_portal = m_distances.GetPortalConstControl();
-    const int size = static_cast<int>(m_pixel_ids.GetNumberOfValues());
-    partials.resize(size);
-
-#ifdef ROVER_ENABLE_OPENMP
-    #pragma omp parallel for
-#endif
-    for(int index = 0; index < size; ++index)
-    {
-      partials[index].m_pixel_id = static_cast<int>(id_portal.Get(index));
-      partials[index].m_depth = depth_portal.Get(index);
-      partials[index].m_bins.resize(num_bins);
-
-      const int starting_index = index * num_bins;
-      for(int i = 0; i < num_bins; ++i)
-      {
-        partials[index].m_bins[i] = buffer_portal.Get(starting_index + i);
-      }
-    }
-  }
-
-  void extract_partials(std::vector<vtkh::EmissionPartial<FloatType>> &partials)
-  {
-    const int num_bins = m_buffer.GetNumChannels();
-    auto id_portal = m_pixel_ids.GetPortalConstControl();
-    auto buffer_portal = m_buffer.Buffer.GetPortalConstControl();
-    auto intensity_portal = m_intensities.Buffer.GetPortalConstControl();
-
-    auto depth_portal = m_distances.GetPortalConstControl();
-    const int size = static_cast<int>(m_pixel_ids.GetNumberOfValues());
-
-    partials.resize(size);
-
-#ifdef ROVER_ENABLE_OPENMP
-    #pragma omp parallel for
-#endif
-    for(int index = 0; index < size; ++index)
-    {
-      partials[index].m_pixel_id = static_cast<int>(id_portal.Get(index));
-      partials[index].m_depth = depth_portal.Get(index);
-      partials[index].m_bins.resize(num_bins);
-      partials[index].m_emission_bins.resize(num_bins);
-
-      const int starting_index = index * num_bins;
-      for(int i = 0; i < num_bins; ++i)
-      {
-        partials[index].m_bins[i] = buffer_portal.Get(starting_index + i);
-        partials[index].m_emission_bins[i] = intensity_portal.Get(starting_index + i);
-      }
+      partials[i].m_alpha = static_cast<PartialType>(buffer_portal.Get(i*4+3));
     }
   }
 
@@ -213,75 +160,47 @@ struct PartialImage
 
   }
 
-  void store(std::vector<vtkh::AbsorptionPartial<FloatType>> &partials,
+  //
+  // store composited energy partials. The intensity is the emission plus
+  // the background source attenuated by the absorption.
+  //
+  void store(const BinPartials<FloatType> &partials,
              const std::vector<double> &background,
              const int width,
              const int height)
   {
     m_width = width;
     m_height = height;
-    const int size = static_cast<int>(partials.size());
-    const int num_bins = static_cast<int>(partials.at(0).m_bins.size());
+    const vtkm::Id size = partials.size();
+    const int num_bins = partials.m_num_bins;
     allocate(size,num_bins);
 
-    auto id_portal = m_pixel_ids.GetPortalControl();
-    auto buffer_portal = m_buffer.Buffer.GetPortalControl();
-    auto depth_portal = m_distances.GetPortalControl();
-    auto intensity_portal = m_intensities.Buffer.GetPortalControl();
-
-#ifdef ROVER_ENABLE_OPENMP
-    #pragma omp parallel for
-#endif
-    for(int i = 0; i < size; ++i)
+    if(size != 0)
     {
-      id_portal.Set(i, partials[i].m_pixel_id );
-      depth_portal.Set(i, partials[i].m_depth );
-      const int starting_index = i * num_bins;
+      vtkm::Id *ids = get_vtkm_ptr(m_pixel_ids);
+      FloatType *depths = get_vtkm_ptr(m_distances);
+      FloatType *buffer = get_vtkm_ptr(m_buffer.Buffer);
+      FloatType *intensities = get_vtkm_ptr(m_intensities.Buffer);
 
-      for(int ii = 0; ii < num_bins; ++ii)
-      {
-        buffer_portal.Set(starting_index + ii, partials[i].m_bins[ii]);
-        intensity_portal.Set( starting_index + ii, partials[i].m_bins[ii] * background[ii]);
-      }
-    }
-
-    for(int i = 0; i < num_bins; ++i)
-    {
-      m_source_sig[i] = background[i];
-    }
-  }
-
-  void store(std::vector<vtkh::EmissionPartial<FloatType>> &partials,
-             const std::vector<double> &background,
-             const int width,
-             const int height)
-  {
-    m_width = width;
-    m_height = height;
-    const int size = static_cast<int>(partials.size());
-    const int num_bins = static_cast<int>(partials.at(0).m_bins.size());
-    allocate(size,num_bins);
-
-    auto id_portal = m_pixel_ids.GetPortalControl();
-    auto buffer_portal = m_buffer.Buffer.GetPortalControl();
-    auto depth_portal = m_distances.GetPortalControl();
-    auto intensity_portal = m_intensities.Buffer.GetPortalControl();
+      std::copy(partials.m_pixel_ids.begin(), partials.m_pixel_ids.end(), ids);
+      std::copy(partials.m_depths.begin(), partials.m_depths.end(), depths);
+      std::copy(partials.m_absorption.begin(), partials.m_absorption.end(), buffer);
 
 #ifdef ROVER_ENABLE_OPENMP
-    #pragma omp parallel for
+      #pragma omp parallel for
 #endif
-    for(int i = 0; i < size; ++i)
-    {
-      id_portal.Set(i, partials[i].m_pixel_id );
-      depth_portal.Set(i, partials[i].m_depth );
-      const int starting_index = i * num_bins;
-
-      for(int ii = 0; ii < num_bins; ++ii)
+      for(vtkm::Id i = 0; i < size; ++i)
       {
-        buffer_portal.Set(starting_index + ii, partials[i].m_bins[ii]);
-        FloatType out_intensity;
-        out_intensity = partials[i].m_emission_bins[ii] +  partials[i].m_bins[ii] * background[ii];
-        intensity_portal.Set( starting_index + ii, out_intensity);
+        const vtkm::Id starting_index = i * num_bins;
+        for(int ii = 0; ii < num_bins; ++ii)
+        {
+          FloatType out_intensity = buffer[starting_index + ii] * background[ii];
+          if(partials.m_has_emission)
+          {
+            out_intensity += partials.m_emission[starting_index + ii];
+          }
+          intensities[starting_index + ii] = out_intensity;
+        }
       }
     }
 
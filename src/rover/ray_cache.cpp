@@ -0,0 +1,108 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include <ray_cache.hpp>
+
+namespace rover
+{
+
+RayCache::RayCache()
+  : m_canvas(0, 0),
+    m_used32(false),
+    m_used64(false),
+    m_num_reuses(0)
+{
+}
+
+RayCache::~RayCache()
+{
+}
+
+template<>
+vtkmRayTracing::Ray<vtkm::Float32> &
+RayCache::get_rays<vtkm::Float32>()
+{
+  if(m_used32)
+  {
+    m_num_reuses++;
+  }
+  m_used32 = true;
+  return m_rays32;
+}
+
+template<>
+vtkmRayTracing::Ray<vtkm::Float64> &
+RayCache::get_rays<vtkm::Float64>()
+{
+  if(m_used64)
+  {
+    m_num_reuses++;
+  }
+  m_used64 = true;
+  return m_rays64;
+}
+
+vtkm::rendering::CanvasRayTracer &
+RayCache::get_canvas(const int width, const int height)
+{
+  if(m_canvas.GetWidth() != width || m_canvas.GetHeight() != height)
+  {
+    // the canvas allocates full size color and depth buffers
+    m_canvas = vtkm::rendering::CanvasRayTracer(width, height);
+  }
+  return m_canvas;
+}
+
+int
+RayCache::num_reuses() const
+{
+  return m_num_reuses;
+}
+
+void
+RayCache::clear()
+{
+  m_rays32 = vtkmRayTracing::Ray<vtkm::Float32>();
+  m_rays64 = vtkmRayTracing::Ray<vtkm::Float64>();
+  m_canvas = vtkm::rendering::CanvasRayTracer(0, 0);
+  m_used32 = false;
+  m_used64 = false;
+}
+
+} // namespace rover
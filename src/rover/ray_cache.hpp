@@ -0,0 +1,85 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef rover_ray_cache_h
+#define rover_ray_cache_h
+
+#include <vtkm_typedefs.hpp>
+#include <vtkm/rendering/CanvasRayTracer.h>
+
+namespace rover
+{
+//
+// Keeps ray storage alive between frames. Domains and views are traced
+// one at a time, so all of them are traced with the same set of rays,
+// and later frames with the same image size reuse its arrays instead of
+// reallocating them. The canvas the ray tracing camera reads the image
+// dimensions from is kept as well, and only recreated when they change.
+//
+class RayCache
+{
+public:
+  RayCache();
+  ~RayCache();
+  //
+  // Returns the rays of the given precision. The caller must be done
+  // with the rays (and anything sharing their arrays) from the last call.
+  //
+  template<typename FloatType>
+  vtkmRayTracing::Ray<FloatType> &get_rays();
+  vtkm::rendering::CanvasRayTracer &get_canvas(const int width, const int height);
+  // number of times rays traced before were handed out again
+  int  num_reuses() const;
+  void clear();
+protected:
+  vtkmRayTracing::Ray<vtkm::Float32> m_rays32;
+  vtkmRayTracing::Ray<vtkm::Float64> m_rays64;
+  vtkm::rendering::CanvasRayTracer   m_canvas;
+  bool                               m_used32;
+  bool                               m_used64;
+  int                                m_num_reuses;
+};
+
+template<>
+vtkmRayTracing::Ray<vtkm::Float32> &RayCache::get_rays<vtkm::Float32>();
+template<>
+vtkmRayTracing::Ray<vtkm::Float64> &RayCache::get_rays<vtkm::Float64>();
+
+} // namespace rover
+#endif
@@ -40,16 +40,22 @@
 //
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 #include <ray_generators/camera_generator.hpp>
+#include <ray_cache.hpp>
+#include <vtkm/rendering/CanvasRayTracer.h>
 namespace rover {
 
 CameraGenerator::CameraGenerator()
- : RayGenerator()
+ : RayGenerator(),
+   m_ray_camera_width(-1),
+   m_ray_camera_height(-1)
 {
 
 }
 
 CameraGenerator::CameraGenerator(const vtkmCamera &camera, const int height, const int width)
- : RayGenerator(height, width)
+ : RayGenerator(height, width),
+   m_ray_camera_width(-1),
+   m_ray_camera_height(-1)
 {
   m_camera = camera;
 }
@@ -59,28 +65,79 @@ CameraGenerator::~CameraGenerator()
 
 }
 
+template<typename FloatType>
 void
-CameraGenerator::get_rays(vtkmRayTracing::Ray<vtkm::Float32> &rays)
+CameraGenerator::create_rays(vtkmRayTracing::Ray<FloatType> &rays,
+                             const vtkm::Bounds &bounds)
 {
-  vtkm::rendering::CanvasRayTracer canvas(m_width, m_height);
-  vtkm::rendering::raytracing::Camera ray_gen;
-  ray_gen.SetParameters(m_camera, canvas);
+  if(m_ray_camera_width != m_width || m_ray_camera_height != m_height)
+  {
+    // the canvas allocates full size color and depth buffers, so
+    // use the one kept by the ray cache when there is one
+    if(m_ray_cache != nullptr)
+    {
+      m_ray_camera.SetParameters(m_camera, m_ray_cache->get_canvas(m_width, m_height));
+    }
+    else
+    {
+      vtkm::rendering::CanvasRayTracer canvas(m_width, m_height);
+      m_ray_camera.SetParameters(m_camera, canvas);
+    }
+    m_ray_camera_width = m_width;
+    m_ray_camera_height = m_height;
+  }
 
-  ray_gen.CreateRays(rays, this->m_coordinates.GetBounds());
-  this->m_has_rays = false;
+  // reuses the storage of rays when it is large enough
+  m_ray_camera.CreateRays(rays, bounds);
   if(rays.NumRays == 0) std::cout<<"CameraGenerator Warning no rays were generated\n";
 }
 
 void
-CameraGenerator::get_rays(vtkmRayTracing::Ray<vtkm::Float64> &rays)
+CameraGenerator::get_rays(vtkmRayTracing::Ray<vtkm::Float32> &rays)
 {
-  vtkm::rendering::CanvasRayTracer canvas(m_width, m_height);
-  vtkm::rendering::raytracing::Camera ray_gen;
-  ray_gen.SetParameters(m_camera, canvas);
+  create_rays(rays, this->m_coordinates.GetBounds());
+  this->m_has_rays = false;
+}
 
-  ray_gen.CreateRays(rays, this->m_coordinates.GetBounds());
+void
+CameraGenerator::get_rays(vtkmRayTracing::Ray<vtkm::Float64> &rays)
+{
+  create_rays(rays, this->m_coordinates.GetBounds());
   this->m_has_rays = false;
-  if(rays.NumRays == 0) std::cout<<"CameraGenerator Warning no rays were generated\n";
+}
+
+void
+CameraGenerator::get_rays(vtkmRayTracing::Ray<vtkm::Float32> &rays,
+                          const vtkm::Bounds &bounds)
+{
+  create_rays(rays, bounds);
+}
+
+void
+CameraGenerator::get_rays(vtkmRayTracing::Ray<vtkm::Float64> &rays,
+                          const vtkm::Bounds &bounds)
+{
+  create_rays(rays, bounds);
+}
+
+double
+CameraGenerator::get_distance(const vtkm::Bounds &bounds) const
+{
+  if(!bounds.IsNonEmpty())
+  {
+    return 0.;
+  }
+
+  const vtkm::Vec<vtkm::Float32,3> eye = m_camera.GetPosition();
+  const vtkm::Range *ranges[3] = {&bounds.X, &bounds.Y, &bounds.Z};
+  double distance = 0.;
+  for(int axis = 0; axis < 3; ++axis)
+  {
+    const double p = static_cast<double>(eye[axis]);
+    const double nearest = vtkm::Max(ranges[axis]->Min, vtkm::Min(ranges[axis]->Max, p));
+    distance += (p - nearest) * (p - nearest);
+  }
+  return vtkm::Sqrt(distance);
 }
 
 vtkmCamera
@@ -53,13 +53,28 @@ public:
   virtual ~CameraGenerator();
   virtual void get_rays(vtkmRayTracing::Ray<vtkm::Float32> &rays);
   virtual void get_rays(vtkmRayTracing::Ray<vtkm::Float64> &rays);
+  virtual void get_rays(vtkmRayTracing::Ray<vtkm::Float32> &rays,
+                        const vtkm::Bounds &bounds);
+  virtual void get_rays(vtkmRayTracing::Ray<vtkm::Float64> &rays,
+                        const vtkm::Bounds &bounds);
+  virtual double get_distance(const vtkm::Bounds &bounds) const;
   vtkmCamera get_camera();
   vtkmCoordinates get_coordinates();
   void set_coordinates(vtkmCoordinates coordinates);
 protected:
   CameraGenerator();
+  template<typename FloatType>
+  void create_rays(vtkmRayTracing::Ray<FloatType> &rays,
+                   const vtkm::Bounds &bounds);
   vtkmCoordinates m_coordinates;
   vtkmCamera m_camera;
+  //
+  // The ray tracing camera is configured once and reused for every
+  // domain until the image dimensions change
+  //
+  vtkmRayTracing::Camera m_ray_camera;
+  int m_ray_camera_width;
+  int m_ray_camera_height;
 };
 
 } // namespace rover
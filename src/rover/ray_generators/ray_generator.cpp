@@ -61,6 +61,26 @@ RayGenerator::~RayGenerator()
 
 }
 
+void
+RayGenerator::get_rays(vtkmRayTracing::Ray<vtkm::Float32> &rays,
+                       const vtkm::Bounds &vtkmNotUsed(bounds))
+{
+  get_rays(rays);
+}
+
+void
+RayGenerator::get_rays(vtkmRayTracing::Ray<vtkm::Float64> &rays,
+                       const vtkm::Bounds &vtkmNotUsed(bounds))
+{
+  get_rays(rays);
+}
+
+double
+RayGenerator::get_distance(const vtkm::Bounds &vtkmNotUsed(bounds)) const
+{
+  return 0.;
+}
+
 void
 RayGenerator::get_dims(int &height, int &width) const
 {
@@ -92,6 +112,12 @@ RayGenerator::set_height(int height)
   m_height = height;
 }
 
+void
+RayGenerator::set_ray_cache(std::shared_ptr<RayCache> ray_cache)
+{
+  m_ray_cache = ray_cache;
+}
+
 int
 RayGenerator::get_size() const
 {
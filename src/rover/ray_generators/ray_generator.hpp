@@ -42,8 +42,11 @@
 #ifndef rover_ray_generator_h
 #define rover_ray_generator_h
 #include <vtkm_typedefs.hpp>
+#include <memory>
 namespace rover {
 
+class RayCache;
+
 class RayGenerator
 {
 public:
@@ -52,6 +55,17 @@ public:
   virtual ~RayGenerator();
   virtual void get_rays(vtkmRayTracing::Ray<vtkm::Float32> &rays) = 0;
   virtual void get_rays(vtkmRayTracing::Ray<vtkm::Float64> &rays) = 0;
+  //
+  // Generate only the rays that can hit the given bounds.
+  // The default ignores the bounds.
+  //
+  virtual void get_rays(vtkmRayTracing::Ray<vtkm::Float32> &rays,
+                        const vtkm::Bounds &bounds);
+  virtual void get_rays(vtkmRayTracing::Ray<vtkm::Float64> &rays,
+                        const vtkm::Bounds &bounds);
+  // distance from the eye to the nearest point of the bounds, used to
+  // order domains front to back. The default keeps the given order.
+  virtual double get_distance(const vtkm::Bounds &bounds) const;
 
   void get_dims(int &height, int &width) const;
   int  get_size() const;
@@ -59,10 +73,13 @@ public:
   void reset();
   void set_width(int width);
   void set_height(int height);
+  // keeps state used to generate rays (e.g., the canvas) between frames
+  void set_ray_cache(std::shared_ptr<RayCache> ray_cache);
 protected:
   int  m_height;
   int  m_width;
   bool m_has_rays;
+  std::shared_ptr<RayCache> m_ray_cache;
 };
 }; //namespace rover
 #endif
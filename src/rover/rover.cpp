@@ -39,6 +39,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+#include <dynamic_scheduler.hpp>
 #include <scheduler.hpp>
 #include <rover.hpp>
 #include <rover_exceptions.hpp>
@@ -55,10 +56,16 @@ namespace rover {
 class Rover::InternalsType
 {
 public:
-  enum TracePrecision {ROVER_FLOAT, ROVER_DOUBLE};
+  // composite64 traces in single precision and composites in double
+  enum TracePrecision {ROVER_FLOAT, ROVER_DOUBLE, ROVER_COMPOSITE64};
 protected:
   SchedulerBase            *m_scheduler;
   TracePrecision            m_precision;
+  // rays are forwarded between domains (local rays or scattering)
+  bool                      m_dynamic;
+  std::shared_ptr<EngineCache> m_engine_cache;
+  vtkm::Int64               m_mesh_generation;
+  std::shared_ptr<RayCache> m_ray_cache;
 #ifdef ROVER_PARALLEL
   MPI_Comm                  m_comm_handle;
   int                       m_rank;
@@ -74,7 +81,9 @@ public:
   InternalsType()
   {
     m_precision = ROVER_FLOAT;
+    m_dynamic = false;
     m_scheduler = new Scheduler<vtkm::Float32>();
+    m_mesh_generation = -1;
 
 #ifdef ROVER_PARALLEL
     m_rank = 1;
@@ -88,33 +97,58 @@ public:
     m_scheduler->add_data_set(dataset);
   }
 
+  void add_data_set(vtkmDataSet &dataset, const vtkm::Id domain_id)
+  {
+    ROVER_INFO("Adding data set "<<domain_id);
+    m_scheduler->add_data_set(dataset, domain_id);
+  }
+
+  void set_engine_cache(std::shared_ptr<EngineCache> engine_cache,
+                        const vtkm::Int64 mesh_generation)
+  {
+    m_engine_cache = engine_cache;
+    m_mesh_generation = mesh_generation;
+  }
+
+  void set_ray_cache(std::shared_ptr<RayCache> ray_cache)
+  {
+    m_ray_cache = ray_cache;
+  }
+
   void set_render_settings(RenderSettings render_settings)
   {
     ROVER_INFO("set_render_settings");
-    // TODO: make copy constructors to get the members like ray_generator
-//#ifdef ROVER_PARALLEL
-    // logic to create the appropriate parallel scheduler
     //
-    // ray tracing = dynamic scheduler, scattering | no_scattering
-    // volume/engery = scattering + local_scope -> dynamic scheduler
-    //                 non_scattering + global_scope ->static scheduler
+    // volume/energy = scattering | local_scope -> dynamic scheduler
+    //                 non_scattering + global_scope -> static scheduler
     //
-    // Note: I wanted to allow for the case of scattering + global scope. This could
-    //       be benificial in the case where we may or may not scatter in a given
-    //       domain. Thus, avoid waiting for the ray to emerge or throw out the results
-//#else
-     //if(render_settings compared to old means new schedular)
-     //if(m_scheduler == NULL) delete m_scheduler;
-     //m_scheduler = new Scheduler<FloatType>();
-     m_scheduler->set_render_settings(render_settings);
-//#endif
-   }
+    // Rover rays do not change direction yet, so scattering only selects
+    // the scheduler that forwards rays between domains.
+    //
+    const bool dynamic = render_settings.m_ray_scope == local_rays ||
+                         render_settings.m_scattering_type == scattering;
+    if(dynamic != m_dynamic)
+    {
+      set_scheduler(m_precision, dynamic);
+    }
+    m_scheduler->set_render_settings(render_settings);
+  }
 
   void set_ray_generator(RayGenerator *ray_generator)
   {
     m_scheduler->set_ray_generator(ray_generator);
   }
 
+  void set_ray_generators(const std::vector<RayGenerator*> &ray_generators)
+  {
+    m_scheduler->set_ray_generators(ray_generators);
+  }
+
+  int get_num_views()
+  {
+    return m_scheduler->get_num_views();
+  }
+
   void clear_data_sets()
   {
     m_scheduler->clear_data_sets();
@@ -135,26 +169,30 @@ public:
     m_scheduler->set_background(background);
   }
 
-  void save_png(const std::string &file_name)
+  void save_png(const std::string &file_name, const int view)
   {
+    m_scheduler->composite_view(view);
 #ifdef ROVER_PARALLEL
-    if(m_rank != 0)
+    // tiled images are written by every rank
+    if(m_rank != 0 && !m_scheduler->has_tiled_result())
     {
       return;
     }
 #endif
-    m_scheduler->save_result(file_name);
+    m_scheduler->save_result(file_name, view);
   }
 
-  void save_bov(const std::string &file_name)
+  void save_bov(const std::string &file_name, const int view)
   {
+    m_scheduler->composite_view(view);
 #ifdef ROVER_PARALLEL
-    if(m_rank != 0)
+    // tiled images are written by every rank
+    if(m_rank != 0 && !m_scheduler->has_tiled_result())
     {
       return;
     }
 #endif
-    m_scheduler->save_bov(file_name);
+    m_scheduler->save_bov(file_name, view);
   }
 
   void execute()
@@ -170,7 +208,18 @@ public:
 
     m_scheduler->set_comm_handle(m_comm_handle);
 #endif
+    // the precision can replace the scheduler, so the cache is
+    // handed over right before tracing
+    m_scheduler->set_engine_cache(m_engine_cache, m_mesh_generation);
+    if(m_ray_cache != nullptr)
+    {
+      m_scheduler->set_ray_cache(m_ray_cache);
+    }
     m_scheduler->trace_rays();
+    if(m_engine_cache != nullptr && m_mesh_generation >= 0)
+    {
+      m_engine_cache->prune();
+    }
   }
 #ifdef ROVER_PARALLEL
   void set_comm_handle(MPI_Comm comm_handle)
@@ -189,34 +238,65 @@ public:
     return m_comm_handle;
   }
 #endif
-  void get_result(Image<vtkm::Float32> &image)
+  void get_result(Image<vtkm::Float32> &image, const int view)
   {
-    m_scheduler->get_result(image);
+    m_scheduler->composite_view(view);
+    m_scheduler->get_result(image, view);
   }
 
-  void get_result(Image<vtkm::Float64> &image)
+  void get_result(Image<vtkm::Float64> &image, const int view)
   {
-    m_scheduler->get_result(image);
+    m_scheduler->composite_view(view);
+    m_scheduler->get_result(image, view);
   }
 
   void set_tracer_precision32()
   {
-    if(m_precision == ROVER_DOUBLE)
+    if(m_precision != ROVER_FLOAT)
     {
-      std::vector<Domain> domains = m_scheduler->get_domains();
-      delete m_scheduler;
-      m_scheduler = new Scheduler<vtkm::Float32>();
+      set_scheduler(ROVER_FLOAT, m_dynamic);
     }
   }
 
   void set_tracer_precision64()
   {
-    if(m_precision == ROVER_FLOAT)
+    if(m_precision != ROVER_DOUBLE)
+    {
+      set_scheduler(ROVER_DOUBLE, m_dynamic);
+    }
+  }
+
+  void set_composite_precision64()
+  {
+    if(m_precision != ROVER_COMPOSITE64)
+    {
+      set_scheduler(ROVER_COMPOSITE64, m_dynamic);
+    }
+  }
+
+  static SchedulerBase *create_scheduler(const TracePrecision precision, const bool dynamic)
+  {
+    if(dynamic)
     {
-      std::vector<Domain> domains = m_scheduler->get_domains();
-      delete m_scheduler;
-      m_scheduler = new Scheduler<vtkm::Float64>();
+      if(precision == ROVER_DOUBLE) return new DynamicScheduler<vtkm::Float64>();
+      if(precision == ROVER_COMPOSITE64) return new DynamicScheduler<vtkm::Float32, vtkm::Float64>();
+      return new DynamicScheduler<vtkm::Float32>();
     }
+    if(precision == ROVER_DOUBLE) return new Scheduler<vtkm::Float64>();
+    if(precision == ROVER_COMPOSITE64) return new Scheduler<vtkm::Float32, vtkm::Float64>();
+    return new Scheduler<vtkm::Float32>();
+  }
+
+  void set_scheduler(const TracePrecision precision, const bool dynamic)
+  {
+    SchedulerBase *scheduler = create_scheduler(precision, dynamic);
+    std::vector<Domain> domains = m_scheduler->get_domains();
+    scheduler->set_domains(domains);
+    scheduler->set_render_settings(m_scheduler->get_render_settings());
+    delete m_scheduler;
+    m_scheduler = scheduler;
+    m_precision = precision;
+    m_dynamic = dynamic;
   }
 
 }; //Internals Type
@@ -267,6 +347,25 @@ Rover::add_data_set(vtkmDataSet &dataset)
   m_internals->add_data_set(dataset);
 }
 
+void
+Rover::add_data_set(vtkmDataSet &dataset, const vtkm::Id domain_id)
+{
+  m_internals->add_data_set(dataset, domain_id);
+}
+
+void
+Rover::set_engine_cache(std::shared_ptr<EngineCache> engine_cache,
+                        const vtkm::Int64 mesh_generation)
+{
+  m_internals->set_engine_cache(engine_cache, mesh_generation);
+}
+
+void
+Rover::set_ray_cache(std::shared_ptr<RayCache> ray_cache)
+{
+  m_internals->set_ray_cache(ray_cache);
+}
+
 void
 Rover::set_render_settings(RenderSettings render_settings)
 {
@@ -289,6 +388,29 @@ Rover::set_ray_generator(RayGenerator *ray_generator)
   m_internals->set_ray_generator(ray_generator);
 }
 
+void
+Rover::set_ray_generators(const std::vector<RayGenerator*> &ray_generators)
+{
+  if(ray_generators.size() == 0)
+  {
+    throw RoverException("Ray generators cannot be empty");
+  }
+  for(size_t i = 0; i < ray_generators.size(); ++i)
+  {
+    if(ray_generators[i] == nullptr)
+    {
+      throw RoverException("Ray generator cannot  be null");
+    }
+  }
+  m_internals->set_ray_generators(ray_generators);
+}
+
+int
+Rover::get_num_views()
+{
+  return m_internals->get_num_views();
+}
+
 void
 Rover::execute()
 {
@@ -374,25 +496,49 @@ Rover::set_background(const std::vector<vtkm::Float32> &background)
 void
 Rover::save_png(const std::string &file_name)
 {
-  m_internals->save_png(file_name);
+  m_internals->save_png(file_name, 0);
+}
+
+void
+Rover::save_png(const std::string &file_name, const int view)
+{
+  m_internals->save_png(file_name, view);
 }
 
 void
 Rover::save_bov(const std::string &file_name)
 {
-  m_internals->save_bov(file_name);
+  m_internals->save_bov(file_name, 0);
+}
+
+void
+Rover::save_bov(const std::string &file_name, const int view)
+{
+  m_internals->save_bov(file_name, view);
 }
 
 void
 Rover::get_result(Image<vtkm::Float32> &image)
 {
-  m_internals->get_result(image);
+  m_internals->get_result(image, 0);
 }
 
 void
 Rover::get_result(Image<vtkm::Float64> &image)
 {
-  m_internals->get_result(image);
+  m_internals->get_result(image, 0);
+}
+
+void
+Rover::get_result(Image<vtkm::Float32> &image, const int view)
+{
+  m_internals->get_result(image, view);
+}
+
+void
+Rover::get_result(Image<vtkm::Float64> &image, const int view)
+{
+  m_internals->get_result(image, view);
 }
 
 void
@@ -407,5 +553,11 @@ Rover::set_tracer_precision64()
   m_internals->set_tracer_precision64();
 }
 
+void
+Rover::set_composite_precision64()
+{
+  m_internals->set_composite_precision64();
+}
+
 }; //namespace rover
 
@@ -54,6 +54,9 @@
 
 namespace rover {
 
+class EngineCache;
+class RayCache;
+
 class Rover
 {
 public:
@@ -66,19 +69,57 @@ public:
   void finalize();
 
   void add_data_set(vtkmDataSet &);
+  void add_data_set(vtkmDataSet &, const vtkm::Id domain_id);
+  //
+  // Keep the engines (and the mesh structures their tracers build) in
+  // engine_cache so later executes can reuse them. The mesh generation
+  // must change whenever the coordinates or cells of a domain change,
+  // and domains are matched by domain id. Engines not used by an
+  // execute are released at the end of it. A negative mesh generation
+  // does not use the cache.
+  //
+  void set_engine_cache(std::shared_ptr<EngineCache> engine_cache,
+                        const vtkm::Int64 mesh_generation);
+  //
+  // Keep ray storage in ray_cache so later executes reuse it
+  // instead of reallocating it every frame
+  //
+  void set_ray_cache(std::shared_ptr<RayCache> ray_cache);
   void set_render_settings(const RenderSettings render_settings);
   void set_ray_generator(RayGenerator *);
+  //
+  // Trace one view per ray generator sharing the same data set setup
+  // and global reductions. Each view is composited when it is first
+  // saved or fetched, one view at a time, and its partials are released
+  // afterwards. Therefore:
+  //   - save_png, save_bov and get_result are collective and must be
+  //     called by all ranks, for the same views in the same order
+  //   - a view can be saved or fetched any number of times until another
+  //     view is saved or fetched, but not after that
+  //
+  void set_ray_generators(const std::vector<RayGenerator*> &ray_generators);
+  int  get_num_views();
   void clear_data_sets();
   void set_background(const std::vector<vtkm::Float32> &background);
   void set_background(const std::vector<vtkm::Float64> &background);
   void execute();
   void about();
   void save_png(const std::string &file_name);
+  void save_png(const std::string &file_name, const int view);
   void save_bov(const std::string &file_name);
+  void save_bov(const std::string &file_name, const int view);
   void set_tracer_precision32();
   void set_tracer_precision64();
+  //
+  // Trace in single precision and composite the partials across
+  // domains and ranks in double precision. Samples within a domain are
+  // still accumulated in single precision by the tracer.
+  //
+  void set_composite_precision64();
   void get_result(Image<vtkm::Float32> &image);
   void get_result(Image<vtkm::Float64> &image);
+  void get_result(Image<vtkm::Float32> &image, const int view);
+  void get_result(Image<vtkm::Float64> &image, const int view);
 private:
   class InternalsType;
   std::shared_ptr<InternalsType> m_internals;
@@ -73,8 +73,21 @@ struct VolumeSettings
 {
   int m_num_samples; // approximate number of samples per ray
   vtkmRange m_scalar_range;
+  //
+  // Macrocells per axis of the grid used to skip space that the
+  // transfer function maps to zero opacity (0 disables skipping)
+  //
+  int m_macrocell_dims;
+  //
+  // Rays stop at domains behind the depth where the partials in front
+  // of them reach this opacity (1 disables early termination). Only
+  // applies when domains are traced one at a time.
+  //
+  float m_opacity_threshold;
   VolumeSettings()
-    : m_num_samples(400)
+    : m_num_samples(400),
+      m_macrocell_dims(0),
+      m_opacity_threshold(1.f)
   {}
 };
 //
@@ -84,9 +97,15 @@ struct EnergySettings
 {
   bool m_divide_abs_by_emmision;
   float m_unit_scalar;
+  //
+  // Leave the composited image distributed across ranks and write it
+  // one bin at a time instead of gathering every bin on rank 0
+  //
+  bool m_tiled_output;
   EnergySettings()
     : m_divide_abs_by_emmision(false),
-      m_unit_scalar(1.0)
+      m_unit_scalar(1.0),
+      m_tiled_output(false)
   {}
 };
 
@@ -101,6 +120,15 @@ struct RenderSettings
   VolumeSettings m_volume_settings;
   EnergySettings m_energy_settings;
   //
+  // Global values the caller already knows (e.g. the bounds used to
+  // place the camera). They must be the same on every rank. Empty
+  // bounds and ranges and non-positive channel counts are computed
+  // with a single reduction across ranks.
+  //
+  vtkm::Bounds   m_global_bounds;
+  vtkmRange      m_primary_range;
+  int            m_num_channels;
+  //
   // Default settings
   //
   RenderSettings()
@@ -109,6 +137,7 @@ struct RenderSettings
     m_render_mode     = volume;
     m_scattering_type = non_scattering;
     m_ray_scope       = global_rays;
+    m_num_channels    = 0;
   }
 
   void print()
@@ -41,15 +41,20 @@
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 
 #include <assert.h>
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <numeric>
 #include <vtkh/rendering/PartialCompositor.hpp>
 #include <scheduler.hpp>
+#include <bin_compositor.hpp>
 #include <utils/png_encoder.hpp>
 #include <utils/rover_logging.hpp>
 #include <vtkm/rendering/CanvasRayTracer.h>
 #include <vtkm_typedefs.hpp>
 #include <ray_generators/camera_generator.hpp>
 #include <rover_exceptions.hpp>
+#include <vtkm/cont/ArrayCopy.h>
 
 #ifdef ROVER_PARALLEL
 #include <mpi.h>
@@ -57,186 +62,193 @@
 
 namespace rover {
 
-template<typename FloatType>
-Scheduler<FloatType>::Scheduler()
+namespace detail
 {
-  m_ray_generator = NULL;
-}
 
-template<typename FloatType>
-Scheduler<FloatType>::~Scheduler()
+//
+// Replaces array with a copy if it shares storage with any of the
+// given ray arrays
+//
+template<typename T>
+void
+detach_array(vtkm::cont::ArrayHandle<T> &array,
+             const std::vector<vtkm::cont::ArrayHandle<T>> &ray_arrays)
 {
+  for(size_t i = 0; i < ray_arrays.size(); ++i)
+  {
+    if(array == ray_arrays[i])
+    {
+      vtkm::cont::ArrayHandle<T> copy;
+      vtkm::cont::ArrayCopy(array, copy);
+      array = copy;
+      return;
+    }
+  }
 }
 
+//
+// Partials can share arrays with the rays they were traced with. The
+// rays are reused by the next domain, so shared arrays are copied out.
+//
 template<typename FloatType>
-int
-Scheduler<FloatType>::get_global_channels()
+void
+detach_from_rays(std::vector<vtkmRayTracing::PartialComposite<FloatType>> &partials,
+                 vtkmRayTracing::Ray<FloatType> &rays)
 {
+  std::vector<vtkm::cont::ArrayHandle<FloatType>> buffers;
+  buffers.push_back(rays.Distance);
+  for(size_t i = 0; i < rays.Buffers.size(); ++i)
+  {
+    buffers.push_back(rays.Buffers[i].Buffer);
+  }
+  std::vector<vtkm::cont::ArrayHandle<vtkm::Id>> pixel_ids(1, rays.PixelIdx);
 
-  int num_channels = 1;
-  for(size_t i = 0; i < m_domains.size(); ++i)
+  for(size_t p = 0; p < partials.size(); ++p)
   {
-    num_channels = std::max(num_channels, m_domains[i].get_num_channels());
+    detach_array(partials[p].PixelIds, pixel_ids);
+    detach_array(partials[p].Distances, buffers);
+    detach_array(partials[p].Buffer.Buffer, buffers);
+    detach_array(partials[p].Intensities.Buffer, buffers);
   }
-#ifdef ROVER_PARALLEL
-  vtkmTimer timer;
-  double time = 0;
-  (void) time;
-  int mpi_num_channels;
-  MPI_Allreduce(&num_channels, &mpi_num_channels, 1, MPI_INT, MPI_MAX, m_comm_handle);
-  num_channels = mpi_num_channels;
-  time = timer.GetElapsedTime();
-  ROVER_DATA_ADD("get_global_channels_all_reduce", time);
-#endif
+}
+
+} // namespace detail
 
-  ROVER_INFO("Global number of channels"<<num_channels);
-  return num_channels;
+template<typename FloatType, typename AccumType>
+Scheduler<FloatType, AccumType>::Scheduler()
+  : m_composited_view(-1),
+    m_num_channels(1)
+{
+  m_ray_generator = NULL;
 }
 
-template<typename FloatType>
-void
-Scheduler<FloatType>::set_global_scalar_range()
+template<typename FloatType, typename AccumType>
+Scheduler<FloatType, AccumType>::~Scheduler()
 {
+}
 
+//
+// Sets the global bounds, scalar range and number of channels. Values
+// supplied in the render settings are used as is and the rest are
+// packed into a single min reduction (maxima are negated), so a render
+// needs at most one collective and none when everything is supplied.
+//
+template<typename FloatType, typename AccumType>
+void
+Scheduler<FloatType, AccumType>::set_global_state()
+{
   vtkmTimer timer;
   double time = 0;
   (void) time;
 
   const int num_domains = static_cast<int>(m_domains.size());
 
-  vtkmRange global_range;
+  vtkm::Bounds global_bounds = m_render_settings.m_global_bounds;
+  const bool reduce_bounds = !global_bounds.IsNonEmpty();
+  if(reduce_bounds)
+  {
+    for(int i = 0; i < num_domains; ++i)
+    {
+      global_bounds.Include(m_domains[i].get_domain_bounds());
+    }
+  }
+  else
+  {
+    ROVER_INFO("Provided bounds "<<global_bounds);
+  }
+
+  vtkmRange global_range = m_render_settings.m_primary_range;
   if(m_render_settings.m_render_mode == volume &&
      m_render_settings.m_volume_settings.m_scalar_range.IsNonEmpty())
   {
     global_range = m_render_settings.m_volume_settings.m_scalar_range;
-    ROVER_INFO("Provided scalar range "<<global_range);
   }
-  else
+  const bool reduce_range = !global_range.IsNonEmpty();
+  if(reduce_range)
   {
-
     for(int i = 0; i < num_domains; ++i)
     {
-      vtkmRange local_range = m_domains[i].get_primary_range();
-      global_range.Include(local_range);
+      global_range.Include(m_domains[i].get_primary_range());
     }
-#ifdef ROVER_PARALLEL
-    double rank_min = global_range.Min;
-    double rank_max = global_range.Max;
-    double mpi_min;
-    double mpi_max;
-    MPI_Allreduce(&rank_min, &mpi_min, 1, MPI_DOUBLE, MPI_MIN, m_comm_handle);
-    MPI_Allreduce(&rank_max, &mpi_max, 1, MPI_DOUBLE, MPI_MAX, m_comm_handle);
-    global_range.Min = mpi_min;
-    global_range.Max = mpi_max;
-#endif
-
-    ROVER_INFO("Global scalar range "<<global_range);
   }
-
-  for(int i = 0; i < num_domains; ++i)
+  else
   {
-    m_domains[i].set_primary_range(global_range);
+    ROVER_INFO("Provided scalar range "<<global_range);
   }
 
-  time = timer.GetElapsedTime();
-  ROVER_DATA_ADD("set_global_scalar_range", time);
-}
-
-template<typename FloatType>
-void
-Scheduler<FloatType>::set_global_bounds()
-{
-  vtkmTimer timer;
-  double time = 0;
-
-  const int num_domains = static_cast<int>(m_domains.size());
-
-  vtkm::Bounds global_bounds;
-
-  for(int i = 0; i < num_domains; ++i)
+  int num_channels = m_render_settings.m_num_channels;
+  if(m_render_settings.m_render_mode == volume)
   {
-    vtkm::Bounds local_bounds = m_domains[i].get_domain_bounds();
-    global_bounds.Include(local_bounds);
+    // volume rendering always produces rgba
+    num_channels = 4;
+  }
+  const bool reduce_channels = num_channels <= 0;
+  if(reduce_channels)
+  {
+    num_channels = 1;
+    for(int i = 0; i < num_domains; ++i)
+    {
+      num_channels = std::max(num_channels, m_domains[i].get_num_channels());
+    }
   }
 
 #ifdef ROVER_PARALLEL
-
-  double x_min = global_bounds.X.Min;
-  double x_max = global_bounds.X.Max;
-  double y_min = global_bounds.Y.Min;
-  double y_max = global_bounds.Y.Max;
-  double z_min = global_bounds.Z.Min;
-  double z_max = global_bounds.Z.Max;
-  double global_x_min = 0;
-  double global_x_max = 0;
-  double global_y_min = 0;
-  double global_y_max = 0;
-  double global_z_min = 0;
-  double global_z_max = 0;
-
-  MPI_Allreduce((void *)(&x_min),
-                (void *)(&global_x_min),
-                1,
-                MPI_DOUBLE,
-                MPI_MIN,
-                m_comm_handle);
-
-  MPI_Allreduce((void *)(&x_max),
-                (void *)(&global_x_max),
-                1,
-                MPI_DOUBLE,
-                MPI_MAX,
-                m_comm_handle);
-
-  MPI_Allreduce((void *)(&y_min),
-                (void *)(&global_y_min),
-                1,
-                MPI_DOUBLE,
-                MPI_MIN,
-                m_comm_handle);
-
-  MPI_Allreduce((void *)(&y_max),
-                (void *)(&global_y_max),
-                1,
-                MPI_DOUBLE,
-                MPI_MAX,
-                m_comm_handle);
-
-  MPI_Allreduce((void *)(&z_min),
-                (void *)(&global_z_min),
-                1,
-                MPI_DOUBLE,
-                MPI_MIN,
-                m_comm_handle);
-
-  MPI_Allreduce((void *)(&z_max),
-                (void *)(&global_z_max),
-                1,
-                MPI_DOUBLE,
-                MPI_MAX,
-                m_comm_handle);
-
-  global_bounds.X.Min = global_x_min;
-  global_bounds.X.Max = global_x_max;
-  global_bounds.Y.Min = global_y_min;
-  global_bounds.Y.Max = global_y_max;
-  global_bounds.Z.Min = global_z_min;
-  global_bounds.Z.Max = global_z_max;
+  if(reduce_bounds || reduce_range || reduce_channels)
+  {
+    double local_values[9];
+    local_values[0] = global_bounds.X.Min;
+    local_values[1] = global_bounds.Y.Min;
+    local_values[2] = global_bounds.Z.Min;
+    local_values[3] = global_range.Min;
+    local_values[4] = -global_bounds.X.Max;
+    local_values[5] = -global_bounds.Y.Max;
+    local_values[6] = -global_bounds.Z.Max;
+    local_values[7] = -global_range.Max;
+    local_values[8] = -static_cast<double>(num_channels);
+
+    double global_values[9];
+    MPI_Allreduce(local_values, global_values, 9, MPI_DOUBLE, MPI_MIN, m_comm_handle);
+
+    if(reduce_bounds)
+    {
+      global_bounds.X.Min = global_values[0];
+      global_bounds.Y.Min = global_values[1];
+      global_bounds.Z.Min = global_values[2];
+      global_bounds.X.Max = -global_values[4];
+      global_bounds.Y.Max = -global_values[5];
+      global_bounds.Z.Max = -global_values[6];
+    }
+    if(reduce_range)
+    {
+      global_range.Min = global_values[3];
+      global_range.Max = -global_values[7];
+    }
+    if(reduce_channels)
+    {
+      num_channels = static_cast<int>(-global_values[8]);
+    }
+  }
 #endif
 
   ROVER_INFO("Global bounds "<<global_bounds);
+  ROVER_INFO("Global scalar range "<<global_range);
+  ROVER_INFO("Global number of channels "<<num_channels);
 
   for(int i = 0; i < num_domains; ++i)
   {
+    m_domains[i].set_primary_range(global_range);
     m_domains[i].set_global_bounds(global_bounds);
   }
+  m_num_channels = num_channels;
+
   time = timer.GetElapsedTime();
-  ROVER_DATA_ADD("set_global_bounds", time);
+  ROVER_DATA_ADD("set_global_state", time);
 }
-template<typename FloatType>
-void Scheduler<FloatType>::add_partial(vtkmRayTracing::PartialComposite<FloatType> &partial,
-                                       int width,
-                                       int height)
+
+template<typename FloatType, typename AccumType>
+void Scheduler<FloatType, AccumType>::add_partial(vtkmRayTracing::PartialComposite<FloatType> &partial,
+                                                  int width,
+                                                  int height)
 {
   PartialImage<FloatType> partial_image;
   partial_image.m_pixel_ids = partial.PixelIds;
@@ -250,8 +262,8 @@ void Scheduler<FloatType>::add_partial(vtkmRayTracing::PartialComposite<FloatTyp
   m_partial_images.push_back(partial_image);
 }
 
-template<typename FloatType>
-void Scheduler<FloatType>::composite()
+template<typename FloatType, typename AccumType>
+void Scheduler<FloatType, AccumType>::composite()
 {
   int rank = 0;
 #ifdef ROVER_PARALLEL
@@ -259,7 +271,7 @@ void Scheduler<FloatType>::composite()
 #endif
   if(m_render_settings.m_render_mode == volume)
   {
-    vtkh::PartialCompositor<vtkh::VolumePartial<FloatType>> compositor;
+    vtkh::PartialCompositor<vtkh::VolumePartial<AccumType>> compositor;
     compositor.set_background(m_background);
 #ifdef ROVER_PARALLEL
     compositor.set_comm_handle(MPI_Comm_c2f(m_comm_handle));
@@ -267,15 +279,15 @@ void Scheduler<FloatType>::composite()
     const int num_partials = m_partial_images.size();
     int width = m_partial_images[0].m_width;
     int height = m_partial_images[0].m_height;
-    std::vector<std::vector<vtkh::VolumePartial<FloatType>>> partials;
+    std::vector<std::vector<vtkh::VolumePartial<AccumType>>> partials;
     partials.resize(num_partials);
     for(int i = 0; i < num_partials; ++i)
     {
       m_partial_images[i].extract_partials(partials[i]);
     }
-    std::vector<vtkh::VolumePartial<FloatType>> result;
+    std::vector<vtkh::VolumePartial<AccumType>> result;
     compositor.composite(partials, result);
-    PartialImage<FloatType> p_result;
+    PartialImage<AccumType> p_result;
 
     if(rank == 0)
     {
@@ -287,137 +299,201 @@ void Scheduler<FloatType>::composite()
   }
   else
   {
-    if(m_render_settings.m_secondary_field != "")
-    {
-      vtkh::PartialCompositor<vtkh::EmissionPartial<FloatType>> compositor;
-      compositor.set_background(m_background);
+    BinCompositor<AccumType> compositor;
 #ifdef ROVER_PARALLEL
-      compositor.set_comm_handle(MPI_Comm_c2f(m_comm_handle));
+    compositor.set_comm_handle(m_comm_handle);
 #endif
-      const int num_partials = m_partial_images.size();
-      int width = m_partial_images[0].m_width;
-      int height = m_partial_images[0].m_height;
-      std::vector<std::vector<vtkh::EmissionPartial<FloatType>>> partials;
-      partials.resize(num_partials);
-      for(int i = 0; i < num_partials; ++i)
-      {
-        m_partial_images[i].extract_partials(partials[i]);
-      }
-      std::vector<vtkh::EmissionPartial<FloatType>> result;
-      compositor.composite(partials, result);
-      PartialImage<FloatType> p_result;
+    const int width = m_partial_images[0].m_width;
+    const int height = m_partial_images[0].m_height;
+    const int num_bins = m_partial_images[0].m_buffer.GetNumChannels();
+    const bool has_emission = m_render_settings.m_secondary_field != "";
+    BinPartials<AccumType> result;
 
-      if(rank == 0)
-      {
-        // data only valid on rank = 0
-        p_result.store(result,m_background, width, height);
-      }
-
-      m_result = p_result;
-    }
-    else
+    if(has_tiled_result())
     {
-      vtkh::PartialCompositor<vtkh::AbsorptionPartial<FloatType>> compositor;
-      compositor.set_background(m_background);
+      vtkm::Id tile_begin = 0;
+      vtkm::Id tile_end = 0;
+      compositor.composite_tiles(m_partial_images,
+                                 num_bins,
+                                 has_emission,
+                                 static_cast<vtkm::Id>(width) * height,
+                                 result,
+                                 tile_begin,
+                                 tile_end);
+      int view_width = 0;
+      int view_height = 0;
+      m_ray_generator->get_dims(view_height, view_width);
 #ifdef ROVER_PARALLEL
-      compositor.set_comm_handle(MPI_Comm_c2f(m_comm_handle));
+      m_tiled_result.set_comm_handle(m_comm_handle);
 #endif
-      const int num_partials = m_partial_images.size();
-      int width = m_partial_images[0].m_width;
-      int height = m_partial_images[0].m_height;
-      std::vector<std::vector<vtkh::AbsorptionPartial<FloatType>>> partials;
-      partials.resize(num_partials);
-      for(int i = 0; i < num_partials; ++i)
-      {
-        m_partial_images[i].extract_partials(partials[i]);
-      }
-      std::vector<vtkh::AbsorptionPartial<FloatType>> result;
-      compositor.composite(partials, result);
-      PartialImage<FloatType> p_result;
+      m_tiled_result.set_tile(result,
+                              tile_begin,
+                              tile_end,
+                              m_background,
+                              view_width,
+                              view_height);
+      m_result = PartialImage<AccumType>();
+      ROVER_INFO("Schedule: tiled compositing complete");
+      return;
+    }
 
-      if(rank == 0)
-      {
-        // data only valid on rank = 0
-        p_result.store(result,m_background, width, height);
-      }
+    compositor.composite(m_partial_images,
+                         num_bins,
+                         has_emission,
+                         static_cast<vtkm::Id>(width) * height,
+                         result);
+    PartialImage<AccumType> p_result;
 
-      m_result = p_result;
+    if(rank == 0)
+    {
+      // data only valid on rank = 0
+      p_result.store(result, m_background, width, height);
     }
+
+    m_result = p_result;
   }
   ROVER_INFO("Schedule: compositing complete");
 }
+template<typename FloatType, typename AccumType>
+bool
+Scheduler<FloatType, AccumType>::early_termination() const
+{
+  return m_render_settings.m_render_mode == volume &&
+         m_render_settings.m_volume_settings.m_opacity_threshold < 1.f;
+}
+
+template<typename FloatType, typename AccumType>
+bool
+Scheduler<FloatType, AccumType>::is_opaque(const vtkm::Float64 transmittance) const
+{
+  return 1. - transmittance >= m_render_settings.m_volume_settings.m_opacity_threshold;
+}
+
+template<typename FloatType, typename AccumType>
+void
+Scheduler<FloatType, AccumType>::reset_opaque_depths()
+{
+  const int size = m_ray_generator->get_size();
+  m_opaque_depths.assign(size, std::numeric_limits<FloatType>::infinity());
+  m_transmittance.assign(size, 1.);
+}
+
 //
-// in the other schedulers this method will be far from trivial
+// Volume rendering only: clips each ray to the nearest depth at which
+// the domains traced earlier made the ray's pixel opaque
 //
-template<typename FloatType>
+template<typename FloatType, typename AccumType>
 void
-Scheduler<FloatType>::trace_rays()
+Scheduler<FloatType, AccumType>::clip_to_opaque_depths(vtkmRayTracing::Ray<FloatType> &rays)
 {
-  ROVER_INFO("tracing_rays");
-  vtkmTimer tot_timer;
-  vtkmTimer timer;
-  double time = 0;
-  (void) time;
-  ROVER_DATA_OPEN("schedule_trace");
-
-  if(m_ray_generator == NULL)
+  const vtkm::Id num_rays = rays.NumRays;
+  auto pixel_portal = rays.PixelIdx.GetPortalConstControl();
+  auto max_portal = rays.MaxDistance.GetPortalControl();
+#ifdef ROVER_ENABLE_OPENMP
+    #pragma omp parallel for
+#endif
+  for(vtkm::Id i = 0; i < num_rays; ++i)
   {
-    throw RoverException("Error: ray generator must be set before execute is called");
+    const FloatType depth = m_opaque_depths[pixel_portal.Get(i)];
+    if(depth < max_portal.Get(i))
+    {
+      max_portal.Set(i, depth);
+    }
   }
+}
 
-  m_ray_generator->reset();
-  // TODO while (m_geerator.has_rays())
-  ROVER_INFO("Tracing rays");
+//
+// Accumulates the opacity of each pixel from the partials of a domain.
+// A pixel that reaches the threshold is opaque from the depth of the
+// partial that made it so.
+//
+template<typename FloatType, typename AccumType>
+void
+Scheduler<FloatType, AccumType>::update_opaque_depths(
+  std::vector<vtkmRayTracing::PartialComposite<FloatType>> &partials)
+{
+  for(size_t p = 0; p < partials.size(); ++p)
+  {
+    const vtkm::Id size = partials[p].PixelIds.GetNumberOfValues();
+    auto id_portal = partials[p].PixelIds.GetPortalConstControl();
+    auto depth_portal = partials[p].Distances.GetPortalConstControl();
+    auto buffer_portal = partials[p].Buffer.Buffer.GetPortalConstControl();
+    for(vtkm::Id i = 0; i < size; ++i)
+    {
+      const vtkm::Id pixel = id_portal.Get(i);
+      // rgba, so alpha is the fourth channel
+      m_transmittance[pixel] *= 1. - buffer_portal.Get(i * 4 + 3);
+      if(is_opaque(m_transmittance[pixel]))
+      {
+        FloatType &depth = m_opaque_depths[pixel];
+        depth = std::min(depth, depth_portal.Get(i));
+      }
+    }
+  }
+}
 
-  int height = 0 ;
-  int width = 0;
+//
+// Trace every domain with the current ray generator.
+//
+// With an opacity threshold below one, volume rendering traces the
+// domains front to back and rays skip everything behind a pixel that
+// a nearer domain made opaque. Anything there would be composited
+// behind that partial, so it changes the pixel by less than one minus
+// the threshold (when the domains do not overlap).
+//
+template<typename FloatType, typename AccumType>
+void
+Scheduler<FloatType, AccumType>::trace_domains(const int width,
+                                               const int height)
+{
+  vtkmTimer timer;
+  double time = 0;
+  (void) time;
+  const int num_domains = static_cast<int>(m_domains.size());
 
-  m_ray_generator->get_dims(height, width);
+  const bool terminate_early = early_termination();
 
-  //
-  // ensure that the render settings are set
-  //
-  // TODO: make copy constructor so the mesh stuctures are not rebuilt when moving from
-  //       volume to energy and vice versa
-  const int num_domains = static_cast<int>(m_domains.size());
-  ROVER_INFO("scheduer set render settings for "<<num_domains<<" domains ");
-  for(int i = 0; i < num_domains; ++i)
+  std::vector<int> order(num_domains);
+  std::iota(order.begin(), order.end(), 0);
+  if(terminate_early)
   {
-    m_domains[i].set_render_settings(m_render_settings);
+    std::vector<double> distances(num_domains);
+    for(int i = 0; i < num_domains; ++i)
+    {
+      distances[i] = m_ray_generator->get_distance(m_domains[i].get_domain_bounds());
+    }
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&distances](int a, int b) { return distances[a] < distances[b]; });
+    reset_opaque_depths();
   }
 
-  ROVER_INFO("done scheduer set render settings for "<<num_domains<<" domains ");
-  time = timer.GetElapsedTime();
-  ROVER_DATA_ADD("setup", time);
-
-  this->set_global_scalar_range();
-  this->set_global_bounds();
-
-  vtkmTimer trace_timer;
-  for(int i = 0; i < num_domains; ++i)
+  for(int n = 0; n < num_domains; ++n)
   {
+    const int i = order[n];
     vtkmTimer domain_timer;
     std::stringstream domain_s;
     domain_s<<"trace_domain_"<<i;
     ROVER_DATA_OPEN(domain_s.str());
 
     vtkmLogger::GetInstance()->Clear();
-    if(dynamic_cast<CameraGenerator*>(m_ray_generator) != NULL)
-    {
-      //
-      // Setting the coordinate system miminizes the number of rays generated
-      //
-      CameraGenerator *generator = dynamic_cast<CameraGenerator*>(m_ray_generator);
-      generator->set_coordinates(m_domains[i].get_data_set().GetCoordinateSystem());
-    }
     ROVER_INFO("Generating rays for domian "<<i);
 
     timer.Reset();
 
-    vtkmRayTracing::Ray<FloatType> rays;
-    m_ray_generator->get_rays(rays);
+    //
+    // Passing the domain bounds miminizes the number of rays generated.
+    // Every domain is traced with the same rays, which are kept between
+    // frames, so the storage is reused instead of reallocated.
+    //
+    vtkmRayTracing::Ray<FloatType> &rays = m_ray_cache->get_rays<FloatType>();
+    m_ray_generator->get_rays(rays, m_domains[i].get_domain_bounds());
 
     ROVER_INFO("Generated "<<rays.NumRays<<" rays");
+    if(terminate_early && n > 0)
+    {
+      clip_to_opaque_depths(rays);
+    }
     m_domains[i].init_rays(rays);
     time = timer.GetElapsedTime();
     ROVER_DATA_ADD("domain_init_rays", time);
@@ -427,8 +503,13 @@ Scheduler<FloatType>::trace_rays()
     timer.Reset();
     std::vector<vtkmRayTracing::PartialComposite<FloatType>> partials;
     partials = m_domains[i].partial_trace(rays);
+    detail::detach_from_rays(partials, rays);
     time = timer.GetElapsedTime();
     ROVER_DATA_ADD("domain_trace", time);
+    if(terminate_early && n < num_domains - 1)
+    {
+      update_opaque_depths(partials);
+    }
 #ifdef ROVER_ENABLE_LOGGING
     DataLogger::GetInstance()->GetStream()<<vtkmLogger::GetInstance()->GetStream().str();
 #endif
@@ -449,34 +530,103 @@ Scheduler<FloatType>::trace_rays()
     ROVER_DATA_CLOSE(time);
     ROVER_INFO("Schedule: done tracing domain "<<i);
   }// for each domain
+}
 
-  timer.Reset();
-  time = trace_timer.GetElapsedTime();
-  ROVER_DATA_ADD("total_trace", time);
-  int num_channels = this->get_global_channels();
+template<typename FloatType, typename AccumType>
+void
+Scheduler<FloatType, AccumType>::trace_view(const int width,
+                                            const int height)
+{
+  trace_domains(width, height);
+}
 
-  vtkmTimer t1;
+//
+// in the other schedulers this method will be far from trivial
+//
+template<typename FloatType, typename AccumType>
+void
+Scheduler<FloatType, AccumType>::trace_rays()
+{
+  ROVER_INFO("tracing_rays");
+  vtkmTimer tot_timer;
+  vtkmTimer timer;
+  double time = 0;
+  (void) time;
+  ROVER_DATA_OPEN("schedule_trace");
+
+  if(m_ray_generators.size() == 0)
+  {
+    throw RoverException("Error: ray generator must be set before execute is called");
+  }
+
+  // TODO while (m_geerator.has_rays())
+  ROVER_INFO("Tracing rays");
+
+  const int num_views = static_cast<int>(m_ray_generators.size());
+
+  //
+  // ensure that the render settings are set
+  //
+  // TODO: make copy constructor so the mesh stuctures are not rebuilt when moving from
+  //       volume to energy and vice versa
+  const int num_domains = static_cast<int>(m_domains.size());
+  ROVER_INFO("scheduer set render settings for "<<num_domains<<" domains ");
+  for(int i = 0; i < num_domains; ++i)
+  {
+    m_domains[i].set_engine_cache(m_engine_cache, m_mesh_generation);
+    m_domains[i].set_render_settings(m_render_settings);
+  }
+
+  ROVER_INFO("done scheduer set render settings for "<<num_domains<<" domains ");
+  time = timer.GetElapsedTime();
+  ROVER_DATA_ADD("setup", time);
 
-  // Add dummy partial image if we had no domains
+  this->set_global_state();
 
-  if(num_domains == 0 || m_partial_images.size() == 0)
+  //
+  // Each view keeps its own partials until it is composited, which
+  // happens when it is asked for, so only one composited view exists
+  // at a time
+  //
+  const int num_channels = m_num_channels;
+  m_view_partials.clear();
+  m_view_partials.resize(num_views);
+  m_composited_view = -1;
+
+  vtkmTimer trace_timer;
+  for(int v = 0; v < num_views; ++v)
   {
-    PartialImage<FloatType> partial_image;
-    partial_image.m_width = width;
-    partial_image.m_height = height;
-    partial_image.m_buffer =
-      vtkm::rendering::raytracing::ChannelBuffer<FloatType>(num_channels, 0);
-    if(m_render_settings.m_secondary_field != "")
+    m_ray_generator = m_ray_generators[v];
+    m_ray_generator->reset();
+    m_ray_generator->set_ray_cache(m_ray_cache);
+    int height = 0;
+    int width = 0;
+    m_ray_generator->get_dims(height, width);
+    trace_view(width, height);
+
+    // Add dummy partial image if we had no domains
+    if(m_partial_images.size() == 0)
     {
-      partial_image.m_intensities =
+      PartialImage<FloatType> partial_image;
+      partial_image.m_width = width;
+      partial_image.m_height = height;
+      partial_image.m_buffer =
         vtkm::rendering::raytracing::ChannelBuffer<FloatType>(num_channels, 0);
+      if(m_render_settings.m_secondary_field != "")
+      {
+        partial_image.m_intensities =
+          vtkm::rendering::raytracing::ChannelBuffer<FloatType>(num_channels, 0);
+      }
+      m_partial_images.push_back(partial_image);
     }
-    m_partial_images.push_back(partial_image);
+    m_view_partials[v].swap(m_partial_images);
   }
-  //DataLogger::GetInstance()->AddLogData("blank_image", t1.GetElapsedTime());
-  //ROVER_DATA_ADD("blank_image", t1.GetElapsedTime());
-  t1.Reset();
 
+  timer.Reset();
+  time = trace_timer.GetElapsedTime();
+  ROVER_DATA_ADD("total_trace", time);
+
+  vtkmTimer t1;
   if(m_background.size() == 0)
   {
     this->create_default_background(num_channels);
@@ -490,17 +640,12 @@ Scheduler<FloatType>::trace_rays()
   timer.Reset();
 
   //
-  // Composite the results
+  // Composite the first view, the others wait until they are saved
   //
   timer.Reset();
-  composite();
+  composite_view(0);
   time = timer.GetElapsedTime();
   ROVER_DATA_ADD("compositing", time);
-  timer.Reset();
-
-  m_partial_images.clear();
-  time = timer.GetElapsedTime();
-  ROVER_DATA_ADD("clear", time);
 
   double tot_time = tot_timer.GetElapsedTime();
   (void) tot_time;
@@ -508,26 +653,83 @@ Scheduler<FloatType>::trace_rays()
   ROVER_INFO("Schedule: end of trace");
 }
 
-template<typename FloatType>
+template<typename FloatType, typename AccumType>
+Image<AccumType> &
+Scheduler<FloatType, AccumType>::get_view_result(const int view)
+{
+  if(has_tiled_result())
+  {
+    throw RoverException("Error: tiled results are distributed across ranks and can only be saved");
+  }
+  if(view != m_composited_view)
+  {
+    throw RoverException("Error: view must be composited before its result is used");
+  }
+  return m_result;
+}
+
+//
+// Composites the partials of one view into m_result (or m_tiled_result)
+// and releases them. This is collective, but does nothing when the view
+// is already the composited one. A view can't be composited again once
+// another view replaced it.
+//
+template<typename FloatType, typename AccumType>
 void
-Scheduler<FloatType>::get_result(Image<vtkm::Float32> &image)
+Scheduler<FloatType, AccumType>::composite_view(const int view)
 {
-  image = m_result;
+  if(view < 0 || view >= static_cast<int>(m_view_partials.size()))
+  {
+    throw RoverException("Error: invalid view number");
+  }
+  if(view == m_composited_view)
+  {
+    return;
+  }
+  // every view has at least one (possibly empty) partial after tracing
+  if(m_view_partials[view].size() == 0)
+  {
+    throw RoverException("Error: view was already composited and released");
+  }
+
+  m_ray_generator = m_ray_generators[view];
+  m_partial_images.swap(m_view_partials[view]);
+  m_tiled_result.clear();
+  composite();
+  std::vector<PartialImage<FloatType>>().swap(m_partial_images);
+  m_composited_view = view;
 }
 
-template<typename FloatType>
+template<typename FloatType, typename AccumType>
 void
-Scheduler<FloatType>::get_result(Image<vtkm::Float64> &image)
+Scheduler<FloatType, AccumType>::get_result(Image<vtkm::Float32> &image, const int view)
 {
-  image = m_result;
+  image = get_view_result(view);
 }
 
-template<typename FloatType>
-void Scheduler<FloatType>::save_result(std::string file_name)
+template<typename FloatType, typename AccumType>
+void
+Scheduler<FloatType, AccumType>::get_result(Image<vtkm::Float64> &image, const int view)
 {
+  image = get_view_result(view);
+}
+
+template<typename FloatType, typename AccumType>
+void Scheduler<FloatType, AccumType>::save_result(std::string file_name, const int view)
+{
+  if(has_tiled_result())
+  {
+    if(view != m_composited_view)
+    {
+      throw RoverException("Error: view must be composited before it is saved");
+    }
+    m_tiled_result.save_png(file_name);
+    return;
+  }
+  Image<AccumType> &result = get_view_result(view);
   int height = 0;
   int width = 0;
-  m_ray_generator->get_dims(height, width);
+  m_ray_generators[view]->get_dims(height, width);
   assert( height > 0 );
   assert( width > 0 );
   ROVER_INFO("Saving file " << height << " "<<width);
@@ -535,15 +737,15 @@ void Scheduler<FloatType>::save_result(std::string file_name)
 
   if(m_render_settings.m_render_mode == energy)
   {
-    const int num_channels = m_result.get_num_channels();
+    const int num_channels = result.get_num_channels();
     ROVER_INFO("Saving "<<num_channels<<" channels ");
     for(int i = 0; i < num_channels; ++i)
     {
       std::stringstream sstream;
       sstream<<file_name<<"_"<<i<<".png";
-      m_result.normalize_intensity(i);
-      FloatType * buffer
-        = get_vtkm_ptr(m_result.get_intensity(i));
+      result.normalize_intensity(i);
+      AccumType * buffer
+        = get_vtkm_ptr(result.get_intensity(i));
 
       encoder.EncodeChannel(buffer, width, height);
       encoder.Save(sstream.str());
@@ -552,10 +754,10 @@ void Scheduler<FloatType>::save_result(std::string file_name)
   else
   {
 
-    assert(m_result.get_num_channels() == 4);
-    vtkm::cont::ArrayHandle<FloatType> colors;
-    colors = m_result.flatten_intensities();
-    FloatType * buffer
+    assert(result.get_num_channels() == 4);
+    vtkm::cont::ArrayHandle<AccumType> colors;
+    colors = result.flatten_intensities();
+    AccumType * buffer
       = get_vtkm_ptr(colors);
 
     encoder.Encode(buffer, width, height);
@@ -564,12 +766,22 @@ void Scheduler<FloatType>::save_result(std::string file_name)
 
 }
 
-template<typename FloatType>
-void Scheduler<FloatType>::save_bov(std::string file_name)
+template<typename FloatType, typename AccumType>
+void Scheduler<FloatType, AccumType>::save_bov(std::string file_name, const int view)
 {
+  if(has_tiled_result())
+  {
+    if(view != m_composited_view)
+    {
+      throw RoverException("Error: view must be composited before it is saved");
+    }
+    m_tiled_result.save_bov(file_name);
+    return;
+  }
+  Image<AccumType> &result = get_view_result(view);
   int height = 0;
   int width = 0;
-  m_ray_generator->get_dims(height, width);
+  m_ray_generators[view]->get_dims(height, width);
   assert( height > 0 );
   assert( width > 0 );
   ROVER_INFO("Saving bov file " << height << " "<<width);
@@ -577,17 +789,17 @@ void Scheduler<FloatType>::save_bov(std::string file_name)
   const int size = height * width;
   if(m_render_settings.m_render_mode == energy)
   {
-    const int num_channels = m_result.get_num_channels();
+    const int num_channels = result.get_num_channels();
     ROVER_INFO("Saving bov"<<num_channels<<" channels ");
     for(int i = 0; i < num_channels; ++i)
     {
       std::stringstream sstream;
       sstream<<file_name<<"_"<<i<<".bov";
-      m_result.normalize_intensity(i);
-      FloatType * buffer
-        = get_vtkm_ptr(m_result.get_intensity(i));
+      result.normalize_intensity(i);
+      AccumType * buffer
+        = get_vtkm_ptr(result.get_intensity(i));
       std::fstream bov(sstream.str(), std::ios::out | std::ios::binary);
-      bov.write((char*)buffer, sizeof(FloatType) * size);
+      bov.write((char*)buffer, sizeof(AccumType) * size);
       bov.close();
     }
   }
@@ -598,4 +810,5 @@ void Scheduler<FloatType>::save_bov(std::string file_name)
 // Explicit instantiation
 template class Scheduler<vtkm::Float32>;
 template class Scheduler<vtkm::Float64>;
+template class Scheduler<vtkm::Float32, vtkm::Float64>;
 }; // namespace rover
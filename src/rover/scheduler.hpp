@@ -46,6 +46,7 @@
 #include <image.hpp>
 #include <engine.hpp>
 #include <scheduler_base.hpp>
+#include <tiled_image.hpp>
 #include <rover_types.hpp>
 #include <ray_generators/ray_generator.hpp>
 #include <vtkm_typedefs.hpp>
@@ -65,27 +66,62 @@
 //
 namespace rover {
 
-template<typename FloatType>
+//
+// Rays are traced in FloatType. Partials are converted to AccumType
+// before they are composited, so the composited images can be kept in
+// higher precision than the traversal. Samples within a domain are
+// accumulated by the tracer in FloatType.
+//
+template<typename FloatType, typename AccumType = FloatType>
 class Scheduler : public SchedulerBase
 {
 public:
   Scheduler();
   virtual ~Scheduler();
   void trace_rays() override;
-  void save_result(std::string file_name) override;
-  void save_bov(std::string file_name) override;
+  void save_result(std::string file_name, const int view) override;
+  void save_bov(std::string file_name, const int view) override;
+  void composite_view(const int view) override;
 
-  virtual void get_result(Image<vtkm::Float32> &image) override;
-  virtual void get_result(Image<vtkm::Float64> &image) override;
+  virtual void get_result(Image<vtkm::Float32> &image, const int view) override;
+  virtual void get_result(Image<vtkm::Float64> &image, const int view) override;
 protected:
   void composite();
-  void set_global_scalar_range();
-  void set_global_bounds();
-  int  get_global_channels();
-  Image<FloatType>                          m_result;
+  void set_global_state();
+  // traces the current view, adding the partials to m_partial_images
+  virtual void trace_view(const int width,
+                          const int height);
+  void trace_domains(const int width,
+                     const int height);
+  //
+  // Early ray termination for volume rendering, shared by the static
+  // and dynamic schedulers
+  //
+  bool early_termination() const;
+  // true once a ray that lets through this fraction of light can stop
+  bool is_opaque(const vtkm::Float64 transmittance) const;
+  void reset_opaque_depths();
+  void clip_to_opaque_depths(vtkmRayTracing::Ray<FloatType> &rays);
+  void update_opaque_depths(std::vector<vtkmRayTracing::PartialComposite<FloatType>> &partials);
+  Image<AccumType> &get_view_result(const int view);
+  // the composited image of m_composited_view
+  Image<AccumType>                          m_result;
+  // this rank's part of the composited image in tiled mode
+  TiledImage<AccumType>                     m_tiled_result;
+  int                                       m_composited_view;
   std::vector<PartialImage<FloatType>>      m_partial_images;
+  // the partials of each view, released once the view is composited
+  std::vector<std::vector<PartialImage<FloatType>>> m_view_partials;
+  // the number of channels of the composited image
+  int                                       m_num_channels;
+  // per pixel depth at which the current view became opaque
+  std::vector<FloatType>                    m_opaque_depths;
+  // per pixel product of one minus alpha of the partials traced so far
+  std::vector<vtkm::Float64>                m_transmittance;
 
-  void add_partial(vtkmRayTracing::PartialComposite<FloatType> &partial, int width, int height);
+  void add_partial(vtkmRayTracing::PartialComposite<FloatType> &partial,
+                   int width,
+                   int height);
 private:
 
 };
@@ -44,6 +44,9 @@
 namespace rover {
 
 SchedulerBase::SchedulerBase()
+  : m_ray_generator(NULL),
+    m_mesh_generation(-1),
+    m_ray_cache(std::make_shared<RayCache>())
 {
 }
 
@@ -66,6 +69,27 @@ void
 SchedulerBase::set_ray_generator(RayGenerator *ray_generator)
 {
   m_ray_generator = ray_generator;
+  m_ray_generators.assign(1, ray_generator);
+}
+
+void
+SchedulerBase::set_ray_generators(const std::vector<RayGenerator*> &ray_generators)
+{
+  m_ray_generators = ray_generators;
+  m_ray_generator = ray_generators.size() != 0 ? ray_generators[0] : NULL;
+}
+
+int
+SchedulerBase::get_num_views() const
+{
+  return static_cast<int>(m_ray_generators.size());
+}
+
+bool
+SchedulerBase::has_tiled_result() const
+{
+  return m_render_settings.m_render_mode == energy &&
+         m_render_settings.m_energy_settings.m_tiled_output;
 }
 
 void
@@ -102,12 +126,33 @@ SchedulerBase::get_domains()
 void
 SchedulerBase::add_data_set(vtkmDataSet &dataset)
 {
-  ROVER_INFO("Adding domain "<<m_domains.size());
+  add_data_set(dataset, static_cast<vtkm::Id>(m_domains.size()));
+}
+
+void
+SchedulerBase::add_data_set(vtkmDataSet &dataset, const vtkm::Id domain_id)
+{
+  ROVER_INFO("Adding domain "<<m_domains.size()<<" id "<<domain_id);
   Domain domain;
   domain.set_data_set(dataset);
+  domain.set_domain_id(domain_id);
   m_domains.push_back(domain);
 }
 
+void
+SchedulerBase::set_engine_cache(std::shared_ptr<EngineCache> engine_cache,
+                                const vtkm::Int64 mesh_generation)
+{
+  m_engine_cache = engine_cache;
+  m_mesh_generation = mesh_generation;
+}
+
+void
+SchedulerBase::set_ray_cache(std::shared_ptr<RayCache> ray_cache)
+{
+  m_ray_cache = ray_cache;
+}
+
 vtkmDataSet
 SchedulerBase::get_data_set(const int &domain)
 {
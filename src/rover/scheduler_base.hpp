@@ -45,6 +45,8 @@
 #include <domain.hpp>
 #include <image.hpp>
 #include <engine.hpp>
+#include <engine_cache.hpp>
+#include <ray_cache.hpp>
 #include <rover_types.hpp>
 #include <ray_generators/ray_generator.hpp>
 #include <vtkm_typedefs.hpp>
@@ -73,16 +75,26 @@ public:
   SchedulerBase();
   virtual ~SchedulerBase();
   virtual void trace_rays() = 0;
-  virtual void save_result(std::string file_name) = 0;
-  virtual void save_bov(std::string file_name) = 0;
+  virtual void save_result(std::string file_name, const int view) = 0;
+  virtual void save_bov(std::string file_name, const int view) = 0;
+  // collective, must be called by all ranks before a view's result is
+  // used. Releases the view's partials, so each view can only be
+  // composited until the next view is.
+  virtual void composite_view(const int view) = 0;
   void clear_data_sets();
   //
   // Setters
   //
   void set_render_settings(const RenderSettings render_settings);
   void add_data_set(vtkmDataSet &data_set);
+  void add_data_set(vtkmDataSet &data_set, const vtkm::Id domain_id);
+  void set_engine_cache(std::shared_ptr<EngineCache> engine_cache,
+                        const vtkm::Int64 mesh_generation);
+  void set_ray_cache(std::shared_ptr<RayCache> ray_cache);
   void set_domains(std::vector<Domain> &domains);
   void set_ray_generator(RayGenerator *ray_generator);
+  // trace one view per ray generator in a single pass
+  void set_ray_generators(const std::vector<RayGenerator*> &ray_generators);
   void set_background(const std::vector<vtkm::Float32> &background);
   void set_background(const std::vector<vtkm::Float64> &background);
 #ifdef ROVER_PARALLEL
@@ -94,13 +106,21 @@ public:
   std::vector<Domain> get_domains();
   RenderSettings get_render_settings() const;
   vtkmDataSet    get_data_set(const int &domain);
-  virtual void get_result(Image<vtkm::Float32> &image) = 0;
-  virtual void get_result(Image<vtkm::Float64> &image) = 0;
+  int            get_num_views() const;
+  // true when each rank keeps a tile of the composited image
+  bool           has_tiled_result() const;
+  virtual void get_result(Image<vtkm::Float32> &image, const int view) = 0;
+  virtual void get_result(Image<vtkm::Float64> &image, const int view) = 0;
 protected:
   std::vector<Domain>                       m_domains;
   RenderSettings                            m_render_settings;
+  // the generator of the view being traced
   RayGenerator                             *m_ray_generator;
+  std::vector<RayGenerator*>                m_ray_generators;
   std::vector<vtkm::Float64>                m_background;
+  std::shared_ptr<EngineCache>              m_engine_cache;
+  vtkm::Int64                               m_mesh_generation;
+  std::shared_ptr<RayCache>                 m_ray_cache;
   void create_default_background(const int num_channels);
 #ifdef ROVER_PARALLEL
   MPI_Comm                                  m_comm_handle;
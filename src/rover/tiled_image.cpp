@@ -0,0 +1,326 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <tiled_image.hpp>
+#include <rover_exceptions.hpp>
+#include <utils/png_encoder.hpp>
+#include <utils/rover_logging.hpp>
+
+namespace rover
+{
+
+namespace detail
+{
+
+#ifdef ROVER_PARALLEL
+template<typename T> MPI_Datatype tile_mpi_type();
+template<> MPI_Datatype tile_mpi_type<vtkm::Float32>() { return MPI_FLOAT; }
+template<> MPI_Datatype tile_mpi_type<vtkm::Float64>() { return MPI_DOUBLE; }
+#endif
+
+std::string
+bin_file_name(const std::string &file_name, const int bin, const std::string &ext)
+{
+  std::stringstream sstream;
+  sstream<<file_name<<"_"<<bin<<ext;
+  return sstream.str();
+}
+
+} // namespace detail
+
+template<typename FloatType>
+TiledImage<FloatType>::TiledImage()
+  : m_tile_begin(0),
+    m_tile_end(0),
+    m_width(0),
+    m_height(0)
+{
+#ifdef ROVER_PARALLEL
+  m_comm_handle = MPI_COMM_WORLD;
+#endif
+}
+
+template<typename FloatType>
+TiledImage<FloatType>::~TiledImage()
+{
+}
+
+#ifdef ROVER_PARALLEL
+template<typename FloatType>
+void
+TiledImage<FloatType>::set_comm_handle(MPI_Comm comm_handle)
+{
+  m_comm_handle = comm_handle;
+}
+#endif
+
+template<typename FloatType>
+void
+TiledImage<FloatType>::set_tile(BinPartials<FloatType> &partials,
+                                const vtkm::Id tile_begin,
+                                const vtkm::Id tile_end,
+                                const std::vector<double> &background,
+                                const int width,
+                                const int height)
+{
+  std::swap(m_partials, partials);
+  m_tile_begin = tile_begin;
+  m_tile_end = tile_end;
+  m_background = background;
+  m_width = width;
+  m_height = height;
+}
+
+template<typename FloatType>
+void
+TiledImage<FloatType>::clear()
+{
+  m_partials = BinPartials<FloatType>();
+  m_tile_begin = 0;
+  m_tile_end = 0;
+}
+
+//
+// Pixels no partial reached see the unattenuated background, so
+// the background is part of the range of a tile with gaps
+//
+template<typename FloatType>
+void
+TiledImage<FloatType>::bin_ranges(const vtkm::Id begin,
+                                  const vtkm::Id end,
+                                  std::vector<vtkmRange> &ranges)
+{
+  const int num_bins = m_partials.m_num_bins;
+  ranges.assign(num_bins, vtkmRange());
+
+  const vtkm::Id first = static_cast<vtkm::Id>(std::lower_bound(m_partials.m_pixel_ids.begin(),
+                                                                m_partials.m_pixel_ids.end(),
+                                                                begin) - m_partials.m_pixel_ids.begin());
+  const vtkm::Id last = static_cast<vtkm::Id>(std::lower_bound(m_partials.m_pixel_ids.begin(),
+                                                               m_partials.m_pixel_ids.end(),
+                                                               end) - m_partials.m_pixel_ids.begin());
+  const bool has_gaps = last - first < end - begin;
+
+  for(int b = 0; b < num_bins; ++b)
+  {
+    if(has_gaps)
+    {
+      ranges[b].Include(m_background[b]);
+    }
+    for(vtkm::Id i = first; i < last; ++i)
+    {
+      vtkm::Float64 intensity = m_partials.m_absorption[i * num_bins + b] * m_background[b];
+      if(m_partials.m_has_emission)
+      {
+        intensity += m_partials.m_emission[i * num_bins + b];
+      }
+      ranges[b].Include(intensity);
+    }
+  }
+
+#ifdef ROVER_PARALLEL
+  // one reduction for every bin: mins and negated maxs
+  std::vector<double> local_values(num_bins * 2);
+  std::vector<double> global_values(num_bins * 2);
+  for(int b = 0; b < num_bins; ++b)
+  {
+    local_values[b] = ranges[b].Min;
+    local_values[num_bins + b] = -ranges[b].Max;
+  }
+  MPI_Allreduce(local_values.data(),
+                global_values.data(),
+                num_bins * 2,
+                MPI_DOUBLE,
+                MPI_MIN,
+                m_comm_handle);
+  for(int b = 0; b < num_bins; ++b)
+  {
+    ranges[b].Min = global_values[b];
+    ranges[b].Max = -global_values[num_bins + b];
+  }
+#endif
+}
+
+template<typename FloatType>
+void
+TiledImage<FloatType>::expand_bin(const int bin,
+                                  const vtkm::Id begin,
+                                  const vtkm::Id end,
+                                  const vtkmRange &range,
+                                  std::vector<FloatType> &pixels) const
+{
+  const int num_bins = m_partials.m_num_bins;
+  const FloatType min_scalar = static_cast<FloatType>(range.Min);
+  const FloatType max_scalar = static_cast<FloatType>(range.Max);
+  const FloatType inv_delta =
+    min_scalar == max_scalar ? FloatType(1) : FloatType(1) / (max_scalar - min_scalar);
+
+  const FloatType background = static_cast<FloatType>(m_background[bin]);
+  pixels.assign(static_cast<size_t>(end - begin), (background - min_scalar) * inv_delta);
+
+  const vtkm::Id first = static_cast<vtkm::Id>(std::lower_bound(m_partials.m_pixel_ids.begin(),
+                                                                m_partials.m_pixel_ids.end(),
+                                                                begin) - m_partials.m_pixel_ids.begin());
+  const vtkm::Id last = static_cast<vtkm::Id>(std::lower_bound(m_partials.m_pixel_ids.begin(),
+                                                               m_partials.m_pixel_ids.end(),
+                                                               end) - m_partials.m_pixel_ids.begin());
+#ifdef ROVER_ENABLE_OPENMP
+  #pragma omp parallel for
+#endif
+  for(vtkm::Id i = first; i < last; ++i)
+  {
+    FloatType intensity = m_partials.m_absorption[i * num_bins + bin] * background;
+    if(m_partials.m_has_emission)
+    {
+      intensity += m_partials.m_emission[i * num_bins + bin];
+    }
+    pixels[m_partials.m_pixel_ids[i] - begin] = (intensity - min_scalar) * inv_delta;
+  }
+}
+
+template<typename FloatType>
+void
+TiledImage<FloatType>::save_bov(const std::string &file_name)
+{
+  const vtkm::Id begin = m_tile_begin;
+  const vtkm::Id end = m_tile_end;
+
+  std::vector<vtkmRange> ranges;
+  bin_ranges(begin, end, ranges);
+
+  std::vector<FloatType> pixels;
+  const int num_bins = m_partials.m_num_bins;
+  for(int b = 0; b < num_bins; ++b)
+  {
+    const std::string bin_name = detail::bin_file_name(file_name, b, ".bov");
+    expand_bin(b, begin, end, ranges[b], pixels);
+#ifdef ROVER_PARALLEL
+    MPI_File file;
+    int err = MPI_File_open(m_comm_handle,
+                            const_cast<char*>(bin_name.c_str()),
+                            MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                            MPI_INFO_NULL,
+                            &file);
+    if(err != MPI_SUCCESS)
+    {
+      throw RoverException("Error: unable to open tiled bov file " + bin_name);
+    }
+    const MPI_Offset file_size =
+      static_cast<MPI_Offset>(m_width) * m_height * sizeof(FloatType);
+    MPI_File_set_size(file, file_size);
+    const MPI_Offset offset =
+      static_cast<MPI_Offset>(begin) * sizeof(FloatType);
+    MPI_File_write_at_all(file,
+                          offset,
+                          pixels.data(),
+                          static_cast<int>(pixels.size()),
+                          detail::tile_mpi_type<FloatType>(),
+                          MPI_STATUS_IGNORE);
+    MPI_File_close(&file);
+#else
+    std::fstream bov(bin_name, std::ios::out | std::ios::binary);
+    bov.write((char*)pixels.data(), sizeof(FloatType) * pixels.size());
+    bov.close();
+#endif
+  }
+}
+
+template<typename FloatType>
+void
+TiledImage<FloatType>::save_png(const std::string &file_name)
+{
+  const vtkm::Id begin = m_tile_begin;
+  const vtkm::Id end = m_tile_end;
+
+  std::vector<vtkmRange> ranges;
+  bin_ranges(begin, end, ranges);
+
+  int rank = 0;
+#ifdef ROVER_PARALLEL
+  int num_ranks = 1;
+  MPI_Comm_rank(m_comm_handle, &rank);
+  MPI_Comm_size(m_comm_handle, &num_ranks);
+
+  // where each rank's part of the image goes on rank 0
+  int count = static_cast<int>(end - begin);
+  int offset = static_cast<int>(begin);
+  std::vector<int> counts(num_ranks, 0);
+  std::vector<int> offsets(num_ranks, 0);
+  MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, m_comm_handle);
+  MPI_Gather(&offset, 1, MPI_INT, offsets.data(), 1, MPI_INT, 0, m_comm_handle);
+#endif
+
+  std::vector<FloatType> pixels;
+  std::vector<FloatType> image;
+  if(rank == 0)
+  {
+    image.resize(static_cast<size_t>(m_width) * m_height);
+  }
+
+  PNGEncoder encoder;
+  const int num_bins = m_partials.m_num_bins;
+  for(int b = 0; b < num_bins; ++b)
+  {
+    expand_bin(b, begin, end, ranges[b], pixels);
+#ifdef ROVER_PARALLEL
+    MPI_Gatherv(pixels.data(), count, detail::tile_mpi_type<FloatType>(),
+                image.data(), counts.data(), offsets.data(),
+                detail::tile_mpi_type<FloatType>(), 0, m_comm_handle);
+#else
+    std::swap(image, pixels);
+#endif
+    if(rank == 0)
+    {
+      encoder.EncodeChannel(image.data(), m_width, m_height);
+      encoder.Save(detail::bin_file_name(file_name, b, ".png"));
+    }
+  }
+}
+
+//
+// Explicit instantiation
+template class TiledImage<vtkm::Float32>;
+template class TiledImage<vtkm::Float64>;
+
+} // namespace rover
@@ -0,0 +1,112 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2018, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-749865
+//
+// All rights reserved.
+//
+// This file is part of Rover.
+//
+// Please also read rover/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+#ifndef rover_tiled_image_h
+#define rover_tiled_image_h
+
+#include <string>
+#include <vector>
+
+#include <bin_partials.hpp>
+#include <vtkm_typedefs.hpp>
+
+#ifdef ROVER_PARALLEL
+#include <mpi.h>
+#endif
+
+namespace rover
+{
+//
+// A composited energy image that stays distributed: each rank holds the
+// partials of a contiguous range of pixels (its tile).
+//
+// Images are written one bin at a time, so no rank ever expands more
+// than one bin. Every rank writes its own part of each raw (bov) file.
+// PNGs need the whole image, so each bin is gathered on rank 0 right
+// before it is encoded.
+//
+// All ranks must call the save methods.
+//
+template<typename FloatType>
+class TiledImage
+{
+public:
+  TiledImage();
+  ~TiledImage();
+#ifdef ROVER_PARALLEL
+  void set_comm_handle(MPI_Comm comm_handle);
+#endif
+  //
+  // Takes ownership of the composited partials of [tile_begin, tile_end)
+  //
+  void set_tile(BinPartials<FloatType> &partials,
+                const vtkm::Id tile_begin,
+                const vtkm::Id tile_end,
+                const std::vector<double> &background,
+                const int width,
+                const int height);
+  void clear();
+  // normalized intensities, one file per bin
+  void save_png(const std::string &file_name);
+  void save_bov(const std::string &file_name);
+protected:
+  // the intensity range of each bin over the whole image
+  void bin_ranges(const vtkm::Id begin,
+                  const vtkm::Id end,
+                  std::vector<vtkmRange> &ranges);
+  // normalized intensities of one bin over [begin, end)
+  void expand_bin(const int bin,
+                  const vtkm::Id begin,
+                  const vtkm::Id end,
+                  const vtkmRange &range,
+                  std::vector<FloatType> &pixels) const;
+
+  BinPartials<FloatType> m_partials;
+  std::vector<double>    m_background;
+  vtkm::Id               m_tile_begin;
+  vtkm::Id               m_tile_end;
+  int                    m_width;
+  int                    m_height;
+#ifdef ROVER_PARALLEL
+  MPI_Comm               m_comm_handle;
+#endif
+};
+
+} // namespace rover
+#endif
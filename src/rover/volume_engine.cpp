@@ -48,6 +48,9 @@ VolumeEngine::VolumeEngine()
 {
   m_tracer = NULL;
   m_num_samples = 400;
+  m_macrocell_dims = 0;
+  m_field_generation = 0;
+  m_macrocell_generation = -1;
 }
 
 VolumeEngine::~VolumeEngine()
@@ -60,6 +63,8 @@ VolumeEngine::set_data_set(vtkm::cont::DataSet &dataset)
 {
   if(m_tracer) delete m_tracer;
   m_tracer = new vtkm::rendering::ConnectivityProxy(dataset);
+  m_data_set = dataset;
+  m_field_generation++;
 }
 
 int VolumeEngine::get_num_channels()
@@ -74,6 +79,55 @@ VolumeEngine::set_primary_field(const std::string &primary_field)
   m_tracer->SetScalarField(m_primary_field);
 }
 
+void
+VolumeEngine::fields_updated()
+{
+  m_field_generation++;
+}
+
+void
+VolumeEngine::set_macrocell_dims(const int dims)
+{
+  if(dims != m_macrocell_dims)
+  {
+    m_macrocell_generation = -1;
+  }
+  m_macrocell_dims = dims;
+}
+
+//
+// The macrocell min/max values are only rebuilt when the field or its
+// values change. Which macrocells are empty depends on the transfer
+// function and the scalar range, and the grid redoes that part when
+// either of them changes.
+//
+template<typename Precision>
+void
+VolumeEngine::skip_empty_space(vtkmRayTracing::Ray<Precision> &rays,
+                               const vtkmColorMap &color_map)
+{
+  if(m_macrocell_dims < 1)
+  {
+    return;
+  }
+
+  vtkmTimer timer;
+  // a failed build is not retried until the field changes
+  if(m_macrocell_field != m_primary_field ||
+     m_macrocell_generation != m_field_generation)
+  {
+    m_macrocells.build(m_data_set, m_primary_field, m_macrocell_dims);
+    m_macrocell_field = m_primary_field;
+    m_macrocell_generation = m_field_generation;
+    ROVER_DATA_ADD("macrocell_build", timer.GetElapsedTime());
+    timer.Reset();
+  }
+
+  m_macrocells.set_opacity(color_map, m_scalar_range);
+  m_macrocells.skip_empty_space(rays);
+  ROVER_DATA_ADD("macrocell_skip", timer.GetElapsedTime());
+}
+
 void
 VolumeEngine::init_rays(Ray32 &rays)
 {
@@ -115,6 +169,11 @@ VolumeEngine::partial_trace(Ray32 &rays)
   rays.Buffers.at(0).InitConst(0.);
   vtkmColorMap corrected = correct_opacity();
   m_tracer->SetColorMap(corrected);
+  skip_empty_space(rays, corrected);
+  if(rays.NumRays == 0)
+  {
+    return PartialVector32();
+  }
   return m_tracer->PartialTrace(rays);
 }
 
@@ -139,6 +198,11 @@ VolumeEngine::partial_trace(Ray64 &rays)
   rays.Buffers.at(0).InitConst(0.);
   vtkmColorMap corrected = correct_opacity();
   m_tracer->SetColorMap(corrected);
+  skip_empty_space(rays, corrected);
+  if(rays.NumRays == 0)
+  {
+    return PartialVector64();
+  }
   return m_tracer->PartialTrace(rays);
 }
 
@@ -184,6 +248,7 @@ VolumeEngine::set_composite_background(bool on)
 void
 VolumeEngine::set_primary_range(const vtkmRange &range)
 {
+  m_scalar_range = range;
   return m_tracer->SetScalarRange(range);
 }
 
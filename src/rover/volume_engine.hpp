@@ -43,6 +43,7 @@
 #define rover_volume_engine_h
 
 #include <engine.hpp>
+#include <macrocell_grid.hpp>
 #include <vtkm/rendering/ConnectivityProxy.h>
 namespace rover {
 
@@ -51,6 +52,18 @@ class VolumeEngine : public Engine
 protected:
   vtkm::rendering::ConnectivityProxy *m_tracer;
   int m_num_samples;
+  vtkmDataSet m_data_set;
+  vtkmRange m_scalar_range;
+  int m_macrocell_dims;
+  MacrocellGrid m_macrocells;
+  // the field the macrocells were built from and a counter bumped
+  // whenever the traced field values change
+  std::string m_macrocell_field;
+  vtkm::Id m_field_generation;
+  vtkm::Id m_macrocell_generation;
+  template<typename Precision>
+  void skip_empty_space(vtkmRayTracing::Ray<Precision> &rays,
+                        const vtkmColorMap &color_map);
 public:
   VolumeEngine();
   ~VolumeEngine();
@@ -63,10 +76,13 @@ public:
   void init_rays(Ray64 &rays) override;
   void set_primary_range(const vtkmRange &range) override;
   void set_primary_field(const std::string &primary_field) override;
+  void fields_updated() override;
   void set_composite_background(bool on) override;
   void set_samples(const vtkm::Bounds &global_bounds, const int &samples) override;
   vtkmRange get_primary_range() override;
   int get_num_channels() override;
+  // macrocells per axis used to skip empty space (0 disables skipping)
+  void set_macrocell_dims(const int dims);
 };
 
 }; // namespace rover
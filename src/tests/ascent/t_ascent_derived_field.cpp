@@ -0,0 +1,239 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+//-----------------------------------------------------------------------------
+///
+/// file: t_ascent_derived_field.cpp
+///
+//-----------------------------------------------------------------------------
+
+
+#include "gtest/gtest.h"
+
+#include <ascent.hpp>
+#include <ascent_hola.hpp>
+
+#include <iostream>
+#include <math.h>
+
+#include <conduit_blueprint.hpp>
+
+#include "t_config.hpp"
+#include "t_utils.hpp"
+
+
+
+
+using namespace std;
+using namespace conduit;
+using namespace ascent;
+
+
+index_t EXAMPLE_MESH_SIDE_DIM = 10;
+
+//-----------------------------------------------------------------------------
+TEST(ascent_derived_field, test_derived_field)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh with an integer element field.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    const int cycle = 100;
+    data["state/cycle"] = cycle;
+
+    const index_t num_elements = (EXAMPLE_MESH_SIDE_DIM - 1) *
+                                 (EXAMPLE_MESH_SIDE_DIM - 1) *
+                                 (EXAMPLE_MESH_SIDE_DIM - 1);
+    data["fields/ids/association"] = "element";
+    data["fields/ids/topology"] = "mesh";
+    data["fields/ids/values"].set(DataType::int32(num_elements));
+    int32_array ids = data["fields/ids/values"].value();
+    for(index_t i = 0; i < num_elements; ++i)
+    {
+        ids[i] = static_cast<int32>(i);
+    }
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing derived field");
+
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_derived_field");
+    string relay_file = conduit::utils::join_file_path(output_path,
+                                                       "tout_derived_field_relay");
+
+    // remove old images before rendering
+    remove_test_image(output_file);
+
+
+    //
+    // Create the actions.
+    //
+
+    conduit::Node pipelines;
+    // pipeline 1
+    pipelines["pl1/f1/type"] = "derived_field";
+    conduit::Node &params = pipelines["pl1/f1/params"];
+    params["expression"] = "\"braid\" * 2 + 1";
+    params["output_name"] = "braid_scaled";
+    // integer fields are converted as they are read
+    pipelines["pl1/f2/type"] = "derived_field";
+    pipelines["pl1/f2/params/expression"] = "\"ids\" + 0.5";
+    pipelines["pl1/f2/params/output_name"] = "ids_half";
+
+    conduit::Node extracts;
+    extracts["e1/type"] = "relay";
+    extracts["e1/pipeline"] = "pl1";
+    extracts["e1/params/path"] = relay_file;
+    extracts["e1/params/protocol"] = "blueprint/mesh/hdf5";
+
+    conduit::Node scenes;
+    scenes["s1/plots/p1/type"]         = "pseudocolor";
+    scenes["s1/plots/p1/field"] = "braid_scaled";
+    scenes["s1/plots/p1/pipeline"] = "pl1";
+
+    scenes["s1/image_prefix"] = output_file;
+
+    conduit::Node actions;
+    // add the pipeline
+    conduit::Node &add_pipelines = actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    add_pipelines["pipelines"] = pipelines;
+    // add the extracts
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+    // add the scenes
+    conduit::Node &add_scenes= actions.append();
+    add_scenes["action"] = "add_scenes";
+    add_scenes["scenes"] = scenes;
+    // execute
+    conduit::Node &execute  = actions.append();
+    execute["action"] = "execute";
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    // check that we created an image
+    EXPECT_TRUE(conduit::utils::is_file(output_file + "100.png"));
+
+    //
+    // Read the pipeline result back and check the new fields
+    //
+    char cyc_fmt_buff[64];
+    snprintf(cyc_fmt_buff, sizeof(cyc_fmt_buff), "%06d",cycle);
+    ostringstream oss;
+    oss << relay_file << ".cycle_" << cyc_fmt_buff << ".root";
+
+    Node hola_data, hola_opts;
+    hola_opts["root_file"] = oss.str();
+    ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+    ASSERT_EQ(hola_data.number_of_children(), 1);
+    const Node &res = hola_data.child(0);
+
+    ASSERT_TRUE(res.has_path("fields/braid_scaled"));
+    EXPECT_EQ(res["fields/braid_scaled/association"].as_string(), "vertex");
+    Node braid_scaled;
+    res["fields/braid_scaled/values"].to_float64_array(braid_scaled);
+    float64_array braid = data["fields/braid/values"].value();
+    float64_array scaled = braid_scaled.value();
+    ASSERT_EQ(scaled.number_of_elements(), braid.number_of_elements());
+    for(index_t i = 0; i < braid.number_of_elements(); ++i)
+    {
+        EXPECT_NEAR(scaled[i], braid[i] * 2. + 1., 1e-12);
+    }
+
+    ASSERT_TRUE(res.has_path("fields/ids_half"));
+    EXPECT_EQ(res["fields/ids_half/association"].as_string(), "element");
+    Node ids_half;
+    res["fields/ids_half/values"].to_float64_array(ids_half);
+    float64_array half = ids_half.value();
+    ASSERT_EQ(half.number_of_elements(), num_elements);
+    for(index_t i = 0; i < num_elements; ++i)
+    {
+        EXPECT_NEAR(half[i], static_cast<double>(i) + 0.5, 1e-12);
+    }
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int result = 0;
+
+    ::testing::InitGoogleTest(&argc, argv);
+
+    // allow override of the data size via the command line
+    if(argc == 2)
+    {
+        EXAMPLE_MESH_SIDE_DIM = atoi(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+    return result;
+}
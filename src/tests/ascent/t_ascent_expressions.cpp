@@ -52,7 +52,11 @@
 #include "gtest/gtest.h"
 
 #include <ascent_expression_eval.hpp>
+#include <expressions/ascent_blueprint_architect.hpp>
+#include <expressions/ascent_conduit_reductions.hpp>
 
+#include <algorithm>
+#include <vector>
 #include <iostream>
 #include <math.h>
 
@@ -200,6 +204,310 @@ TEST(ascent_expressions, basic_expressions)
     EXPECT_EQ(res["type"].as_string(), "boolean");
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, fused_field_stats)
+{
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    // ascent normally adds this but we are doing an end around
+    data["state/domain_id"] = 0;
+    Node multi_dom;
+    blueprint::mesh::to_multi_domain(data, multi_dom);
+
+    // reference values
+    float64_array vals = data["fields/braid/values"].value();
+    const index_t num_vals = vals.number_of_elements();
+    double ref_min = vals[0];
+    double ref_max = vals[0];
+    double ref_sum = 0.;
+    for(index_t i = 0; i < num_vals; ++i)
+    {
+      ref_min = std::min(ref_min, vals[i]);
+      ref_max = std::max(ref_max, vals[i]);
+      ref_sum += vals[i];
+    }
+
+    runtime::expressions::register_builtin();
+    runtime::expressions::ExpressionEval eval(&multi_dom);
+
+    conduit::Node res;
+
+    // all of these share the stats of "braid"
+    res = eval.evaluate("max(\"braid\")");
+    EXPECT_NEAR(res["value"].to_float64(), ref_max, 1e-12);
+    res = eval.evaluate("min(\"braid\")");
+    EXPECT_NEAR(res["value"].to_float64(), ref_min, 1e-12);
+    res = eval.evaluate("avg(\"braid\")");
+    EXPECT_NEAR(res["value"].to_float64(), ref_sum / num_vals, 1e-12);
+
+    conduit::Node stats = runtime::expressions::field_stats(multi_dom, "braid");
+    EXPECT_EQ(stats["count"].to_int64(), num_vals);
+    EXPECT_NEAR(stats["min/value"].to_float64(), ref_min, 1e-12);
+    EXPECT_NEAR(stats["max/value"].to_float64(), ref_max, 1e-12);
+    EXPECT_NEAR(stats["sum"].to_float64(), ref_sum, 1e-9);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, compiled_expression_reuse)
+{
+    Node data;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    data["state/domain_id"] = 0;
+    Node multi_dom;
+    blueprint::mesh::to_multi_domain(data, multi_dom);
+
+    runtime::expressions::register_builtin();
+
+    conduit::Node res;
+    double first_max = 0.;
+    {
+      runtime::expressions::ExpressionEval eval(&multi_dom);
+      res = eval.evaluate("cycle() + 1");
+      EXPECT_EQ(res["value"].to_int32(), 101);
+      res = eval.evaluate("max(\"braid\")", "braid_max");
+      first_max = res["value"].to_float64();
+      res = eval.evaluate("braid_max * 2");
+      EXPECT_EQ(res["value"].to_float64(), first_max * 2.);
+    }
+
+    // the same expressions against the next cycle re-use the compiled
+    // programs but must see the new data
+    multi_dom.child(0)["state/cycle"] = 101;
+    float64_array vals = multi_dom.child(0)["fields/braid/values"].value();
+    for(index_t i = 0; i < vals.number_of_elements(); ++i)
+    {
+      vals[i] *= 2.;
+    }
+
+    {
+      runtime::expressions::ExpressionEval eval(&multi_dom);
+      res = eval.evaluate("cycle() + 1");
+      EXPECT_EQ(res["value"].to_int32(), 102);
+      res = eval.evaluate("max(\"braid\")", "braid_max");
+      EXPECT_NEAR(res["value"].to_float64(), first_max * 2., 1e-12);
+      EXPECT_TRUE(res.has_path("atts/position"));
+      res = eval.evaluate("braid_max * 2");
+      EXPECT_NEAR(res["value"].to_float64(), first_max * 4., 1e-12);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, compiled_matches_graph)
+{
+    Node data;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    data["state/domain_id"] = 0;
+    Node multi_dom;
+    blueprint::mesh::to_multi_domain(data, multi_dom);
+
+    runtime::expressions::register_builtin();
+    runtime::expressions::ExpressionEval eval(&multi_dom);
+
+    // every builtin and binary operator
+    std::vector<std::string> exprs;
+    exprs.push_back("cycle()");
+    exprs.push_back("min(\"braid\")");
+    exprs.push_back("max(\"braid\")");
+    exprs.push_back("avg(\"braid\")");
+    exprs.push_back("min(1, 2.5)");
+    exprs.push_back("max(3, 2)");
+    exprs.push_back("position(max(\"braid\"))");
+    exprs.push_back("vector(1, 2.5, 3)");
+    exprs.push_back("magnitude(vector(3, 4, 0))");
+    exprs.push_back("histogram(\"braid\")");
+    exprs.push_back("histogram(\"braid\", 10, 0, 1)");
+    exprs.push_back("(2.0 + 1) / 0.5 - 3 * 2");
+    exprs.push_back("7 / 2");
+    exprs.push_back("vector(1, 2, 3) + vector(1, 1, 1)");
+    exprs.push_back("vector(1, 2, 3) - vector(1, 1, 1)");
+    exprs.push_back("cycle() < 101");
+    exprs.push_back("cycle() <= 99");
+    exprs.push_back("2.5 > 1");
+    exprs.push_back("1 >= 1");
+    exprs.push_back("max(\"braid\") == max(\"braid\")");
+    exprs.push_back("cycle() != 100");
+
+    for(size_t i = 0; i < exprs.size(); ++i)
+    {
+      const conduit::Node compiled = eval.evaluate(exprs[i]);
+      const conduit::Node graph = eval.evaluate_graph(exprs[i]);
+
+      const std::string type = compiled["type"].as_string();
+      EXPECT_EQ(type, graph["type"].as_string()) << exprs[i];
+
+      conduit::Node c_vals, g_vals;
+      compiled["value"].to_float64_array(c_vals);
+      graph["value"].to_float64_array(g_vals);
+      const index_t num_vals = c_vals.dtype().number_of_elements();
+      ASSERT_EQ(num_vals, g_vals.dtype().number_of_elements()) << exprs[i];
+      const float64 *c_ptr = c_vals.as_float64_ptr();
+      const float64 *g_ptr = g_vals.as_float64_ptr();
+      for(index_t v = 0; v < num_vals; ++v)
+      {
+        EXPECT_EQ(c_ptr[v], g_ptr[v]) << exprs[i];
+      }
+
+      if(type == "histogram")
+      {
+        EXPECT_EQ(compiled["min_val"].to_float64(),
+                  graph["min_val"].to_float64()) << exprs[i];
+        EXPECT_EQ(compiled["max_val"].to_float64(),
+                  graph["max_val"].to_float64()) << exprs[i];
+      }
+      EXPECT_EQ(compiled.has_path("atts/position"),
+                graph.has_path("atts/position")) << exprs[i];
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, reduction_dtypes)
+{
+    // small integer types are reduced natively
+    Node n_uint8;
+    n_uint8.set(DataType::uint8(1000));
+    uint8 *u8_ptr = n_uint8.value();
+    for(int i = 0; i < 1000; ++i)
+    {
+      u8_ptr[i] = 255;
+    }
+    u8_ptr[500] = 1;
+
+    conduit::Node res;
+    res = runtime::expressions::array_sum(n_uint8);
+    // would wrap if accumulated in the array type
+    EXPECT_EQ(res["value"].to_float64(), 999. * 255. + 1.);
+    EXPECT_EQ(res["count"].to_int64(), 1000);
+
+    res = runtime::expressions::array_min(n_uint8);
+    EXPECT_EQ(res["value"].to_float64(), 1.);
+    EXPECT_EQ(res["index"].to_int64(), 500);
+
+    Node n_int16;
+    n_int16.set(DataType::int16(4));
+    int16 *i16_ptr = n_int16.value();
+    i16_ptr[0] = -3; i16_ptr[1] = -7; i16_ptr[2] = -1; i16_ptr[3] = -5;
+    // all negative values must not report a max of zero
+    res = runtime::expressions::array_max(n_int16);
+    EXPECT_EQ(res["value"].to_float64(), -1.);
+    EXPECT_EQ(res["index"].to_int64(), 2);
+
+    // compensated summation keeps small values that a naive
+    // running sum would drop
+    const index_t num_vals = 1000001;
+    Node n_f64;
+    n_f64.set(DataType::float64(num_vals));
+    float64 *f64_ptr = n_f64.value();
+    f64_ptr[0] = 1.0e16;
+    for(index_t i = 1; i < num_vals; ++i)
+    {
+      f64_ptr[i] = 1.;
+    }
+    res = runtime::expressions::array_sum(n_f64);
+    EXPECT_EQ(res["value"].to_float64(), 1.0e16 + 1.0e6);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, histogram_log_and_explicit_bins)
+{
+    Node values;
+    values.set(DataType::float64(6));
+    float64 *vals = values.value();
+    vals[0] = 0.5;
+    vals[1] = 1.5;
+    vals[2] = 15.;
+    vals[3] = 150.;
+    vals[4] = 1500.;
+    vals[5] = -1.;
+
+    // decades: [1,10) [10,100) [100,1000], out of range values are clamped
+    Node res = runtime::expressions::array_log_histogram(values, 1., 1000., 3);
+    int64_array log_bins = res["value"].value();
+    EXPECT_EQ(log_bins[0], 3);
+    EXPECT_EQ(log_bins[1], 1);
+    EXPECT_EQ(log_bins[2], 2);
+
+    Node edges;
+    edges.set(DataType::float64(3));
+    float64 *edges_ptr = edges.value();
+    edges_ptr[0] = 0.;
+    edges_ptr[1] = 1.;
+    edges_ptr[2] = 100.;
+
+    res = runtime::expressions::array_histogram(values, edges);
+    int64_array edge_bins = res["value"].value();
+    EXPECT_EQ(edge_bins.number_of_elements(), 2);
+    EXPECT_EQ(edge_bins[0], 2);
+    EXPECT_EQ(edge_bins[1], 4);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, derived_field_program)
+{
+    Node data;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    data["state/domain_id"] = 0;
+    Node multi_dom;
+    blueprint::mesh::to_multi_domain(data, multi_dom);
+
+    runtime::expressions::register_builtin();
+    runtime::expressions::ExpressionEval eval(&multi_dom);
+    conduit::Node res = eval.evaluate("max(\"braid\")", "braid_max");
+    const double braid_max = res["value"].to_float64();
+
+    runtime::expressions::DerivedFieldProgram program =
+      runtime::expressions::ExpressionEval::derived_field(
+        "sqrt(\"braid\" * \"braid\") / braid_max + 1");
+
+    ASSERT_EQ(program.field_names().size(), (size_t)1);
+    EXPECT_EQ(program.field_names()[0], "braid");
+
+    const Node &braid = multi_dom.child(0)["fields/braid/values"];
+    const index_t size = braid.dtype().number_of_elements();
+
+    // more values than fit in one block
+    EXPECT_GT(size, runtime::expressions::DerivedFieldProgram::BLOCK_SIZE);
+
+    std::vector<const Node*> inputs;
+    inputs.push_back(&braid);
+    std::vector<double> output(size);
+    program.execute(inputs, size, &output[0]);
+
+    float64_array vals = braid.value();
+    for(index_t i = 0; i < size; ++i)
+    {
+      EXPECT_NEAR(output[i], fabs(vals[i]) / braid_max + 1., 1e-12);
+    }
+
+    // non float64 inputs are converted as they are read
+    Node braid_f32;
+    braid.to_float32_array(braid_f32);
+    inputs[0] = &braid_f32;
+    program.execute(inputs, size, &output[0]);
+    for(index_t i = 0; i < size; ++i)
+    {
+      EXPECT_NEAR(output[i], fabs(vals[i]) / braid_max + 1., 1e-5);
+    }
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_expressions, expressions_optional_params)
 {
@@ -0,0 +1,190 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_ascent_histogram_benchmark.cpp
+///
+//-----------------------------------------------------------------------------
+
+
+#include "gtest/gtest.h"
+
+#include <ascent.hpp>
+#include <expressions/ascent_conduit_reductions.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <math.h>
+
+// thread counts can only be varied if this test is built with openmp
+#if defined(ASCENT_USE_OPENMP) && defined(_OPENMP)
+#define T_HISTOGRAM_USE_OPENMP
+#include <omp.h>
+#endif
+
+#include "t_config.hpp"
+#include "t_utils.hpp"
+
+
+using namespace std;
+using namespace conduit;
+using namespace ascent;
+
+// a smoke size by default, so ctest stays fast. pass the number of
+// values on the command line to benchmark (e.g. 4194304)
+index_t NUM_VALUES = 1 << 16;
+int     NUM_BINS   = 16;
+
+//-----------------------------------------------------------------------------
+// the previous histogram path: one shared set of bins updated atomically
+//-----------------------------------------------------------------------------
+void
+atomic_histogram(const double *values,
+                 const index_t size,
+                 const double min_val,
+                 const double max_val,
+                 const int num_bins,
+                 int *bins)
+{
+    const double inv_delta = double(num_bins) / (max_val - min_val);
+    memset(bins, 0, sizeof(int) * num_bins);
+#ifdef T_HISTOGRAM_USE_OPENMP
+    #pragma omp parallel for
+#endif
+    for(index_t v = 0; v < size; ++v)
+    {
+      int bin_index = static_cast<int>((values[v] - min_val) * inv_delta);
+      bin_index = std::max(0, std::min(bin_index, num_bins - 1));
+#ifdef T_HISTOGRAM_USE_OPENMP
+      #pragma omp atomic
+#endif
+      bins[bin_index]++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+double
+elapsed_since(const std::chrono::high_resolution_clock::time_point &start)
+{
+    std::chrono::duration<double> elapsed =
+      std::chrono::high_resolution_clock::now() - start;
+    return elapsed.count();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_histogram_benchmark, private_bins_vs_atomic)
+{
+    Node values;
+    values.set(DataType::float64(NUM_VALUES));
+    float64 *vals = values.value();
+    for(index_t i = 0; i < NUM_VALUES; ++i)
+    {
+      vals[i] = sin(double(i) * 0.001);
+    }
+
+    std::vector<int> thread_counts;
+#ifdef T_HISTOGRAM_USE_OPENMP
+    const int max_threads = omp_get_max_threads();
+    for(int t = 1; t < max_threads; t *= 2)
+    {
+      thread_counts.push_back(t);
+    }
+    thread_counts.push_back(max_threads);
+#else
+    thread_counts.push_back(1);
+#endif
+
+    std::vector<int> ref_bins(NUM_BINS);
+
+    for(size_t t = 0; t < thread_counts.size(); ++t)
+    {
+#ifdef T_HISTOGRAM_USE_OPENMP
+      omp_set_num_threads(thread_counts[t]);
+#endif
+      std::chrono::high_resolution_clock::time_point start;
+
+      start = std::chrono::high_resolution_clock::now();
+      atomic_histogram(vals, NUM_VALUES, -1., 1., NUM_BINS, &ref_bins[0]);
+      const double atomic_time = elapsed_since(start);
+
+      start = std::chrono::high_resolution_clock::now();
+      Node res = runtime::expressions::array_histogram(values, -1., 1., NUM_BINS);
+      const double private_time = elapsed_since(start);
+
+      std::cout << "threads " << thread_counts[t]
+                << " atomic " << atomic_time
+                << " private " << private_time << std::endl;
+
+      int64_array bins = res["value"].value();
+      ASSERT_EQ(bins.number_of_elements(), NUM_BINS);
+      for(int b = 0; b < NUM_BINS; ++b)
+      {
+        EXPECT_EQ(bins[b], ref_bins[b]);
+      }
+    }
+
+#ifdef T_HISTOGRAM_USE_OPENMP
+    omp_set_num_threads(max_threads);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int result = 0;
+
+    ::testing::InitGoogleTest(&argc, argv);
+
+    // allow override of the number of values via the command line
+    if(argc == 2)
+    {
+        NUM_VALUES = atoi(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+    return result;
+}
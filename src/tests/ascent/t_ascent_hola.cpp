@@ -56,6 +56,8 @@
 #include "t_config.hpp"
 #include "t_utils.hpp"
 
+#include <thread>
+
 using namespace std;
 using namespace conduit;
 using ascent::Ascent;
@@ -161,3 +163,325 @@ TEST(ascent_hola, test_hola_relay_blueprint_mesh)
 
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_hola, test_hola_relay_async)
+{
+    //
+    // Create example data
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              10,
+                                              10,
+                                              10,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+    int cycle = 102;
+    data["state/cycle"] = cycle;
+
+    // the root file pattern is relative to the working directory
+    string output_file = "tout_hola_relay_async";
+    //
+    // Create the actions to export the dataset in the background
+    //
+
+    conduit::Node actions;
+    // add the extracts
+    conduit::Node &add_extract = actions.append();
+    add_extract["action"] = "add_extracts";
+    add_extract["extracts/e1/type"]  = "relay";
+    add_extract["extracts/e1/params/path"] = output_file;
+    add_extract["extracts/e1/params/protocol"] = "blueprint/mesh/hdf5";
+    add_extract["extracts/e1/params/async"] = "true";
+    add_extract["extracts/e1/params/max_in_flight"] = 1;
+
+    actions.append()["action"] = "execute";
+
+    // wait for the files
+    conduit::Node flush_actions;
+    flush_actions.append()["action"] = "flush";
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    // the extract wrote a snapshot, so the simulation can change its
+    // data while the files are still being written
+    Node orig_vals;
+    orig_vals.set(data["fields/braid/values"]);
+    float64_array sim_vals = data["fields/braid/values"].value();
+    for(index_t i = 0; i < sim_vals.number_of_elements(); ++i)
+    {
+        sim_vals[i] = -1.0;
+    }
+
+    ascent.execute(flush_actions);
+
+    char cyc_fmt_buff[64];
+    snprintf(cyc_fmt_buff, sizeof(cyc_fmt_buff), "%06d",cycle);
+
+    ostringstream oss;
+    oss << output_file << ".cycle_" << cyc_fmt_buff << ".root";
+    std::string output_root = oss.str();
+
+    // the flush action finished the files before close
+    EXPECT_TRUE(conduit::utils::is_file(output_root));
+    ascent.close();
+
+    Node hola_data, hola_opts;
+    hola_opts["root_file"] = output_root;
+    ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+
+    EXPECT_EQ(hola_data.number_of_children(), 1);
+    EXPECT_TRUE(hola_data.child(0).has_path("fields/braid"));
+
+    float64_array snap_vals = orig_vals.value();
+    float64_array hola_vals = hola_data.child(0)["fields/braid/values"].value();
+    EXPECT_EQ(snap_vals.number_of_elements(), hola_vals.number_of_elements());
+    for(index_t i = 0; i < snap_vals.number_of_elements(); ++i)
+    {
+        EXPECT_EQ(snap_vals[i], hola_vals[i]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_hola, test_hola_relay_num_files)
+{
+    //
+    // Create two domains that will share one file
+    //
+    Node data, verify_info;
+    for(int i = 0; i < 2; ++i)
+    {
+        Node &dom = data.append();
+        conduit::blueprint::mesh::examples::braid("hexs",
+                                                  10,
+                                                  10,
+                                                  10,
+                                                  dom);
+        dom["state/cycle"] = 103;
+        dom["state/domain_id"] = i;
+    }
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    // the root file pattern is relative to the working directory
+    string output_file = "tout_hola_relay_num_files";
+
+    conduit::Node actions;
+    conduit::Node &add_extract = actions.append();
+    add_extract["action"] = "add_extracts";
+    add_extract["extracts/e1/type"]  = "relay";
+    add_extract["extracts/e1/params/path"] = output_file;
+    add_extract["extracts/e1/params/protocol"] = "blueprint/mesh/hdf5";
+    add_extract["extracts/e1/params/num_files"] = 1;
+
+    actions.append()["action"] = "execute";
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    std::string output_dir = output_file + ".cycle_000103";
+    std::string output_root = output_dir + ".root";
+
+    EXPECT_TRUE(conduit::utils::is_file(output_root));
+    EXPECT_TRUE(conduit::utils::is_file(
+        conduit::utils::join_file_path(output_dir, "file_000000.hdf5")));
+    EXPECT_FALSE(conduit::utils::is_file(
+        conduit::utils::join_file_path(output_dir, "domain_000000.hdf5")));
+
+    Node hola_data, hola_opts;
+    hola_opts["root_file"] = output_root;
+    ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+
+    EXPECT_EQ(hola_data.number_of_children(), 2);
+    EXPECT_TRUE(hola_data.has_path("domain_000001/fields/braid"));
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_hola, test_hola_relay_conduit_bin)
+{
+    //
+    // Create example data
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              10,
+                                              10,
+                                              10,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+    data["state/cycle"] = 104;
+
+    // the root file pattern is relative to the working directory
+    string output_file = "tout_hola_relay_conduit_bin";
+
+    conduit::Node actions;
+    conduit::Node &add_extract = actions.append();
+    add_extract["action"] = "add_extracts";
+    add_extract["extracts/e1/type"]  = "relay";
+    add_extract["extracts/e1/params/path"] = output_file;
+    add_extract["extracts/e1/params/protocol"] = "blueprint/mesh/conduit_bin";
+
+    actions.append()["action"] = "execute";
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    std::string output_root = output_file + ".cycle_000104.root";
+    EXPECT_TRUE(conduit::utils::is_file(output_root));
+
+    float64_array orig_vals = data["fields/braid/values"].value();
+
+    // the domain is loaded by default and memory mapped when asked for
+    for(int i = 0; i < 2; ++i)
+    {
+        Node hola_data, hola_opts;
+        hola_opts["root_file"] = output_root;
+        if(i == 1)
+        {
+            hola_opts["mmap"] = "true";
+        }
+        ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+
+        EXPECT_EQ(hola_data.number_of_children(), 1);
+        Node &hola_dom = hola_data.child(0);
+        EXPECT_TRUE(conduit::blueprint::mesh::verify(hola_dom,verify_info));
+
+        float64_array hola_vals = hola_dom["fields/braid/values"].value();
+        EXPECT_EQ(orig_vals.number_of_elements(), hola_vals.number_of_elements());
+        EXPECT_EQ(orig_vals[10], hola_vals[10]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// four domains with different values, each written to its own file
+void write_hola_domains(const std::string &output_file,
+                        const std::string &protocol,
+                        const int cycle,
+                        Node &data)
+{
+    data.reset();
+    for(int i = 0; i < 4; ++i)
+    {
+        Node &dom = data.append();
+        conduit::blueprint::mesh::examples::braid("hexs",
+                                                  5,
+                                                  5,
+                                                  5,
+                                                  dom);
+        dom["state/cycle"] = cycle;
+        dom["state/domain_id"] = i;
+        float64_array vals = dom["fields/braid/values"].value();
+        for(index_t v = 0; v < vals.number_of_elements(); ++v)
+        {
+            vals[v] += i * 100.0;
+        }
+    }
+
+    conduit::Node actions;
+    conduit::Node &add_extract = actions.append();
+    add_extract["action"] = "add_extracts";
+    add_extract["extracts/e1/type"]  = "relay";
+    add_extract["extracts/e1/params/path"] = output_file;
+    add_extract["extracts/e1/params/protocol"] = protocol;
+    actions.append()["action"] = "execute";
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+void check_hola_domains(const Node &data, const Node &hola_data)
+{
+    EXPECT_EQ(hola_data.number_of_children(), data.number_of_children());
+    for(int i = 0; i < data.number_of_children(); ++i)
+    {
+        const Node &hola_dom = hola_data.child(i);
+        EXPECT_EQ(hola_dom["state/domain_id"].to_int(), i);
+        float64_array orig_vals = data.child(i)["fields/braid/values"].value();
+        float64_array hola_vals = hola_dom["fields/braid/values"].value();
+        EXPECT_EQ(orig_vals.number_of_elements(),
+                  hola_vals.number_of_elements());
+        EXPECT_EQ(orig_vals[7], hola_vals[7]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_hola, test_hola_relay_threads)
+{
+    std::vector<std::string> protocols = {"hdf5", "json"};
+    for(size_t p = 0; p < protocols.size(); ++p)
+    {
+        string output_file = "tout_hola_relay_threads_" + protocols[p];
+        Node data;
+        write_hola_domains(output_file,
+                           "blueprint/mesh/" + protocols[p],
+                           105,
+                           data);
+
+        std::string output_root = output_file + ".cycle_000105.root";
+        EXPECT_TRUE(conduit::utils::is_file(output_root));
+
+        // each reader gets a file, and each domain lands in its own slot
+        Node hola_data, hola_opts;
+        hola_opts["root_file"] = output_root;
+        hola_opts["num_threads"] = 4;
+        ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+        check_hola_domains(data, hola_data);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_hola, test_hola_prefetch)
+{
+    // replay reads the next cycle while ascent works on the current one
+    string output_file = "tout_hola_prefetch";
+    Node data;
+    write_hola_domains(output_file, "blueprint/mesh/hdf5", 106, data);
+    std::string output_root = output_file + ".cycle_000106.root";
+    EXPECT_TRUE(conduit::utils::is_file(output_root));
+
+    Node hola_data;
+    std::thread reader([&]()
+    {
+        Node hola_opts;
+        hola_opts["root_file"] = output_root;
+        hola_opts["num_threads"] = 2;
+        ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+    });
+
+    // ascent writes hdf5 on this thread at the same time
+    Node next_data;
+    write_hola_domains("tout_hola_prefetch_next",
+                       "blueprint/mesh/hdf5",
+                       107,
+                       next_data);
+    reader.join();
+
+    check_hola_domains(data, hola_data);
+    EXPECT_TRUE(conduit::utils::is_file("tout_hola_prefetch_next.cycle_000107.root"));
+}
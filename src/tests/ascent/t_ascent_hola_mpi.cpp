@@ -89,6 +89,25 @@ void hola_mpi_helpers_test_setup_src_data(int rank, Node &data)
     }
 }
 
+//-----------------------------------------------------------------------------
+// adds a uniform domain with num_cells cells in x and a payload field
+// of num_values values
+void hola_mpi_balance_test_add_domain(int num_cells,
+                                      int num_values,
+                                      Node &data)
+{
+    Node &dom = data.append();
+    dom["coordsets/coords/type"] = "uniform";
+    dom["coordsets/coords/dims/i"] = num_cells + 1;
+    dom["coordsets/coords/dims/j"] = 2;
+    dom["coordsets/coords/dims/k"] = 2;
+    dom["topologies/mesh/type"] = "uniform";
+    dom["topologies/mesh/coordset"] = "coords";
+    dom["fields/payload/association"] = "element";
+    dom["fields/payload/topology"] = "mesh";
+    dom["fields/payload/values"].set(DataType::float64(num_values));
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_hola_mpi, test_hola_mpi_helpers)
 {
@@ -194,12 +213,13 @@ TEST(ascent_hola_mpi, test_hola_mpi_helpers)
         MPI_Barrier(comm);
     }
 
+    // all domains are the same size, so the 23 domains are split evenly
     if(rank == 5)
-        EXPECT_EQ(data.number_of_children(),7);
+        EXPECT_EQ(data.number_of_children(),8);
     if(rank == 6)
         EXPECT_EQ(data.number_of_children(),7);
     if(rank == 7)
-        EXPECT_EQ(data.number_of_children(),9);
+        EXPECT_EQ(data.number_of_children(),8);
 }
 
 //-----------------------------------------------------------------------------
@@ -357,6 +377,149 @@ TEST(ascent_hola_mpi, test_hola_mpi)
     MPI_Comm_free(&sub_comm);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_hola_mpi, test_hola_mpi_balance)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank = relay::mpi::rank(comm);
+    int total_size = relay::mpi::size(comm);
+    int rank_split = 5;
+
+    //
+    // every source has two domains. The first domain has many cells
+    // and the last domain has many bytes, the others are small.
+    //
+    Node data;
+    if(rank < rank_split)
+    {
+        const int big_cells = rank == 0 ? 10000 : 1;
+        const int big_values = rank == rank_split - 1 ? 100000 : 1;
+        hola_mpi_balance_test_add_domain(big_cells, 1, data);
+        hola_mpi_balance_test_add_domain(1, big_values, data);
+    }
+
+    Node my_maps;
+    my_maps["wts"] = DataType::int32(total_size);
+    my_maps["wtd"] = DataType::int32(total_size);
+
+    int32_array world_to_src  = my_maps["wts"].value();
+    int32_array world_to_dest = my_maps["wtd"].value();
+
+    for(int i=0;i<total_size;i++)
+    {
+        world_to_src[i]  = i < rank_split ? i : -1;
+        world_to_dest[i] = i < rank_split ? -1 : i - rank_split;
+    }
+
+    // every rank gathers the same comm map
+    Node comm_map;
+
+    // the domain with many bytes gets a destination to itself
+    hola_mpi_comm_map(data, comm, world_to_src, world_to_dest, comm_map, "bytes");
+    int32_array dest_counts = comm_map["dest_counts"].value();
+    EXPECT_EQ(dest_counts[0], 8);
+    EXPECT_EQ(dest_counts[1], 1);
+    EXPECT_EQ(dest_counts[2], 1);
+
+    // so does the domain with many cells
+    hola_mpi_comm_map(data, comm, world_to_src, world_to_dest, comm_map, "cells");
+    dest_counts = comm_map["dest_counts"].value();
+    EXPECT_EQ(dest_counts[0], 1);
+    EXPECT_EQ(dest_counts[1], 1);
+    EXPECT_EQ(dest_counts[2], 8);
+
+    // and every domain counts the same
+    hola_mpi_comm_map(data, comm, world_to_src, world_to_dest, comm_map, "domains");
+    dest_counts = comm_map["dest_counts"].value();
+    EXPECT_EQ(dest_counts[0], 3);
+    EXPECT_EQ(dest_counts[1], 4);
+    EXPECT_EQ(dest_counts[2], 3);
+
+    // the domains go where the byte balanced map sends them
+    hola_mpi_comm_map(data, comm, world_to_src, world_to_dest, comm_map, "bytes");
+    if(rank < rank_split)
+    {
+        hola_mpi_send(data, comm, rank, comm_map);
+    }
+    else
+    {
+        hola_mpi_recv(comm, rank - rank_split, comm_map, data);
+    }
+
+    if(rank == 5)
+        EXPECT_EQ(data.number_of_children(), 8);
+    if(rank == 6)
+        EXPECT_EQ(data.number_of_children(), 1);
+    if(rank == 7)
+    {
+        ASSERT_EQ(data.number_of_children(), 1);
+        EXPECT_EQ(data.child(0)["fields/payload/values"].dtype().number_of_elements(),
+                  100000);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_hola_mpi, test_hola_mpi_invalid_balance)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    Node data, opts;
+    opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    opts["rank_split"] = 5;
+    opts["balance"] = "bogus";
+
+    // the balance is checked before any communication
+    EXPECT_THROW(hola_mpi(opts, data), conduit::Error);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_hola_mpi, test_hola_mpi_comm_map_reuse)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank = relay::mpi::rank(comm);
+    int rank_split = 5;
+
+    Node opts;
+    opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    opts["rank_split"] = rank_split;
+    // no other test uses this balance, so nothing is cached yet
+    opts["balance"] = "domains";
+
+    const int num_builds = hola_mpi_comm_map_builds();
+
+    // the same domains every cycle, then one more domain
+    for(int cycle = 0; cycle < 3; cycle++)
+    {
+        Node data;
+        if(rank < rank_split)
+        {
+            hola_mpi_balance_test_add_domain(4, 4, data);
+            hola_mpi_balance_test_add_domain(4, 4, data);
+            if(cycle == 2 && rank == 0)
+            {
+                hola_mpi_balance_test_add_domain(4, 4, data);
+            }
+        }
+
+        hola_mpi(opts, data);
+
+        // 10 domains, then 11 across the 3 destinations
+        if(rank == 5)
+            EXPECT_EQ(data.number_of_children(), cycle == 2 ? 4 : 3);
+        if(rank == 6)
+            EXPECT_EQ(data.number_of_children(), cycle == 2 ? 3 : 4);
+        if(rank == 7)
+            EXPECT_EQ(data.number_of_children(), cycle == 2 ? 4 : 3);
+
+        // the map is built the first cycle and rebuilt when the
+        // domains change, on every rank
+        const int expected_builds = cycle == 0 ? 1 : cycle;
+        EXPECT_EQ(hola_mpi_comm_map_builds() - num_builds, expected_builds);
+    }
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
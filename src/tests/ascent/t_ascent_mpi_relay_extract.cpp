@@ -51,6 +51,7 @@
 #include "gtest/gtest.h"
 
 #include <ascent.hpp>
+#include <ascent_hola.hpp>
 
 #include <iostream>
 #include <math.h>
@@ -551,6 +552,94 @@ TEST(ascent_mpi_runtime, test_relay_empty)
 
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_runtime, test_relay_num_files_permuted_ids)
+{
+    //
+    // Set Up MPI
+    //
+    int par_rank;
+    int par_size;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+    MPI_Comm_size(comm, &par_size);
+
+    //
+    // Create two domains per rank, with ids that do not follow the
+    // rank order. Each domain's field holds its id.
+    //
+    const int doms_per_rank = 2;
+    const int num_doms = doms_per_rank * par_size;
+    Node data, verify_info;
+    for(int i = 0; i < doms_per_rank; ++i)
+    {
+        Node &dom = data.append();
+        conduit::blueprint::mesh::examples::braid("hexs", 5, 5, 5, dom);
+        dom["state/cycle"] = 110;
+        // reverse the rank order
+        int domain_id = num_doms - 1 - (par_rank * doms_per_rank + i);
+        dom["state/domain_id"] = domain_id;
+        float64_array vals = dom["fields/braid/values"].value();
+        for(index_t v = 0; v < vals.number_of_elements(); ++v)
+        {
+            vals[v] = domain_id;
+        }
+    }
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    // make sure the _output dir exists
+    string output_path = "";
+    if(par_rank == 0)
+    {
+        output_path = prepare_output_dir();
+    }
+    else
+    {
+        output_path = output_dir();
+    }
+
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_relay_permuted_ids");
+
+    conduit::Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts/e1/type"]  = "relay";
+    add_extracts["extracts/e1/params/path"] = output_file;
+    add_extracts["extracts/e1/params/protocol"] = "blueprint/mesh/hdf5";
+    add_extracts["extracts/e1/params/num_files"] = 1;
+    actions.append()["action"] = "execute";
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    ascent_opts["runtime"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    MPI_Barrier(comm);
+
+    // every domain comes back whole, with its own field
+    Node hola_data, hola_opts;
+    hola_opts["root_file"] = output_file + ".cycle_000110.root";
+    hola_opts["mpi_comm"] = MPI_Comm_c2f(comm);
+    ascent::hola("relay/blueprint/mesh", hola_opts, hola_data);
+
+    EXPECT_EQ(hola_data.number_of_children(), doms_per_rank);
+    for(int i = 0; i < hola_data.number_of_children(); ++i)
+    {
+        const Node &dom = hola_data.child(i);
+        // trees are read back in rank order
+        int domain_id = num_doms - 1 - (par_rank * doms_per_rank + i);
+        EXPECT_EQ(dom["state/domain_id"].to_int(), domain_id);
+        float64_array vals = dom["fields/braid/values"].value();
+        EXPECT_EQ(vals[0], (float64)domain_id);
+    }
+}
+
 //
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
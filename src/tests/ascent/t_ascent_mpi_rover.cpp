@@ -0,0 +1,447 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_ascent_mpi_rover.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <ascent.hpp>
+#include <iostream>
+#include <map>
+#include <math.h>
+#include <vector>
+
+#include <mpi.h>
+
+#include <runtimes/ascent_vtkh_data_adapter.hpp>
+#include <bin_compositor.hpp>
+#include <partial_image.hpp>
+#include <rover.hpp>
+#include <ray_generators/camera_generator.hpp>
+#include <vtkh/vtkh.hpp>
+#include <vtkh/DataSet.hpp>
+#include <vtkh/rendering/AbsorptionPartial.hpp>
+#include <vtkh/rendering/EmissionPartial.hpp>
+#include <vtkh/rendering/PartialCompositor.hpp>
+
+#include "t_config.hpp"
+#include "t_utils.hpp"
+
+using namespace std;
+using namespace conduit;
+using namespace ascent;
+
+const int NUM_BINS = 3;
+const int IMAGE_SIZE = 64;
+
+//-----------------------------------------------------------------------------
+// Builds a partial image with a deterministic set of pixels, depths and
+// bins that differ between ranks and images. Depths are unique, so the
+// depth order of the partials of a pixel is well defined.
+//-----------------------------------------------------------------------------
+void
+make_partial_image(const int rank,
+                   const int image,
+                   const bool has_emission,
+                   rover::PartialImage<vtkm::Float32> &partial_image)
+{
+    std::vector<vtkm::Id> ids;
+    for(int p = (rank + image) % 3; p < IMAGE_SIZE; p += 2 + image)
+    {
+        ids.push_back(p);
+    }
+    const vtkm::Id size = static_cast<vtkm::Id>(ids.size());
+
+    partial_image.m_width = IMAGE_SIZE;
+    partial_image.m_height = 1;
+    partial_image.allocate(size, NUM_BINS);
+
+    vtkm::Id *pixel_ids = rover::get_vtkm_ptr(partial_image.m_pixel_ids);
+    vtkm::Float32 *depths = rover::get_vtkm_ptr(partial_image.m_distances);
+    vtkm::Float32 *absorption = rover::get_vtkm_ptr(partial_image.m_buffer.Buffer);
+    vtkm::Float32 *emission = has_emission ?
+      rover::get_vtkm_ptr(partial_image.m_intensities.Buffer) : NULL;
+
+    for(vtkm::Id i = 0; i < size; ++i)
+    {
+        pixel_ids[i] = ids[i];
+        depths[i] = static_cast<vtkm::Float32>(rank * 10 + image * 3) +
+                    0.01f * static_cast<vtkm::Float32>(ids[i]);
+        for(int b = 0; b < NUM_BINS; ++b)
+        {
+            const vtkm::Id index = i * NUM_BINS + b;
+            absorption[index] = 0.5f + 0.1f * static_cast<vtkm::Float32>((rank + image + b + i) % 5);
+            if(has_emission)
+            {
+                emission[index] = 0.05f * static_cast<vtkm::Float32>((rank * 3 + image + b + i) % 7);
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// The array of structures partials vtk-h composites
+//-----------------------------------------------------------------------------
+void
+extract_partials(rover::PartialImage<vtkm::Float32> &partial_image,
+                 std::vector<vtkh::AbsorptionPartial<vtkm::Float32>> &partials)
+{
+    const vtkm::Id size = partial_image.m_pixel_ids.GetNumberOfValues();
+    vtkm::Id *pixel_ids = rover::get_vtkm_ptr(partial_image.m_pixel_ids);
+    vtkm::Float32 *depths = rover::get_vtkm_ptr(partial_image.m_distances);
+    vtkm::Float32 *absorption = rover::get_vtkm_ptr(partial_image.m_buffer.Buffer);
+    partials.resize(size);
+    for(vtkm::Id i = 0; i < size; ++i)
+    {
+        partials[i].m_pixel_id = static_cast<int>(pixel_ids[i]);
+        partials[i].m_depth = depths[i];
+        partials[i].m_bins.assign(absorption + i * NUM_BINS,
+                                  absorption + (i + 1) * NUM_BINS);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+extract_partials(rover::PartialImage<vtkm::Float32> &partial_image,
+                 std::vector<vtkh::EmissionPartial<vtkm::Float32>> &partials)
+{
+    const vtkm::Id size = partial_image.m_pixel_ids.GetNumberOfValues();
+    vtkm::Id *pixel_ids = rover::get_vtkm_ptr(partial_image.m_pixel_ids);
+    vtkm::Float32 *depths = rover::get_vtkm_ptr(partial_image.m_distances);
+    vtkm::Float32 *absorption = rover::get_vtkm_ptr(partial_image.m_buffer.Buffer);
+    vtkm::Float32 *emission = rover::get_vtkm_ptr(partial_image.m_intensities.Buffer);
+    partials.resize(size);
+    for(vtkm::Id i = 0; i < size; ++i)
+    {
+        partials[i].m_pixel_id = static_cast<int>(pixel_ids[i]);
+        partials[i].m_depth = depths[i];
+        partials[i].m_bins.assign(absorption + i * NUM_BINS,
+                                  absorption + (i + 1) * NUM_BINS);
+        partials[i].m_emission_bins.assign(emission + i * NUM_BINS,
+                                           emission + (i + 1) * NUM_BINS);
+    }
+}
+
+//-----------------------------------------------------------------------------
+vtkm::Float32
+emission_bin(const vtkh::AbsorptionPartial<vtkm::Float32> &/*partial*/, const int /*bin*/)
+{
+    return 0.f;
+}
+
+//-----------------------------------------------------------------------------
+vtkm::Float32
+emission_bin(const vtkh::EmissionPartial<vtkm::Float32> &partial, const int bin)
+{
+    return partial.m_emission_bins[bin];
+}
+
+//-----------------------------------------------------------------------------
+// Composites the same partials with the structure of arrays bin
+// compositor and the array of structures vtk-h compositor and
+// compares the results on rank 0
+//-----------------------------------------------------------------------------
+template<typename PartialType>
+void
+compare_compositors(const bool has_emission)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int par_rank;
+    MPI_Comm_rank(comm, &par_rank);
+
+    const int num_images = 2;
+    std::vector<rover::PartialImage<vtkm::Float32>> partial_images(num_images);
+    std::vector<std::vector<PartialType>> aos_partials(num_images);
+    for(int i = 0; i < num_images; ++i)
+    {
+        make_partial_image(par_rank, i, has_emission, partial_images[i]);
+        extract_partials(partial_images[i], aos_partials[i]);
+    }
+
+    // the background is applied after compositing, so a neutral one
+    // keeps vtk-h from changing the composited bins
+    std::vector<vtkm::Float32> background(NUM_BINS, 1.f);
+    vtkh::PartialCompositor<PartialType> aos_compositor;
+    aos_compositor.set_background(background);
+    aos_compositor.set_comm_handle(MPI_Comm_c2f(comm));
+    std::vector<PartialType> aos_result;
+    aos_compositor.composite(aos_partials, aos_result);
+
+    rover::BinCompositor<vtkm::Float32> soa_compositor;
+    soa_compositor.set_comm_handle(comm);
+    // split every message into many small ones
+    soa_compositor.set_max_message_size(2);
+    rover::BinPartials<vtkm::Float32> soa_result;
+    soa_compositor.composite(partial_images,
+                             NUM_BINS,
+                             has_emission,
+                             IMAGE_SIZE,
+                             soa_result);
+
+    if(par_rank != 0)
+    {
+        return;
+    }
+
+    std::map<vtkm::Id, size_t> aos_index;
+    for(size_t i = 0; i < aos_result.size(); ++i)
+    {
+        aos_index[aos_result[i].m_pixel_id] = i;
+    }
+
+    EXPECT_TRUE(soa_result.size() > 0);
+    for(vtkm::Id i = 0; i < soa_result.size(); ++i)
+    {
+        const vtkm::Id pixel_id = soa_result.m_pixel_ids[i];
+        ASSERT_TRUE(aos_index.find(pixel_id) != aos_index.end());
+        const PartialType &aos = aos_result[aos_index[pixel_id]];
+        for(int b = 0; b < NUM_BINS; ++b)
+        {
+            EXPECT_NEAR(soa_result.m_absorption[i * NUM_BINS + b], aos.m_bins[b], 1e-5);
+            if(has_emission)
+            {
+                EXPECT_NEAR(soa_result.m_emission[i * NUM_BINS + b],
+                            emission_bin(aos, b),
+                            1e-5);
+            }
+        }
+        aos_index.erase(pixel_id);
+    }
+
+    // anything else vtk-h kept must be untouched background
+    for(auto it = aos_index.begin(); it != aos_index.end(); ++it)
+    {
+        const PartialType &aos = aos_result[it->second];
+        for(int b = 0; b < NUM_BINS; ++b)
+        {
+            EXPECT_NEAR(aos.m_bins[b], 1.f, 1e-5);
+            EXPECT_NEAR(emission_bin(aos, b), 0.f, 1e-5);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_rover, bin_compositor_absorption)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    compare_compositors<vtkh::AbsorptionPartial<vtkm::Float32>>(false);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_rover, bin_compositor_emission)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    compare_compositors<vtkh::EmissionPartial<vtkm::Float32>>(true);
+}
+
+//-----------------------------------------------------------------------------
+// Traces one slab of the example data set per rank with a camera looking
+// down the slabs, so every ray goes through the domains of all ranks.
+// The result is only valid on rank 0.
+//-----------------------------------------------------------------------------
+void
+trace_slabs(const rover::RenderMode mode,
+            const rover::RayScope scope,
+            rover::Image<vtkm::Float32> &result)
+{
+    int par_rank;
+    int par_size;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+    MPI_Comm_size(comm, &par_size);
+
+    // the data adapter expects a multi-domain tree
+    Node data;
+    create_3d_example_dataset(data.append(), 16, par_rank, par_size);
+    vtkh::DataSet *dataset = VTKHDataAdapter::BlueprintToVTKHDataSet(data, true);
+    const vtkm::Bounds bounds = dataset->GetGlobalBounds();
+
+    vtkmCamera camera;
+    camera.ResetToBounds(bounds);
+    camera.Azimuth(90.f);
+    rover::CameraGenerator generator(camera, 32, 32);
+
+    rover::Rover tracer;
+    tracer.set_mpi_comm_handle(MPI_Comm_c2f(comm));
+
+    rover::RenderSettings settings;
+    settings.m_render_mode = mode;
+    settings.m_ray_scope = scope;
+    settings.m_global_bounds = bounds;
+    settings.m_primary_field = "radial_vert";
+    tracer.set_render_settings(settings);
+
+    for(int i = 0; i < dataset->GetNumberOfDomains(); ++i)
+    {
+        vtkm::cont::DataSet domain;
+        vtkm::Id domain_id;
+        dataset->GetDomain(i, domain, domain_id);
+        tracer.add_data_set(domain, domain_id);
+    }
+
+    tracer.set_ray_generator(&generator);
+    tracer.execute();
+    // every rank takes part in compositing the view
+    tracer.get_result(result);
+    tracer.finalize();
+    delete dataset;
+}
+
+//-----------------------------------------------------------------------------
+void
+expect_near_handles(rover::Image<vtkm::Float32>::HandleType expected,
+                    rover::Image<vtkm::Float32>::HandleType actual)
+{
+    const vtkm::Id size = expected.GetNumberOfValues();
+    ASSERT_EQ(size, actual.GetNumberOfValues());
+    auto expected_portal = expected.GetPortalConstControl();
+    auto actual_portal = actual.GetPortalConstControl();
+    for(vtkm::Id i = 0; i < size; ++i)
+    {
+        EXPECT_NEAR(expected_portal.Get(i), actual_portal.Get(i), 1e-4);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Forwarding rays between ranks must produce the image every rank
+// tracing every ray produces.
+//-----------------------------------------------------------------------------
+void
+compare_schedulers(const rover::RenderMode mode)
+{
+    rover::Image<vtkm::Float32> static_result;
+    rover::Image<vtkm::Float32> dynamic_result;
+    trace_slabs(mode, rover::global_rays, static_result);
+    trace_slabs(mode, rover::local_rays, dynamic_result);
+
+    int par_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &par_rank);
+    if(par_rank != 0)
+    {
+        return;
+    }
+
+    const int num_channels = static_result.get_num_channels();
+    ASSERT_GT(num_channels, 0);
+    ASSERT_EQ(num_channels, dynamic_result.get_num_channels());
+    for(int c = 0; c < num_channels; ++c)
+    {
+        EXPECT_EQ(static_result.has_intensity(c), dynamic_result.has_intensity(c));
+        EXPECT_EQ(static_result.has_optical_depth(c), dynamic_result.has_optical_depth(c));
+        if(static_result.has_intensity(c) && dynamic_result.has_intensity(c))
+        {
+            expect_near_handles(static_result.get_intensity(c),
+                                dynamic_result.get_intensity(c));
+        }
+        if(static_result.has_optical_depth(c) && dynamic_result.has_optical_depth(c))
+        {
+            expect_near_handles(static_result.get_optical_depth(c),
+                                dynamic_result.get_optical_depth(c));
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_rover, dynamic_scheduler_energy)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    compare_schedulers(rover::energy);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_rover, dynamic_scheduler_volume)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    compare_schedulers(rover::volume);
+}
+
+//-----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    int result = 0;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    MPI_Init(&argc, &argv);
+    vtkh::SetMPICommHandle(MPI_Comm_c2f(MPI_COMM_WORLD));
+    result = RUN_ALL_TESTS();
+    MPI_Finalize();
+
+    return result;
+}
@@ -52,9 +52,14 @@
 #include "gtest/gtest.h"
 
 #include <ascent.hpp>
+#include <runtimes/flow_filters/ascent_runtime_rover_filters.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <iostream>
 #include <math.h>
+#include <vector>
 
 #include <conduit_blueprint.hpp>
 
@@ -71,6 +76,64 @@ using namespace ascent;
 
 index_t EXAMPLE_MESH_SIDE_DIM = 20;
 
+//-----------------------------------------------------------------------------
+// runs the given extracts on data with a new ascent instance
+//-----------------------------------------------------------------------------
+void
+run_extracts(const Node &data, const Node &extracts)
+{
+    conduit::Node actions;
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+    actions.append()["action"] = "execute";
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+// reads the raw pixels of a bov image written by an xray extract
+//-----------------------------------------------------------------------------
+template<typename T>
+std::vector<T>
+read_bov(const std::string &file_name)
+{
+    std::vector<T> pixels;
+    std::ifstream bov(file_name, std::ios::in | std::ios::binary);
+    if(!bov.is_open())
+    {
+        return pixels;
+    }
+    bov.seekg(0, std::ios::end);
+    pixels.resize(static_cast<size_t>(bov.tellg()) / sizeof(T));
+    bov.seekg(0, std::ios::beg);
+    bov.read((char*)pixels.data(), pixels.size() * sizeof(T));
+    return pixels;
+}
+
+//-----------------------------------------------------------------------------
+template<typename T>
+void
+expect_near_bovs(const std::string &expected_file,
+                 const std::string &actual_file,
+                 const double tolerance)
+{
+    std::vector<T> expected = read_bov<T>(expected_file);
+    std::vector<T> actual = read_bov<T>(actual_file);
+    EXPECT_FALSE(expected.empty());
+    ASSERT_EQ(expected.size(), actual.size());
+    for(size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_NEAR(expected[i], actual[i], tolerance);
+    }
+}
+
 
 //-----------------------------------------------------------------------------
 TEST(ascent_rover, test_xray_serial)
@@ -143,6 +206,307 @@ TEST(ascent_rover, test_xray_serial)
     // check that we created an image
     EXPECT_TRUE(check_test_image(output_file, 0.0001f, "100_0"));
 }
+//-----------------------------------------------------------------------------
+TEST(ascent_rover, test_xray_multi_camera)
+{
+    // the vtkm runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing xray_extract with multiple cameras");
+
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_rover_xray_views");
+    string front_image = output_file + "_front100_0.png";
+    string side_image = output_file + "_side100_0.png";
+    string front_bov = output_file + "_front100_0.bov";
+    string side_bov = output_file + "_side100_0.bov";
+    // each camera traced on its own
+    string single_file = conduit::utils::join_file_path(output_path,"tout_rover_xray_view");
+    string single_front_bov = single_file + "_front100_0.bov";
+    string single_side_bov = single_file + "_side100_0.bov";
+
+    // remove old images before rendering
+    const std::string files[] = {front_image, side_image, front_bov, side_bov,
+                                 single_front_bov, single_side_bov};
+    for(const std::string &file : files)
+    {
+        if(conduit::utils::is_file(file))
+        {
+            conduit::utils::remove_file(file);
+        }
+    }
+
+    //
+    // Create the actions.
+    //
+
+    conduit::Node extracts;
+    extracts["e1/type"]  = "xray";
+    extracts["e1/params/absorption"] = "radial";
+    extracts["e1/params/filename"] = output_file;
+    extracts["e1/params/bov_filename"] = output_file;
+    extracts["e1/params/cameras/front/azimuth"] = 0.0;
+    extracts["e1/params/cameras/side/azimuth"] = 45.0;
+
+    //
+    // Run Ascent
+    //
+    run_extracts(data, extracts);
+
+    // check that we created an image for each camera
+    EXPECT_TRUE(conduit::utils::is_file(front_image));
+    EXPECT_TRUE(conduit::utils::is_file(side_image));
+
+    conduit::Node single_extracts;
+    single_extracts["front/type"]  = "xray";
+    single_extracts["front/params/absorption"] = "radial";
+    single_extracts["front/params/filename"] = single_file + "_front";
+    single_extracts["front/params/bov_filename"] = single_file + "_front";
+    single_extracts["front/params/camera/azimuth"] = 0.0;
+    single_extracts["side/type"]  = "xray";
+    single_extracts["side/params/absorption"] = "radial";
+    single_extracts["side/params/filename"] = single_file + "_side";
+    single_extracts["side/params/bov_filename"] = single_file + "_side";
+    single_extracts["side/params/camera/azimuth"] = 45.0;
+    run_extracts(data, single_extracts);
+
+    // each view of the batch matches the same camera traced on its own
+    expect_near_bovs<float>(single_front_bov, front_bov, 1e-6);
+    expect_near_bovs<float>(single_side_bov, side_bov, 1e-6);
+
+    // and the views are not copies of each other
+    std::vector<float> front_pixels = read_bov<float>(front_bov);
+    std::vector<float> side_pixels = read_bov<float>(side_bov);
+    ASSERT_EQ(front_pixels.size(), side_pixels.size());
+    float max_diff = 0.f;
+    for(size_t i = 0; i < front_pixels.size(); ++i)
+    {
+        max_diff = std::max(max_diff, std::abs(front_pixels[i] - side_pixels[i]));
+    }
+    EXPECT_GT(max_diff, 1e-3f);
+}
+//-----------------------------------------------------------------------------
+TEST(ascent_rover, test_xray_static_mesh)
+{
+    // the vtkm runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    // the mesh never changes, only the field values do
+    data["state/mesh_generation"] = 0;
+
+    ASCENT_INFO("Testing xray_extract with a static mesh");
+
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_rover_xray_static");
+    string image_0 = output_file + "100_0.png";
+    string image_1 = output_file + "101_0.png";
+
+    // remove old images before rendering
+    if(conduit::utils::is_file(image_0))
+    {
+        conduit::utils::remove_file(image_0);
+    }
+    if(conduit::utils::is_file(image_1))
+    {
+        conduit::utils::remove_file(image_1);
+    }
+
+    //
+    // Create the actions.
+    //
+
+    const std::string extract_name = "xray_static_mesh";
+    conduit::Node extracts;
+    extracts[extract_name + "/type"]  = "xray";
+    extracts[extract_name + "/params/absorption"] = "radial";
+    extracts[extract_name + "/params/filename"] = output_file;
+
+    conduit::Node actions;
+    // add the pipeline
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+    // execute
+    conduit::Node &execute  = actions.append();
+    execute["action"] = "execute";
+
+    conduit::Node reset_actions;
+    reset_actions.append()["action"] = "reset";
+
+    //
+    // Run Ascent
+    //
+
+    using ascent::runtime::filters::RoverCaches;
+    RoverCaches::clear();
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+
+    float64_array radial = data["fields/radial/values"].value();
+    for(int cycle = 100; cycle < 102; ++cycle)
+    {
+        data["state/cycle"] = cycle;
+        ascent.publish(data);
+        ascent.execute(actions);
+        ascent.execute(reset_actions);
+
+        // the first cycle builds the engine, the second reuses it
+        EXPECT_EQ(RoverCaches::num_engine_reuses(extract_name), cycle - 100);
+
+        // change the field, but not the mesh
+        for(index_t i = 0; i < radial.number_of_elements(); ++i)
+        {
+            radial[i] *= 0.5;
+        }
+    }
+
+    // moving a point changes the mesh, so the simulation bumps the
+    // mesh generation and the engine is rebuilt
+    float64_array x = data["coordsets/coords/values/x"].value();
+    x[0] -= 1.0;
+    data["state/cycle"] = 102;
+    data["state/mesh_generation"] = 1;
+    ascent.publish(data);
+    ascent.execute(actions);
+    EXPECT_EQ(RoverCaches::num_engine_reuses(extract_name), 1);
+
+    // the engines are released once the extract is removed
+    ascent.execute(reset_actions);
+    conduit::Node execute_actions;
+    execute_actions.append()["action"] = "execute";
+    ascent.execute(execute_actions);
+    EXPECT_EQ(RoverCaches::num_engine_reuses(extract_name), 0);
+
+    ascent.close();
+
+    // check that both cycles created an image
+    EXPECT_TRUE(conduit::utils::is_file(image_0));
+    EXPECT_TRUE(conduit::utils::is_file(image_1));
+}
+//-----------------------------------------------------------------------------
+TEST(ascent_rover, test_xray_ray_reuse)
+{
+    // the vtkm runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing xray_extract ray reuse across executes");
+
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_rover_xray_ray_reuse");
+
+    //
+    // Create the actions.
+    //
+
+    const std::string extract_name = "xray_ray_reuse";
+    conduit::Node extracts;
+    extracts[extract_name + "/type"]  = "xray";
+    extracts[extract_name + "/params/absorption"] = "radial";
+    extracts[extract_name + "/params/filename"] = output_file;
+
+    conduit::Node actions;
+    // add the pipeline
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+    // execute
+    conduit::Node &execute  = actions.append();
+    execute["action"] = "execute";
+    // reset the graph, so the next execute builds a new extract filter
+    conduit::Node &reset  = actions.append();
+    reset["action"] = "reset";
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+
+    using ascent::runtime::filters::RoverCaches;
+    RoverCaches::clear();
+
+    // a single domain and view, so the first execute allocates the rays
+    ascent.publish(data);
+    ascent.execute(actions);
+    EXPECT_EQ(RoverCaches::num_ray_reuses(extract_name), 0);
+
+    // and the second traces with the same rays
+    ascent.publish(data);
+    ascent.execute(actions);
+    EXPECT_EQ(RoverCaches::num_ray_reuses(extract_name), 1);
+
+    // closing releases the rays
+    ascent.close();
+    EXPECT_EQ(RoverCaches::num_ray_reuses(extract_name), 0);
+}
 //
 //-----------------------------------------------------------------------------
 TEST(ascent_rover, test_volume_min_max)
@@ -286,3 +650,320 @@ TEST(ascent_rover, test_volume_serial)
     // check that we created an image
     EXPECT_TRUE(check_test_image(output_file));
 }
+//-----------------------------------------------------------------------------
+TEST(ascent_rover, test_volume_skip_empty_space)
+{
+    // the vtkm runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing volume_extract with empty space skipping");
+
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_rover_volume_skip");
+    string full_file = conduit::utils::join_file_path(output_path,
+                                                      "tout_rover_volume_no_skip");
+    string threshold_file = conduit::utils::join_file_path(output_path,
+                                                           "tout_rover_volume_skip_threshold");
+    string full_threshold_file = conduit::utils::join_file_path(output_path,
+                                                                "tout_rover_volume_no_skip_threshold");
+
+    // remove old images before rendering
+    remove_test_image(output_file);
+    remove_test_image(full_file);
+    remove_test_image(threshold_file);
+    remove_test_image(full_threshold_file);
+
+
+    //
+    // Create the actions.
+    //
+
+    conduit::Node extracts;
+    extracts["full/type"]  = "volume";
+    // populate some param examples
+    extracts["full/params/field"] = "radial";
+    extracts["full/params/filename"] = full_file;
+    extracts["full/params/color_table/name"] = "cool to warm";
+
+    // the lower half of the range is fully transparent
+    conduit::Node control_points;
+
+    conduit::Node &point1 = control_points.append();
+    point1["type"] = "alpha";
+    point1["position"] = 0.;
+    point1["alpha"] = 0.0;
+
+    conduit::Node &point2 = control_points.append();
+    point2["type"] = "alpha";
+    point2["position"] = 0.5;
+    point2["alpha"] = 0.0;
+
+    conduit::Node &point3 = control_points.append();
+    point3["type"] = "alpha";
+    point3["position"] = 1.0;
+    point3["alpha"] = 0.5;
+
+    extracts["full/params/color_table/control_points"] = control_points;
+
+    // the same scene with empty space skipping
+    extracts["skip"] = extracts["full"];
+    extracts["skip/params/filename"] = output_file;
+    extracts["skip/params/macrocells"] = 8;
+
+    // early termination changes the saturated pixels, so it is
+    // compared against a render that only terminates early
+    extracts["full_threshold"] = extracts["full"];
+    extracts["full_threshold/params/filename"] = full_threshold_file;
+    extracts["full_threshold/params/opacity_threshold"] = 0.95;
+    extracts["skip_threshold"] = extracts["full_threshold"];
+    extracts["skip_threshold/params/filename"] = threshold_file;
+    extracts["skip_threshold/params/macrocells"] = 8;
+
+    //
+    // Run Ascent
+    //
+    run_extracts(data, extracts);
+
+    // skipping empty space must not change the image
+    EXPECT_TRUE(conduit::utils::is_file(output_file + "100.png"));
+    EXPECT_TRUE(conduit::utils::is_file(threshold_file + "100.png"));
+    Node info;
+    ascent::PNGCompare compare;
+    EXPECT_TRUE(compare.Compare(output_file + "100.png",
+                                full_file + "100.png",
+                                info,
+                                0.01f));
+    EXPECT_TRUE(compare.Compare(threshold_file + "100.png",
+                                full_threshold_file + "100.png",
+                                info,
+                                0.01f));
+}
+//-----------------------------------------------------------------------------
+TEST(ascent_rover, test_xray_tiled)
+{
+    // the vtkm runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing xray_extract with tiled output");
+
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_rover_xray_tiled");
+    string bov_file = conduit::utils::join_file_path(output_path,"tout_rover_xray_tiled_bov");
+    string untiled_bov_file = conduit::utils::join_file_path(output_path,
+                                                             "tout_rover_xray_untiled_bov");
+    string image = output_file + "100_0.png";
+    string bov = bov_file + "100_0.bov";
+    string untiled_bov = untiled_bov_file + "100_0.bov";
+
+    // remove old images before rendering
+    std::vector<std::string> files = {image, bov, untiled_bov};
+    for(size_t i = 0; i < files.size(); ++i)
+    {
+        if(conduit::utils::is_file(files[i]))
+        {
+            conduit::utils::remove_file(files[i]);
+        }
+    }
+
+    //
+    // Render the same image with and without tiles
+    //
+
+    conduit::Node extracts;
+    extracts["e1/type"]  = "xray";
+    // populate some param examples
+    extracts["e1/params/absorption"] = "radial";
+    extracts["e1/params/emission"] = "radial";
+    extracts["e1/params/filename"] = output_file;
+    extracts["e1/params/bov_filename"] = untiled_bov_file;
+    run_extracts(data, extracts);
+
+    extracts["e1/params/bov_filename"] = bov_file;
+    extracts["e1/params/tiled"] = "true";
+    run_extracts(data, extracts);
+
+    // check that we created the png, and that the raw image of the
+    // first bin matches the one written without tiles
+    EXPECT_TRUE(conduit::utils::is_file(image));
+    expect_near_bovs<float>(untiled_bov, bov, 1e-6);
+}
+//-----------------------------------------------------------------------------
+TEST(ascent_rover, test_xray_double_composite)
+{
+    // the vtkm runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing xray_extract with double precision compositing");
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_rover_xray_double_composite");
+    string double_bov = conduit::utils::join_file_path(output_path,
+                                                       "tout_rover_xray_double_bov");
+    string composite_bov = output_file + "_bov";
+
+    // remove old images before rendering
+    std::vector<std::string> files = {output_file + "100_0.png",
+                                      double_bov + "100_0.bov",
+                                      composite_bov + "100_0.bov"};
+    for(size_t i = 0; i < files.size(); ++i)
+    {
+        if(conduit::utils::is_file(files[i]))
+        {
+            conduit::utils::remove_file(files[i]);
+        }
+    }
+
+    //
+    // Trace in double precision, then in single precision with double
+    // precision compositing. Both store double precision images.
+    //
+    conduit::Node extracts;
+    extracts["e1/type"]  = "xray";
+    extracts["e1/params/absorption"] = "radial";
+    extracts["e1/params/emission"] = "radial";
+    extracts["e1/params/filename"] = output_file;
+    extracts["e1/params/bov_filename"] = double_bov;
+    extracts["e1/params/precision"] = "double";
+    run_extracts(data, extracts);
+
+    extracts["e1/params/bov_filename"] = composite_bov;
+    extracts["e1/params/precision"] = "double_composite";
+    run_extracts(data, extracts);
+
+    EXPECT_TRUE(conduit::utils::is_file(files[0]));
+    // only the samples within the single domain are accumulated in
+    // single precision, the normalized images agree to that precision
+    expect_near_bovs<double>(double_bov + "100_0.bov",
+                                    composite_bov + "100_0.bov",
+                                    1e-4);
+}
+//-----------------------------------------------------------------------------
+TEST(ascent_rover, test_volume_local_rays)
+{
+    // the vtkm runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh with a few slabs, so rays are passed
+    // between the domains.
+    //
+    Node data, verify_info;
+    const int num_domains = 4;
+    for(int i = 0; i < num_domains; ++i)
+    {
+        create_3d_example_dataset(data.append(), 8, i, num_domains);
+    }
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing volume_extract with local rays");
+
+
+    string output_path = prepare_output_dir();
+    string global_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_rover_volume_global_rays");
+    string local_file = conduit::utils::join_file_path(output_path,
+                                                       "tout_rover_volume_local_rays");
+
+    // remove old images before rendering
+    remove_test_image(global_file);
+    remove_test_image(local_file);
+
+
+    //
+    // Create the actions.
+    //
+
+    conduit::Node extracts;
+    extracts["global/type"]  = "volume";
+    extracts["global/params/field"] = "radial_vert";
+    extracts["global/params/filename"] = global_file;
+    // look across the slabs
+    extracts["global/params/camera/azimuth"] = 90.0;
+    extracts["local"] = extracts["global"];
+    extracts["local/params/filename"] = local_file;
+    extracts["local/params/ray_scope"] = "local";
+
+    //
+    // Run Ascent
+    //
+    run_extracts(data, extracts);
+
+    // passing rays between domains must produce the image of tracing
+    // every ray through every domain
+    EXPECT_TRUE(conduit::utils::is_file(local_file + "100.png"));
+    Node info;
+    ascent::PNGCompare compare;
+    EXPECT_TRUE(compare.Compare(local_file + "100.png",
+                                global_file + "100.png",
+                                info,
+                                0.01f));
+}
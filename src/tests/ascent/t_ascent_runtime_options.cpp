@@ -379,3 +379,330 @@ TEST(ascent_runtime_options, test_actions_yaml_file)
     EXPECT_TRUE(check_test_file(output_actions));
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_graph_cache)
+{
+    // the ascent runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping graph cache test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing graph cache");
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_graph_cache_");
+    string image_0 = output_file + "100.png";
+    string image_1 = output_file + "101.png";
+
+    // remove old images before rendering
+    remove_test_file(image_0);
+    remove_test_file(image_1);
+
+    //
+    // Create the actions.
+    //
+    conduit::Node scenes;
+    scenes["s1/plots/p1/type"]  = "pseudocolor";
+    scenes["s1/plots/p1/field"] = "braid";
+    scenes["s1/image_prefix"]   = output_file + "%03d";
+
+    conduit::Node actions;
+    conduit::Node &add_plots = actions.append();
+    add_plots["action"] = "add_scenes";
+    add_plots["scenes"] = scenes;
+    conduit::Node &execute  = actions.append();
+    execute["action"] = "execute";
+
+    conduit::Node reset_actions;
+    reset_actions.append()["action"] = "reset";
+
+    //
+    // Run Ascent
+    //
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["graph_cache"] = "enabled";
+    ascent.open(ascent_opts);
+
+    // the second cycle replays the graph built by the first
+    for(int cycle = 100; cycle < 102; ++cycle)
+    {
+      data["state/cycle"] = cycle;
+      ascent.publish(data);
+      ascent.execute(actions);
+      ascent.execute(reset_actions);
+    }
+
+    ascent.close();
+
+    // check that both cycles created an image
+    EXPECT_TRUE(check_test_file(image_0));
+    EXPECT_TRUE(check_test_file(image_1));
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_graph_cache_trigger_file)
+{
+    // the ascent runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping graph cache test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing graph cache with a changing trigger actions file");
+
+    string output_path = prepare_output_dir();
+    string trigger_file = conduit::utils::join_file_path(output_path,
+                                                         "graph_cache_trigger_actions");
+    string first_file = conduit::utils::join_file_path(output_path,
+                                                       "tout_graph_cache_trigger_a_");
+    // a longer prefix changes the size of the actions file
+    string second_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_graph_cache_trigger_bb_");
+
+    // remove old files
+    remove_test_file(trigger_file);
+    remove_test_file(first_file + "100.png");
+    remove_test_file(first_file + "101.png");
+    remove_test_file(second_file + "101.png");
+
+    //
+    // Create the actions.
+    //
+    conduit::Node triggers;
+    triggers["t1/params/condition"] = "1 == 1";
+    triggers["t1/params/actions_file"] = trigger_file;
+
+    conduit::Node actions;
+    conduit::Node &add_triggers = actions.append();
+    add_triggers["action"] = "add_triggers";
+    add_triggers["triggers"] = triggers;
+    conduit::Node &execute  = actions.append();
+    execute["action"] = "execute";
+    conduit::Node &reset  = actions.append();
+    reset["action"] = "reset";
+
+    //
+    // Run Ascent
+    //
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["graph_cache"] = "enabled";
+    ascent.open(ascent_opts);
+
+    // the actions are the same every cycle, but the trigger's actions
+    // file changes, so the second cycle must rebuild the graph
+    for(int cycle = 100; cycle < 102; ++cycle)
+    {
+      const string prefix = cycle == 100 ? first_file : second_file;
+      Node trigger_actions;
+      conduit::Node &add_scenes = trigger_actions.append();
+      add_scenes["action"] = "add_scenes";
+      add_scenes["scenes/s1/plots/p1/type"]  = "pseudocolor";
+      add_scenes["scenes/s1/plots/p1/field"] = "braid";
+      add_scenes["scenes/s1/image_prefix"]   = prefix + "%03d";
+      trigger_actions.save(trigger_file, "json");
+
+      data["state/cycle"] = cycle;
+      ascent.publish(data);
+      ascent.execute(actions);
+    }
+
+    ascent.close();
+
+    EXPECT_TRUE(check_test_file(first_file + "100.png"));
+    EXPECT_TRUE(check_test_file(second_file + "101.png"));
+    EXPECT_FALSE(check_test_file(first_file + "101.png"));
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_incremental_verify)
+{
+    // the ascent runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping incremental verify test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing incremental verify");
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_incremental_verify");
+    string output_image = output_file + ".png";
+
+    // remove old images before rendering
+    remove_test_file(output_image);
+
+    //
+    // Create the actions.
+    //
+    conduit::Node scenes;
+    scenes["s1/plots/p1/type"]  = "pseudocolor";
+    scenes["s1/plots/p1/field"] = "braid";
+    scenes["s1/image_prefix"]   = output_file;
+
+    conduit::Node actions;
+    conduit::Node &add_plots = actions.append();
+    add_plots["action"] = "add_scenes";
+    add_plots["scenes"] = scenes;
+    conduit::Node &execute  = actions.append();
+    execute["action"] = "execute";
+    conduit::Node &reset  = actions.append();
+    reset["action"] = "reset";
+
+    //
+    // Run Ascent
+    //
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["verify"] = "incremental";
+    ascent.open(ascent_opts);
+
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    // the mesh did not change, but a new field that does not
+    // conform to the blueprint must still be caught
+    data["fields/bad/association"] = "vertex";
+    data["fields/bad/topology"] = "missing_topo";
+    data["fields/bad/values"].set(DataType::float64(10));
+
+    ascent.publish(data);
+    EXPECT_THROW(ascent.execute(actions),conduit::Error);
+
+    ascent.close();
+
+    // check that the first cycle created an image
+    EXPECT_TRUE(check_test_file(output_image));
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_runtime_options, test_incremental_verify_generation)
+{
+    // the ascent runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping incremental verify test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    data["state/generation"] = 0;
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing incremental verify with a generation counter");
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,
+                                                        "tout_incremental_verify_gen");
+
+    //
+    // Create the actions.
+    //
+    conduit::Node scenes;
+    scenes["s1/plots/p1/type"]  = "pseudocolor";
+    scenes["s1/plots/p1/field"] = "braid";
+    scenes["s1/image_prefix"]   = output_file;
+
+    conduit::Node actions;
+    conduit::Node &add_plots = actions.append();
+    add_plots["action"] = "add_scenes";
+    add_plots["scenes"] = scenes;
+    conduit::Node &execute  = actions.append();
+    execute["action"] = "execute";
+    conduit::Node &reset  = actions.append();
+    reset["action"] = "reset";
+
+    //
+    // Run Ascent
+    //
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent_opts["verify"] = "incremental";
+    ascent.open(ascent_opts);
+
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    // break the field in place: its schema and address don't change,
+    // but the new generation must force a re-verify
+    char *assoc = data["fields/braid/association"].as_char8_str();
+    assoc[1] = 'o';
+    data["state/generation"] = 1;
+
+    ascent.publish(data);
+    EXPECT_THROW(ascent.execute(actions),conduit::Error);
+
+    ascent.close();
+}
@@ -332,6 +332,170 @@ TEST(ascent_triggers, trigger_extract)
 }
 
 
+//-----------------------------------------------------------------------------
+TEST(ascent_triggers, trigger_shared_pipeline)
+{
+    // the vtkm runtime is currently our only rendering runtime
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    string output_path = prepare_output_dir();
+    string fire_file = conduit::utils::join_file_path(output_path,"shared_fire_actions");
+    string skip_file = conduit::utils::join_file_path(output_path,"shared_skip_actions");
+    string fire_image = conduit::utils::join_file_path(output_path,"tout_trigger_shared_fire");
+    string skip_image = conduit::utils::join_file_path(output_path,"tout_trigger_shared_skip");
+    // remove old files
+    if(conduit::utils::is_file(fire_image + ".png"))
+    {
+      conduit::utils::remove_file(fire_image + ".png");
+    }
+    if(conduit::utils::is_file(skip_image + ".png"))
+    {
+      conduit::utils::remove_file(skip_image + ".png");
+    }
+
+    //
+    // Create trigger actions, both render a pipeline of the main actions
+    //
+    Node trigger_actions;
+    conduit::Node &add_scenes= trigger_actions.append();
+    add_scenes["action"] = "add_scenes";
+    add_scenes["scenes/s1/plots/p1/type"]  = "pseudocolor";
+    add_scenes["scenes/s1/plots/p1/field"] = "braid";
+    add_scenes["scenes/s1/plots/p1/pipeline"] = "pl1";
+    add_scenes["scenes/s1/image_prefix"] = fire_image;
+    trigger_actions.save(fire_file, "json");
+
+    add_scenes["scenes/s1/image_prefix"] = skip_image;
+    trigger_actions.save(skip_file, "json");
+
+    //
+    // Create the actions.
+    //
+    Node actions;
+
+    conduit::Node pipelines;
+    pipelines["pl1/f1/type"] = "contour";
+    pipelines["pl1/f1/params/field"] = "braid";
+    pipelines["pl1/f1/params/iso_values"] = 0.;
+
+    conduit::Node &add_pipelines = actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    add_pipelines["pipelines"] = pipelines;
+
+    conduit::Node triggers;
+    triggers["t1/params/condition"] = "cycle() == 100";
+    triggers["t1/params/actions_file"] = fire_file;
+    triggers["t2/params/condition"] = "cycle() != 100";
+    triggers["t2/params/actions_file"] = skip_file;
+
+    conduit::Node &add_triggers= actions.append();
+    add_triggers["action"] = "add_triggers";
+    add_triggers["triggers"] = triggers;
+    conduit::Node &execute = actions.append();
+    execute["action"] = "execute";
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    // only the trigger that fired rendered
+    EXPECT_TRUE(conduit::utils::is_file(fire_image + ".png"));
+    EXPECT_FALSE(conduit::utils::is_file(skip_image + ".png"));
+}
+
+
+//-----------------------------------------------------------------------------
+TEST(ascent_triggers, trigger_query_same_name)
+{
+    //
+    // Create example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    string output_path = prepare_output_dir();
+    string trigger_file = conduit::utils::join_file_path(output_path,
+                                                         "query_same_name_actions");
+
+    //
+    // the trigger adds a query with the same name as a main query
+    //
+    Node trigger_actions;
+    conduit::Node &trigger_queries = trigger_actions.append();
+    trigger_queries["action"] = "add_queries";
+    trigger_queries["queries/q1/params/expression"] = "min(\"braid\")";
+    trigger_queries["queries/q1/params/name"] = "trigger_min";
+    trigger_actions.save(trigger_file, "json");
+
+    //
+    // Create the actions.
+    //
+    Node actions;
+
+    conduit::Node &add_queries = actions.append();
+    add_queries["action"] = "add_queries";
+    add_queries["queries/q1/params/expression"] = "max(\"braid\")";
+    add_queries["queries/q1/params/name"] = "main_max";
+
+    conduit::Node &add_triggers= actions.append();
+    add_triggers["action"] = "add_triggers";
+    add_triggers["triggers/t1/params/condition"] = "cycle() == 100";
+    add_triggers["triggers/t1/params/actions_file"] = trigger_file;
+    conduit::Node &execute = actions.append();
+    execute["action"] = "execute";
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    // both queries ran
+    conduit::Node info;
+    ascent.info(info);
+    EXPECT_TRUE(info.has_path("expressions/main_max/100/value"));
+    EXPECT_TRUE(info.has_path("expressions/trigger_min/100/value"));
+    ascent.close();
+}
+
 
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
@@ -53,8 +53,11 @@
 #include <flow.hpp>
 #include <flow_builtin_filters.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <math.h>
+#include <thread>
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
@@ -455,6 +458,50 @@ TEST(ascent_flow_workspace, dag_graph_filter_ptr_iface_port_idx)
 }
 
 //-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+class SumFilter: public Filter
+{
+public:
+    SumFilter()
+    : Filter()
+    {}
+
+    virtual ~SumFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "sum";
+        i["output_port"] = "true";
+        i["cacheable"]   = "true";
+        i["port_names"].append().set("in");
+    }
+
+    virtual void execute()
+    {
+        num_execs++;
+
+        Node *in = input<Node>("in");
+        int *vals = (*in)["values"].value();
+        int rval = 0;
+        for(index_t i = 0; i < (*in)["values"].dtype().number_of_elements(); i++)
+        {
+            rval += vals[i];
+        }
+
+        Node *res = new Node();
+        res->set(rval);
+        set_output<Node>(res);
+
+        ASCENT_INFO("exec: " << name() << " result = " << res->to_json());
+    }
+
+    static int num_execs;
+};
+
+int SumFilter::num_execs = 0;
+
+
 TEST(ascent_flow_workspace, graph_workspace_reg_source)
 {
     Workspace::register_filter_type<filters::RegistrySource>();
@@ -505,6 +552,425 @@ TEST(ascent_flow_workspace, graph_workspace_reg_source)
 }
 
 
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, reexecute_modified_graph)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<IncFilter>();
+
+    Workspace w;
+
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("inc","a");
+    w.graph().connect("s","a","in");
+
+    // execute twice, the second exec reuses the compiled plan
+    for(int i = 0; i < 2; ++i)
+    {
+        w.execute();
+        Node *res = w.registry().fetch<Node>("a");
+        EXPECT_EQ(res->to_int(),1);
+        w.registry().reset();
+    }
+
+    // changing the graph must invalidate the compiled plan
+    w.graph().add_filter("inc","b");
+    w.graph().connect("a","b","in");
+
+    w.execute();
+
+    Node *res = w.registry().fetch<Node>("b");
+    EXPECT_EQ(res->to_int(),2);
+    w.registry().reset();
+
+    // so does a reset
+    w.reset();
+    w.graph().add_filter("src","s");
+    w.execute();
+
+    res = w.registry().fetch<Node>("s");
+    EXPECT_EQ(res->to_int(),0);
+    w.registry().reset();
+
+    Workspace::clear_supported_filter_types();
+}
+
+
+//-----------------------------------------------------------------------------
+// inc filter that records how many instances execute at the same time
+//-----------------------------------------------------------------------------
+static std::atomic<int> probe_active(0);
+static std::atomic<int> probe_max_active(0);
+
+class ProbeIncFilter: public IncFilter
+{
+public:
+    ProbeIncFilter()
+    : IncFilter()
+    {}
+
+    virtual ~ProbeIncFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        IncFilter::declare_interface(i);
+        i["type_name"]   = "probe_inc";
+    }
+
+    virtual void execute()
+    {
+        int active = ++probe_active;
+        int max_active = probe_max_active;
+        while(active > max_active &&
+              !probe_max_active.compare_exchange_weak(max_active, active))
+        {}
+
+        // give other workers a chance to overlap
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        IncFilter::execute();
+        --probe_active;
+    }
+};
+
+//-----------------------------------------------------------------------------
+class SafeIncFilter: public ProbeIncFilter
+{
+public:
+    SafeIncFilter()
+    : ProbeIncFilter()
+    {}
+
+    virtual ~SafeIncFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        ProbeIncFilter::declare_interface(i);
+        i["type_name"]   = "safe_inc";
+        i["thread_safe"] = "true";
+    }
+};
+
+//-----------------------------------------------------------------------------
+// four independent branches that hang off the same source, joined by adds
+// result: (10+1) + (10+2) + (10+3) + (10+4)
+//-----------------------------------------------------------------------------
+void
+build_parallel_graph(Workspace &w, const std::string &inc_type)
+{
+    Node p_vs;
+    p_vs["value"].set(int(10));
+
+    w.graph().add_filter("src","s",p_vs);
+
+    std::vector<std::string> branches;
+    for(int b = 0; b < 4; ++b)
+    {
+        std::ostringstream oss;
+        oss << "b" << b;
+        std::string prev = "s";
+        for(int i = 0; i <= b; ++i)
+        {
+            std::ostringstream f_name;
+            f_name << oss.str() << "_inc_" << i;
+            w.graph().add_filter(inc_type,f_name.str());
+            w.graph().connect(prev,f_name.str(),"in");
+            prev = f_name.str();
+        }
+        branches.push_back(prev);
+    }
+
+    // join the branches
+    w.graph().add_filter("add","a1");
+    w.graph().add_filter("add","a2");
+    w.graph().add_filter("add","a3");
+    w.graph().connect(branches[0],"a1","a");
+    w.graph().connect(branches[1],"a1","b");
+    w.graph().connect(branches[2],"a2","a");
+    w.graph().connect(branches[3],"a2","b");
+    w.graph().connect("a1","a3","a");
+    w.graph().connect("a2","a3","b");
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, dag_graph_parallel_execute)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<SafeIncFilter>();
+    Workspace::register_filter_type<AddFilter>();
+
+    Workspace w;
+    w.set_num_threads(4);
+    EXPECT_EQ(w.num_threads(),4);
+
+    build_parallel_graph(w, "safe_inc");
+
+    for(int i = 0; i < 4; ++i)
+    {
+        w.execute();
+
+        Node *res = w.registry().fetch<Node>("a3");
+        EXPECT_EQ(res->to_int(),50);
+        w.registry().consume("a3");
+    }
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, dag_graph_parallel_execute_serial_filters)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<ProbeIncFilter>();
+    Workspace::register_filter_type<AddFilter>();
+
+    Workspace w;
+    w.set_num_threads(4);
+
+    build_parallel_graph(w, "probe_inc");
+
+    probe_active = 0;
+    probe_max_active = 0;
+    w.execute();
+
+    Node *res = w.registry().fetch<Node>("a3");
+    EXPECT_EQ(res->to_int(),50);
+    w.registry().consume("a3");
+
+    // probe_inc doesn't declare thread_safe, so it never overlaps
+    EXPECT_EQ(probe_max_active.load(),1);
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, cached_filter_reexecute)
+{
+    Workspace::register_filter_type<filters::RegistrySource>();
+    Workspace::register_filter_type<SumFilter>();
+    Workspace::register_filter_type<IncFilter>();
+
+    Workspace w;
+    w.set_cache_enabled(true);
+    EXPECT_TRUE(w.cache_enabled());
+
+    int vals[4] = {1, 2, 3, 4};
+    Node data;
+    data["state/generation"] = 0;
+    data["values"].set_external(vals,4);
+    w.registry().add<Node>(":src",&data);
+
+    Node p;
+    p["entry"] = ":src";
+    w.graph().add_filter("registry_source","s",p);
+    w.graph().add_filter("sum","sum");
+    w.graph().add_filter("inc","inc");
+    w.graph().connect("s","sum","in");
+    w.graph().connect("sum","inc","in");
+
+    SumFilter::num_execs = 0;
+
+    // the second exec reuses the cached sum
+    for(int i = 0; i < 2; ++i)
+    {
+        w.execute();
+        Node *res = w.registry().fetch<Node>("inc");
+        EXPECT_EQ(res->to_int(),11);
+        w.registry().consume("inc");
+    }
+    EXPECT_EQ(SumFilter::num_execs,1);
+
+    // bumping the generation invalidates the cached sum
+    vals[0] = 11;
+    data["state/generation"] = 1;
+    w.execute();
+    Node *res = w.registry().fetch<Node>("inc");
+    EXPECT_EQ(res->to_int(),21);
+    w.registry().consume("inc");
+    EXPECT_EQ(SumFilter::num_execs,2);
+
+    Node info;
+    w.info(info);
+    EXPECT_TRUE(info.has_path("cache/entries/sum"));
+
+    // disabling the cache releases the cached outputs
+    w.set_cache_enabled(false);
+    w.execute();
+    res = w.registry().fetch<Node>("inc");
+    EXPECT_EQ(res->to_int(),21);
+    w.registry().consume("inc");
+    EXPECT_EQ(SumFilter::num_execs,3);
+
+    Workspace::clear_supported_filter_types();
+}
+
+
+//-----------------------------------------------------------------------------
+class CopyFilter: public Filter
+{
+public:
+    CopyFilter()
+    : Filter()
+    {}
+
+    virtual ~CopyFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "copy";
+        i["output_port"] = "true";
+        i["cacheable"]   = "true";
+        i["port_names"].append().set("in");
+    }
+
+    virtual void execute()
+    {
+        num_execs++;
+        Node *res = new Node();
+        res->set(*input<Node>("in"));
+        set_output<Node>(res);
+    }
+
+    static int num_execs;
+};
+
+int CopyFilter::num_execs = 0;
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, cached_filter_new_cycle)
+{
+    Workspace::register_filter_type<filters::RegistrySource>();
+    Workspace::register_filter_type<CopyFilter>();
+
+    Workspace w;
+    w.set_cache_enabled(true);
+
+    int vals[4] = {1, 2, 3, 4};
+    Node data;
+    data["state/generation"] = 0;
+    data["state/cycle"] = 100;
+    data["state/time"] = 1.0;
+    data["values"].set_external(vals,4);
+    w.registry().add<Node>(":src",&data);
+
+    Node p;
+    p["entry"] = ":src";
+    w.graph().add_filter("registry_source","s",p);
+    w.graph().add_filter("copy","copy");
+    w.graph().connect("s","copy","in");
+
+    CopyFilter::num_execs = 0;
+
+    for(int cycle = 100; cycle < 103; ++cycle)
+    {
+        // a new cycle w/o a new generation reuses the cached copy
+        data["state/cycle"] = cycle;
+        data["state/time"]  = cycle / 100.0;
+        w.execute();
+
+        Node *res = w.registry().fetch<Node>("copy");
+        EXPECT_EQ((*res)["state/cycle"].to_int(),cycle);
+        EXPECT_EQ((*res)["state/time"].to_float64(),cycle / 100.0);
+        EXPECT_EQ((*res)["values"].as_int_ptr()[3],4);
+
+        // consumers get their own copy, changes don't reach the cache
+        EXPECT_FALSE(res->has_child("extra"));
+        (*res)["extra"] = 1;
+        (*res)["state/cycle"] = -1;
+        w.registry().consume("copy");
+    }
+    EXPECT_EQ(CopyFilter::num_execs,1);
+
+    Workspace::clear_supported_filter_types();
+}
+
+
+//-----------------------------------------------------------------------------
+class CondFilter: public Filter
+{
+public:
+    CondFilter()
+    : Filter()
+    {}
+
+    virtual ~CondFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "cond";
+        i["output_port"] = "true";
+        i["port_names"].append().set("in");
+        i["default_params"]["fire"].set((int)1);
+    }
+
+    virtual void execute()
+    {
+        int fire = params()["fire"].value();
+        if(fire == 0)
+        {
+            skip();
+            return;
+        }
+
+        set_output(input(0));
+    }
+};
+
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, gated_graph_skip)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<IncFilter>();
+    Workspace::register_filter_type<CondFilter>();
+    filters::register_builtin();
+
+    for(int num_threads = 1; num_threads <= 4; num_threads += 3)
+    {
+        Workspace w;
+        w.set_num_threads(num_threads);
+
+        Node p_vs;
+        p_vs["value"].set(int(10));
+        w.graph().add_filter("src","s",p_vs);
+        w.graph().add_filter("inc","i1");
+        w.graph().connect("s","i1","in");
+
+        // i1 feeds both a regular consumer and a gated branch
+        w.graph().add_filter("inc","i2");
+        w.graph().connect("i1","i2","in");
+
+        w.graph().add_filter("cond","c");
+        w.graph().connect("s","c","in");
+        w.graph().add_filter("gate","g");
+        w.graph().connect("i1","g","in");
+        w.graph().connect("c","g","gate");
+        w.graph().add_filter("inc","i3");
+        w.graph().connect("g","i3","in");
+
+        w.execute();
+        EXPECT_EQ(w.registry().fetch<Node>("i2")->to_int(),12);
+        EXPECT_EQ(w.registry().fetch<Node>("i3")->to_int(),12);
+        w.registry().reset();
+
+        // the gated branch doesn't execute, the rest of the graph does
+        w.graph().filter("c")->params()["fire"] = 0;
+        w.execute();
+        EXPECT_EQ(w.registry().fetch<Node>("i2")->to_int(),12);
+        EXPECT_FALSE(w.registry().has_entry("g"));
+        EXPECT_FALSE(w.registry().has_entry("i3"));
+        // the shared input was released
+        EXPECT_FALSE(w.registry().has_entry("i1"));
+        w.registry().reset();
+    }
+
+    Workspace::clear_supported_filter_types();
+}
+
+
 //-----------------------------------------------------------------------------
 TEST(ascent_flow_workspace, dag_graph_filter_ptr_iface_auto_name)
 {
@@ -51,7 +51,9 @@
 #include <ascent.hpp>
 #include <ascent_hola.hpp>
 
+#include <exception>
 #include <fstream>
+#include <thread>
 #include <vector>
 #ifdef REPLAY_MPI
 #include <mpi.h>
@@ -68,7 +70,9 @@ void usage()
   std::cout<<"  --cycles  : a text file containing a list of root files, one per line.\n";
   std::cout<<"              Each file will be loaded and sent to Ascent in order.\n";
   std::cout<<"  --actions : a json file containing ascent actions. Default value\n";
-  std::cout<<"              is 'ascent_actions.json'.\n\n";
+  std::cout<<"              is 'ascent_actions.json'.\n";
+  std::cout<<"  --mmap    : memory map conduit_bin domains instead of reading them.\n";
+  std::cout<<"              Changes to the mapped data are written to the files.\n\n";
   std::cout<<"======================== Examples =========================\n";
   std::cout<<"./relay_ser --root=clover.cycle_000060.root\n";
   std::cout<<"./relay_ser --root=clover.cycle_000060.root --actions=my_actions.json\n";
@@ -81,6 +85,7 @@ struct Options
   std::string m_actions_file = "ascent_actions.json";
   std::string m_root_file;
   std::string m_cycles_file;
+  bool m_mmap = false;
 
   void parse(int argc, char** argv)
   {
@@ -98,6 +103,10 @@ struct Options
       {
         m_actions_file = get_arg(argv[i]);
       }
+      else if(std::string(argv[i]) == "--mmap")
+      {
+        m_mmap = true;
+      }
       else
       {
         bad_arg(argv[i]);
@@ -194,18 +203,28 @@ int main (int argc, char *argv[])
 
   int comm_size = 1;
   int rank = 0;
+  // read the next cycle while ascent works on the current one
+  bool prefetch = true;
 
+  conduit::Node replay_opts;
+  if(options.m_mmap)
+  {
+    replay_opts["mmap"] = "true";
+  }
 #ifdef REPLAY_MPI
-  MPI_Init(NULL,NULL);
+  // hola talks to the other ranks from the reader thread
+  int thread_level;
+  MPI_Init_thread(NULL,NULL, MPI_THREAD_MULTIPLE, &thread_level);
   MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-#endif
+  prefetch = thread_level == MPI_THREAD_MULTIPLE;
 
-  conduit::Node replay_data, replay_opts;
-#ifdef REPLAY_MPI
-  replay_opts["mpi_comm"] = MPI_Comm_c2f(MPI_COMM_WORLD);
+  // keep the reads from matching ascent's messages
+  MPI_Comm read_comm;
+  MPI_Comm_dup(MPI_COMM_WORLD, &read_comm);
+  replay_opts["mpi_comm"] = MPI_Comm_c2f(read_comm);
 #endif
-  //replay_data.print();
+
   conduit::Node ascent_opts;
   ascent_opts["actions_file"] = options.m_actions_file;
   ascent_opts["ascent_info"] = "verbose";
@@ -221,17 +240,66 @@ int main (int argc, char *argv[])
   ascent::Ascent ascent;
   ascent.open(ascent_opts);
 
-  for(int i = 0; i < time_steps.size(); ++i)
+  // one cycle is published while the other is read
+  conduit::Node replay_data[2];
+  std::exception_ptr read_error;
+
+  auto load_cycle = [&](const int step)
+  {
+    try
+    {
+      conduit::Node opts;
+      opts.set(replay_opts);
+      opts["root_file"] = time_steps[step];
+      conduit::Node &data = replay_data[step % 2];
+      data.reset();
+      ascent::hola("relay/blueprint/mesh", opts, data);
+    }
+    catch(...)
+    {
+      read_error = std::current_exception();
+    }
+  };
+
+  const int num_steps = static_cast<int>(time_steps.size());
+  if(num_steps > 0)
+  {
+    load_cycle(0);
+  }
+
+  for(int i = 0; i < num_steps; ++i)
   {
-    replay_opts["root_file"] = time_steps[i];
-    ascent::hola("relay/blueprint/mesh", replay_opts, replay_data);
+    if(read_error)
+    {
+      std::rethrow_exception(read_error);
+    }
+
+    ascent.publish(replay_data[i % 2]);
+
+    std::thread reader;
+    if(i + 1 < num_steps)
+    {
+      if(prefetch)
+      {
+        reader = std::thread(load_cycle, i + 1);
+      }
+    }
 
-    ascent.publish(replay_data);
     ascent.execute(actions);
+
+    if(reader.joinable())
+    {
+      reader.join();
+    }
+    else if(i + 1 < num_steps)
+    {
+      load_cycle(i + 1);
+    }
   }
   ascent.close();
 
 #ifdef REPLAY_MPI
+  MPI_Comm_free(&read_comm);
   MPI_Finalize();
 #endif
   return 0;